@@ -0,0 +1,177 @@
+#include "FZ35_Admission.h"
+#include "FZ35_Trace.h"
+
+/**
+ * @file FZ35_Admission.cpp
+ * @brief Token buckets, heavy-request accounting and read timing.
+ */
+
+/**
+ * @struct AdmitEndpoint
+ * @brief Bucket and counters of one guarded endpoint. Tokens in 1/1000.
+ */
+struct AdmitEndpoint {
+    const char *name;
+    AdmitClass cls;
+    uint16_t ratePerSec;
+    uint8_t burst;
+    uint32_t tokens;
+    uint32_t refillMs;
+    uint32_t admitted;
+    uint32_t rejectedRate;
+    uint32_t rejectedBusy;
+    uint32_t rejectedLate;
+    uint64_t handlerUs;        // synchronous handler time of admitted requests
+    uint32_t maxHandlerUs;
+};
+
+static AdmitEndpoint endpoints[ADMIT_MAX_ENDPOINTS];
+static int endpointCount = 0;
+static uint8_t heavyInFlight = 0;
+static uint8_t heavyPeak = 0;
+static uint32_t behindUntilMs = 0;
+static uint32_t behindEvents = 0;
+
+// read timing
+static uint32_t reads = 0;
+static uint32_t lateReads = 0;
+static int64_t lateSumMs = 0;      // positive lateness only
+static uint32_t lateMaxMs = 0;
+static uint32_t readMaxMs = 0;
+
+static int registerEndpoint(const char *name, AdmitClass cls) {
+    if (endpointCount >= ADMIT_MAX_ENDPOINTS) return -1;
+    AdmitEndpoint &e = endpoints[endpointCount];
+    memset(&e, 0, sizeof(e));
+    e.name = name;
+    e.cls = cls;
+    e.ratePerSec = cls == AdmitClass::Heavy ? 2 : 5;
+    e.burst = cls == AdmitClass::Heavy ? 4 : 10;
+    e.tokens = e.burst * 1000UL;
+    e.refillMs = millis();
+    return endpointCount++;
+}
+
+static void refill(AdmitEndpoint &e, uint32_t now) {
+    uint32_t cap = e.burst * 1000UL;
+    // an endpoint idle for days: more than a full refill would overflow the product
+    uint32_t elapsed = now - e.refillMs, fullMs = cap / e.ratePerSec + 1;
+    uint32_t add = (elapsed < fullMs ? elapsed : fullMs) * e.ratePerSec; // 1/1000 tokens
+    e.refillMs = now;
+    e.tokens = add >= cap - e.tokens ? cap : e.tokens + add;
+}
+
+static void reject(AsyncWebServerRequest *request, int code, uint32_t retryS, const char *why) {
+    AsyncWebServerResponse *response = request->beginResponse(code, "text/plain", why);
+    response->addHeader("Retry-After", String((unsigned long)retryS));
+    response->addHeader("Cache-Control", "no-store");
+    request->send(response);
+}
+
+bool admissionBehind() {
+    return behindUntilMs && (int32_t)(millis() - behindUntilMs) < 0;
+}
+
+ArRequestHandlerFunction admitted(const char *name, AdmitClass cls, ArRequestHandlerFunction handler) {
+    int id = registerEndpoint(name, cls);
+    if (id < 0) {
+        Serial.printf("Admission: no slot for %s\n", name);
+        return handler;
+    }
+    return [id, handler](AsyncWebServerRequest *request) {
+        AdmitEndpoint &e = endpoints[id];
+        uint32_t now = millis();
+        refill(e, now);
+
+        if (e.tokens < 1000) {
+            e.rejectedRate++;
+            reject(request, 429, (1000 - e.tokens) / e.ratePerSec / 1000 + 1, "rate limited");
+            return;
+        }
+        if (e.cls == AdmitClass::Heavy) {
+            if (admissionBehind()) {
+                e.rejectedLate++;
+                reject(request, 503, ADMIT_RETRY_S, "sampling behind schedule");
+                return;
+            }
+            if (heavyInFlight >= ADMIT_MAX_HEAVY) {
+                e.rejectedBusy++;
+                reject(request, 503, 1, "busy");
+                return;
+            }
+            heavyInFlight++;
+            if (heavyInFlight > heavyPeak) heavyPeak = heavyInFlight;
+            // streamed bodies keep working after the handler returns; the slot is
+            // released when the connection closes
+            request->onDisconnect([]() { if (heavyInFlight) heavyInFlight--; });
+        }
+        e.tokens -= 1000;
+        e.admitted++;
+
+        uint32_t t0 = micros();
+        {
+            TraceScope trace(e.name, TRACE_TID_ASYNC);
+            handler(request);
+        }
+        uint32_t dt = micros() - t0;
+        e.handlerUs += dt;
+        if (dt > e.maxHandlerUs) e.maxHandlerUs = dt;
+    };
+}
+
+void admissionNoteRead(long lateMs, unsigned long durationMs) {
+    reads++;
+    if (lateMs > 0) {
+        lateSumMs += lateMs;
+        if ((uint32_t)lateMs > lateMaxMs) lateMaxMs = lateMs;
+    }
+    if (durationMs > readMaxMs) readMaxMs = durationMs;
+    if (lateMs > ADMIT_LATE_MS || durationMs > ADMIT_READ_BUDGET_MS) {
+        lateReads++;
+        if (!admissionBehind()) {
+            behindEvents++;
+            Serial.printf("Admission: read %ld ms late, %lu ms long; shedding heavy requests\n",
+                          lateMs, durationMs);
+        }
+        behindUntilMs = millis() + ADMIT_HOLD_MS;
+        if (!behindUntilMs) behindUntilMs = 1;
+    }
+}
+
+String admissionStatusJson() {
+    uint32_t rejected = 0;
+    uint64_t savedUs = 0;
+    String list;
+    list.reserve(endpointCount * 120);
+    for (int i = 0; i < endpointCount; ++i) {
+        const AdmitEndpoint &e = endpoints[i];
+        uint32_t rej = e.rejectedRate + e.rejectedBusy + e.rejectedLate;
+        uint32_t meanUs = e.admitted ? (uint32_t)(e.handlerUs / e.admitted) : 0;
+        rejected += rej;
+        savedUs += (uint64_t)rej * meanUs;
+        if (i) list += ",";
+        list += "{\"path\":\"" + String(e.name) + "\",\"class\":\"" +
+                String(e.cls == AdmitClass::Heavy ? "heavy" : "poll") + "\"";
+        list += ",\"admitted\":" + String((unsigned long)e.admitted);
+        list += ",\"rate\":" + String((unsigned long)e.rejectedRate);
+        list += ",\"busy\":" + String((unsigned long)e.rejectedBusy);
+        list += ",\"late\":" + String((unsigned long)e.rejectedLate);
+        list += ",\"mean_us\":" + String((unsigned long)meanUs);
+        list += ",\"max_us\":" + String((unsigned long)e.maxHandlerUs) + "}";
+    }
+
+    String json = "{\"behind\":" + String(admissionBehind() ? "true" : "false");
+    json += ",\"behind_events\":" + String((unsigned long)behindEvents);
+    json += ",\"heavy_inflight\":" + String(heavyInFlight);
+    json += ",\"heavy_peak\":" + String(heavyPeak);
+    json += ",\"reads\":" + String((unsigned long)reads);
+    json += ",\"late_reads\":" + String((unsigned long)lateReads);
+    json += ",\"late_ms_mean\":" + String((unsigned long)(reads ? lateSumMs / reads : 0));
+    json += ",\"late_ms_max\":" + String((unsigned long)lateMaxMs);
+    json += ",\"read_ms_max\":" + String((unsigned long)readMaxMs);
+    json += ",\"rejected\":" + String((unsigned long)rejected);
+    // handler time the rejected requests would have taken from loop() (mean per endpoint)
+    json += ",\"saved_ms\":" + String((unsigned long)(savedUs / 1000));
+    json += ",\"endpoints\":[" + list + "]}";
+    return json;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+
+/**
+ * @file FZ35_Admission.h
+ * @brief Admission control for HTTP handlers. Handlers run in the async TCP context
+ *        and compete with loop() for the CPU, so each guarded endpoint gets a token
+ *        bucket (429 when exceeded), expensive endpoints share a concurrency cap
+ *        (503 while ADMIT_MAX_HEAVY are in flight), and expensive endpoints are shed
+ *        (503) for a while after a device read started late or ran long.
+ *        Rejections carry Retry-After. Counters are served at /admission.
+ */
+
+#define ADMIT_MAX_ENDPOINTS  24
+#define ADMIT_MAX_HEAVY      2     // concurrent heavy requests (until disconnect)
+#define ADMIT_LATE_MS        250   // read started this much after its slot = behind
+#define ADMIT_READ_BUDGET_MS 700   // read took longer than this = behind
+#define ADMIT_HOLD_MS        3000  // heavy requests shed this long after the last bad read
+#define ADMIT_RETRY_S        2
+
+enum class AdmitClass : uint8_t {
+    Poll,    // cheap, polled by the dashboard: 5/s, burst 10
+    Heavy    // large bodies / flash reads: 2/s, burst 4, concurrency cap, shed when behind
+};
+
+/**
+ * @brief Wrap a handler with admission control; name is the endpoint (string literal).
+ */
+ArRequestHandlerFunction admitted(const char *name, AdmitClass cls, ArRequestHandlerFunction handler);
+
+/**
+ * @brief Acquisition timing, fed from loop() after every device read.
+ * @param lateMs How long after its scheduled time the read started (may be <= 0).
+ * @param durationMs How long the read took.
+ */
+void admissionNoteRead(long lateMs, unsigned long durationMs);
+bool admissionBehind();
+
+String admissionStatusJson();
@@ -1,110 +1,133 @@
 #include "FZ35_Battery.h"
 #include <Arduino.h>
 #include "FZ35_Comm.h"
+#include "FZ35_ProfileStore.h"
+#include "FZ35_Channel.h"
+#include "FZ35_Trace.h"
 
 /**
  * @file FZ35_Battery.cpp
- * @brief Implements battery profile selection, clamping to device limits,
- *        queuing of parameter commands, and staged transmission (processPendingBattery()).
+ * @brief Implements battery profile selection, queuing of the precomputed parameter
+ *        commands (FZ35_Profiles.h), and staged transmission (processPendingBattery()).
  */
 
-// extern declarations for globals defined in main .ino
-extern String TEST_LOAD; // NEW
-
-// ===== battery table with complete protection parameters =====
-// Recommended test loads based on typical discharge test standards:
-// - Li-ion/LiPo: 0.2C–1C (we use 0.5C conservative)
-// - LiFePO4: 0.5C–1C (we use 0.5C)
-// - Lead Acid: 0.05C–0.2C (we use 0.1C)
-// - Primary lithium (coin cells): 0.1C–0.5C (we use 0.2C)
-// - Alkaline: 0.1C–0.5C (we use 0.2C)
-// - NiMH: 0.2C–1C (we use 0.5C)
-
-BatteryModule batteryModules[] = {
-  // name, chem, nominalV, capacityAh, maxLoadA, recommendedLoadA, LVP, OAH, OHP
-  { "24V Generic 5.00A", BatteryChemistry::LiIon, 24.20f, 30.0f, 5.10f, 5.00f, 18.0f, 36.0f, "10:00" }, // 6S Li-ion: 3.0V*6=18V cutoff
-  { "24V Lead Acid 5.00A", BatteryChemistry::LeadAcid, 24.00f, 50.0f, 10.00f, 5.00f, 21.0f, 60.0f, "10:00" }, // 12 cells: 1.75V*12=21V
-  { "24V LiFePO4 5.00A", BatteryChemistry::LiFePO4, 24.20f, 20.0f, 20.00f, 5.00f, 20.0f, 24.0f, "05:00" }, // 8S: 2.5V*8=20V
-
-  // Single-cell Li-ion (3.0V cutoff)
-  { "18650 Li-ion 4.2V 1.30A", BatteryChemistry::LiIon, 4.20f, 2.6f, 3.0f, 1.30f, 3.0f, 3.2f, "02:00" },
-  { "21700 Li-ion 4.2V 2.00A", BatteryChemistry::LiIon, 4.20f, 4.0f, 5.0f, 2.00f, 3.0f, 4.8f, "02:30" },
-  { "14500 Li-ion 4.2V 0.40A", BatteryChemistry::LiIon, 4.20f, 0.8f, 1.5f, 0.40f, 3.0f, 1.0f, "02:00" },
-  { "16340 Li-ion 4.2V 0.35A", BatteryChemistry::LiIon, 4.20f, 0.7f, 1.5f, 0.35f, 3.0f, 0.85f, "02:00" },
-
-  // LiFePO4 cells (2.5V cutoff)
-  { "18650 LiFePO4 3.65V 0.75A", BatteryChemistry::LiFePO4, 3.65f, 1.5f, 3.0f, 0.75f, 2.5f, 1.8f, "02:00" },
-  { "26650 LiFePO4 3.65V 1.65A", BatteryChemistry::LiFePO4, 3.65f, 3.3f, 5.0f, 1.65f, 2.5f, 4.0f, "02:30" },
-
-  // Primary Lithium (2.0V cutoff)
-  { "CR2 3.3V 0.16A", BatteryChemistry::CoinCell, 3.30f, 0.8f, 1.0f, 0.16f, 2.0f, 1.0f, "05:00" },
-  { "CR123A 3.3V 0.30A", BatteryChemistry::CoinCell, 3.30f, 1.5f, 1.5f, 0.30f, 2.0f, 1.8f, "05:00" },
-
-  // Alkaline (0.9V cutoff)
-  { "AA Alkaline 1.6V 0.48A", BatteryChemistry::LeadAcid, 1.60f, 2.4f, 1.0f, 0.48f, 0.9f, 3.0f, "05:00" },
-  { "AAA Alkaline 1.6V 0.24A", BatteryChemistry::LeadAcid, 1.60f, 1.2f, 0.5f, 0.24f, 0.9f, 1.5f, "05:00" },
-
-  // NiMH (0.9V cutoff)
-  { "AA NiMH 1.5V 1.00A", BatteryChemistry::LeadAcid, 1.50f, 2.0f, 2.0f, 1.00f, 0.9f, 2.5f, "02:00" },
-  { "AAA NiMH 1.5V 0.40A", BatteryChemistry::LeadAcid, 1.50f, 0.8f, 1.0f, 0.40f, 0.9f, 1.0f, "02:00" },
-
-  // 9V batteries
-  { "PP3 9V Alkaline 0.06A", BatteryChemistry::LeadAcid, 9.60f, 0.6f, 0.2f, 0.06f, 5.4f, 0.75f, "10:00" }, // 6 cells: 0.9V*6=5.4V
-  { "PP3 8.4V Li-ion 0.30A", BatteryChemistry::LiIon, 8.40f, 0.6f, 0.5f, 0.30f, 6.0f, 0.75f, "02:00" }, // 2S: 3.0V*2=6V
-
-  // LiPo packs
-  { "2S LiPo 7.4V 1.10A", BatteryChemistry::LiIon, 8.40f, 2.2f, 5.0f, 1.10f, 6.0f, 2.6f, "02:00" }, // 2S: 3.0V*2
-  { "3S LiPo 11.1V 1.10A", BatteryChemistry::LiIon, 12.60f, 2.2f, 5.0f, 1.10f, 9.0f, 2.6f, "02:00" }, // 3S: 3.0V*3
-  { "4S LiPo 14.8V 1.10A", BatteryChemistry::LiIon, 16.80f, 2.2f, 2.0f, 1.10f, 12.0f, 2.6f, "02:00" }, // 4S: 3.0V*4
-  { "5S LiPo 18.5V 1.10A", BatteryChemistry::LiIon, 21.00f, 2.2f, 2.0f, 1.10f, 15.0f, 2.6f, "02:00" }, // 5S: 3.0V*5
-
-  // LiFePO4 pack
-  { "4S LiFePO4 12.8V 5.00A", BatteryChemistry::LiFePO4, 14.60f, 10.0f, 5.0f, 5.00f, 10.0f, 12.0f, "02:30" }, // 4S: 2.5V*4
-
-  // Lead Acid (10.5V for 12V battery = 1.75V/cell)
-  { "12V SLA 14.4V 0.70A", BatteryChemistry::LeadAcid, 14.40f, 7.0f, 5.0f, 0.70f, 10.5f, 8.5f, "10:00" },
-};
-const size_t batteryModulesCount = sizeof(batteryModules) / sizeof(batteryModules[0]);
 // start with index 0 active
-BatteryModule currentBattery = batteryModules[0];
+int activeBatteryIdx = 0;
+// the derived table stays in flash; only the active entry is copied to RAM
+static BatteryDerived activeDerived;
+static bool activeDerivedLoaded = false;
+
+// RAM copy of an active user profile (built-ins point straight into batteryModules[])
+static BatteryModule activeUserModule;
+static char activeUserName[PROFILE_NAME_LEN];
+static char activeUserOhp[6];
+
+const BatteryModule& activeBattery() {
+  if (isUserBatteryId(activeBatteryIdx)) return activeUserModule;
+  return batteryModules[activeBatteryIdx];
+}
+
+const BatteryDerived& activeBatteryDerived() {
+  if (!activeDerivedLoaded) {
+    if (isUserBatteryId(activeBatteryIdx)) {
+      activeDerived = deriveBattery(activeUserModule); // same rules, evaluated at runtime
+    } else {
+      memcpy_P(&activeDerived, &batteryDerived.entries[activeBatteryIdx], sizeof(activeDerived));
+    }
+    activeDerivedLoaded = true;
+  }
+  return activeDerived;
+}
+
+bool isUserBatteryId(int idx) { return idx >= (int)batteryModulesCount; }
+
+static void userRecordToModule(const UserProfileRecord &r, BatteryModule &b, char *name, char *ohp) {
+  memcpy(name, r.name, PROFILE_NAME_LEN);
+  name[PROFILE_NAME_LEN - 1] = '\0';
+  memcpy(ohp, r.ohp, sizeof(r.ohp));
+  ohp[sizeof(r.ohp) - 1] = '\0';
+  b = { name, (BatteryChemistry)r.chem, r.nominal_mV / 1000.0f, r.capacity_mAh / 1000.0f,
+        r.maxLoad_mA / 1000.0f, r.recLoad_mA / 1000.0f, r.lvp_mV / 1000.0f,
+        r.oah_mAh / 1000.0f, ohp };
+}
 
-// device rated limits (do not exceed)
-static constexpr float RATED_VOLTAGE_MAX = 25.0f;
-static constexpr float RATED_CURRENT_MAX = 5.0f;
-static constexpr float RATED_POWER_MAX   = 35.0f;
+uint32_t batteryListGeneration = 0;
 
 // pending index (no apply yet). -1 = none
 int pendingBatteryIdx = -1;
 bool pendingWasClamped = false;
 
-// NEW: freeze numeric values at selection time (used for sending)
-static float pendingOVP = 0.0f;
-static float pendingOCP = 0.0f;
-static float pendingOPP = 0.0f;
-static float pendingLVP = 0.0f;
-static float pendingOAH = 0.0f;
-static String pendingOHP;
-
 // helpers exposed in header
-int getBatteryCount() { return (int)batteryModulesCount; }
+int getBatteryCount() { return (int)batteryModulesCount + userProfileCount(); }
 String getBatteryName(int idx) {
-  if (idx < 0 || (size_t)idx >= batteryModulesCount) return String();
-  return String(batteryModules[idx].name);
+  if (idx < 0) return String();
+  if ((size_t)idx < batteryModulesCount) return String(batteryModules[idx].name);
+  UserProfileRecord rec;
+  if (!readUserProfile(idx - (int)batteryModulesCount, rec)) return String();
+  return String(rec.name);
 }
-int getActiveBatteryIndex() {
-  for (size_t i = 0; i < batteryModulesCount; ++i) {
-    if (strcmp(currentBattery.name, batteryModules[i].name) == 0) return (int)i;
+int getActiveBatteryIndex() { return activeBatteryIdx; }
+
+/**
+ * @brief One page of the catalog: built-ins first, then user profiles in slot order.
+ * Ids are listed alongside names since deleted user slots leave gaps.
+ */
+String getBatteryListJson(int offset, int limit) {
+  int total = getBatteryCount();
+  if (offset < 0) offset = 0;
+  if (limit <= 0) limit = total;
+  int end = offset + limit;
+  if (end > total) end = total;
+
+  String names, ids;
+  for (int ord = offset; ord < end; ++ord) {
+    int id;
+    String name;
+    if ((size_t)ord < batteryModulesCount) {
+      id = ord;
+      name = batteryModules[ord].name;
+    } else {
+      int slot = userProfileSlotAt(ord - (int)batteryModulesCount);
+      id = (int)batteryModulesCount + slot;
+      name = getBatteryName(id);
+    }
+    if (ord > offset) { names += ","; ids += ","; }
+    names += "\"" + name + "\"";
+    ids += String(id);
   }
-  return 0;
+  return "{\"active\":" + String(getActiveBatteryIndex()) + ",\"total\":" + String(total) +
+         ",\"builtin\":" + String((int)batteryModulesCount) + ",\"offset\":" + String(offset) +
+         ",\"batteries\":[" + names + "],\"ids\":[" + ids + "]}";
 }
-String getBatteryListJson() {
-  String s = "{\"active\":" + String(getActiveBatteryIndex()) + ",\"batteries\":[";
-  for (size_t i = 0; i < batteryModulesCount; ++i) {
-    if (i) s += ",";
-    s += "\"" + String(batteryModules[i].name) + "\"";
+
+/**
+ * @brief Full definition of one profile (built-in or user) for editing.
+ */
+String getBatteryProfileJson(int idx) {
+  BatteryModule b;
+  char name[PROFILE_NAME_LEN], ohp[6];
+  if (idx >= 0 && (size_t)idx < batteryModulesCount) {
+    b = batteryModules[idx];
+  } else {
+    UserProfileRecord rec;
+    if (idx < 0 || !readUserProfile(idx - (int)batteryModulesCount, rec)) return String();
+    userRecordToModule(rec, b, name, ohp);
   }
-  s += "]}";
-  return s;
+  char num[16];
+  auto field = [&](const char *key, float v, uint8_t decimals) {
+    formatMilli(num, sizeof(num), toMilli(v), decimals);
+    return ",\"" + String(key) + "\":" + num;
+  };
+  String json = "{\"id\":" + String(idx) + ",\"user\":" + (isUserBatteryId(idx) ? "true" : "false");
+  json += ",\"name\":\"" + String(b.name) + "\",\"chem\":" + String((int)b.chem);
+  json += field("nominal", b.nominalVoltage, 2);
+  json += field("capacity", b.capacityAh, 3);
+  json += field("max_load", b.maxLoadA, 2);
+  json += field("load", b.recommendedLoadA, 2);
+  json += field("lvp", b.lowVoltageProtect, 2);
+  json += field("oah", b.overAhLimit, 3);
+  json += ",\"ohp\":\"" + String(b.overHourLimit) + "\"}";
+  return json;
 }
 
 void selectBatteryByName(const char* name){
@@ -114,130 +137,144 @@ void selectBatteryByName(const char* name){
       return;
     }
   }
+  int slot = findUserProfileByName(name);
+  if (slot >= 0) setActiveBattery((int)batteryModulesCount + slot);
 }
 
 /**
- * @brief Queue profile, clamp values (V/I/P), format strings for UI, freeze numeric copies.
+ * @brief Queue profile and publish its precomputed (clamped, formatted) values to the UI.
  */
-// setActiveBattery: queue profile (update UI globals immediately)
-// now clamps values to device rated limits
 bool setActiveBattery(int idx){
-  if (idx < 0 || (size_t)idx >= batteryModulesCount) return false;
-  currentBattery = batteryModules[idx];
-
-  // requested values from profile
-  float reqOVP = currentBattery.nominalVoltage;
-  float reqOCP = currentBattery.maxLoadA;
-  float reqOPP = reqOVP * reqOCP;
-
-  bool clamped = false;
-
-  // clamp voltage
-  if (reqOVP > RATED_VOLTAGE_MAX) { reqOVP = RATED_VOLTAGE_MAX; clamped = true; }
-
-  // clamp current
-  if (reqOCP > RATED_CURRENT_MAX) { reqOCP = RATED_CURRENT_MAX; clamped = true; }
-
-  // ensure power limit: if product still > max, reduce current to fit power budget
-  if (reqOVP * reqOCP > RATED_POWER_MAX) {
-    float allowedI = RATED_POWER_MAX / reqOVP;
-    if (allowedI < reqOCP) {
-      reqOCP = allowedI;
-      clamped = true;
-    }
+  if (idx < 0) return false;
+  if (isUserBatteryId(idx)) {
+    UserProfileRecord rec;
+    if (!readUserProfile(idx - (int)batteryModulesCount, rec)) return false;
+    userRecordToModule(rec, activeUserModule, activeUserName, activeUserOhp);
+  } else if ((size_t)idx >= batteryModulesCount) {
+    return false;
   }
-
-  // Quantize OVP to 0.1V steps (device accepts 0.1V resolution) and recompute OPP
-  reqOVP = roundf(reqOVP * 10.0f) / 10.0f;
-  reqOPP = reqOVP * reqOCP;
-
-  // format strings for UI and sending
-  extern String OVP, OCP, OPP, LVP, OAH, OHP, TEST_LOAD;
-  OVP = String(reqOVP, 1);
-  OCP = String(reqOCP, 2);
-  OPP = String(reqOPP, 2);
-
-  // NEW: use chemistry-specific protection values from profile
-  LVP = String(currentBattery.lowVoltageProtect, 1);
-  OAH = String(currentBattery.overAhLimit, 3);
-  OHP = String(currentBattery.overHourLimit);
-
-  // NEW: use pre-defined recommended test load
-  float recommendedI = currentBattery.recommendedLoadA;
-  if (recommendedI > RATED_CURRENT_MAX) recommendedI = RATED_CURRENT_MAX;
-  if (recommendedI < 0.05f) recommendedI = 0.05f;
-  TEST_LOAD = String(recommendedI, 2);
-
-  // NEW: freeze numeric values for sending
-  pendingOVP = reqOVP;
-  pendingOCP = reqOCP;
-  pendingOPP = reqOPP;
-  pendingLVP = currentBattery.lowVoltageProtect;
-  pendingOAH = currentBattery.overAhLimit;
-  pendingOHP = String(currentBattery.overHourLimit);
+  activeBatteryIdx = idx;
+  activeDerivedLoaded = false;
+  batteryListGeneration++;
+  const BatteryModule &b = activeBattery();
+  const BatteryDerived &d = activeBatteryDerived();
+
+  // UI strings are the value part of the precomputed command payloads
+  OVP = d.ovp.c_str();
+  OCP = d.ocpCmd.c_str() + PROFILE_CMD_PREFIX_LEN;
+  OPP = d.oppCmd.c_str() + PROFILE_CMD_PREFIX_LEN;
+  LVP = d.lvpCmd.c_str() + PROFILE_CMD_PREFIX_LEN;
+  OAH = d.oahCmd.c_str() + PROFILE_CMD_PREFIX_LEN;
+  OHP = d.ohpCmd.c_str() + PROFILE_CMD_PREFIX_LEN;
+  TEST_LOAD = d.load.c_str();
 
   // queue actual device commands for later (do NOT send now)
   pendingBatteryIdx = idx;
-  pendingWasClamped = clamped;
+  pendingWasClamped = d.clamped;
 
   Serial.printf("Queued battery [%d] %s -> will apply when comm idle (clamped=%s)\n",
-                idx, currentBattery.name, clamped ? "YES" : "NO");
-  if (clamped) {
+                idx, b.name, d.clamped ? "YES" : "NO");
+  if (d.clamped) {
     Serial.println("Warning: profile values were clamped to device rated limits (V<=25.0V, I<=5.0A, P<=35W).");
   }
   return true;
 }
 
+void refreshActiveBattery() {
+  if (!isUserBatteryId(activeBatteryIdx)) return;
+  UserProfileRecord rec;
+  if (!readUserProfile(activeBatteryIdx - (int)batteryModulesCount, rec)) return;
+  userRecordToModule(rec, activeUserModule, activeUserName, activeUserOhp);
+  activeDerivedLoaded = false;
+  batteryListGeneration++;
+}
+
 /**
- * @brief Send queued profile parameters in ordered sequence with confirmation.
- * Stops measurement, applies parameters, restarts measurement.
+ * @brief Payloads of any profile, e.g. for a load other than the active one (FZ35_Channel.h).
  */
-// processPendingBattery() uses frozen numeric values above
-void processPendingBattery() {
-  if (pendingBatteryIdx < 0) return;
-  int idx = pendingBatteryIdx;
-  pendingBatteryIdx = -1;
+bool getBatteryDerived(int idx, BatteryDerived &d, String &name) {
+  if (idx >= 0 && (size_t)idx < batteryModulesCount) {
+    memcpy_P(&d, &batteryDerived.entries[idx], sizeof(d));
+    name = batteryModules[idx].name;
+    return true;
+  }
+  UserProfileRecord rec;
+  if (idx < 0 || !readUserProfile(idx - (int)batteryModulesCount, rec)) return false;
+  BatteryModule b;
+  char userName[PROFILE_NAME_LEN], ohp[6];
+  userRecordToModule(rec, b, userName, ohp);
+  d = deriveBattery(b);
+  name = userName;
+  return true;
+}
 
+/**
+ * @brief Stop measurement and send the parameters in order with confirmation
+ * (the caller restarts measurement).
+ * @return Number of confirmed parameters out of PROFILE_PAYLOAD_COUNT.
+ */
+int sendProfilePayloads(const BatteryDerived &d) {
   int successCount = 0;
-  const int totalCommands = 6;
-
-  Serial.printf("\n=== Applying battery[%d] profile (clamped=%s) ===\n",
-                idx, pendingWasClamped ? "YES" : "NO");
+  const int totalCommands = PROFILE_PAYLOAD_COUNT;
 
   // STEP 1: stop measurements to avoid interference
   Serial.println("Stopping measurements...");
   sendCommandNoNL("stop");
-  delay(300);
+  estopDelay(300);
 
   auto doCmd = [&](int order, const String &payload){
+    TraceScope step("profile step", TRACE_TID_LOOP, order);
     Serial.printf("\n[%d/%d] Setting %s\n", order, totalCommands, payload.c_str());
     if (sendCommandWithConfirm(payload, 1000)) successCount++;
-    delay(120);
+    estopDelay(120);
   };
 
   // NEW: send test load current (format: x.xxA without any prefix)
   Serial.println("\n[0/6] Setting LOAD (test current)");
-  String loadCmd = TEST_LOAD + "A"; // e.g., "1.30A"
-  if (sendCommandWithConfirm(loadCmd, 1000)) {
-    Serial.println("Test load current applied.");
-  } else {
-    Serial.println("Failed to apply test load current.");
+  String loadCmd = String(d.load.c_str()) + "A"; // e.g., "1.30A"
+  {
+    TraceScope step("profile step", TRACE_TID_LOOP, 0);
+    if (sendCommandWithConfirm(loadCmd, 1000)) {
+      Serial.println("Test load current applied.");
+    } else {
+      Serial.println("Failed to apply test load current.");
+    }
   }
-  delay(150);
+  estopDelay(150);
 
   // STEP 2: send parameters
-  doCmd(1, "OCP:" + String(pendingOCP, 2));
-  doCmd(2, "OPP:" + String(pendingOPP, 2));
-  doCmd(3, "LVP:" + String(pendingLVP, 1));
-  doCmd(4, "OAH:" + String(pendingOAH, 3));
-  doCmd(5, "OHP:" + pendingOHP);
+  doCmd(1, d.ocpCmd.c_str());
+  doCmd(2, d.oppCmd.c_str());
+  doCmd(3, d.lvpCmd.c_str());
+  doCmd(4, d.oahCmd.c_str());
+  doCmd(5, d.ohpCmd.c_str());
 
   // OVP last, try variants
   {
-    String ovpStr = String(pendingOVP, 1);
+    TraceScope step("profile step", TRACE_TID_LOOP, 6);
+    String ovpStr = d.ovp.c_str();
     Serial.printf("\n[6/%d] Setting OVP:%s (with variants)\n", totalCommands, ovpStr.c_str());
     if (sendParamVariants("OVP", ovpStr, 1200)) successCount++;
   }
+  return successCount;
+}
+
+/**
+ * @brief Send queued profile parameters in ordered sequence with confirmation.
+ * Stops measurement, applies parameters, restarts measurement.
+ */
+// processPendingBattery() sends the compile-time payloads of the queued profile
+void processPendingBattery() {
+  if (pendingBatteryIdx < 0) return;
+  int idx = pendingBatteryIdx;
+  pendingBatteryIdx = -1;
+  const BatteryDerived &d = activeBatteryDerived(); // pending is always the active profile
+  TraceScope trace("profile apply");
+  const int totalCommands = PROFILE_PAYLOAD_COUNT;
+
+  Serial.printf("\n=== Applying battery[%d] profile (clamped=%s) ===\n",
+                idx, pendingWasClamped ? "YES" : "NO");
+  int successCount = sendProfilePayloads(d);
 
   Serial.printf("\n=== Battery[%d] Apply Complete: %d/%d successful (clamped=%s) ===\n\n",
                 idx, successCount, totalCommands, pendingWasClamped ? "YES" : "NO");
@@ -249,7 +286,7 @@ void processPendingBattery() {
   // STEP 3: restart measurements
   Serial.println("Restarting measurements...");
   sendCommandNoNL("start");
-  delay(300);
+  estopDelay(300);
 
   pendingWasClamped = false;
 }
@@ -1,49 +1,22 @@
 #pragma once
 #include <Arduino.h>
+#include "FZ35_Profiles.h"
 
 /**
  * @file FZ35_Battery.h
- * @brief Battery profile definitions and selection API. Each BatteryModule carries
- *        nominal parameters and protection limits used to configure the load.
+ * @brief Battery profile selection API. The profile table itself (BatteryModule,
+ *        batteryModules[], precomputed batteryDerived) lives in FZ35_Profiles.h.
+ *        Ids 0..batteryModulesCount-1 are built-in; higher ids are user profiles
+ *        (FZ35_ProfileStore.h, id = batteryModulesCount + record slot).
  */
 
-enum class BatteryChemistry {
-    LiIon,
-    LiFePO4,
-    LeadAcid,
-    CoinCell
-};
-
-/**
- * @struct BatteryModule
- * @brief Defines one test profile.
- * @param nominalVoltage Approx full voltage.
- * @param capacityAh Nominal capacity in Ah.
- * @param maxLoadA Maximum safe current.
- * @param recommendedLoadA Suggested test current (C-rate based).
- * @param lowVoltageProtect Cutoff voltage.
- * @param overAhLimit Amp-hour termination limit.
- * @param overHourLimit Time termination HH:MM.
- */
-struct BatteryModule {
-    const char* name;
-    BatteryChemistry chem;
-    float nominalVoltage;
-    float capacityAh;
-    float maxLoadA;
-    float recommendedLoadA; // NEW: recommended test load current (A)
-    float lowVoltageProtect; // NEW: LVP cutoff voltage
-    float overAhLimit;       // NEW: OAH in Ah (capacity limit)
-    const char* overHourLimit; // NEW: OHP in HH:MM format
-};
-
-// only declare here, define exactly once in FZ35_Battery.cpp
-extern BatteryModule batteryModules[];
-extern const size_t batteryModulesCount;
-extern BatteryModule currentBattery;
+// active profile is tracked by id (see above)
+extern int activeBatteryIdx;
+const BatteryModule& activeBattery();
+// RAM copy of the active profile's precomputed payloads
+const BatteryDerived& activeBatteryDerived();
 
 // helpers
-const char* chemistryToString(BatteryChemistry c);
 void selectBatteryByName(const char* name);
 
 /**
@@ -52,11 +25,28 @@ void selectBatteryByName(const char* name);
  */
 bool setActiveBattery(int idx);
 
+/**
+ * @brief Reload the RAM copy of the active user profile after it was edited. Nothing is
+ *        queued, so a running test or program keeps going; re-select to send the values.
+ */
+void refreshActiveBattery();
+
 // simple battery list API used by WebUI
 int getBatteryCount();
 String getBatteryName(int idx);
-bool setActiveBattery(int idx);
+int getActiveBatteryIndex();
+bool isUserBatteryId(int idx);
+String getBatteryListJson(int offset, int limit);
+String getBatteryProfileJson(int idx);
+
+// bumped on every profile selection change (keys the /batteries response cache)
+extern uint32_t batteryListGeneration;
 
 // new: pending index (>=0 means pending) and processor called from main loop
 extern int pendingBatteryIdx;
 void processPendingBattery();
+
+// any profile's payloads, and the send sequence shared with other loads (FZ35_Channel.h)
+#define PROFILE_PAYLOAD_COUNT 6   // OCP, OPP, LVP, OAH, OHP, OVP (the load current is not counted)
+bool getBatteryDerived(int idx, BatteryDerived &d, String &name);
+int sendProfilePayloads(const BatteryDerived &d);
@@ -0,0 +1,151 @@
+#include "FZ35_Capture.h"
+#include "FZ35_Trace.h"
+#include <LittleFS.h>
+#include <time.h>
+
+/**
+ * @file FZ35_Capture.cpp
+ * @brief Record encoding, RAM batch and the capture file.
+ */
+
+bool captureOn = false;
+uint8_t captureDepth = 0;
+
+static uint8_t buf[CAPTURE_BUF_BYTES];
+static size_t bufLen = 0;
+static int rxTagPos = -1;        // tag of the open RX record in buf, -1 = none
+static uint64_t lastRecordUs = 0;
+static uint64_t lastRxUs = 0;
+static File captureFile;
+static uint32_t fileBytes = 0;
+static uint32_t records = 0;
+static uint32_t calls = 0;
+static uint64_t startUs = 0;
+static uint64_t stopUs = 0;
+static const char *stopReason = "";
+
+static void writeOut() {
+    if (bufLen && captureFile) {
+        TraceScope trace("fs capture");
+        captureFile.write(buf, bufLen);
+        fileBytes += bufLen;
+    }
+    bufLen = 0;
+    rxTagPos = -1;
+}
+
+// opens a record and returns the position of its tag byte
+static size_t beginRecord(uint8_t type, uint64_t nowUs) {
+    if (bufLen + 1 + 10 + CAPTURE_LEN_MAX > sizeof(buf)) writeOut();
+    size_t tagPos = bufLen;
+    buf[bufLen++] = type;
+    uint64_t delta = nowUs - lastRecordUs;
+    lastRecordUs = nowUs;
+    do {
+        uint8_t b = delta & 0x7F;
+        delta >>= 7;
+        buf[bufLen++] = delta ? (b | 0x80) : b;
+    } while (delta);
+    records++;
+    return tagPos;
+}
+
+static void putRecords(uint8_t type, const uint8_t *data, size_t len) {
+    uint64_t now = micros64();
+    do {
+        size_t n = len > CAPTURE_LEN_MAX ? CAPTURE_LEN_MAX : len;
+        size_t tagPos = beginRecord(type, now);
+        buf[tagPos] |= (uint8_t)n;
+        memcpy(buf + bufLen, data, n);
+        bufLen += n;
+        data += n;
+        len -= n;
+    } while (len);
+    rxTagPos = -1;
+}
+
+void captureRxByte(uint8_t c) {
+    uint64_t now = micros64();
+    if (rxTagPos < 0 || (buf[rxTagPos] & CAPTURE_LEN_MAX) == CAPTURE_LEN_MAX ||
+        now - lastRxUs >= CAPTURE_RX_GAP_US) {
+        rxTagPos = (int)beginRecord(CAPTURE_RX, now);
+    }
+    buf[bufLen++] = c;
+    buf[rxTagPos]++;
+    lastRxUs = now;
+}
+
+void captureTx(const String &data, bool newline) {
+    String frame = newline ? data + "\r\n" : data; // what println() puts on the wire
+    putRecords(CAPTURE_TX, (const uint8_t*)frame.c_str(), frame.length());
+}
+
+void captureCall(uint8_t op, uint16_t timeout_ms, const String &arg) {
+    uint8_t payload[CAPTURE_LEN_MAX];
+    size_t n = arg.length();
+    if (n > sizeof(payload) - 3) n = sizeof(payload) - 3;
+    payload[0] = op;
+    payload[1] = timeout_ms & 0xFF;
+    payload[2] = timeout_ms >> 8;
+    memcpy(payload + 3, arg.c_str(), n);
+    putRecords(CAPTURE_CALL, payload, n + 3);
+    calls++;
+}
+
+/**
+ * @brief Start a new capture (replaces the previous file).
+ * Requires LittleFS to be mounted (initTestLog()).
+ */
+bool captureStart() {
+    if (captureOn) return true;
+    captureFile = LittleFS.open(CAPTURE_FILE, "w");
+    if (!captureFile) {
+        Serial.println("Failed to create capture file");
+        return false;
+    }
+    time_t now = time(nullptr);
+    CaptureHeader hdr = { CAPTURE_MAGIC, CAPTURE_VERSION, 0, now > 100000 ? (uint32_t)now : 0 };
+    captureFile.write((const uint8_t*)&hdr, sizeof(hdr));
+    fileBytes = sizeof(hdr);
+    bufLen = 0;
+    rxTagPos = -1;
+    records = calls = 0;
+    startUs = lastRecordUs = micros64();
+    stopUs = 0;
+    stopReason = "";
+    captureOn = true;
+    Serial.println("Serial capture started");
+    return true;
+}
+
+static void finish(const char *reason) {
+    captureOn = false;
+    writeOut();
+    captureFile.close();
+    stopUs = micros64();
+    stopReason = reason;
+    Serial.printf("Serial capture stopped (%s): %u records, %u bytes\n",
+                  reason, (unsigned)records, (unsigned)fileBytes);
+}
+
+void captureStop() {
+    if (captureOn) finish("user");
+}
+
+void captureFlush() {
+    if (!captureOn) return;
+    writeOut();
+    if (fileBytes >= CAPTURE_MAX_BYTES) finish("full");
+}
+
+String captureStatusJson() {
+    uint64_t end = captureOn ? micros64() : stopUs;
+    String json = "{\"running\":" + String(captureOn ? "true" : "false");
+    json += ",\"bytes\":" + String((unsigned long)(fileBytes + (captureOn ? bufLen : 0)));
+    json += ",\"max_bytes\":" + String((unsigned long)CAPTURE_MAX_BYTES);
+    json += ",\"records\":" + String((unsigned long)records);
+    json += ",\"calls\":" + String((unsigned long)calls);
+    json += ",\"duration_s\":" + String((unsigned long)(startUs && end ? (end - startUs) / 1000000ULL : 0));
+    json += ",\"stopped\":\"" + String(stopReason) + "\"}";
+    return json;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @file FZ35_Capture.h
+ * @brief Capture of the raw fzSerial traffic for offline replay (tools/fz35_replay).
+ *        While a capture runs, every byte written to and read from the device is
+ *        recorded with a microsecond time delta, plus one CALL record at the entry
+ *        of each top-level Comm operation (readFZ35(), sendCommandWithConfirm(), ...)
+ *        so the replayer can call the same functions with the same arguments.
+ *        Records are buffered in RAM and appended to LittleFS from loop().
+ *
+ * File: CaptureHeader, then records of
+ *   tag (type in bits 7..6, payload length 0..63 in bits 5..0),
+ *   delta_us since the previous record (unsigned LEB128), payload.
+ * CALL payload: op (CaptureOp), timeout_ms (uint16 LE), argument text.
+ */
+
+#define CAPTURE_FILE      "/capture.bin"
+#define CAPTURE_MAGIC     0x50435A46UL   // "FZCP"
+#define CAPTURE_VERSION   1
+#define CAPTURE_BUF_BYTES 1024           // RAM batch between flash appends
+#define CAPTURE_MAX_BYTES (256UL * 1024) // capture stops itself at this file size
+#define CAPTURE_RX_GAP_US 500            // RX bytes closer than this share one record
+
+#define CAPTURE_RX      0x00
+#define CAPTURE_TX      0x40
+#define CAPTURE_CALL    0x80
+#define CAPTURE_TYPE    0xC0
+#define CAPTURE_LEN_MAX 0x3F
+
+/**
+ * @struct CaptureHeader
+ * @brief File header; startEpoch is wall-clock time of the start (0 if not synced).
+ */
+struct CaptureHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t startEpoch;
+};
+
+enum CaptureOp : uint8_t {
+    CAPTURE_OP_RAW = 1,     // sendCommandNoNL(arg)
+    CAPTURE_OP_CONFIRM,     // sendCommandWithConfirm(arg, timeout)
+    CAPTURE_OP_SEND,        // sendCommand(arg, timeout)
+    CAPTURE_OP_READ,        // readFZ35()
+    CAPTURE_OP_READ_TIMED   // readMeasurementTimed(t, timeout)
+};
+
+// checked inline on every serial byte; everything else is out of line
+extern bool captureOn;
+extern uint8_t captureDepth;
+
+void captureRxByte(uint8_t c);
+void captureTx(const String &data, bool newline);
+void captureCall(uint8_t op, uint16_t timeout_ms, const String &arg);
+
+/**
+ * @struct CaptureScope
+ * @brief Marks a Comm operation; only the outermost one is recorded (readFZ35()
+ *        runs sendCommand(), but replaying readFZ35() covers both).
+ */
+struct CaptureScope {
+    CaptureScope(uint8_t op, unsigned long timeout_ms, const String &arg) {
+        if (captureOn && captureDepth == 0) {
+            captureCall(op, (uint16_t)(timeout_ms > 65535 ? 65535 : timeout_ms), arg);
+        }
+        captureDepth++;
+    }
+    ~CaptureScope() { captureDepth--; }
+};
+
+bool captureStart();
+void captureStop();
+// append buffered records to flash; call from loop()
+void captureFlush();
+String captureStatusJson();
@@ -0,0 +1,282 @@
+#include "FZ35_Channel.h"
+#include "FZ35_Comm.h"
+#include "FZ35_Battery.h"
+#include "FZ35_TestLog.h"
+#include "FZ35_Memory.h"
+#include "FZ35_Trace.h"
+
+/**
+ * @file FZ35_Channel.cpp
+ * @brief Channel table, the interleaved read scheduler of channels 1.. and their
+ *        per-channel profile, sample ring and test logging.
+ */
+
+FzChannel channels[FZ_CHANNELS];
+FzChannel *fzActive = &channels[0];
+
+Measurement &meas = channels[0].meas;
+String &voltage = channels[0].voltage;
+String &current = channels[0].current;
+String &power = channels[0].power;
+String &capacityAh = channels[0].capacityAh;
+String &energyWh = channels[0].energyWh;
+String &status = channels[0].status;
+String &OVP = channels[0].OVP;
+String &OCP = channels[0].OCP;
+String &OPP = channels[0].OPP;
+String &LVP = channels[0].LVP;
+String &OAH = channels[0].OAH;
+String &OHP = channels[0].OHP;
+String &TEST_LOAD = channels[0].testLoad;
+bool &testInProgress = channels[0].testInProgress;
+unsigned long &testStartTime = channels[0].testStartTime;
+String &currentTestBattery = channels[0].testBattery;
+TestStats &testStats = channels[0].stats;
+
+// RX pins must be interrupt capable (not GPIO16). GPIO0/2 must be high at boot, which
+// the idle level of a UART line (load TX -> GPIO2, GPIO0 -> load RX) keeps them at.
+static const uint8_t channelPins[FZ_CHANNELS_MAX][2] = {
+    { RX_PIN, TX_PIN }, { 12, 14 }, { 4, 5 }, { 2, 0 }
+};
+
+void initChannels() {
+    for (int i = 0; i < FZ_CHANNELS; ++i) channels[i].id = (uint8_t)i;
+    channels[0].port = &fzSerial;
+    for (int i = 1; i < FZ_CHANNELS; ++i) {
+        FzChannel &ch = channels[i];
+        ch.port = new SoftwareSerial(channelPins[i][0], channelPins[i][1]);
+        ch.port->begin(9600, SWSERIAL_8N1, channelPins[i][0], channelPins[i][1], false, CHANNEL_RX_BUFFER);
+        ch.ring = (ChannelSample*)calloc(CHANNEL_RING_POINTS, sizeof(ChannelSample));
+        ch.nextReadMs = millis();
+    }
+    if (FZ_CHANNELS > 1) {
+        memRegister("Channel", "sample rings", MemKind::Heap,
+                    (FZ_CHANNELS - 1) * CHANNEL_RING_POINTS * sizeof(ChannelSample));
+        memRegister("Channel", "RX buffers", MemKind::Heap, (FZ_CHANNELS - 1) * CHANNEL_RX_BUFFER);
+    }
+    Serial.printf("Channels: %d\n", FZ_CHANNELS);
+}
+
+FzChannel *channelById(int id) {
+    return id >= 0 && id < FZ_CHANNELS ? &channels[id] : nullptr;
+}
+
+void channelNoteSample(FzChannel &ch, uint32_t sentMs, uint32_t nowMs) {
+    uint32_t latency = nowMs - sentMs;
+    ch.latencySumMs += latency;
+    if (latency > ch.maxLatencyMs) ch.maxLatencyMs = latency;
+    if (ch.samples) {
+        uint32_t gap = nowMs - ch.lastSampleMs;
+        if (gap > ch.maxGapMs) ch.maxGapMs = gap;
+    } else {
+        ch.firstSampleMs = nowMs;
+    }
+    ch.lastSampleMs = nowMs;
+    ch.samples++;
+}
+
+// ---------- secondary channels ----------
+
+static void ringAppend(FzChannel &ch, uint32_t nowMs) {
+    if (!ch.ring) return;
+    ChannelSample &s = ch.ring[ch.ringHead];
+    s.t_s = nowMs / 1000;
+    s.v_cV = ringCenti(ch.meas.voltage_mV);
+    s.i_cA = ringCenti(ch.meas.current_mA);
+    s.p_dW = ringPowerDeci(ch.meas);
+    ch.ringHead = (ch.ringHead + 1) % CHANNEL_RING_POINTS;
+    if (ch.ringCount < CHANNEL_RING_POINTS) ch.ringCount++;
+}
+
+// same start / end rules as channel 0 in loop(); fresh = false for a timed out read
+static void trackTest(FzChannel &ch, uint32_t nowMs, bool fresh) {
+    DetectRead dr = { nowMs, ch.meas.current_mA, ch.meas.capacity_mAh, fresh };
+    DetectResult ev;
+    detectAddRead(ch.detect, dr, ch.testInProgress, ev);
+    if (!fresh) return;
+    if (ev.event == DetectEvent::Start) {
+        ch.testInProgress = true;
+        ch.testStartTime = ev.atMs;
+        statsReset(ch.stats, nowMs);
+        if (!ch.testBattery.length()) ch.testBattery = "Channel " + String((int)ch.id);
+        Serial.printf("Channel %u: test started: %s\n", ch.id, ch.testBattery.c_str());
+    }
+    if (!ch.testInProgress) return;
+    statsAddSample(ch.stats, ch.meas, nowMs);
+    if (ev.event == DetectEvent::End) {
+        float finalCap = ev.capacity_mAh / 1000.0f;
+        float hours = (ev.atMs - ch.testStartTime) / 3600000.0f;
+        if (finalCap > 0.001f) saveTestResult(ch.testBattery.c_str(), finalCap, hours);
+        ch.testInProgress = false;
+        Serial.printf("Channel %u: test completed: %.3f Ah in %.2f hours\n", ch.id, finalCap, hours);
+    }
+}
+
+// assemble lines from the RX buffer; a CSV line completes the outstanding read
+static void pollLink(FzChannel &ch, uint32_t nowMs) {
+    if (!ch.port->available()) return;
+    ChannelScope scope(ch);
+    while (fzPort().available()) {
+        char c = (char)fzRead();
+        if (c == '\r') continue;
+        if (c != '\n') {
+            if (ch.lineLen < CHANNEL_LINE_MAX - 1) ch.line[ch.lineLen++] = c;
+            continue;
+        }
+        ch.line[ch.lineLen] = '\0';
+        ch.lineLen = 0;
+        String line(ch.line);
+        line.trim();
+        if (line.length() == 0) continue;
+        uint32_t csvBefore = ch.csvLines;
+        parseFZ35(line);
+        if (ch.waiting && line.indexOf("V,") >= 0 && line.indexOf("Ah") >= 0) {
+            ch.waiting = false;
+            channelNoteSample(ch, ch.sentMs, nowMs);
+            ringAppend(ch, nowMs);
+            trackTest(ch, nowMs, ch.csvLines != csvBefore);
+        }
+    }
+}
+
+static void startRead(FzChannel &ch, uint32_t nowMs) {
+    // fixed rate; slots that have already passed entirely are skipped, not made up
+    int32_t behind = (int32_t)(nowMs - ch.nextReadMs);
+    if (behind >= (int32_t)CHANNEL_READ_INTERVAL_MS) {
+        uint32_t skipped = behind / CHANNEL_READ_INTERVAL_MS;
+        ch.missedSlots += skipped;
+        ch.nextReadMs += skipped * CHANNEL_READ_INTERVAL_MS;
+    }
+    ch.nextReadMs += CHANNEL_READ_INTERVAL_MS;
+    ChannelScope scope(ch);
+    if (estopPoll()) return;   // stopped in this pass
+    fzSend("read", true);
+    ch.waiting = true;
+    ch.sentMs = nowMs;
+}
+
+static void applyProfile(FzChannel &ch) {
+    int idx = ch.pendingBatteryIdx;
+    ch.pendingBatteryIdx = -1;
+    BatteryDerived d;
+    String name;
+    if (!getBatteryDerived(idx, d, name)) return;
+
+    TraceScope trace("profile apply", TRACE_TID_LOOP, ch.id);
+    ChannelScope scope(ch);
+    Serial.printf("\n=== Channel %u: applying battery[%d] %s (clamped=%s) ===\n",
+                  ch.id, idx, name.c_str(), d.clamped ? "YES" : "NO");
+    int ok = sendProfilePayloads(d);
+    Serial.println("Restarting measurements...");
+    sendCommandNoNL("start");
+    if (estopPoll()) {
+        Serial.printf("=== Channel %u: apply abandoned (emergency stop) ===\n\n", ch.id);
+        return;
+    }
+    Serial.printf("=== Channel %u: %d/%d confirmed ===\n\n", ch.id, ok, PROFILE_PAYLOAD_COUNT);
+
+    ch.batteryIdx = idx;
+    if (!ch.testInProgress) ch.testBattery = name;   // name of the next test
+    ch.OVP = d.ovp.c_str();
+    ch.OCP = d.ocpCmd.c_str() + PROFILE_CMD_PREFIX_LEN;
+    ch.OPP = d.oppCmd.c_str() + PROFILE_CMD_PREFIX_LEN;
+    ch.LVP = d.lvpCmd.c_str() + PROFILE_CMD_PREFIX_LEN;
+    ch.OAH = d.oahCmd.c_str() + PROFILE_CMD_PREFIX_LEN;
+    ch.OHP = d.ohpCmd.c_str() + PROFILE_CMD_PREFIX_LEN;
+    ch.testLoad = d.load.c_str();
+    ch.lineLen = 0;
+    // like channel 0, no reads for 2 s after an apply
+    ch.nextReadMs = millis() + 2000;
+}
+
+void channelsTick(uint32_t horizonMs) {
+    for (int i = 1; i < FZ_CHANNELS; ++i) {
+        FzChannel &ch = channels[i];
+        uint32_t now = millis();
+        pollLink(ch, now);
+        if (ch.waiting) {
+            if (now - ch.sentMs < CHANNEL_READ_TIMEOUT_MS) continue;
+            ch.waiting = false;
+            ch.timeouts++;
+            trackTest(ch, now, false);
+        }
+        // anything else on this link goes between its reads
+        if (ch.pendingBatteryIdx >= 0) {
+            applyProfile(ch);
+            continue;
+        }
+        if (ch.pendingCmd.length()) {
+            ChannelScope scope(ch);
+            fzSend(ch.pendingCmd, false);
+            Serial.printf(">> Channel %u sent (no NL): %s\n", ch.id, ch.pendingCmd.c_str());
+            ch.pendingCmd = String();
+        }
+        if ((int32_t)(ch.nextReadMs - now) > (int32_t)horizonMs) continue;
+        startRead(ch, now);
+    }
+}
+
+bool channelSelectBattery(FzChannel &ch, int idx) {
+    if (ch.id == 0) return setActiveBattery(idx);
+    if (getBatteryName(idx).length() == 0) return false;
+    ch.pendingBatteryIdx = idx;
+    Serial.printf("Channel %u: queued battery [%d]\n", ch.id, idx);
+    return true;
+}
+
+void channelQueueCmd(FzChannel &ch, const String &cmd) {
+    ch.pendingCmd = cmd;
+}
+
+// ---------- JSON ----------
+
+String channelsJson() {
+    String json = "{\"interval_ms\":" + String((unsigned long)CHANNEL_READ_INTERVAL_MS) + ",\"channels\":[";
+    for (int i = 0; i < FZ_CHANNELS; ++i) {
+        const FzChannel &ch = channels[i];
+        uint32_t meanGap = ch.samples > 1 ? (ch.lastSampleMs - ch.firstSampleMs) / (ch.samples - 1) : 0;
+        if (i) json += ",";
+        json += "{\"id\":" + String(i);
+        json += ",\"rx\":" + String(channelPins[i][0]) + ",\"tx\":" + String(channelPins[i][1]);
+        json += ",\"battery\":" + String(i == 0 ? getActiveBatteryIndex() : ch.batteryIdx);
+        json += ",\"v\":\"" + ch.voltage + "\",\"i\":\"" + ch.current + "\",\"p\":\"" + ch.power + "\",\"ah\":\"" + ch.capacityAh + "\"";
+        json += ",\"test\":" + String(ch.testInProgress ? "true" : "false");
+        json += ",\"samples\":" + String((unsigned long)ch.samples);
+        json += ",\"timeouts\":" + String((unsigned long)ch.timeouts);
+        json += ",\"missed\":" + String((unsigned long)ch.missedSlots);
+        json += ",\"mean_interval_ms\":" + String((unsigned long)meanGap);
+        json += ",\"max_interval_ms\":" + String((unsigned long)ch.maxGapMs);
+        json += ",\"mean_latency_ms\":" + String((unsigned long)(ch.samples ? ch.latencySumMs / ch.samples : 0));
+        json += ",\"max_latency_ms\":" + String((unsigned long)ch.maxLatencyMs);
+        const LoadDetector &d = ch.detect;
+        json += ",\"detect\":{\"filtered_ma\":" + String((long)d.filtered_mA);
+        json += ",\"stale\":" + String(detectStale(d, millis()) ? "true" : "false");
+        json += ",\"stale_reads\":" + String((unsigned long)d.staleReads);
+        json += ",\"rejected\":" + String((unsigned long)d.rejected);
+        json += ",\"events\":" + String((unsigned long)d.events);
+        json += ",\"last_latency_ms\":" + String((unsigned long)d.lastLatencyMs);
+        json += ",\"max_latency_ms\":" + String((unsigned long)d.maxLatencyMs) + "}}";
+    }
+    json += "]}";
+    return json;
+}
+
+String channelSamplesJson(const FzChannel &ch, int points) {
+    int toSend = !ch.ring ? 0 : points < ch.ringCount ? points : ch.ringCount;
+    String json = "{\"points\":[";
+    json.reserve(16 + toSend * 32);
+    char num[16];
+    int start = (ch.ringHead - toSend + CHANNEL_RING_POINTS) % CHANNEL_RING_POINTS;
+    for (int i = 0; i < toSend; ++i) {
+        const ChannelSample &s = ch.ring[(start + i) % CHANNEL_RING_POINTS];
+        if (i) json += ",";
+        json += "[";
+        formatFixed(num, sizeof(num), s.v_cV, 2, 2); json += num; json += ",";
+        formatFixed(num, sizeof(num), s.i_cA, 2, 2); json += num; json += ",";
+        formatFixed(num, sizeof(num), s.p_dW, 1, 2); json += num; json += ",";
+        json += String((unsigned long)s.t_s);
+        json += "]";
+    }
+    json += "]}";
+    return json;
+}
@@ -0,0 +1,164 @@
+#pragma once
+#include <Arduino.h>
+#include <SoftwareSerial.h>
+#include "FZ35_Fixed.h"
+#include "FZ35_Stats.h"
+#include "FZ35_Capture.h"
+#include "FZ35_Detect.h"
+
+/**
+ * @file FZ35_Channel.h
+ * @brief Several FZ35 loads on one controller, one SoftwareSerial link each. Every load
+ *        is a channel instance holding its link, parsed values, profile and test state.
+ *        The Comm helpers and parseFZ35() work on the selected channel (fzActive).
+ *
+ * Channel 0 is the primary load: the existing single-load code (graph ring, history,
+ * programs, DCIR, command batches, telemetry, checkpoints, capture) drives it from
+ * loop() and reads it through the globals below, which alias channels[0].
+ * Channels 1.. are sampled by channelsTick() without blocking: "read" is sent to every
+ * due channel at once and the answers are assembled from each port's RX buffer as they
+ * arrive, so N links share one read time instead of queueing N blocking reads. They
+ * keep a compact sample ring, apply profiles and log finished tests.
+ */
+
+#ifndef FZ_CHANNELS
+#define FZ_CHANNELS 1          // loads on this controller (1..4); set in the build flags for a rack
+#endif
+#define FZ_CHANNELS_MAX 4
+static_assert(FZ_CHANNELS >= 1 && FZ_CHANNELS <= FZ_CHANNELS_MAX, "FZ_CHANNELS must be 1..4");
+
+#define CHANNEL_READ_INTERVAL_MS 1000
+#define CHANNEL_READ_TIMEOUT_MS  900    // same as readFZ35()
+#define CHANNEL_RX_BUFFER        256    // holds a full answer while loop() blocks on channel 0
+#define CHANNEL_LINE_MAX         96
+#define CHANNEL_RING_POINTS      180    // 3 minutes at 1 Hz per secondary channel
+
+/**
+ * @struct ChannelSample
+ * @brief One sample of a secondary channel, same units as the graph ring.
+ */
+struct ChannelSample {
+    uint32_t t_s;    // seconds since boot
+    uint16_t v_cV;   // 0.01 V
+    uint16_t i_cA;   // 0.01 A
+    uint16_t p_dW;   // 0.1 W
+};
+
+/**
+ * @struct FzChannel
+ * @brief One load.
+ */
+struct FzChannel {
+    uint8_t id = 0;
+    SoftwareSerial *port = nullptr;
+
+    // live values, written by parseFZ35() while this channel is selected
+    String voltage = "0", current = "0", power = "0", capacityAh = "0", energyWh = "0", status = "UNKNOWN";
+    String OVP, OCP, OPP, LVP, OAH, OHP;
+    String testLoad;                // recommended load of the selected profile (x.xx)
+    Measurement meas = { 0, 0, 0, 0 };
+    uint32_t csvLines = 0;          // measurement lines parsed; unchanged over a read = stale read
+
+    // test detection (channel 0: loop() in FZ35_Lab.ino)
+    LoadDetector detect = {};
+    bool testInProgress = false;
+    unsigned long testStartTime = 0;
+    String testBattery;             // profile name of the running (or next) test
+    TestStats stats = {};
+
+    // secondary channels: profile, queued operation, read cycle
+    int batteryIdx = -1;            // last selected profile, -1 = none
+    int pendingBatteryIdx = -1;
+    String pendingCmd;              // /cmd?ch= operation, sent from channelsTick() (0: loop())
+    bool waiting = false;           // "read" sent, CSV line not seen yet
+    uint32_t sentMs = 0;
+    uint32_t nextReadMs = 0;
+    char line[CHANNEL_LINE_MAX];
+    uint8_t lineLen = 0;
+
+    // compact sample ring (secondary channels)
+    ChannelSample *ring = nullptr;
+    uint16_t ringHead = 0;
+    uint16_t ringCount = 0;
+
+    // sampling counters (all channels)
+    uint32_t samples = 0;
+    uint32_t timeouts = 0;
+    uint32_t missedSlots = 0;       // read slots skipped because the channel was busy or late
+    uint32_t firstSampleMs = 0;
+    uint32_t lastSampleMs = 0;
+    uint32_t maxGapMs = 0;
+    uint32_t latencySumMs = 0;      // "read" sent -> CSV line complete
+    uint32_t maxLatencyMs = 0;
+};
+
+extern FzChannel channels[FZ_CHANNELS];
+// channel the Comm helpers and parseFZ35() operate on (channel 0 unless a scope says otherwise)
+extern FzChannel *fzActive;
+
+/**
+ * @struct ChannelScope
+ * @brief Select a channel for the Comm helpers until the scope ends. Captures only
+ *        cover channel 0, so a secondary scope also hides its Comm calls from the capture.
+ */
+struct ChannelScope {
+    FzChannel *prev;
+    bool hidden;
+    explicit ChannelScope(FzChannel &ch) : prev(fzActive), hidden(ch.id != 0) {
+        fzActive = &ch;
+        if (hidden) captureDepth++;
+    }
+    ~ChannelScope() {
+        if (hidden) captureDepth--;
+        fzActive = prev;
+    }
+};
+
+// channel 0 under the names the single-load code uses
+extern Measurement &meas;
+extern String &voltage, &current, &power, &capacityAh, &energyWh, &status;
+extern String &OVP, &OCP, &OPP, &LVP, &OAH, &OHP;
+extern String &TEST_LOAD;
+extern bool &testInProgress;
+extern unsigned long &testStartTime;
+extern String &currentTestBattery;
+extern TestStats &testStats;
+
+/**
+ * @brief Open the links and sample rings of channels 1.. (before the graph ring takes the heap).
+ */
+void initChannels();
+
+/**
+ * @brief Scheduler step for channels 1.., never blocks except to apply a queued profile.
+ * @param horizonMs Also start reads due within this time (loop() is about to block on
+ *        channel 0 for about that long; the answers wait in the RX buffers).
+ */
+void channelsTick(uint32_t horizonMs = 0);
+
+/**
+ * @brief Count a completed read (interval and latency statistics).
+ */
+void channelNoteSample(FzChannel &ch, uint32_t sentMs, uint32_t nowMs);
+
+/**
+ * @return The channel with this id, or nullptr.
+ */
+FzChannel *channelById(int id);
+
+/**
+ * @brief Queue a profile for a secondary channel (channel 0: setActiveBattery()).
+ */
+bool channelSelectBattery(FzChannel &ch, int idx);
+
+/**
+ * @brief Queue a raw device operation (on/off/start/stop). Secondary channels send it
+ *        from channelsTick(), channel 0 from loop().
+ */
+void channelQueueCmd(FzChannel &ch, const String &cmd);
+
+String channelsJson();
+/**
+ * @brief Most recent samples of a secondary channel, same format as /data?points=.
+ */
+String channelSamplesJson(const FzChannel &ch, int points);
@@ -0,0 +1,169 @@
+#include "FZ35_Checkpoint.h"
+#include "FZ35_Trace.h"
+#include <LittleFS.h>
+
+/**
+ * @file FZ35_Checkpoint.cpp
+ * @brief Record append / compaction, boot scan and write cost accounting.
+ */
+
+static TestCheckpoint lastRecord;
+static bool haveLast = false;
+static bool interrupted = false;
+static uint32_t fileRecords = 0;
+static bool realign = false;      // file ends in a partial record
+static uint32_t nextSeq = 1;
+static uint32_t lastWriteMs = 0;
+
+// cost accounting
+static uint32_t writes = 0;
+static uint32_t lastUs = 0;
+static uint32_t maxUs = 0;
+static uint64_t totalUs = 0;
+static uint32_t bytesWritten = 0;
+static uint32_t compactions = 0;
+static uint32_t badRecords = 0;
+static uint32_t resumed = 0;
+static uint32_t finalized = 0;
+
+static uint32_t checkpointCrc(const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t*)data;
+    uint32_t crc = 0xFFFFFFFFUL;
+    while (len--) {
+        crc ^= *p++;
+        for (uint8_t b = 0; b < 8; ++b) crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+static bool validRecord(const TestCheckpoint &cp) {
+    return cp.magic == CHECKPOINT_MAGIC && cp.recordSize == sizeof(TestCheckpoint) &&
+           cp.crc == checkpointCrc(&cp, offsetof(TestCheckpoint, crc));
+}
+
+// keeps only the last record; the old file is replaced by rename, never rewritten in place
+static void compact(const TestCheckpoint &cp) {
+    File f = LittleFS.open(CHECKPOINT_TMP_FILE, "w");
+    if (!f) return;
+    bool ok = f.write((const uint8_t*)&cp, sizeof(cp)) == sizeof(cp);
+    f.close();
+    if (!ok) return;
+    LittleFS.remove(CHECKPOINT_FILE);
+    LittleFS.rename(CHECKPOINT_TMP_FILE, CHECKPOINT_FILE);
+    fileRecords = 1;
+    realign = false;
+    compactions++;
+}
+
+void initCheckpoint() {
+    // a reset between remove and rename in compact() leaves only the tmp file
+    if (!LittleFS.exists(CHECKPOINT_FILE) && LittleFS.exists(CHECKPOINT_TMP_FILE)) {
+        LittleFS.rename(CHECKPOINT_TMP_FILE, CHECKPOINT_FILE);
+    }
+    File f = LittleFS.open(CHECKPOINT_FILE, "r");
+    if (!f) return;
+    TestCheckpoint cp;
+    bool torn = f.size() % sizeof(cp) != 0;
+    while (f.read((uint8_t*)&cp, sizeof(cp)) == sizeof(cp)) {
+        fileRecords++;
+        if (!validRecord(cp)) {
+            // torn or corrupted append: the records before it still count
+            badRecords++;
+            continue;
+        }
+        lastRecord = cp;
+        haveLast = true;
+    }
+    f.close();
+    // appends after a partial record would be misaligned: the next write compacts
+    realign = torn || badRecords;
+    if (!haveLast) return;
+
+    nextSeq = lastRecord.seq + 1;
+    interrupted = lastRecord.kind != CHECKPOINT_END;
+    if (interrupted) {
+        Serial.printf("Checkpoint: test '%s' interrupted after %lu s (%ld mAh, record %lu)\n",
+                      lastRecord.battery, (unsigned long)(lastRecord.elapsedMs / 1000),
+                      (long)lastRecord.capacity_mAh, (unsigned long)lastRecord.seq);
+    }
+}
+
+const TestCheckpoint *checkpointInterrupted() {
+    return interrupted ? &lastRecord : nullptr;
+}
+
+void checkpointResolved(bool wasResumed) {
+    interrupted = false;
+    if (wasResumed) resumed++;
+    else finalized++;
+}
+
+void checkpointWrite(CheckpointKind kind, TestCheckpoint &cp) {
+    TraceScope trace("fs checkpoint");
+    uint32_t t0 = micros();
+    cp.magic = CHECKPOINT_MAGIC;
+    cp.recordSize = sizeof(TestCheckpoint);
+    cp.kind = kind;
+    cp.reserved = 0;
+    cp.seq = nextSeq++;
+    cp.crc = checkpointCrc(&cp, offsetof(TestCheckpoint, crc));
+
+    if (kind != CHECKPOINT_BEGIN && (realign || fileRecords >= CHECKPOINT_MAX_RECORDS)) {
+        compact(cp);
+    } else {
+        File f = LittleFS.open(CHECKPOINT_FILE, kind == CHECKPOINT_BEGIN ? "w" : "a");
+        if (!f) {
+            Serial.println("Failed to write checkpoint");
+            return;
+        }
+        if (kind == CHECKPOINT_BEGIN) {
+            fileRecords = 0;
+            realign = false;
+        }
+        if (f.write((const uint8_t*)&cp, sizeof(cp)) == sizeof(cp)) fileRecords++;
+        f.close();
+    }
+    lastRecord = cp;
+    haveLast = true;
+    lastWriteMs = millis();
+
+    lastUs = micros() - t0;
+    if (lastUs > maxUs) maxUs = lastUs;
+    totalUs += lastUs;
+    writes++;
+    bytesWritten += sizeof(cp);
+}
+
+bool checkpointDue(uint32_t nowMs) {
+    return nowMs - lastWriteMs >= CHECKPOINT_INTERVAL_MS;
+}
+
+String checkpointStatusJson() {
+    static const char *const kinds[] = { "", "begin", "progress", "resume", "end" };
+    uint32_t meanUs = writes ? (uint32_t)(totalUs / writes) : 0;
+    String json = "{\"interrupted\":" + String(interrupted ? "true" : "false");
+    json += ",\"interval_s\":" + String((unsigned long)(CHECKPOINT_INTERVAL_MS / 1000));
+    json += ",\"record_bytes\":" + String((unsigned)sizeof(TestCheckpoint));
+    json += ",\"file_records\":" + String((unsigned long)fileRecords);
+    json += ",\"writes\":" + String((unsigned long)writes);
+    json += ",\"last_us\":" + String((unsigned long)lastUs);
+    json += ",\"mean_us\":" + String((unsigned long)meanUs);
+    json += ",\"max_us\":" + String((unsigned long)maxUs);
+    // share of loop() time spent checkpointing, in parts per million
+    json += ",\"load_ppm\":" + String((unsigned long)(meanUs * 1000ULL / CHECKPOINT_INTERVAL_MS));
+    json += ",\"bytes_written\":" + String((unsigned long)bytesWritten);
+    json += ",\"compactions\":" + String((unsigned long)compactions);
+    json += ",\"bad_records\":" + String((unsigned long)badRecords);
+    json += ",\"resumed\":" + String((unsigned long)resumed);
+    json += ",\"finalized\":" + String((unsigned long)finalized);
+    if (haveLast) {
+        json += ",\"last\":{\"seq\":" + String((unsigned long)lastRecord.seq);
+        json += ",\"kind\":\"" + String(lastRecord.kind <= CHECKPOINT_END ? kinds[lastRecord.kind] : "") + "\"";
+        json += ",\"battery\":\"" + String(lastRecord.battery) + "\"";
+        json += ",\"elapsed_s\":" + String((unsigned long)(lastRecord.elapsedMs / 1000));
+        json += ",\"stale_s\":" + String((unsigned)lastRecord.stale_s);
+        json += ",\"capacity_mah\":" + String((long)lastRecord.capacity_mAh) + "}";
+    }
+    json += "}";
+    return json;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <Arduino.h>
+#include "FZ35_Stats.h"
+#include "FZ35_ProfileStore.h"
+
+/**
+ * @file FZ35_Checkpoint.h
+ * @brief Crash-safe test state. While a test runs, loop() appends a small fixed-size
+ *        record (test time, wall clock, device capacity counter, profile, running
+ *        aggregates) with a CRC-32 to /test.ckpt every CHECKPOINT_INTERVAL_MS, plus one
+ *        at start and end. After a reset the last valid record tells whether a test was
+ *        interrupted; loop() then resumes it or logs it (see FZ35_Lab.ino).
+ *        The file is truncated at every test start and compacted to its last record
+ *        once it holds CHECKPOINT_MAX_RECORDS.
+ */
+
+#define CHECKPOINT_FILE         "/test.ckpt"
+#define CHECKPOINT_TMP_FILE     "/test.ckpt.tmp"
+#define CHECKPOINT_MAGIC        0x4B435A46UL   // "FZCK"
+#define CHECKPOINT_INTERVAL_MS  60000UL
+#define CHECKPOINT_MAX_RECORDS  64
+#define CHECKPOINT_RESOLVE_MS   20000UL        // wait this long for a valid reading after boot
+
+enum CheckpointKind : uint8_t {
+    CHECKPOINT_BEGIN = 1,
+    CHECKPOINT_PROGRESS,
+    CHECKPOINT_RESUME,      // first record after a resumed reset
+    CHECKPOINT_END          // test logged (normally or after a reset)
+};
+
+/**
+ * @struct TestCheckpoint
+ * @brief One on-flash record. stats times are relative to the test start (startMs = 0).
+ */
+struct TestCheckpoint {
+    uint32_t magic;
+    uint16_t recordSize;
+    uint8_t kind;            // CheckpointKind
+    uint8_t reserved;
+    uint32_t seq;
+    int32_t batteryId;
+    uint32_t startEpoch;     // wall clock at test start (0 if not synced)
+    uint32_t epoch;          // wall clock of this record (0 if not synced)
+    uint32_t elapsedMs;      // test time at this record
+    int32_t capacity_mAh;    // device's own counter (keeps running through an ESP reset)
+    char battery[PROFILE_NAME_LEN];
+    uint16_t stale_s;        // test time with failed reads only (saturates)
+    TestStats stats;
+    uint32_t crc;            // CRC-32 of all bytes before it
+};
+
+/**
+ * @brief Boot: find the last valid record. Requires LittleFS (initTestLog()).
+ */
+void initCheckpoint();
+
+/**
+ * @brief The record of a test that was running at the last reset, or nullptr.
+ */
+const TestCheckpoint *checkpointInterrupted();
+void checkpointResolved(bool resumed);
+
+/**
+ * @brief Append a record (seq, magic, crc filled in); BEGIN truncates the file first.
+ */
+void checkpointWrite(CheckpointKind kind, TestCheckpoint &cp);
+bool checkpointDue(uint32_t nowMs);
+
+String checkpointStatusJson();
@@ -0,0 +1,240 @@
+#include "FZ35_CmdBatch.h"
+#include "FZ35_Profiles.h"
+#include "FZ35_Comm.h"
+#include "FZ35_Program.h"
+#include "FZ35_Dcir.h"
+
+/**
+ * @file FZ35_CmdBatch.cpp
+ * @brief Batch parser / validator and the sequential executor.
+ */
+
+extern String LOAD_ENABLE_CMD;
+extern String LOAD_DISABLE_CMD;
+
+static BatchCommand job[CMD_BATCH_MAX];
+static int jobCount = 0;
+static uint32_t jobId = 0;
+static bool jobStopOnError = true;
+static bool pending = false;
+static bool running = false;
+static bool cancelled = false;
+static uint32_t jobQueuedMs = 0;
+static uint32_t jobStartDelayMs = 0;   // queued -> first command
+static uint32_t jobTotalUs = 0;
+
+static const int32_t RATED_VOLTAGE_MV = toMilli(RATED_VOLTAGE_MAX);
+static const int32_t RATED_CURRENT_MA = toMilli(RATED_CURRENT_MAX);
+static const int32_t RATED_POWER_MW = toMilli(RATED_POWER_MAX);
+
+// ---------- parsing ----------
+
+struct BatchKey {
+    const char *name;
+    BatchOp op;
+    const char *prefix;     // device payload prefix
+    uint8_t decimals;       // payload decimals (same as the profile payloads)
+    int32_t max;            // milli-units
+};
+
+static const BatchKey keys[] = {
+    { "load",  BatchOp::Load,  "",     2, RATED_CURRENT_MA },
+    { "ocp",   BatchOp::Ocp,   "OCP:", 2, RATED_CURRENT_MA },
+    { "opp",   BatchOp::Opp,   "OPP:", 2, RATED_POWER_MW },
+    { "lvp",   BatchOp::Lvp,   "LVP:", 1, RATED_VOLTAGE_MV },
+    { "ovp",   BatchOp::Ovp,   "OVP:", 1, RATED_VOLTAGE_MV },
+    { "oah",   BatchOp::Oah,   "OAH:", 3, 99999 },
+    { "ohp",   BatchOp::Ohp,   "OHP:", 0, 0 },
+    { "on",    BatchOp::On,    "",     0, 0 },
+    { "off",   BatchOp::Off,   "",     0, 0 },
+    { "start", BatchOp::Start, "",     0, 0 },
+    { "stop",  BatchOp::Stop,  "",     0, 0 },
+};
+
+static bool validHours(const String &v) {
+    // HH:MM, MM < 60
+    return v.length() == 5 && isDigit(v.charAt(0)) && isDigit(v.charAt(1)) && v.charAt(2) == ':' &&
+           v.charAt(3) >= '0' && v.charAt(3) <= '5' && isDigit(v.charAt(4));
+}
+
+static const char *opName(BatchOp op) {
+    for (const BatchKey &k : keys) {
+        if (k.op == op) return k.name;
+    }
+    return "?";
+}
+
+// error messages quote the user's item and end up in a JSON string
+static String jsonEscaped(const String &s) {
+    String out;
+    for (size_t i = 0; i < s.length(); ++i) {
+        char c = s[i];
+        if (c == '"' || c == '\\') out += '\\';
+        if ((uint8_t)c >= 0x20) out += c;
+    }
+    return out;
+}
+
+int parseCmdBatch(const String &text, BatchCommand *cmds, int maxCmds, String &err) {
+    int count = 0;
+    int pos = 0;
+    int32_t last[(int)BatchOp::Stop + 1];
+    for (int32_t &v : last) v = -1;
+
+    while (pos < (int)text.length()) {
+        int semi = text.indexOf(';', pos);
+        if (semi < 0) semi = text.length();
+        String item = text.substring(pos, semi);
+        item.trim();
+        pos = semi + 1;
+        if (item.length() == 0) continue;
+        if (count >= maxCmds) { err = "too many commands (max " + String(maxCmds) + ")"; return -1; }
+
+        // split at the first ':' only (OHP values contain one)
+        int colon = item.indexOf(':');
+        String name = colon < 0 ? item : item.substring(0, colon);
+        String value = colon < 0 ? String() : item.substring(colon + 1);
+        name.trim();
+        name.toLowerCase();
+        value.trim();
+
+        const BatchKey *key = nullptr;
+        for (const BatchKey &k : keys) {
+            if (name == k.name) key = &k;
+        }
+        String where = "command " + String(count + 1) + " (" + jsonEscaped(item) + ")";
+        if (!key) { err = "unknown " + where; return -1; }
+
+        BatchCommand c = {};
+        c.op = key->op;
+        c.result = BatchResult::Pending;
+        bool isSetting = key->op <= BatchOp::Ohp;
+        if (isSetting != (colon >= 0)) {
+            err = String(isSetting ? "missing value in " : "unexpected value in ") + where;
+            return -1;
+        }
+
+        if (key->op == BatchOp::Ohp) {
+            if (!validHours(value)) { err = "ohp needs HH:MM in " + where; return -1; }
+            snprintf(c.text, sizeof(c.text), "OHP:%s", value.c_str());
+        } else if (isSetting) {
+            if (!parseFixed(value.c_str(), 3, c.value) || c.value < 0) { err = "bad number in " + where; return -1; }
+            if (c.value > key->max) { err = where + " exceeds the rating"; return -1; }
+            if (key->op == BatchOp::Load && c.value < toMilli(MIN_TEST_LOAD_A)) { err = where + " below minimum load"; return -1; }
+            size_t n = snprintf(c.text, sizeof(c.text), "%s", key->prefix);
+            n += formatMilli(c.text + n, sizeof(c.text) - n - 1, c.value, key->decimals);
+            if (key->op == BatchOp::Load) {
+                c.text[n++] = 'A';
+                c.text[n] = '\0';
+            }
+            last[(int)key->op] = c.value;
+        } else {
+            const String &device = key->op == BatchOp::On ? LOAD_ENABLE_CMD
+                                 : key->op == BatchOp::Off ? LOAD_DISABLE_CMD : String(key->name);
+            snprintf(c.text, sizeof(c.text), "%s", device.c_str());
+        }
+        cmds[count++] = c;
+    }
+    if (count == 0) { err = "empty batch"; return -1; }
+
+    // cross checks between values set in the same batch
+    int32_t load = last[(int)BatchOp::Load], ocp = last[(int)BatchOp::Ocp];
+    int32_t ovp = last[(int)BatchOp::Ovp], lvp = last[(int)BatchOp::Lvp];
+    if (load >= 0 && ocp >= 0 && load > ocp) { err = "load exceeds ocp"; return -1; }
+    if (lvp >= 0 && ovp >= 0 && lvp >= ovp) { err = "lvp must be below ovp"; return -1; }
+    if (ovp >= 0 && ocp >= 0 && mulMilli(ovp, ocp) > RATED_POWER_MW) { err = "ovp x ocp exceeds rated power"; return -1; }
+    return count;
+}
+
+// ---------- execution ----------
+
+uint32_t requestCmdBatch(const BatchCommand *cmds, int count, bool stopOnError, String &err) {
+    if (pending || running) { err = "batch already running"; return 0; }
+    if (dcirBusy()) { err = "DCIR measurement running"; return 0; }
+    if (programActive()) { err = "program running"; return 0; }
+    if (count < 1 || count > CMD_BATCH_MAX) { err = "bad command count"; return 0; }
+    memcpy(job, cmds, count * sizeof(BatchCommand));
+    jobCount = count;
+    jobStopOnError = stopOnError;
+    jobTotalUs = 0;
+    jobStartDelayMs = 0;
+    jobQueuedMs = millis();
+    cancelled = false;
+    pending = true;
+    return ++jobId;
+}
+
+bool cmdBatchPending() { return pending; }
+bool cmdBatchBusy() { return pending || running; }
+
+bool cmdBatchCancel() {
+    if (!pending && !running) return false;
+    if (pending) {
+        for (int i = 0; i < jobCount; ++i) job[i].result = BatchResult::Skipped;
+        pending = false;
+    }
+    cancelled = true;
+    return true;
+}
+
+void processPendingCmdBatch() {
+    if (!pending) return;
+    pending = false;
+    running = true;
+    jobStartDelayMs = millis() - jobQueuedMs;
+    Serial.printf("Batch %lu: %d commands\n", (unsigned long)jobId, jobCount);
+
+    uint64_t t0 = micros64();
+    bool failed = false;
+    for (int i = 0; i < jobCount; ++i) {
+        BatchCommand &c = job[i];
+        if ((failed && jobStopOnError) || cancelled) {
+            c.result = BatchResult::Skipped;
+            continue;
+        }
+        uint64_t start = micros64();
+        if (c.op == BatchOp::Ovp) {
+            // same path as profile application: the device is picky about OVP formats
+            c.result = sendParamVariants("OVP", c.text + PROFILE_CMD_PREFIX_LEN, 1200) ? BatchResult::Confirmed : BatchResult::Failed;
+        } else if (c.op <= BatchOp::Ohp) {
+            c.result = sendCommandWithConfirm(c.text, 1000) ? BatchResult::Confirmed : BatchResult::Failed;
+        } else {
+            sendCommandNoNL(c.text);
+            c.result = BatchResult::Sent;
+        }
+        c.us = (uint32_t)(micros64() - start);
+        if (c.result == BatchResult::Failed) failed = true;
+    }
+    jobTotalUs = (uint32_t)(micros64() - t0);
+    running = false;
+    Serial.printf("Batch %lu done in %lu ms%s\n", (unsigned long)jobId,
+                  (unsigned long)(jobTotalUs / 1000),
+                  cancelled ? " (emergency stop)" : failed ? " (failures)" : "");
+}
+
+String cmdBatchStatusJson(uint32_t id) {
+    if (!jobId || (id && id != jobId)) return String();
+    static const char *const names[] = { "pending", "confirmed", "failed", "sent", "skipped" };
+    int ok = 0, bad = 0;
+    String list;
+    list.reserve(jobCount * 64);
+    for (int i = 0; i < jobCount; ++i) {
+        const BatchCommand &c = job[i];
+        if (c.result == BatchResult::Confirmed || c.result == BatchResult::Sent) ok++;
+        if (c.result == BatchResult::Failed || c.result == BatchResult::Skipped) bad++;
+        if (i) list += ",";
+        list += "{\"op\":\"" + String(opName(c.op)) + "\",\"cmd\":\"" + String(c.text) + "\"";
+        list += ",\"result\":\"" + String(names[(int)c.result]) + "\"";
+        list += ",\"ms\":" + String(c.us / 1000.0f, 1) + "}";
+    }
+    const char *state = pending ? "queued" : running ? "running" : cancelled ? "cancelled" : "done";
+    String json = "{\"id\":" + String((unsigned long)jobId);
+    json += ",\"state\":\"" + String(state) + "\"";
+    json += ",\"ok\":" + String(ok);
+    json += ",\"failed\":" + String(bad);
+    json += ",\"stop_on_error\":" + String(jobStopOnError ? "true" : "false");
+    json += ",\"queued_ms\":" + String((unsigned long)jobStartDelayMs);
+    json += ",\"total_ms\":" + String((unsigned long)(jobTotalUs / 1000));
+    json += ",\"commands\":[" + list + "]}";
+    return json;
+}
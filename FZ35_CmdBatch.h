@@ -0,0 +1,69 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @file FZ35_CmdBatch.h
+ * @brief Command batches: an ordered list of device settings and actions, validated
+ *        against the device ratings up front and then sent back-to-back from loop()
+ *        in one pass over the serial link (no reads or fixed gaps in between). Each
+ *        setting is confirmed by the device (sendCommandWithConfirm); per-command result
+ *        and time are kept for /cmd_batch_status.
+ *
+ * Text: commands separated by ';', key:value for settings (case-insensitive):
+ *   load:1.30  ocp:1.45  opp:20  lvp:3.0  ovp:4.2  oah:2.5  ohp:01:30
+ *   on  off  start  stop
+ */
+
+#define CMD_BATCH_MAX   16
+#define CMD_BATCH_TEXT  16   // device payload, e.g. "OHP:10:00"
+
+enum class BatchOp : uint8_t { Load, Ocp, Opp, Lvp, Ovp, Oah, Ohp, On, Off, Start, Stop };
+
+enum class BatchResult : uint8_t {
+    Pending,
+    Confirmed,
+    Failed,    // no confirmation after retries
+    Sent,      // actions are not acknowledged by the device
+    Skipped    // an earlier setting failed (stop on error)
+};
+
+/**
+ * @struct BatchCommand
+ * @brief One parsed command; text is the exact device payload.
+ */
+struct BatchCommand {
+    BatchOp op;
+    BatchResult result;
+    int32_t value;          // milli-units (load/ocp/opp/lvp/ovp/oah), unused otherwise
+    uint32_t us;            // send -> confirmation (or return) time
+    char text[CMD_BATCH_TEXT];
+};
+
+/**
+ * @brief Parse and validate a batch (ratings, OCP/OPP vs. OVP, LVP < OVP, load <= OCP).
+ * @return Number of commands, or -1 with err set (JSON-escaped, the handler quotes it).
+ */
+int parseCmdBatch(const String &text, BatchCommand *cmds, int maxCmds, String &err);
+
+/**
+ * @brief Queue a parsed batch for loop(). Rejected while a batch, DCIR or program runs.
+ * @return Job id (> 0), or 0 with err set.
+ */
+uint32_t requestCmdBatch(const BatchCommand *cmds, int count, bool stopOnError, String &err);
+bool cmdBatchPending();
+bool cmdBatchBusy();
+/**
+ * @brief Skip the rest of the queued or running batch (emergency stop).
+ * @return true if there was one.
+ */
+bool cmdBatchCancel();
+
+/**
+ * @brief Run the queued batch (blocking, called from loop()).
+ */
+void processPendingCmdBatch();
+
+/**
+ * @brief Results of the job with this id (0 = latest); empty if it is not the latest.
+ */
+String cmdBatchStatusJson(uint32_t id);
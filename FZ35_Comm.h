@@ -3,29 +3,66 @@
 #include <SoftwareSerial.h>
 #include <math.h> // NEW: for roundf
 #include "FZ35_Battery.h"
+#include "FZ35_Capture.h"
+#include "FZ35_Channel.h"
+#include "FZ35_Estop.h"
+#include "FZ35_Trace.h"
 
 /**
  * @file FZ35_Comm.h
  * @brief Serial communication helpers for XY-FZ35 load. Provides sending with retries,
  *        classification of success/failure tokens, and parsing delegation to parseFZ35().
+ *        All device I/O goes through fzRead()/fzSend() so it can be captured (FZ35_Capture.h),
+ *        on the link of the selected channel (fzActive, FZ35_Channel.h).
+ *        Every wait polls for an emergency stop (FZ35_Estop.h) and gives up once the
+ *        selected load has been stopped. Load on / off commands are reported to the
+ *        channel's test detector (FZ35_Detect.h).
  */
 
 #define RX_PIN 15
 #define TX_PIN 13
 
+// link of channel 0
 extern SoftwareSerial fzSerial;
+// load on / off commands (FZ35_Lab.ino)
+extern String LOAD_ENABLE_CMD;
+extern String LOAD_DISABLE_CMD;
 
 /**
- * @brief Callback implemented in main .ino to parse each line from device.
+ * @brief Callback implemented in FZ35_Parse.cpp to parse each line from device.
  */
 void parseFZ35(const String &lineIn);
 
+// raw device I/O on the selected channel (channel 0 is recorded while a capture runs)
+inline SoftwareSerial &fzPort() { return *fzActive->port; }
+inline bool fzCaptured() { return captureOn && fzActive->id == 0; }
+inline int fzRead() {
+    int c = fzPort().read();
+    if (c >= 0 && fzCaptured()) captureRxByte((uint8_t)c);
+    return c;
+}
+inline void fzDrain() {
+    while (fzPort().available()) fzRead();
+}
+inline void fzSend(const String &cmd, bool newline) {
+    if (estopPoll()) return;   // stopped load: nothing else until the next loop() pass
+    if (newline) fzPort().println(cmd);
+    else         fzPort().print(cmd);
+    if (fzCaptured()) captureTx(cmd, newline);
+    // our own switch: the next read showing it starts / ends a test at once
+    if (cmd == LOAD_ENABLE_CMD) detectExpect(fzActive->detect, true, millis());
+    else if (cmd == LOAD_DISABLE_CMD) detectExpect(fzActive->detect, false, millis());
+}
+
 /**
  * @brief Send a command without newline (raw frame).
  */
 inline void sendCommandNoNL(const String &cmd) {
-    while (fzSerial.available()) { fzSerial.read(); }
-    fzSerial.print(cmd); // no newline
+    if (estopPoll()) return;
+    CaptureScope scope(CAPTURE_OP_RAW, 0, cmd);
+    TraceScope trace("serial raw");
+    fzDrain();
+    fzSend(cmd, false); // no newline
     Serial.printf(">> Sent (no NL): %s\n", cmd.c_str());
 }
 
@@ -55,29 +92,31 @@ inline bool sendCommandWithConfirm(const String &cmd, unsigned long overallTimeo
     const int MAX_RETRIES = 3;
     const unsigned long IDLE_GAP_MS = 80;
     const unsigned long BETWEEN_RETRY_DELAY = 150;
+    CaptureScope scope(CAPTURE_OP_CONFIRM, overallTimeoutMs, cmd);
+    TraceScope trace("serial confirm");
 
     String keyLower = cmd.substring(0, cmd.indexOf(':'));
     keyLower.toLowerCase();
 
     for (int attempt = 1; attempt <= MAX_RETRIES; ++attempt) {
+        if (estopPoll()) return false;
         bool sendNoNewline = (attempt % 2 == 1);
         Serial.printf(">> Attempt %d/%d: %s (mode: %s newline)\n",
                       attempt, MAX_RETRIES, cmd.c_str(),
                       sendNoNewline ? "without" : "with");
 
-        while (fzSerial.available()) fzSerial.read();
-
-        if (sendNoNewline) fzSerial.print(cmd);
-        else               fzSerial.println(cmd);
+        fzDrain();
+        fzSend(cmd, !sendNoNewline);
 
         unsigned long tStart = millis();
         unsigned long lastByte = tStart;
         String resp;
 
         while (millis() - tStart < overallTimeoutMs) {
+            if (estopPoll()) return false;
             bool got = false;
-            while (fzSerial.available()) {
-                char c = (char)fzSerial.read();
+            while (fzPort().available()) {
+                char c = (char)fzRead();
                 if (c == '\r') continue;
                 if (c == '\n') {
                     if (resp.length() && resp.charAt(resp.length()-1) != '\n')
@@ -89,7 +128,7 @@ inline bool sendCommandWithConfirm(const String &cmd, unsigned long overallTimeo
                 got = true;
             }
             if (!got && resp.length() > 0 && (millis() - lastByte) >= IDLE_GAP_MS) break;
-            delay(5);
+            delay(ESTOP_POLL_MS);
         }
 
         resp.trim();
@@ -106,7 +145,7 @@ inline bool sendCommandWithConfirm(const String &cmd, unsigned long overallTimeo
             Serial.println("   (Unclassified response, will retry)");
         }
 
-        if (attempt < MAX_RETRIES) delay(BETWEEN_RETRY_DELAY);
+        if (attempt < MAX_RETRIES && estopDelay(BETWEEN_RETRY_DELAY)) return false;
     }
 
     Serial.printf("   ✗✗ FAILED after %d attempts: %s\n", MAX_RETRIES, cmd.c_str());
@@ -136,7 +175,7 @@ inline bool sendParamVariants(const String &key, const String &value, unsigned l
     for (int i=0;i<count;i++){
         Serial.printf(".. trying variant: %s\n", variants[i].c_str());
         if (sendCommandWithConfirm(variants[i], timeoutMs)) return true;
-        delay(120);
+        if (estopDelay(120)) return false;
     }
     return false;
 }
@@ -148,9 +187,12 @@ inline bool sendParamVariants(const String &key, const String &value, unsigned l
  * @return Raw concatenated response lines (trimmed).
  */
 inline String sendCommand(const String &cmd, unsigned long timeout_ms) {
+    if (estopPoll()) return String();
+    CaptureScope scope(CAPTURE_OP_SEND, timeout_ms, cmd);
+    TraceScope trace("serial send");
     Serial.printf(">> Sending: %s\n", cmd.c_str());
-    while (fzSerial.available()) { fzSerial.read(); }
-    fzSerial.println(cmd);
+    fzDrain();
+    fzSend(cmd, true);
 
     unsigned long t0 = millis();
     String resp = "";
@@ -159,8 +201,9 @@ inline String sendCommand(const String &cmd, unsigned long timeout_ms) {
     bool seenCSV = false;
 
     while (millis() - t0 < timeout_ms) {
-        while (fzSerial.available()) {
-            char c = (char)fzSerial.read();
+        if (estopPoll()) return String();
+        while (fzPort().available()) {
+            char c = (char)fzRead();
             if (c == '\r') continue;
             if (c == '\n') {
                 line.trim();
@@ -172,7 +215,7 @@ inline String sendCommand(const String &cmd, unsigned long timeout_ms) {
                     line = "";
                     if (seenPrefix && seenCSV) {
                         unsigned long waitExtra = millis() + 10;
-                        while (millis() < waitExtra) { while (fzSerial.available()) fzSerial.read(); }
+                        while (millis() < waitExtra) { fzDrain(); }
                         goto finished_read;
                     }
                 }
@@ -180,7 +223,7 @@ inline String sendCommand(const String &cmd, unsigned long timeout_ms) {
                 line += c;
             }
         }
-        delay(5);
+        delay(ESTOP_POLL_MS);
     }
 
 finished_read:
@@ -195,10 +238,66 @@ finished_read:
     return resp;
 }
 
+/**
+ * @struct TimedRead
+ * @brief Timestamps bracketing one measurement read. The device samples somewhere
+ *        between the end of our command and its first response byte, so that window
+ *        is the timing uncertainty of the sample.
+ */
+struct TimedRead {
+    uint64_t sentUs;       // command fully shifted out
+    uint64_t firstByteUs;  // first response byte seen (0 = no response)
+    uint64_t doneUs;       // CSV line complete
+};
+
+/**
+ * @brief Fast read for time-critical callers: sends "read", returns as soon as the
+ * CSV measurement line is complete (no wait for the summary line) and feeds the
+ * lines received so far to parseFZ35().
+ * @return true if a CSV measurement line was received.
+ */
+inline bool readMeasurementTimed(TimedRead &t, unsigned long timeout_ms = 600) {
+    if (estopPoll()) { t = TimedRead(); return false; }
+    CaptureScope scope(CAPTURE_OP_READ_TIMED, timeout_ms, "read");
+    TraceScope trace("serial read timed");
+    fzDrain();
+    fzSend("read", true);
+    t.sentUs = micros64(); // SoftwareSerial TX is blocking: bytes are on the wire
+    t.firstByteUs = 0;
+    t.doneUs = 0;
+
+    String line;
+    bool seenCSV = false;
+    unsigned long t0 = millis();
+    while (!seenCSV && millis() - t0 < timeout_ms) {
+        if (estopPoll()) return false;
+        while (fzPort().available()) {
+            char c = (char)fzRead();
+            if (!t.firstByteUs) t.firstByteUs = micros64();
+            if (c == '\r') continue;
+            if (c != '\n') { line += c; continue; }
+            line.trim();
+            if (line.length() > 0) {
+                if (line.indexOf("V,") >= 0 && line.indexOf("Ah") >= 0) {
+                    seenCSV = true;
+                    t.doneUs = micros64();
+                }
+                parseFZ35(line);
+            }
+            line = "";
+            if (seenCSV) break;
+        }
+        if (!seenCSV) delay(1);
+    }
+    return seenCSV;
+}
+
 /**
  * @brief High-level read cycle: sends "read" then feeds each line to parseFZ35().
  */
 inline void readFZ35() {
+    CaptureScope scope(CAPTURE_OP_READ, 900, "read");
+    TraceScope trace("readFZ35");
     String raw = sendCommand("read", 900);
     Serial.printf("RAW:\n%s\n", raw.c_str());
 
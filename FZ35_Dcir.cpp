@@ -0,0 +1,184 @@
+#include "FZ35_Dcir.h"
+#include "FZ35_Battery.h"
+#include "FZ35_Comm.h"
+#include "FZ35_Program.h"
+#include "FZ35_CmdBatch.h"
+
+/**
+ * @file FZ35_Dcir.cpp
+ * @brief DCIR step sequence and statistics.
+ */
+
+extern String LOAD_ENABLE_CMD;
+extern String LOAD_DISABLE_CMD;
+
+static DcirConfig pendingCfg;
+static bool pending = false;
+static bool running = false;
+static bool cancelled = false;
+static DcirResult result;
+
+static const int32_t RATED_CURRENT_MA = toMilli(RATED_CURRENT_MAX);
+
+bool requestDcir(const DcirConfig &cfg, String &err) {
+    if (pending || running) { err = "measurement already running"; return false; }
+    if (programActive()) { err = "program running"; return false; }
+    if (cmdBatchBusy()) { err = "command batch running"; return false; }
+    if (cfg.low_mA < 0 || cfg.high_mA > RATED_CURRENT_MA || cfg.high_mA - cfg.low_mA < 100) {
+        err = "need 0 <= low, high <= rated current, high - low >= 0.1 A";
+        return false;
+    }
+    if (cfg.repeats < 1 || cfg.repeats > DCIR_MAX_REPEATS) { err = "repeats 1.." + String(DCIR_MAX_REPEATS); return false; }
+    if (cfg.settle_ms < 50 || cfg.settle_ms > 5000) { err = "settle 50..5000 ms"; return false; }
+    pendingCfg = cfg;
+    pending = true;
+    return true;
+}
+
+bool dcirPending() { return pending; }
+bool dcirBusy() { return pending || running; }
+
+bool dcirCancel() {
+    if (!pending && !running) return false;
+    pending = false;
+    cancelled = running;
+    return true;
+}
+
+static void setLoadCurrent(int32_t mA) {
+    char cmd[16];
+    size_t n = formatMilli(cmd, sizeof(cmd) - 1, mA, 2);
+    cmd[n] = 'A';
+    cmd[n + 1] = '\0';
+    sendCommandNoNL(cmd);
+}
+
+/**
+ * @brief Read one sample, recording its timing window.
+ */
+static bool timedSample(Measurement &out, TimedRead &t) {
+    if (!readMeasurementTimed(t) || !t.firstByteUs) return false;
+    out = meas;
+    return true;
+}
+
+static uint32_t noteWindow(const TimedRead &t) {
+    uint32_t w = (uint32_t)(t.firstByteUs - t.sentUs);
+    if (w > result.windowMax_us) result.windowMax_us = w;
+    return w;
+}
+
+static void fail(const char *why) {
+    strncpy(result.error, why, sizeof(result.error) - 1);
+    result.error[sizeof(result.error) - 1] = '\0';
+    result.valid = false;
+}
+
+void processPendingDcir() {
+    if (!pending) return;
+    pending = false;
+    running = true;
+    cancelled = false;
+    const DcirConfig cfg = pendingCfg;
+    bool wasOn = meas.current_mA > 10;
+
+    memset(&result, 0, sizeof(result));
+    result.takenMs = millis();
+    Serial.printf("DCIR: %ld -> %ld mA, %u repeats, settle %u ms\n",
+                  (long)cfg.low_mA, (long)cfg.high_mA, cfg.repeats, cfg.settle_ms);
+
+    setLoadCurrent(cfg.low_mA);
+    sendCommandNoNL(LOAD_ENABLE_CMD);
+    estopDelay(cfg.settle_ms);
+
+    int64_t sumR = 0, sumSqR = 0, sumDV = 0, sumDI = 0;
+    uint64_t sumWindow = 0, sumStepToRead = 0;
+    uint32_t windows = 0;
+    bool atHigh = false;
+
+    for (uint16_t rep = 0; rep < cfg.repeats && !cancelled; ++rep) {
+        Measurement before, after;
+        TimedRead tb, ta;
+        if (!timedSample(before, tb)) { result.rejected++; continue; }
+
+        atHigh = !atHigh;
+        setLoadCurrent(atHigh ? cfg.high_mA : cfg.low_mA);
+        uint64_t stepUs = micros64();
+        estopDelay(cfg.settle_ms);
+        if (!timedSample(after, ta)) { result.rejected++; continue; }
+
+        // signs cancel for high->low, so one formula covers both directions
+        int32_t dI = after.current_mA - before.current_mA;
+        int32_t dV = before.voltage_mV - after.voltage_mV;
+        if (abs(dI) < DCIR_MIN_STEP_MA) { result.rejected++; continue; }
+        int32_t r = (int32_t)fixedRoundDivWide((int64_t)dV * 1000000LL, dI); // mV/mA = ohm
+
+        sumR += r;
+        sumSqR += (int64_t)r * r;
+        sumDV += abs(dV);
+        sumDI += abs(dI);
+        sumStepToRead += ta.sentUs - stepUs;
+        sumWindow += noteWindow(tb) + noteWindow(ta);
+        windows += 2;
+        result.steps++;
+    }
+
+    // restore: profile load current, previous on/off state
+    setLoadCurrent(activeBatteryDerived().load_mA);
+    if (!wasOn) sendCommandNoNL(LOAD_DISABLE_CMD);
+
+    if (cancelled) {
+        fail("emergency stop");
+    } else if (result.steps == 0) {
+        fail(result.rejected ? "no valid steps" : "no response");
+    } else {
+        int32_t n = result.steps;
+        result.r_uOhm = (int32_t)fixedRoundDivWide(sumR, n);
+        int64_t var = sumSqR / n - (int64_t)result.r_uOhm * result.r_uOhm;
+        // reporting only: float is fine off the sample path
+        result.rStd_uOhm = var > 0 ? (int32_t)(sqrtf((float)var) + 0.5f) : 0;
+        result.dV_mV = (int32_t)fixedRoundDivWide(sumDV, n);
+        result.dI_mA = (int32_t)fixedRoundDivWide(sumDI, n);
+        result.windowMean_us = (uint32_t)(sumWindow / windows);
+        result.stepToRead_us = (uint32_t)(sumStepToRead / (uint64_t)n);
+        result.valid = true;
+        Serial.printf("DCIR: %ld uOhm (sd %ld) over %u steps, sample window mean %u us max %u us\n",
+                      (long)result.r_uOhm, (long)result.rStd_uOhm, result.steps,
+                      (unsigned)result.windowMean_us, (unsigned)result.windowMax_us);
+    }
+    running = false;
+}
+
+const DcirResult &dcirLastResult() { return result; }
+
+bool dcirTakeForLog(float &milliOhm) {
+    if (!result.valid || result.logged) return false;
+    result.logged = true;
+    milliOhm = result.r_uOhm / 1000.0f;
+    return true;
+}
+
+String dcirStatusJson() {
+    String json = "{\"state\":\"";
+    json += running ? "running" : (pending ? "pending" : "idle");
+    json += "\",\"valid\":";
+    json += result.valid ? "true" : "false";
+    if (result.valid) {
+        char num[16];
+        formatMilli(num, sizeof(num), result.r_uOhm, 2);
+        json += ",\"r_mohm\":" + String(num);
+        formatMilli(num, sizeof(num), result.rStd_uOhm, 2);
+        json += ",\"r_sd_mohm\":" + String(num);
+        json += ",\"steps\":" + String(result.steps);
+        json += ",\"dv_mv\":" + String((long)result.dV_mV);
+        json += ",\"di_ma\":" + String((long)result.dI_mA);
+        json += ",\"timing_us\":{\"window_mean\":" + String((unsigned long)result.windowMean_us);
+        json += ",\"window_max\":" + String((unsigned long)result.windowMax_us);
+        json += ",\"step_to_read\":" + String((unsigned long)result.stepToRead_us) + "}";
+        json += ",\"age_s\":" + String((millis() - result.takenMs) / 1000UL);
+    } else if (result.error[0]) {
+        json += ",\"error\":\"" + String(result.error) + "\"";
+    }
+    json += ",\"rejected\":" + String(result.rejected) + "}";
+    return json;
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <Arduino.h>
+#include "FZ35_Fixed.h"
+
+/**
+ * @file FZ35_Dcir.h
+ * @brief Pulse-based DC internal resistance: steps the load between two currents and
+ *        reads V/I immediately before and after each step, R = dV / dI on the measured
+ *        values. Direction alternates (low->high, high->low) so slow voltage drift
+ *        cancels in the average. Each read is bracketed by micros64() stamps
+ *        (TimedRead); the window between command end and first response byte is the
+ *        timing uncertainty of that sample.
+ */
+
+#define DCIR_MAX_REPEATS 20
+#define DCIR_MIN_STEP_MA 50   // smaller measured steps are rejected (0.01 A resolution)
+
+/**
+ * @struct DcirConfig
+ * @brief Requested measurement.
+ */
+struct DcirConfig {
+    int32_t low_mA;
+    int32_t high_mA;
+    uint16_t repeats;
+    uint16_t settle_ms;   // wait after each step before the "after" read
+};
+
+/**
+ * @struct DcirResult
+ * @brief Last measurement. Resistance in micro-ohms, timing in microseconds.
+ */
+struct DcirResult {
+    bool valid;
+    bool logged;            // already attached to a test log entry
+    int32_t r_uOhm;         // mean over good steps
+    int32_t rStd_uOhm;
+    uint16_t steps;         // good steps
+    uint16_t rejected;      // read failures / too small dI
+    int32_t dV_mV;          // mean |dV|
+    int32_t dI_mA;          // mean |dI|
+    uint32_t windowMean_us; // per-sample uncertainty: command end -> first response byte
+    uint32_t windowMax_us;
+    uint32_t stepToRead_us; // mean step command -> "after" sample window start
+    unsigned long takenMs;
+    char error[32];
+};
+
+/**
+ * @brief Queue a measurement for loop() (rejected while a program or DCIR is running).
+ */
+bool requestDcir(const DcirConfig &cfg, String &err);
+bool dcirPending();
+// pending or running: the serial link must be left alone
+bool dcirBusy();
+/**
+ * @brief Drop a queued measurement or end a running one after its current step
+ * (emergency stop). @return true if there was one.
+ */
+bool dcirCancel();
+
+/**
+ * @brief Run a queued measurement (blocking, called from loop()). Restores the
+ * profile load current and the previous on/off state afterwards.
+ */
+void processPendingDcir();
+
+const DcirResult &dcirLastResult();
+
+/**
+ * @brief Hand the latest valid, not yet logged result to the test log.
+ * @return false if there is none.
+ */
+bool dcirTakeForLog(float &milliOhm);
+
+String dcirStatusJson();
@@ -0,0 +1,79 @@
+#include "FZ35_Detect.h"
+
+/**
+ * @file FZ35_Detect.cpp
+ * @brief Running median and start/end hysteresis.
+ */
+
+void detectReset(LoadDetector &d) {
+    d = LoadDetector();
+}
+
+// replace the oldest fresh current: one shift in the sorted copy, N is fixed
+static void medianPush(LoadDetector &d, int32_t v) {
+    int n = d.count;
+    if (n == DETECT_MEDIAN_N) {
+        int32_t old = d.window[d.head];
+        int i = 0;
+        while (d.sorted[i] != old) ++i;
+        for (; i < n - 1; ++i) d.sorted[i] = d.sorted[i + 1];
+        n--;
+    } else {
+        d.count++;
+    }
+    d.window[d.head] = v;
+    d.head = (d.head + 1) % DETECT_MEDIAN_N;
+    int i = n;
+    while (i > 0 && d.sorted[i - 1] > v) {
+        d.sorted[i] = d.sorted[i - 1];
+        --i;
+    }
+    d.sorted[i] = v;
+    d.filtered_mA = d.sorted[d.count / 2];
+}
+
+DetectEvent detectAddRead(LoadDetector &d, const DetectRead &r, bool active, DetectResult &out) {
+    out = DetectResult();
+    if (!r.fresh) {
+        d.staleRun++;
+        d.staleReads++;
+        return DetectEvent::None;
+    }
+    d.staleRun = 0;
+    d.lastFreshMs = r.ms;
+    medianPush(d, r.current_mA);
+
+    // a running test can only end, an idle load only start
+    const DetectEvent edge = active ? DetectEvent::End : DetectEvent::Start;
+    bool past = active ? r.current_mA < DETECT_END_MA : r.current_mA > DETECT_START_MA;
+    bool filteredPast = active ? d.filtered_mA < DETECT_END_MA : d.filtered_mA > DETECT_START_MA;
+
+    if (d.run != DetectEvent::None && d.run != edge) d.run = DetectEvent::None;  // state changed elsewhere
+    if (past && d.run == DetectEvent::None) {
+        d.run = edge;
+        d.runMs = r.ms;
+        d.runCap_mAh = r.capacity_mAh;
+    } else if (!past && !filteredPast && d.run != DetectEvent::None) {
+        d.run = DetectEvent::None;   // back before the median followed: a glitch
+        d.rejected++;
+    }
+    if (d.run == DetectEvent::None) return DetectEvent::None;
+
+    bool expected = past && d.expect == edge && r.ms - d.expectMs < DETECT_EXPECT_MS;
+    uint32_t dwell = active ? DETECT_END_DWELL_MS : DETECT_START_DWELL_MS;
+    // the deciding read itself must be past too: a run of three glitches keeps the
+    // median past for two more reads, but not the reads themselves
+    bool settled = past && filteredPast && d.count >= DETECT_MIN_READS && r.ms - d.runMs >= dwell;
+    if (!expected && !settled) return DetectEvent::None;
+
+    out.event = edge;
+    out.atMs = d.runMs;
+    out.capacity_mAh = d.runCap_mAh;
+    out.latencyMs = r.ms - d.runMs;
+    d.run = DetectEvent::None;
+    d.expect = DetectEvent::None;
+    d.events++;
+    d.lastLatencyMs = out.latencyMs;
+    if (out.latencyMs > d.maxLatencyMs) d.maxLatencyMs = out.latencyMs;
+    return edge;
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * @file FZ35_Detect.h
+ * @brief Filter stage between a load's reads and test start/end detection. Every read
+ *        is fed in as fresh or stale (failed or timed out: the parsed values are still
+ *        the previous ones); stale reads never move the filter. Fresh currents go
+ *        through a running median of DETECT_MEDIAN_N, then a hysteresis (start above
+ *        DETECT_START_MA, end below DETECT_END_MA) with dwell times. An event is
+ *        emitted on the read that makes it certain and is dated to the first read of
+ *        the run that caused it. After the firmware itself switched the load, one read
+ *        on the expected side is certain (detectExpect()). O(1) per read, no
+ *        Arduino dependency.
+ */
+
+#define DETECT_MEDIAN_N        5      // fresh reads in the median (up to two glitches in five are rejected)
+#define DETECT_MIN_READS       3      // median needs this many fresh reads before any event
+#define DETECT_START_MA        50     // filtered current above: the load is drawing
+#define DETECT_END_MA          10     // filtered current below: the load is off
+#define DETECT_START_DWELL_MS  2500   // run must have lasted this long (4 reads at 1 Hz) to start a test
+#define DETECT_END_DWELL_MS    2500   // ... or to end one
+#define DETECT_EXPECT_MS       5000   // our own on/off is trusted for this long
+#define DETECT_STALE_MS        5000   // no fresh read for this long: values are stale
+
+enum class DetectEvent : uint8_t {
+    None,
+    Start,
+    End
+};
+
+/**
+ * @struct DetectRead
+ * @brief One read as seen by the filter.
+ */
+struct DetectRead {
+    uint32_t ms;
+    int32_t current_mA;
+    int32_t capacity_mAh;
+    bool fresh;              // false: the read failed, values are the previous ones
+};
+
+/**
+ * @struct DetectResult
+ * @brief An event and the read it is dated to.
+ */
+struct DetectResult {
+    DetectEvent event;
+    uint32_t atMs;           // first read of the run that caused it
+    int32_t capacity_mAh;    // device counter at that read
+    uint32_t latencyMs;      // atMs -> the read that made it certain
+};
+
+/**
+ * @struct LoadDetector
+ * @brief Filter and hysteresis state of one load.
+ */
+struct LoadDetector {
+    int32_t window[DETECT_MEDIAN_N];   // fresh currents, oldest at head once full
+    int32_t sorted[DETECT_MEDIAN_N];   // same values, ascending
+    uint8_t head, count;
+    int32_t filtered_mA;
+
+    DetectEvent run;                   // edge a run of reads past its threshold points to
+    uint32_t runMs;                    // first read of the run
+    int32_t runCap_mAh;
+
+    DetectEvent expect;                // edge our last on/off command should cause
+    uint32_t expectMs;
+
+    uint32_t lastFreshMs;
+    uint32_t staleRun;                 // consecutive stale reads
+    uint32_t staleReads;
+    uint32_t rejected;                 // runs the filter dropped (glitches)
+    uint32_t events;
+    uint32_t lastLatencyMs;
+    uint32_t maxLatencyMs;
+};
+
+void detectReset(LoadDetector &d);
+
+/**
+ * @brief Feed one read. active: a test is running (only End can follow), else only Start.
+ * @return out.event (None most of the time).
+ */
+DetectEvent detectAddRead(LoadDetector &d, const DetectRead &r, bool active, DetectResult &out);
+
+// the firmware switched the load: the matching edge is certain on the next read that shows it
+inline void detectExpect(LoadDetector &d, bool on, uint32_t nowMs) {
+    d.expect = on ? DetectEvent::Start : DetectEvent::End;
+    d.expectMs = nowMs;
+}
+
+inline bool detectStale(const LoadDetector &d, uint32_t nowMs) {
+    return d.staleRun > 0 && nowMs - d.lastFreshMs >= DETECT_STALE_MS;
+}
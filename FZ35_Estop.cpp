@@ -0,0 +1,107 @@
+#include "FZ35_Estop.h"
+#include "FZ35_Comm.h"
+#include "FZ35_Channel.h"
+#include "FZ35_CmdBatch.h"
+#include "FZ35_Dcir.h"
+#include "FZ35_Program.h"
+#include "FZ35_Trace.h"
+
+/**
+ * @file FZ35_Estop.cpp
+ * @brief Stop execution, latches and latency statistics.
+ */
+
+extern String LOAD_DISABLE_CMD;
+
+static volatile uint8_t requested = 0;   // channels to stop (set by HTTP handlers)
+static uint64_t requestUs = 0;           // oldest unserved request
+static uint8_t latched = 0;              // stopped in this loop() pass
+static bool programStopPending = false;
+
+static uint32_t stops = 0;
+static uint32_t lastUs = 0;
+static uint32_t maxUs = 0;
+static uint64_t sumUs = 0;
+static uint32_t overBound = 0;
+static uint32_t dropped = 0;             // queued operations discarded
+
+void estopRequest(uint8_t mask) {
+    mask &= (1u << FZ_CHANNELS) - 1;
+    if (!mask) return;
+    if (!requested) requestUs = micros64();
+    requested |= mask;
+}
+
+static void execute() {
+    TraceScope trace("estop");
+    uint8_t mask = requested;
+    requested = 0;
+    // a second stop in the same pass sends the disable again
+    latched &= ~mask;
+    for (int i = 0; i < FZ_CHANNELS; ++i) {
+        uint8_t bit = 1u << i;
+        if (!(mask & bit)) continue;
+        FzChannel &ch = channels[i];
+        ChannelScope scope(ch);
+        fzDrain();                     // the rest of an abandoned answer
+        fzSend(LOAD_DISABLE_CMD, false);
+        latched |= bit;
+        if (ch.pendingCmd.length()) { ch.pendingCmd = String(); dropped++; }
+        if (ch.pendingBatteryIdx >= 0) { ch.pendingBatteryIdx = -1; dropped++; }
+    }
+    uint32_t us = (uint32_t)(micros64() - requestUs);
+
+    // queued work of channel 0 (pendingBatteryIdx is its queue, see FZ35_Battery.h)
+    if (mask & 1) {
+        if (pendingBatteryIdx >= 0) { pendingBatteryIdx = -1; dropped++; }
+        if (cmdBatchCancel()) dropped++;
+        if (dcirCancel()) dropped++;
+        // stopped from estopRelease(): programTick() may be running right now
+        if (programActive()) { programStopPending = true; dropped++; }
+    }
+
+    stops++;
+    lastUs = us;
+    sumUs += us;
+    if (us > maxUs) maxUs = us;
+    if (us > ESTOP_BOUND_MS * 1000UL) overBound++;
+    Serial.printf("E-STOP: channels 0x%02x disabled %lu us after the request\n",
+                  mask, (unsigned long)us);
+}
+
+bool estopPoll() {
+    if (requested) execute();
+    return latched & (1u << fzActive->id);
+}
+
+void estopRelease() {
+    if (programStopPending) {
+        programStopPending = false;
+        stopProgram("emergency stop");   // still latched: its disable is not sent twice
+    }
+    latched = 0;
+    if (requested) execute();
+}
+
+bool estopDelay(unsigned long ms) {
+    unsigned long t0 = millis();
+    for (;;) {
+        if (estopPoll()) return true;
+        unsigned long elapsed = millis() - t0;
+        if (elapsed >= ms) return false;
+        unsigned long left = ms - elapsed;
+        delay(left < ESTOP_POLL_MS ? left : ESTOP_POLL_MS);
+    }
+}
+
+String estopStatusJson() {
+    String json = "{\"stops\":" + String((unsigned long)stops);
+    json += ",\"last_us\":" + String((unsigned long)lastUs);
+    json += ",\"mean_us\":" + String((unsigned long)(stops ? sumUs / stops : 0));
+    json += ",\"max_us\":" + String((unsigned long)maxUs);
+    json += ",\"bound_ms\":" + String(ESTOP_BOUND_MS);
+    json += ",\"over_bound\":" + String((unsigned long)overBound);
+    json += ",\"dropped\":" + String((unsigned long)dropped);
+    json += ",\"pending\":" + String(requested ? "true" : "false") + "}";
+    return json;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @file FZ35_Estop.h
+ * @brief Emergency stop. A stop request (/estop, /cmd?op=disable) only sets a flag; the
+ *        serial code polls it in every wait loop and between the steps of a sequence
+ *        (estopPoll(), FZ35_Comm.h), so the disable command goes out within a few ms
+ *        even while loop() is blocked in a read or a profile application.
+ *
+ * When the stop is executed the channel is latched: the transaction in flight ends,
+ * every further command to that load is suppressed and queued work (profile, command
+ * batch, DCIR, program, queued /cmd) is dropped. The latch is released at the top of
+ * the next loop() pass, once the interrupted sequence has unwound.
+ *
+ * Latency is measured from the stop request to the last byte of the disable command
+ * on the wire.
+ */
+
+// worst case from the request to the disable on the wire: one poll period (the
+// longest wait step), a command already being shifted out (up to 12 bytes at
+// 9600 baud) and the disable itself
+#define ESTOP_POLL_MS  5
+#define ESTOP_BOUND_MS 20
+
+/**
+ * @brief Request a stop of the loads in mask (bit = channel id). Safe from HTTP handlers.
+ */
+void estopRequest(uint8_t mask);
+
+/**
+ * @brief Execute a pending stop, then report whether the selected channel is latched.
+ * @return true if the caller must abandon its current transaction.
+ */
+bool estopPoll();
+
+/**
+ * @brief Release the latches; called at the top of loop().
+ */
+void estopRelease();
+
+/**
+ * @brief delay() that returns early (true) when the selected channel gets stopped.
+ */
+bool estopDelay(unsigned long ms);
+
+String estopStatusJson();
@@ -0,0 +1,566 @@
+#include "FZ35_Export.h"
+#include "FZ35_TestLog.h"
+#include "FZ35_Memory.h"
+#include "FZ35_Admission.h"
+#include "FZ35_Trace.h"
+#include <LittleFS.h>
+#include <memory>
+#include <new>
+
+/**
+ * @file FZ35_Export.cpp
+ * @brief Test history file, fixed-width NDJSON formatting and ranged streaming.
+ */
+
+// graph ring (FZ35_Lab.ino); samples are numbered from boot, sampleSlot() maps to the ring
+extern int samplesStored;
+extern uint32_t samplesWritten;
+extern int sampleSlot(uint32_t seq);
+extern uint16_t scaledVoltageAt(int idx);
+extern uint16_t scaledCurrentAt(int idx);
+extern uint16_t scaledPowerAt(int idx);
+extern uint32_t sampleTimestampAt(int idx);
+
+#define EXPORT_BATCH 16
+
+// ---------- test history ----------
+
+static SampleRecord histBuf[HISTORY_FLUSH_RECORDS];
+static uint8_t histBuffered = 0;
+static uint32_t histFileCount = 0;
+static uint32_t histGeneration = 0; // bumped by historyBegin(); open downloads notice
+static bool histFullLogged = false;
+static uint32_t histOffset_s = 0;   // added to sample times after a resume (historyResume())
+
+/**
+ * @brief Start a new history with the ring samples taken from from_s on (the reads
+ * before the test start was certain), except the newest: the caller appends that one.
+ */
+void historyBegin(uint32_t from_s) {
+    histOffset_s = 0;
+    histBuffered = 0;
+    histFileCount = 0;
+    histGeneration++;
+    histFullLogged = false;
+    File f = LittleFS.open(HISTORY_FILE, "w");
+    if (!f) {
+        Serial.println("Failed to create history file");
+        return;
+    }
+    HistoryHeader hdr = { HISTORY_MAGIC, sizeof(SampleRecord), 0 };
+    f.write((const uint8_t*)&hdr, sizeof(hdr));
+    f.close();
+
+    if (!samplesStored) return;
+    uint32_t newest = samplesWritten - 1;
+    uint32_t k = newest;
+    while (k > samplesWritten - (uint32_t)samplesStored && sampleTimestampAt(sampleSlot(k - 1)) >= from_s) k--;
+    for (; k < newest; ++k) {
+        int slot = sampleSlot(k);
+        SampleRecord r = { sampleTimestampAt(slot), scaledVoltageAt(slot), scaledCurrentAt(slot),
+                           scaledPowerAt(slot), 0 };
+        historyAppend(r);
+    }
+}
+
+void historyFlush() {
+    if (histBuffered == 0) return;
+    TraceScope trace("fs history");
+    File f = LittleFS.open(HISTORY_FILE, "a");
+    if (!f) {
+        Serial.println("Failed to append history");
+        return;
+    }
+    size_t bytes = histBuffered * sizeof(SampleRecord);
+    size_t written = f.write((const uint8_t*)histBuf, bytes);
+    f.close();
+    histFileCount += written / sizeof(SampleRecord);
+    histBuffered = 0;
+}
+
+void historyAppend(const SampleRecord &r) {
+    if (historyCount() >= HISTORY_MAX_RECORDS) {
+        if (!histFullLogged) Serial.println("History full, further samples not stored");
+        histFullLogged = true;
+        return;
+    }
+    histBuf[histBuffered] = r;
+    histBuf[histBuffered++].t_s += histOffset_s;
+    if (histBuffered >= HISTORY_FLUSH_RECORDS) historyFlush();
+}
+
+uint32_t historyCount() { return histFileCount + histBuffered; }
+
+/**
+ * @brief Boot: pick up the history of the last test (kept across resets).
+ * Requires LittleFS to be mounted (initTestLog()).
+ */
+void initHistory() {
+    memRegister("Export", "history batch", MemKind::Static, sizeof(histBuf));
+    if (!LittleFS.exists(HISTORY_FILE)) return;
+    File f = LittleFS.open(HISTORY_FILE, "r");
+    HistoryHeader hdr = {};
+    if (f && f.read((uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr) &&
+        hdr.magic == HISTORY_MAGIC && hdr.recordSize == sizeof(SampleRecord)) {
+        histFileCount = (f.size() - sizeof(hdr)) / sizeof(SampleRecord);
+    }
+    if (f) f.close();
+}
+
+// ---------- sample sources ----------
+
+enum class ExportSource : uint8_t { Ring, History };
+
+/**
+ * @struct ExportView
+ * @brief Records [first, first + count) of a source, resolved when the request
+ * arrives; generation detects a source that was reset during the download.
+ */
+struct ExportView {
+    ExportSource source;
+    uint32_t first;
+    uint32_t count;
+    uint32_t generation;
+};
+
+static uint32_t ringOldest() { return samplesWritten - (uint32_t)samplesStored; }
+
+static SampleRecord ringRecord(uint32_t k) {
+    SampleRecord r = {};
+    if (k < ringOldest() || k >= samplesWritten) {
+        r.flags = SAMPLE_LOST; // overwritten since the request started
+        return r;
+    }
+    int slot = sampleSlot(k);
+    r.t_s = sampleTimestampAt(slot);
+    r.v_cV = scaledVoltageAt(slot);
+    r.i_cA = scaledCurrentAt(slot);
+    r.p_dW = scaledPowerAt(slot);
+    return r;
+}
+
+/**
+ * @brief Read n history records from k; file first, then the unflushed RAM batch.
+ */
+static void historyRead(uint32_t k, uint32_t n, SampleRecord *out) {
+    uint32_t i = 0;
+    if (k < histFileCount) {
+        uint32_t fromFile = min(n, histFileCount - k);
+        File f = LittleFS.open(HISTORY_FILE, "r");
+        size_t got = 0;
+        if (f && f.seek(sizeof(HistoryHeader) + k * sizeof(SampleRecord), SeekSet)) {
+            got = f.read((uint8_t*)out, fromFile * sizeof(SampleRecord)) / sizeof(SampleRecord);
+        }
+        if (f) f.close();
+        for (uint32_t j = got; j < fromFile; ++j) { out[j] = SampleRecord(); out[j].flags = SAMPLE_LOST; }
+        i = fromFile;
+    }
+    for (; i < n; ++i) {
+        uint32_t b = k + i - histFileCount;
+        if (b < histBuffered) out[i] = histBuf[b];
+        else { out[i] = SampleRecord(); out[i].flags = SAMPLE_LOST; }
+    }
+}
+
+/**
+ * @brief Continue the kept history of a resumed test in its own time base: a sample
+ * taken now is dated to the first record plus the test's elapsed time, and always
+ * after the last record (the clock restarted with the reset).
+ */
+void historyResume(uint32_t now_s, uint32_t elapsed_s) {
+    histOffset_s = 0;
+    uint32_t n = historyCount();
+    if (!n) return;
+    SampleRecord first, last;
+    historyRead(0, 1, &first);
+    historyRead(n - 1, 1, &last);
+    uint32_t t = first.t_s + elapsed_s;
+    if (t <= last.t_s) t = last.t_s + 1;
+    histOffset_s = t - now_s;
+}
+
+static void readRecords(const ExportView &v, uint32_t k, uint32_t n, SampleRecord *out) {
+    if (v.source == ExportSource::Ring) {
+        for (uint32_t i = 0; i < n; ++i) out[i] = ringRecord(k + i);
+        return;
+    }
+    if (v.generation != histGeneration) {
+        for (uint32_t i = 0; i < n; ++i) { out[i] = SampleRecord(); out[i].flags = SAMPLE_LOST; }
+        return;
+    }
+    historyRead(k, n, out);
+}
+
+static uint32_t recordTime(ExportSource s, uint32_t k) {
+    SampleRecord r;
+    if (s == ExportSource::Ring) r = ringRecord(k);
+    else historyRead(k, 1, &r);
+    return r.t_s;
+}
+
+/**
+ * @brief First record in [lo, hi) with t > t_s (inclusive=false) or t >= t_s.
+ * Timestamps are appended in order, so both sources are sorted.
+ */
+static uint32_t timeBound(ExportSource s, uint32_t lo, uint32_t hi, uint32_t t_s, bool inclusive) {
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        uint32_t t = recordTime(s, mid);
+        if (inclusive ? t < t_s : t <= t_s) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+static ExportView resolveView(ExportSource s, AsyncWebServerRequest *request) {
+    ExportView v = {};
+    v.source = s;
+    uint32_t lo, hi;
+    if (s == ExportSource::Ring) {
+        lo = ringOldest();
+        hi = samplesWritten;
+    } else {
+        lo = 0;
+        hi = historyCount();
+        v.generation = histGeneration;
+    }
+    if (request->hasParam("from")) lo = timeBound(s, lo, hi, request->getParam("from")->value().toInt(), true);
+    if (request->hasParam("to")) hi = timeBound(s, lo, hi, request->getParam("to")->value().toInt(), false);
+    v.first = lo;
+    v.count = hi > lo ? hi - lo : 0;
+    return v;
+}
+
+// ---------- formatting ----------
+
+/**
+ * @brief Format one record as exactly SAMPLE_NDJSON_WIDTH bytes (space padded, '\n').
+ */
+static void formatSampleLine(const SampleRecord &r, char *line) {
+    int n;
+    if (r.flags & SAMPLE_LOST) {
+        n = snprintf(line, SAMPLE_NDJSON_WIDTH, "{\"lost\":true}");
+    } else {
+        char v[12], i[12], p[12];
+        formatFixed(v, sizeof(v), r.v_cV, 2, 2);
+        formatFixed(i, sizeof(i), r.i_cA, 2, 2);
+        formatFixed(p, sizeof(p), r.p_dW, 1, 2);
+        n = snprintf(line, SAMPLE_NDJSON_WIDTH, "{\"t\":%lu,\"v\":%s,\"i\":%s,\"p\":%s}",
+                     (unsigned long)r.t_s, v, i, p);
+    }
+    memset(line + n, ' ', SAMPLE_NDJSON_WIDTH - 1 - n);
+    line[SAMPLE_NDJSON_WIDTH - 1] = '\n';
+}
+
+/**
+ * @brief Copy body bytes [offset, offset + maxLen) of a fixed-width export into buf.
+ */
+static size_t fillSamples(const ExportView &v, uint8_t *buf, size_t maxLen, size_t offset) {
+    const size_t total = (size_t)v.count * SAMPLE_NDJSON_WIDTH;
+    SampleRecord recs[EXPORT_BATCH];
+    char line[SAMPLE_NDJSON_WIDTH + 1];
+    size_t w = 0;
+    while (w < maxLen && offset < total) {
+        uint32_t k = offset / SAMPLE_NDJSON_WIDTH;
+        size_t skip = offset % SAMPLE_NDJSON_WIDTH;
+        uint32_t n = (maxLen - w + skip) / SAMPLE_NDJSON_WIDTH + 1;
+        if (n > EXPORT_BATCH) n = EXPORT_BATCH;
+        if (n > v.count - k) n = v.count - k;
+        readRecords(v, v.first + k, n, recs);
+        for (uint32_t j = 0; j < n && w < maxLen; ++j) {
+            formatSampleLine(recs[j], line);
+            size_t len = min(SAMPLE_NDJSON_WIDTH - skip, maxLen - w);
+            memcpy(buf + w, line + skip, len);
+            w += len;
+            offset += len;
+            skip = 0;
+        }
+    }
+    return w;
+}
+
+// ---------- decimated graph data ----------
+
+#define LOD_BATCH 64
+
+/**
+ * @struct LodColumn
+ * @brief Running M4 aggregate of one pixel column; s[] = V, I, P in ring units.
+ */
+struct LodColumn {
+    int32_t col;
+    uint32_t n;
+    uint16_t first[3], lo[3], hi[3], last[3];
+};
+
+/**
+ * @struct LodState
+ * @brief Per-request state of a /data?width= stream (one pass over the records).
+ */
+struct LodState {
+    ExportView v;
+    uint32_t next;             // records read, relative to v.first
+    uint32_t from, to;         // time axis (s)
+    uint32_t oldest, newest;   // whole source (s), so clients can place the next axis
+    uint16_t width;
+    uint16_t minCol;           // first column sent (&col=), earlier ones the client already has
+    uint8_t stage;             // 0 header, 1 columns, 2 footer, 3 done
+    bool anyColumn;
+    LodColumn acc;             // acc.n == 0: nothing pending
+    SampleRecord batch[LOD_BATCH];
+    uint8_t batchLen, batchPos;
+    char pend[160];            // formatted text not yet copied out
+    uint8_t pendLen, pendOff;
+};
+
+static void lodAdd(LodColumn &c, int32_t col, const SampleRecord &r) {
+    const uint16_t val[3] = { r.v_cV, r.i_cA, r.p_dW };
+    if (c.n == 0) {
+        c.col = col;
+        for (int k = 0; k < 3; ++k) c.first[k] = c.lo[k] = c.hi[k] = val[k];
+    }
+    for (int k = 0; k < 3; ++k) {
+        if (val[k] < c.lo[k]) c.lo[k] = val[k];
+        if (val[k] > c.hi[k]) c.hi[k] = val[k];
+        c.last[k] = val[k];
+    }
+    c.n++;
+}
+
+static void lodFormatColumn(LodState &st) {
+    const LodColumn &c = st.acc;
+    int n = snprintf(st.pend, sizeof(st.pend), "%s[%ld,%lu", st.anyColumn ? "," : "",
+                     (long)c.col, (unsigned long)c.n);
+    for (int k = 0; k < 3; ++k) {
+        n += snprintf(st.pend + n, sizeof(st.pend) - n, ",%u,%u,%u,%u",
+                      c.first[k], c.lo[k], c.hi[k], c.last[k]);
+    }
+    n += snprintf(st.pend + n, sizeof(st.pend) - n, "]");
+    st.pendLen = (uint8_t)n;
+    st.anyColumn = true;
+    st.acc.n = 0;
+}
+
+/**
+ * @brief Consume records until a column closes (formatted into pend) or the budget runs out.
+ * @return false when the records are exhausted.
+ */
+static bool lodStep(LodState &st, uint32_t &budget) {
+    const uint32_t span = st.to - st.from + 1;
+    while (st.next < st.v.count || st.batchPos < st.batchLen) {
+        if (st.batchPos >= st.batchLen) {
+            if (!budget) return true;
+            uint32_t n = min((uint32_t)LOD_BATCH, st.v.count - st.next);
+            if (n > budget) n = budget;
+            readRecords(st.v, st.v.first + st.next, n, st.batch);
+            st.next += n;
+            budget -= n;
+            st.batchLen = (uint8_t)n;
+            st.batchPos = 0;
+        }
+        const SampleRecord &r = st.batch[st.batchPos++];
+        if ((r.flags & SAMPLE_LOST) || r.t_s < st.from || r.t_s > st.to) continue;
+        int32_t col = (int32_t)((uint64_t)(r.t_s - st.from) * st.width / span);
+        if (col < st.minCol) continue;
+        if (st.acc.n && col != st.acc.col) {
+            lodFormatColumn(st);
+            lodAdd(st.acc, col, r);
+            return true;
+        }
+        lodAdd(st.acc, col, r);
+    }
+    return false;
+}
+
+static size_t fillLod(LodState &st, uint8_t *buf, size_t maxLen) {
+    uint32_t budget = LOD_RECORDS_PER_FILL;
+    size_t w = 0;
+    while (w < maxLen) {
+        if (st.pendOff < st.pendLen) {
+            size_t len = min((size_t)(st.pendLen - st.pendOff), maxLen - w);
+            memcpy(buf + w, st.pend + st.pendOff, len);
+            st.pendOff += len;
+            w += len;
+            continue;
+        }
+        st.pendLen = st.pendOff = 0;
+        if (st.stage == 0) {
+            st.pendLen = (uint8_t)snprintf(st.pend, sizeof(st.pend),
+                "{\"src\":\"%s\",\"from\":%lu,\"to\":%lu,\"span\":[%lu,%lu],\"width\":%u,\"records\":%lu,"
+                "\"scale\":[100,100,10],\"cols\":[",
+                st.v.source == ExportSource::Ring ? "ring" : "history", (unsigned long)st.from,
+                (unsigned long)st.to, (unsigned long)st.oldest, (unsigned long)st.newest, st.width,
+                (unsigned long)st.v.count);
+            st.stage = 1;
+        } else if (st.stage == 1) {
+            if (lodStep(st, budget)) {
+                if (!st.pendLen) break; // budget spent inside a column
+            } else {
+                if (st.acc.n) lodFormatColumn(st);
+                st.stage = 2;
+            }
+        } else if (st.stage == 2) {
+            st.pendLen = (uint8_t)snprintf(st.pend, sizeof(st.pend), "]}");
+            st.stage = 3;
+        } else {
+            break;
+        }
+    }
+    // a chunked body ends on 0, so a callback that only consumed records sends
+    // a space (valid JSON whitespace) and gets called again
+    if (w == 0 && st.stage != 3) {
+        buf[0] = ' ';
+        return 1;
+    }
+    return w;
+}
+
+void sendDecimatedSamples(AsyncWebServerRequest *request) {
+    ExportSource s = request->hasParam("src") && request->getParam("src")->value() == "history"
+                   ? ExportSource::History : ExportSource::Ring;
+    ExportView v = resolveView(s, request);
+    int width = request->getParam("width")->value().toInt();
+    width = constrain(width, 1, LOD_MAX_WIDTH);
+
+    uint32_t newest = v.count ? recordTime(s, v.first + v.count - 1) : 0;
+    uint32_t from = v.count ? recordTime(s, v.first) : 0;
+    if (request->hasParam("last") && v.count) {
+        uint32_t last = request->getParam("last")->value().toInt();
+        from = newest > last ? newest - last : 0;
+        uint32_t lo = timeBound(s, v.first, v.first + v.count, from, true);
+        v.count -= lo - v.first;
+        v.first = lo;
+    }
+    if (request->hasParam("from")) from = request->getParam("from")->value().toInt();
+    uint32_t to = request->hasParam("to") ? (uint32_t)request->getParam("to")->value().toInt() : newest;
+    if (to < from) to = from;
+
+    // &col=c: only columns c.. (the dashboard's incremental update), so skip the
+    // records before the start of column c instead of binning them
+    int minCol = request->hasParam("col") ? request->getParam("col")->value().toInt() : 0;
+    minCol = constrain(minCol, 0, width);
+    if (minCol && v.count) {
+        uint64_t span = (uint64_t)(to - from) + 1;
+        uint32_t cut = from + (uint32_t)(((uint64_t)minCol * span + width - 1) / width);
+        uint32_t lo = timeBound(s, v.first, v.first + v.count, cut, true);
+        v.count -= lo - v.first;
+        v.first = lo;
+    }
+
+    // time span of the whole source, also for an empty view (from=1&to=0 probes it)
+    uint32_t begin = s == ExportSource::Ring ? ringOldest() : 0;
+    uint32_t end = s == ExportSource::Ring ? samplesWritten : historyCount();
+
+    std::shared_ptr<LodState> st(new (std::nothrow) LodState());
+    if (!st) {
+        request->send(503, "text/plain", "out of memory");
+        return;
+    }
+    st->v = v;
+    st->from = from;
+    st->to = to;
+    st->oldest = end > begin ? recordTime(s, begin) : 0;
+    st->newest = end > begin ? recordTime(s, end - 1) : 0;
+    st->width = (uint16_t)width;
+    st->minCol = (uint16_t)minCol;
+    AsyncWebServerResponse *response = request->beginChunkedResponse("application/json",
+        [st](uint8_t *buf, size_t maxLen, size_t) -> size_t { return fillLod(*st, buf, maxLen); });
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+}
+
+// ---------- ranged responses ----------
+
+/**
+ * @brief Parse a single "bytes=a-b" / "bytes=a-" / "bytes=-n" range.
+ * @return 0 = no (usable) Range header, 1 = range set, -1 = unsatisfiable.
+ */
+static int parseRange(AsyncWebServerRequest *request, size_t total, size_t &start, size_t &end) {
+    if (!request->hasHeader("Range")) return 0;
+    String r = request->getHeader("Range")->value();
+    if (!r.startsWith("bytes=") || r.indexOf(',') >= 0) return 0;
+    int dash = r.indexOf('-');
+    if (dash < 0) return 0;
+    String a = r.substring(6, dash), b = r.substring(dash + 1);
+    a.trim();
+    b.trim();
+    if (a.length() == 0) {
+        size_t suffix = (size_t)b.toInt();
+        if (suffix == 0 || total == 0) return -1;
+        start = suffix >= total ? 0 : total - suffix;
+        end = total - 1;
+        return 1;
+    }
+    start = (size_t)a.toInt();
+    end = b.length() ? (size_t)b.toInt() : total - 1;
+    if (start >= total || end < start) return -1;
+    if (end >= total) end = total - 1;
+    return 1;
+}
+
+/**
+ * @brief Send [0, total) or the requested range of a body produced by fill(buf, maxLen, offset).
+ * If-Range with a different ETag falls back to the full body.
+ */
+static void sendRanged(AsyncWebServerRequest *request, const char *contentType, const char *filename,
+                       size_t total, const String &etag,
+                       std::function<size_t(uint8_t*, size_t, size_t)> fill) {
+    size_t start = 0, end = total ? total - 1 : 0;
+    int range = parseRange(request, total, start, end);
+    if (range != 0 && request->hasHeader("If-Range") && request->getHeader("If-Range")->value() != etag) range = 0;
+    if (range < 0) {
+        AsyncWebServerResponse *response = request->beginResponse(416, "text/plain", "range not satisfiable");
+        response->addHeader("Content-Range", "bytes */" + String((unsigned long)total));
+        request->send(response);
+        return;
+    }
+    if (range == 0) { start = 0; end = total ? total - 1 : 0; }
+    size_t len = total ? end - start + 1 : 0;
+
+    AsyncWebServerResponse *response = request->beginResponse(contentType, len,
+        [fill, start, len](uint8_t *buf, size_t maxLen, size_t index) -> size_t {
+            if (index >= len) return 0;
+            if (maxLen > len - index) maxLen = len - index;
+            return fill(buf, maxLen, start + index);
+        });
+    if (range > 0) {
+        response->setCode(206);
+        response->addHeader("Content-Range", "bytes " + String((unsigned long)start) + "-" +
+                            String((unsigned long)end) + "/" + String((unsigned long)total));
+    }
+    response->addHeader("Accept-Ranges", "bytes");
+    response->addHeader("ETag", etag);
+    response->addHeader("Cache-Control", "no-cache");
+    response->addHeader("Content-Disposition", String("attachment; filename=\"") + filename + "\"");
+    request->send(response);
+}
+
+static void sendSamples(AsyncWebServerRequest *request, ExportSource s, const char *filename) {
+    ExportView v = resolveView(s, request);
+    // same view -> same ETag, so a resumed download can use If-Range
+    String etag = "\"" + String(s == ExportSource::Ring ? "r" : "h") + String((unsigned long)v.generation) + "-" +
+                  String((unsigned long)v.first) + "-" + String((unsigned long)v.count) + "\"";
+    sendRanged(request, "application/x-ndjson", filename, (size_t)v.count * SAMPLE_NDJSON_WIDTH, etag,
+               [v](uint8_t *buf, size_t maxLen, size_t offset) { return fillSamples(v, buf, maxLen, offset); });
+}
+
+void registerExportRoutes(AsyncWebServer &server) {
+    // whole CSV log straight from flash (all entries, not just the RAM FIFO)
+    server.on("/export/tests.csv", HTTP_GET, admitted("/export/tests.csv", AdmitClass::Heavy, [](AsyncWebServerRequest *request){
+        File f = LittleFS.exists(TEST_LOG_FILE) ? LittleFS.open(TEST_LOG_FILE, "r") : File();
+        size_t total = f ? f.size() : 0;
+        String etag = "\"t" + String((unsigned long)testLogGeneration) + "-" + String((unsigned long)total) + "\"";
+        sendRanged(request, "text/csv", "tests.csv", total, etag,
+                   [f](uint8_t *buf, size_t maxLen, size_t offset) mutable -> size_t {
+                       if (!f || !f.seek(offset, SeekSet)) return 0;
+                       return f.read(buf, maxLen);
+                   });
+    }));
+
+    server.on("/export/samples.ndjson", HTTP_GET, admitted("/export/samples.ndjson", AdmitClass::Heavy, [](AsyncWebServerRequest *request){
+        sendSamples(request, ExportSource::Ring, "samples.ndjson");
+    }));
+
+    server.on("/export/history.ndjson", HTTP_GET, admitted("/export/history.ndjson", AdmitClass::Heavy, [](AsyncWebServerRequest *request){
+        sendSamples(request, ExportSource::History, "history.ndjson");
+    }));
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "FZ35_Fixed.h"
+
+/**
+ * @file FZ35_Export.h
+ * @brief Streaming downloads of the test log and sample history. Bodies are produced
+ *        by filler callbacks into the TCP send buffer, a few records at a time, so a
+ *        multi-hour history is never held in RAM. Sample exports use fixed-width
+ *        NDJSON lines, which makes every byte offset map to a record: Content-Length
+ *        is known up front and single byte ranges (resumable downloads) are cheap.
+ *
+ * Sample sources:
+ *   ring    -> the in-RAM graph ring (last graphPoints samples)
+ *   history -> /history.bin, every sample of the current or last test (LittleFS)
+ *
+ * Graph data (/data?width=) is decimated per pixel column in one streaming pass:
+ * first/min/max/last of V, I and P for every column (M4), so the payload depends
+ * on the plot width rather than the time span, and spikes survive any zoom level.
+ */
+
+#define HISTORY_FILE          "/history.bin"
+#define HISTORY_MAGIC         0x53485A46UL // "FZHS"
+#define HISTORY_MAX_RECORDS   40000        // ~11 h at 1 Hz, 480 KB
+#define HISTORY_FLUSH_RECORDS 32           // RAM batch between flash appends
+#define SAMPLE_NDJSON_WIDTH   56           // bytes per exported line incl. '\n'
+#define LOD_MAX_WIDTH         2000         // columns per /data?width= response
+#define LOD_RECORDS_PER_FILL  256          // bounds the work per TCP send callback
+
+/**
+ * @struct SampleRecord
+ * @brief One stored sample, same units as the graph ring.
+ */
+struct SampleRecord {
+    uint32_t t_s;    // seconds since boot (history: the boot that started the test)
+    uint16_t v_cV;   // 0.01 V
+    uint16_t i_cA;   // 0.01 A
+    uint16_t p_dW;   // 0.1 W
+    uint16_t flags;  // SAMPLE_LOST on export when the record is no longer available
+};
+static_assert(sizeof(SampleRecord) == 12, "SampleRecord layout is part of the file format");
+#define SAMPLE_LOST 0x0001
+
+/**
+ * @struct HistoryHeader
+ * @brief File header; recordSize guards against layout changes.
+ */
+struct HistoryHeader {
+    uint32_t magic;
+    uint16_t recordSize;
+    uint16_t reserved;
+};
+
+// test history, driven from loop() at test start / per sample / test end
+void initHistory();
+void historyBegin(uint32_t from_s);
+void historyAppend(const SampleRecord &r);
+void historyResume(uint32_t now_s, uint32_t elapsed_s);
+void historyFlush();
+uint32_t historyCount();
+
+/**
+ * @brief Register /export/tests.csv, /export/samples.ndjson, /export/history.ndjson.
+ */
+void registerExportRoutes(AsyncWebServer &server);
+
+/**
+ * @brief /data?width=W[&from=&to=|&last=s][&src=history]: M4 columns over a time range.
+ */
+void sendDecimatedSamples(AsyncWebServerRequest *request);
@@ -0,0 +1,141 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @file FZ35_Fixed.h
+ * @brief Integer fixed-point helpers for the measurement path. The ESP8266 has no FPU,
+ *        so device decimals are parsed straight into milli-units (mV, mA, mAh, mW)
+ *        and formatted back to text without touching float. No Arduino dependency.
+ */
+
+/**
+ * @struct Measurement
+ * @brief Latest parsed sample in integer milli-units.
+ */
+struct Measurement {
+    int32_t voltage_mV;
+    int32_t current_mA;
+    int32_t capacity_mAh;
+    int32_t power_mW;   // voltage_mV * current_mA, rounded
+};
+
+static constexpr int32_t FIXED_POW10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000 };
+
+/**
+ * @brief Divide with rounding half away from zero.
+ */
+constexpr int64_t fixedRoundDivWide(int64_t num, int32_t den) {
+    if (num >= 0) return (num + den / 2) / den;
+    return -((-num + den / 2) / den);
+}
+constexpr int32_t fixedRoundDiv(int64_t num, int32_t den) {
+    return (int32_t)fixedRoundDivWide(num, den);
+}
+
+/**
+ * @brief Parse decimal text ("12.345", "-0.5", "3") into value * 10^scaleDigits.
+ * Extra fractional digits are rounded; surrounding non-numeric characters are skipped.
+ * @return false if no digit was found.
+ */
+inline bool parseFixed(const char *s, uint8_t scaleDigits, int32_t &out) {
+    while (*s && !(*s >= '0' && *s <= '9') && *s != '-' && *s != '.') ++s;
+    bool neg = false;
+    if (*s == '-') { neg = true; ++s; }
+
+    int64_t whole = 0;
+    bool any = false;
+    while (*s >= '0' && *s <= '9') {
+        whole = whole * 10 + (*s++ - '0');
+        any = true;
+        if (whole > 2000000000LL) return false;
+    }
+
+    int32_t frac = 0;
+    uint8_t fracDigits = 0;
+    bool roundUp = false;
+    if (*s == '.') {
+        ++s;
+        while (*s >= '0' && *s <= '9') {
+            if (fracDigits < scaleDigits) {
+                frac = frac * 10 + (*s - '0');
+                fracDigits++;
+            } else if (fracDigits == scaleDigits) {
+                roundUp = (*s >= '5');
+                fracDigits++; // only the first dropped digit decides rounding
+            }
+            ++s;
+            any = true;
+        }
+    }
+    if (!any) return false;
+
+    if (fracDigits > scaleDigits) fracDigits = scaleDigits;
+    int64_t v = whole * FIXED_POW10[scaleDigits] + (int64_t)frac * FIXED_POW10[scaleDigits - fracDigits];
+    if (roundUp) v++;
+    if (v > INT32_MAX) return false;
+    out = neg ? -(int32_t)v : (int32_t)v;
+    return true;
+}
+
+/**
+ * @brief Parse decimal text into milli-units (V -> mV, A -> mA, Ah -> mAh).
+ */
+inline bool parseMilli(const char *s, int32_t &out) {
+    return parseFixed(s, 3, out);
+}
+
+/**
+ * @brief Format value (real * 10^scaleDigits) with a fixed number of decimals.
+ * Rounds half away from zero when decimals < scaleDigits, zero-pads otherwise.
+ * @return Characters written (excluding terminator); buffer is always terminated.
+ * constexpr so profile payloads can be formatted at compile time (FZ35_Profiles.h).
+ */
+constexpr size_t formatFixed(char *buf, size_t len, int64_t value, uint8_t scaleDigits, uint8_t decimals) {
+    if (len == 0) return 0;
+    int64_t v = value;
+    if (decimals < scaleDigits) v = fixedRoundDivWide(v, FIXED_POW10[scaleDigits - decimals]);
+    else v *= FIXED_POW10[decimals - scaleDigits];
+
+    char tmp[24] = {};
+    size_t n = 0;
+    bool neg = v < 0;
+    uint64_t u = neg ? (uint64_t)(-v) : (uint64_t)v;
+    for (uint8_t d = 0; d < decimals; ++d) { tmp[n++] = (char)('0' + u % 10); u /= 10; }
+    if (decimals) tmp[n++] = '.';
+    do { tmp[n++] = (char)('0' + u % 10); u /= 10; } while (u);
+    if (neg) tmp[n++] = '-';
+
+    size_t w = 0;
+    while (n && w + 1 < len) buf[w++] = tmp[--n];
+    buf[w] = '\0';
+    return w;
+}
+
+/**
+ * @brief Format milli-units with the given number of decimals (e.g. 12345 mV, 2 -> "12.35").
+ */
+constexpr size_t formatMilli(char *buf, size_t len, int32_t milli, uint8_t decimals) {
+    return formatFixed(buf, len, milli, 3, decimals);
+}
+
+/**
+ * @brief Product of two milli-unit values in milli-units (mV * mA -> mW).
+ * For display, format the exact product (scale 6) instead to avoid double rounding.
+ */
+inline int32_t mulMilli(int32_t a, int32_t b) {
+    return fixedRoundDiv((int64_t)a * b, 1000);
+}
+
+/**
+ * @brief Sample ring units: V / A in 0.01 from milli-units, W in 0.1 from the exact
+ *        mV * mA product (rounding power_mW again would round twice). Clamped to uint16_t.
+ */
+inline uint16_t ringCenti(int32_t milli) {
+    int32_t v = fixedRoundDiv(milli, 10);
+    return (uint16_t)(v < 0 ? 0 : v > 65535 ? 65535 : v);
+}
+inline uint16_t ringPowerDeci(const Measurement &m) {
+    int64_t v = fixedRoundDivWide((int64_t)m.voltage_mV * m.current_mA, 100000);
+    return (uint16_t)(v < 0 ? 0 : v > 65535 ? 65535 : v);
+}
@@ -3,35 +3,18 @@
 
 /**
  * @file FZ35_Graph.h
- * @brief Ring buffer storage for recent measurement samples (voltage/current/power).
- * GRAPH_POINTS defines capacity; addGraphPoint advances index circularly.
+ * @brief Sizing of the in-RAM sample ring (voltage/current/power/timestamp).
+ * The ring is allocated at the end of setup() from the heap that is left once
+ * WiFi, the web server and the logs are up; graphPoints holds the result.
  */
 
-// 5-minute buffer: at ~300 ms sample => 5*60*1000 / 300 = 1000 samples
-#define GRAPH_POINTS 1000
+// bytes per ring slot: V, I, P (uint16_t, scaled) + timestamp (uint32_t)
+#define GRAPH_POINT_BYTES  10
+// bounds: 200 samples keeps the graph useful, 3600 = 1 h at 1 Hz
+#define GRAPH_POINTS_MIN   200
+#define GRAPH_POINTS_MAX   3600
+// heap left for async web requests, TCP buffers and LittleFS after the ring
+#define GRAPH_HEAP_RESERVE 20000
 
-/**
- * @struct GraphData
- * @brief Holds circular arrays for plotting plus current write index.
- */
-struct GraphData {
-    float voltage[GRAPH_POINTS];
-    float current[GRAPH_POINTS];
-    float power[GRAPH_POINTS];
-    int idx;
-};
-
-extern GraphData graph;
-
-/**
- * @brief Push one sample into the ring buffer.
- * @param v Voltage (V)
- * @param i Current (A)
- * @param p Power (W)
- */
-void addGraphPoint(float v, float i, float p){
-    graph.voltage[graph.idx] = v;
-    graph.current[graph.idx] = i;
-    graph.power[graph.idx] = p;
-    graph.idx = (graph.idx + 1) % GRAPH_POINTS;
-}
+// capacity of the ring in samples (0 until allocated)
+extern int graphPoints;
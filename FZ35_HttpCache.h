@@ -0,0 +1,63 @@
+#pragma once
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+
+/**
+ * @file FZ35_HttpCache.h
+ * @brief Memoized JSON responses for rarely-changing endpoints. A body is rebuilt only
+ *        when the owning module's generation counter moves; clients revalidate with
+ *        If-None-Match and get a bodiless 304 while nothing changed.
+ */
+
+// "%08x-%x-%x" with its quotes: 2 + 8 + 1 + 8 + 1 + 8 characters and the terminator
+#define HTTP_CACHE_ETAG_LEN 32
+static_assert(HTTP_CACHE_ETAG_LEN >= 2 + 8 + 1 + 8 + 1 + 8 + 1, "ETag buffer too small for its format");
+
+/**
+ * @struct CachedResponse
+ * @brief One memoized body plus the generation it was built for.
+ */
+struct CachedResponse {
+    bool valid;
+    uint32_t generation;
+    uint32_t variant;      // request parameters folded into the key (e.g. page)
+    String body;
+    char etag[HTTP_CACHE_ETAG_LEN];
+};
+
+/**
+ * @brief Per-boot salt so ETags from before a reboot never match a fresh counter.
+ */
+inline uint32_t httpCacheBootId() {
+    static uint32_t id = ESP.random();
+    return id;
+}
+
+/**
+ * @brief Serve cache (rebuilding via build() if stale) with ETag / 304 handling.
+ * @param generation Current generation of the underlying data.
+ * @param variant Request parameters the body depends on (0 if none).
+ */
+template <typename Builder>
+inline void sendCachedJson(AsyncWebServerRequest *request, CachedResponse &cache,
+                           uint32_t generation, uint32_t variant, Builder build) {
+    if (!cache.valid || cache.generation != generation || cache.variant != variant) {
+        cache.body = build();
+        cache.generation = generation;
+        cache.variant = variant;
+        cache.valid = true;
+        snprintf(cache.etag, sizeof(cache.etag), "\"%08x-%x-%x\"",
+                 (unsigned)httpCacheBootId(), (unsigned)generation, (unsigned)variant);
+    }
+
+    AsyncWebServerResponse *response;
+    if (request->hasHeader("If-None-Match") &&
+        request->getHeader("If-None-Match")->value() == cache.etag) {
+        response = request->beginResponse(304);
+    } else {
+        response = request->beginResponse(200, "application/json", cache.body);
+    }
+    response->addHeader("ETag", cache.etag);
+    response->addHeader("Cache-Control", "no-cache"); // always revalidate
+    request->send(response);
+}
@@ -4,13 +4,28 @@
 #include <DNSServer.h>
 #include <time.h> // NEW: for NTP time
 
-// Ensure GRAPH_POINTS and graph-related declarations are available before WebUI includes
+// Ensure graphPoints and graph-related declarations are available before WebUI includes
 #include "FZ35_Graph.h"
+#include "FZ35_Memory.h"
+#include "FZ35_Fixed.h"
+#include "FZ35_Stats.h"
+#include "FZ35_Predict.h"
 #include "FZ35_Battery.h"
+#include "FZ35_Dcir.h"
 #include "FZ35_WebUI.h"
 #include "FZ35_Comm.h"
 #include "FZ35_WiFi.h"
 #include "FZ35_TestLog.h"
+#include "FZ35_ProfileStore.h"
+#include "FZ35_Program.h"
+#include "FZ35_Export.h"
+#include "FZ35_Admission.h"
+#include "FZ35_Telemetry.h"
+#include "FZ35_Checkpoint.h"
+#include "FZ35_CmdBatch.h"
+#include "FZ35_Trace.h"
+#include "FZ35_Channel.h"
+#include "FZ35_Estop.h"
 
 #define RX_PIN 15
 #define TX_PIN 13
@@ -19,21 +34,14 @@ SoftwareSerial fzSerial(RX_PIN, TX_PIN);
 AsyncWebServer server(80);
 DNSServer dns;
 
-String voltage="0", current="0", power="0", capacityAh="0", energyWh="0", status="UNKNOWN";
-String OVP = "", OCP = "", OPP = "", LVP = "", OAH = "", OHP = "";
-// NEW: recommended test load current (formatted x.xx)
-String TEST_LOAD = "";
+// live values (voltage, ..., OVP, ..., TEST_LOAD, meas) and test state of the load on
+// fzSerial are channel 0's (FZ35_Channel.h), under their old names
 
 // Device command strings for enabling/disabling the load.
 // Replace these placeholder strings with the exact commands from the PDF manual.
 String LOAD_ENABLE_CMD  = "on";   // <<-- set exact command from PDF
 String LOAD_DISABLE_CMD = "off";  // <<-- set exact command from PDF
 
-// define buffers once here using GRAPH_POINTS from FZ35_Graph.h
-float voltageBuffer[GRAPH_POINTS];
-float currentBuffer[GRAPH_POINTS];
-float powerBuffer[GRAPH_POINTS];
-
 // remove static large arrays and use heap-allocated buffers
 uint16_t *voltageBufScaled = nullptr;
 uint16_t *currentBufScaled = nullptr;
@@ -41,21 +49,31 @@ uint16_t *powerBufScaled   = nullptr;
 // new: timestamps (seconds since boot) for each sample
 uint32_t *timestampBuf     = nullptr;
 int graphIndex = 0;
+// ring capacity, sized at boot by allocateSampleRing()
+int graphPoints = 0;
 
-// new: how many samples we actually have (0..GRAPH_POINTS)
+// new: how many samples we actually have (0..graphPoints)
 int samplesStored = 0;
+// samples written since boot (absolute numbering for /export)
+uint32_t samplesWritten = 0;
 
 unsigned long lastRead = 0;
 // sample interval (ms) — set to fastest practical (matches sendCommand timeout)
 const unsigned long readInterval = 1000;
 
+// typical duration of one blocking readFZ35() (EMA), used to keep reads clear of
+// program deadlines; a program may defer reads for at most PROGRAM_MAX_READ_DEFER_MS
+unsigned long readDurationMs = 300;
+
 // new: track if we're applying battery profile (don't read during apply)
 unsigned long lastBatteryApply = 0;
 
-// NEW: track if test is running
-bool testInProgress = false;
-unsigned long testStartTime = 0;
-String currentTestBattery = "";
+// wall clock at test start (0 if not synced); checkpoints survive resets, millis() does not
+uint32_t testStartEpoch = 0;
+// end-of-test estimate, fed with every sample while a test runs
+EndPredictor endPredictor;
+// test time covered only by failed reads (kept in the checkpoint)
+uint32_t testStaleMs = 0;
 
 // NEW: NTP configuration
 #define NTP_SERVER1 "pool.ntp.org"
@@ -63,9 +81,47 @@ String currentTestBattery = "";
 #define GMT_OFFSET_SEC 0           // Adjust for your timezone (e.g., -18000 for EST, 3600 for CET)
 #define DAYLIGHT_OFFSET_SEC 3600      // Adjust for DST if needed
 
+static void freeSampleRing() {
+    free(voltageBufScaled); voltageBufScaled = nullptr;
+    free(currentBufScaled); currentBufScaled = nullptr;
+    free(powerBufScaled);   powerBufScaled = nullptr;
+    free(timestampBuf);     timestampBuf = nullptr;
+}
+
+/**
+ * @brief Size the sample ring from the free heap (minus GRAPH_HEAP_RESERVE), clamped to
+ * [GRAPH_POINTS_MIN, GRAPH_POINTS_MAX]. Falls back to smaller sizes if the heap is too
+ * fragmented for four blocks of the computed size.
+ */
+bool allocateSampleRing() {
+    uint32_t freeHeap = ESP.getFreeHeap();
+    int points = freeHeap > GRAPH_HEAP_RESERVE ? (int)((freeHeap - GRAPH_HEAP_RESERVE) / GRAPH_POINT_BYTES) : 0;
+    points = constrain(points, GRAPH_POINTS_MIN, GRAPH_POINTS_MAX);
+
+    for (;;) {
+        voltageBufScaled = (uint16_t*)calloc(points, sizeof(uint16_t));
+        currentBufScaled = (uint16_t*)calloc(points, sizeof(uint16_t));
+        powerBufScaled   = (uint16_t*)calloc(points, sizeof(uint16_t));
+        timestampBuf     = (uint32_t*)calloc(points, sizeof(uint32_t));
+        if (voltageBufScaled && currentBufScaled && powerBufScaled && timestampBuf) break;
+        freeSampleRing();
+        if (points == GRAPH_POINTS_MIN) break;
+        // halve, but the last attempt is the minimum size itself
+        points = points / 2 < GRAPH_POINTS_MIN ? GRAPH_POINTS_MIN : points / 2;
+    }
+    if (!timestampBuf) return false;
+
+    graphPoints = points;
+    graphIndex = 0;
+    memRegister("Graph", "sample ring", MemKind::Heap, (uint32_t)points * GRAPH_POINT_BYTES);
+    Serial.printf("Sample ring: %d points (%u bytes, free heap was %u)\n",
+                  points, (unsigned)(points * GRAPH_POINT_BYTES), (unsigned)freeHeap);
+    return true;
+}
+
 /**
  * @file FZ35_Lab.ino
- * @brief Main entry: initializes serial, WiFi captive portal, web UI, NTP time,
+ * @brief Main entry: initializes serial, background WiFi, web UI, NTP time,
  *        allocates sample buffers, handles periodic read + graph update,
  *        manages automatic test start/finish and logging.
  */
@@ -73,33 +129,26 @@ String currentTestBattery = "";
 void setup() {
     Serial.begin(115200);
     fzSerial.begin(9600);
+    initChannels();
     delay(2000);
     Serial.println("\n[XY-FZ35 Lab] Starting...");
+    memMark("boot");
 
-    // allocate scaled buffers on the heap
-    size_t points = GRAPH_POINTS;
-    voltageBufScaled = (uint16_t*)calloc(points, sizeof(uint16_t));
-    currentBufScaled = (uint16_t*)calloc(points, sizeof(uint16_t));
-    powerBufScaled   = (uint16_t*)calloc(points, sizeof(uint16_t));
-    timestampBuf     = (uint32_t*)calloc(points, sizeof(uint32_t));
-
-    if (!voltageBufScaled || !currentBufScaled || !powerBufScaled || !timestampBuf) {
-        Serial.println("ERROR: buffer allocation failed. Reduce GRAPH_POINTS.");
-        while(true) { delay(1000); } // halt for debug
-    }
-
-    // WiFi + Web Server
-    setupWiFi(server, dns);
+    // WiFi connects in the background (fallback AP without stored credentials)
+    setupWiFi(dns);
+    memMark("wifi");
     
     // NEW: Configure and sync NTP time
     Serial.println("Configuring time via NTP...");
     configTime(GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, NTP_SERVER1, NTP_SERVER2);
     
-    // Wait for time to be set (up to 10 seconds)
+    // Wait for time to be set (up to 10 seconds, while the first attempt runs); SNTP
+    // keeps trying and sets the clock whenever the network comes up
     int ntpRetries = 0;
-    while (time(nullptr) < 100000 && ntpRetries < 20) {
+    while (wifiHasCredentials() && time(nullptr) < 100000 && ntpRetries < 20) {
         Serial.print(".");
         delay(500);
+        wifiTick();
         ntpRetries++;
     }
     Serial.println();
@@ -109,15 +158,27 @@ void setup() {
         Serial.println("Time synchronized successfully!");
         Serial.println(ctime(&now));
     } else {
-        Serial.println("Warning: NTP sync failed, timestamps will be incorrect");
+        Serial.println("Warning: NTP not synced yet, timestamps are wrong until it is");
     }
     
-    setupWebServer(server);
+    setupWebUI();
+    memMark("webui");
 
     // NEW: initialize test log after time sync
     initTestLog();
-    
-    graphIndex = 0;
+    initProfileStore(); // LittleFS mounted by initTestLog()
+    initHistory();
+    initTelemetry();
+    initCheckpoint(); // an interrupted test is resolved on the first reading
+    memMark("logs");
+
+    // the sample ring takes what is left; everything else is allocated by now
+    if (!allocateSampleRing()) {
+        Serial.println("ERROR: sample ring allocation failed.");
+        while(true) { delay(1000); } // halt for debug
+    }
+    memMark("ring");
+    memPrintMap();
     
     // No auto-start here; user must either:
     // 1. Select a battery profile (which sends start), or
@@ -126,35 +187,41 @@ void setup() {
 
 /**
  * @brief Capture latest sample, translate into scaled buffers (for graph / JSON).
+ * Integer only: V/I stored in 0.01 units, P in 0.1 W units.
  */
-void updateGraphBuffersScaled(float v, float i, float p) {
+void updateGraphBuffersScaled(const Measurement &m) {
     if (!voltageBufScaled) return;
-    uint16_t vs = (uint16_t)constrain((int)roundf(v * 100.0f), 0, 65535);
-    uint16_t cs = (uint16_t)constrain((int)roundf(i * 100.0f), 0, 65535);
-    uint16_t ps = (uint16_t)constrain((int)roundf(p * 10.0f), 0, 65535);
+    uint16_t vs = ringCenti(m.voltage_mV);
+    uint16_t cs = ringCenti(m.current_mA);
+    uint16_t ps = ringPowerDeci(m);
     voltageBufScaled[graphIndex] = vs;
     currentBufScaled[graphIndex] = cs;
     powerBufScaled[graphIndex]   = ps;
     timestampBuf[graphIndex]     = (uint32_t)(millis() / 1000UL); // seconds
 
-    // increment stored count up to GRAPH_POINTS
-    if (samplesStored < GRAPH_POINTS) samplesStored++;
+    // increment stored count up to graphPoints
+    if (samplesStored < graphPoints) samplesStored++;
+    samplesWritten++;
 
-    graphIndex = (graphIndex + 1) % GRAPH_POINTS;
+    graphIndex = (graphIndex + 1) % graphPoints;
 }
 
-// accessors required by WebUI
-float scaledVoltageAt(int idx) {
-    if (!voltageBufScaled) return 0.0f;
-    return voltageBufScaled[idx] / 100.0f;
+int sampleSlot(uint32_t seq) {
+    return seq % graphPoints;
 }
-float scaledCurrentAt(int idx) {
-    if (!currentBufScaled) return 0.0f;
-    return currentBufScaled[idx] / 100.0f;
+
+// accessors required by WebUI (raw scaled units, see updateGraphBuffersScaled)
+uint16_t scaledVoltageAt(int idx) {
+    if (!voltageBufScaled) return 0;
+    return voltageBufScaled[idx];
+}
+uint16_t scaledCurrentAt(int idx) {
+    if (!currentBufScaled) return 0;
+    return currentBufScaled[idx];
 }
-float scaledPowerAt(int idx) {
-    if (!powerBufScaled) return 0.0f;
-    return powerBufScaled[idx] / 10.0f;
+uint16_t scaledPowerAt(int idx) {
+    if (!powerBufScaled) return 0;
+    return powerBufScaled[idx];
 }
 uint32_t sampleTimestampAt(int idx) {
     if (!timestampBuf) return 0;
@@ -162,101 +229,88 @@ uint32_t sampleTimestampAt(int idx) {
 }
 
 /**
- * @brief Device parse callback. Extracts protection values and live CSV measurement line.
+ * @brief Append a checkpoint of the running test (FZ35_Checkpoint.h).
  */
-void parseFZ35(const String &lineIn) {
-    String s = lineIn;
-    s.trim();
-    if (s.length() == 0) return;
-
-    Serial.printf("Parsing line: \"%s\"\n", s.c_str());
-    bool parsedSummary = false;
-    bool parsedCSV = false;
-
-    auto extractNumber = [](const String &tok)->String {
-        String out;
-        for (size_t i=0;i<tok.length();++i) {
-            char c = tok.charAt(i);
-            if ((c >= '0' && c <= '9') || c == '.' || c == '-' ) out += c;
-        }
-        out.trim();
-        return out;
-    };
-
-    // summary tokens (OVP:, OCP:, OPP:, LVP:, OAH:, OHP:)
-    if (s.indexOf("OVP:") >= 0 || s.indexOf("OCP:") >= 0 || s.indexOf("OPP:") >= 0) {
-        int pos = 0;
-        while (pos < s.length()) {
-            int comma = s.indexOf(',', pos);
-            if (comma < 0) comma = s.length();
-            String token = s.substring(pos, comma);
-            token.trim();
-            int colon = token.indexOf(':');
-            if (colon > 0) {
-                String key = token.substring(0, colon);
-                String val = token.substring(colon + 1);
-                key.trim(); val.trim();
-                for (size_t k=0;k<key.length();++k) key.setCharAt(k, toupper(key.charAt(k)));
-                if (key == "OVP") OVP = val;
-                else if (key == "OCP") OCP = val;
-                else if (key == "OPP") OPP = val;
-                else if (key == "LVP") LVP = val;
-                else if (key == "OAH") OAH = val;
-                else if (key == "OHP") OHP = val;
-            }
-            pos = comma + 1;
-        }
-        parsedSummary = true;
-        Serial.println("Parsed summary parameters.");
-    }
+static void checkpointTest(CheckpointKind kind) {
+    TestCheckpoint cp = {};
+    time_t now = time(nullptr);
+    cp.batteryId = activeBatteryIdx;
+    cp.startEpoch = testStartEpoch;
+    cp.epoch = now > 100000 ? (uint32_t)now : 0;
+    cp.elapsedMs = millis() - testStartTime;
+    cp.capacity_mAh = meas.capacity_mAh;
+    cp.stale_s = testStaleMs / 1000 > 0xFFFF ? 0xFFFF : (uint16_t)(testStaleMs / 1000);
+    strncpy(cp.battery, currentTestBattery.c_str(), sizeof(cp.battery) - 1);
+    cp.stats = testStats;
+    cp.stats.startMs -= testStartTime;
+    cp.stats.lastMs -= testStartTime;
+    checkpointWrite(kind, cp);
+}
 
-    // CSV measurement: look for V, A and Ah tokens (keep previous values if not present)
-    if ((s.indexOf('V') >= 0) && (s.indexOf('A') >= 0) && (s.indexOf("Ah") >= 0)) {
-        int pos = 0;
-        while (pos < s.length()) {
-            int comma = s.indexOf(',', pos);
-            if (comma < 0) comma = s.length();
-            String tok = s.substring(pos, comma);
-            tok.trim();
-            if (tok.length() > 0) {
-                String lowerTok = tok;
-                lowerTok.toLowerCase();
-                if (lowerTok.endsWith("ah")) {
-                    String num = extractNumber(tok);
-                    if (num.length()) capacityAh = num;
-                } else if (lowerTok.endsWith("v")) {
-                    String num = extractNumber(tok);
-                    if (num.length()) voltage = num;
-                } else if (lowerTok.endsWith("a")) {
-                    // exclude 'ah' case (already handled)
-                    if (! (lowerTok.endsWith("ah")) ) {
-                        String num = extractNumber(tok);
-                        if (num.length()) current = num;
-                    }
-                } else {
-                    // fallback: treat as time string
-                    energyWh = tok;
-                }
-            }
-            pos = comma + 1;
-        }
-        // compute power from latest numeric values
-        float vf = voltage.toFloat();
-        float cf = current.toFloat();
-        power = String(vf * cf, 2);
-        parsedCSV = true;
-        Serial.println("Parsed CSV measurement.");
+/**
+ * @brief A reset interrupted a test: resume it if the load still draws current, else
+ * log it from the last checkpoint. The FZ35 keeps discharging (and counting Ah) while
+ * the ESP restarts, so the device counter covers the gap. Waits up to
+ * CHECKPOINT_RESOLVE_MS for a reading; without one the test is logged as checkpointed.
+ */
+static void resolveInterruptedTest() {
+    static uint32_t firstTry = millis();
+    const TestCheckpoint &cp = *checkpointInterrupted();
+    bool valid = meas.voltage_mV > 0;
+    if (!valid && millis() - firstTry < CHECKPOINT_RESOLVE_MS) return;
+
+    // a smaller counter means the load itself was reset: keep the checkpointed value
+    int32_t cap = meas.capacity_mAh > cp.capacity_mAh ? meas.capacity_mAh : cp.capacity_mAh;
+    time_t nowEpoch = time(nullptr);
+    uint32_t gapMs = cp.epoch && nowEpoch > (time_t)cp.epoch ? (uint32_t)(nowEpoch - cp.epoch) * 1000 : 0;
+
+    if (!valid || meas.current_mA <= 50) {
+        // ended during the reset (or the load is gone); duration up to the last record
+        if (cap > 1) saveTestResult(cp.battery, cap / 1000.0f, cp.elapsedMs / 3600000.0f);
+        TestCheckpoint end = cp;
+        end.capacity_mAh = cap;
+        end.epoch = nowEpoch > 100000 ? (uint32_t)nowEpoch : 0;
+        checkpointWrite(CHECKPOINT_END, end);
+        checkpointResolved(false);
+        Serial.printf("Interrupted test logged: %s, %ld mAh in %lu s\n",
+                      cp.battery, (long)cap, (unsigned long)(cp.elapsedMs / 1000));
+        return;
     }
 
-    if (!parsedSummary && !parsedCSV) {
-        Serial.println("Line not recognized, ignored.");
+    uint32_t now = millis();
+    testInProgress = true;
+    testStartTime = now - (cp.elapsedMs + gapMs);
+    testStartEpoch = cp.startEpoch;
+    currentTestBattery = String(cp.battery);
+    // the load still holds the profile's settings: restore the selection without re-sending it
+    if (getBatteryName(cp.batteryId) == currentTestBattery && setActiveBattery(cp.batteryId)) {
+        pendingBatteryIdx = -1;
     }
 
-    // status remains whatever logic sets it elsewhere; don't zero fields here
-    Serial.printf("== Parsed Data ==\nOVP=%s OCP=%s OPP=%s LVP=%s OAH=%s OHP=%s\n",
-                  OVP.c_str(), OCP.c_str(), OPP.c_str(), LVP.c_str(), OAH.c_str(), OHP.c_str());
-    Serial.printf("meas V=%s I=%s Ah=%s T=%s P=%s STATUS=%s\n",
-                  voltage.c_str(), current.c_str(), capacityAh.c_str(), energyWh.c_str(), power.c_str(), status.c_str());
+    testStats = cp.stats;
+    testStats.startMs += testStartTime;
+    testStaleMs = cp.stale_s * 1000UL;
+    // the gap: charge from the device counter, energy at the mean of both voltages
+    uint64_t gapCharge_mAms = (uint64_t)(cap - cp.capacity_mAh) * 3600000ULL;
+    int32_t lastV = testStats.lastCurrent_mA > 0
+        ? (int32_t)((int64_t)testStats.lastPower_mW * 1000 / testStats.lastCurrent_mA) : meas.voltage_mV;
+    testStats.charge_mAms += gapCharge_mAms;
+    testStats.energy_mWms += gapCharge_mAms * (uint32_t)((lastV + meas.voltage_mV) / 2) / 1000;
+    testStats.lastMs = now;
+    testStats.lastPower_mW = meas.power_mW;
+    testStats.lastCurrent_mA = meas.current_mA;
+
+    const BatteryModule &b = activeBattery();
+    PredictLimits limits = { toMilli(b.lowVoltageProtect), toMilli(b.overAhLimit),
+                             predictParseHourLimit(b.overHourLimit), toMilli(b.capacityAh) };
+    predictReset(endPredictor, limits, meas, testStartTime);
+    // /history.bin is kept: samples continue after the gap, on its time base
+    historyResume(now / 1000, (now - testStartTime) / 1000);
+    checkpointTest(CHECKPOINT_RESUME);
+    checkpointResolved(true);
+    Serial.printf("Test resumed: %s after %lu s (gap %lu s, +%ld mAh)\n", cp.battery,
+                  (unsigned long)(cp.elapsedMs / 1000), (unsigned long)(gapMs / 1000),
+                  (long)(cap - cp.capacity_mAh));
 }
 
 /**
@@ -264,42 +318,141 @@ void parseFZ35(const String &lineIn) {
  *        test start/end for logging.
  */
 void loop() {
+    TraceScope trace("loop", TRACE_TID_LOOP, 0, TRACE_LOOP_MIN_US);
+    // a sequence cut short by an emergency stop has unwound: the loads take commands again
+    estopRelease();
+    // timed program load changes first: they have hard deadlines
+    programTick();
+    // serial capture: move the RAM batch to flash between device transactions
+    captureFlush();
+    // telemetry: close due batches, reconnect, send the oldest queued batch
+    telemetryTick();
+    // other loads: collect answers, send due reads (never blocks on a read)
+    channelsTick();
+    // WiFi: poll the station, retry with backoff, fallback AP (never blocks)
+    wifiTick();
+
     // check if battery profile is being applied
     if (pendingBatteryIdx >= 0) {
+        if (programActive()) stopProgram("profile change");
         processPendingBattery(); // sends stop, applies params, sends start
         lastBatteryApply = millis();
-        delay(500);
+        estopDelay(500);
+        return;
+    }
+
+    // DCIR step sequence owns the serial link while it runs
+    if (dcirPending()) {
+        processPendingDcir();
+        lastRead = millis();
         return;
     }
 
+    // so does a queued command batch (one pass, no reads in between)
+    if (cmdBatchPending()) {
+        processPendingCmdBatch();
+        lastRead = millis();
+        return;
+    }
+
+    // a /cmd operation for this load (queued by the handler, like the other channels)
+    if (channels[0].pendingCmd.length()) {
+        sendCommandNoNL(channels[0].pendingCmd);
+        channels[0].pendingCmd = String();
+    }
+
     // don't read if we just applied battery settings
     if (millis() - lastBatteryApply < 2000) {
         return;
     }
 
     if (millis() - lastRead > readInterval) {
+        // a blocking read must not overrun the next program event (bounded deferral)
+        if (programMsUntilNextEvent() < readDurationMs + PROGRAM_READ_MARGIN_MS &&
+            millis() - lastRead < PROGRAM_MAX_READ_DEFER_MS) {
+            programNoteDeferredRead(lastRead);
+            return;
+        }
+        // reads of the other loads due while this one blocks go out first
+        channelsTick(readDurationMs);
+        unsigned long readStart = millis();
+        long lateMs = (long)(readStart - lastRead) - (long)readInterval;
+        uint32_t csvBefore = channels[0].csvLines;
         readFZ35();
-        updateGraphBuffersScaled(voltage.toFloat(), current.toFloat(), power.toFloat());
+        bool fresh = channels[0].csvLines != csvBefore;
+        admissionNoteRead(lateMs, millis() - readStart);
+        wifiNoteRead(readStart, readInterval);
+        readDurationMs = (readDurationMs * 3 + (millis() - readStart)) / 4;
+
+        // a failed read leaves the previous values: flag it stale for the detector and
+        // record nothing (no repeated sample in the graph, history, stats or programs)
+        DetectRead dr = { (uint32_t)millis(), meas.current_mA, meas.capacity_mAh, fresh };
+        DetectResult ev;
+        detectAddRead(channels[0].detect, dr, testInProgress, ev);
+        if (!fresh) {
+            channels[0].timeouts++;
+            // the test runs on without samples: count the time, keep checkpointing
+            if (testInProgress) {
+                testStaleMs += millis() - lastRead;
+                if (checkpointDue(millis())) checkpointTest(CHECKPOINT_PROGRESS);
+            }
+            lastRead = millis();
+            return;
+        }
+        channelNoteSample(channels[0], readStart, millis());
+        updateGraphBuffersScaled(meas);
+        programOnSample(meas);
         
-        // NEW: check if test just started
-        float measI = current.toFloat();
-        if (measI > 0.05f && !testInProgress) {
+        // a test interrupted by a reset is resumed or logged before a new one can start
+        if (checkpointInterrupted()) resolveInterruptedTest();
+
+        // test start / end come filtered and dated to their first read (FZ35_Detect.h)
+        if (ev.event == DetectEvent::Start && !testInProgress && !checkpointInterrupted()) {
+            uint32_t now = millis();
             testInProgress = true;
-            testStartTime = millis();
-            extern BatteryModule currentBattery;
-            currentTestBattery = String(currentBattery.name);
-            Serial.println("Test started: " + currentTestBattery);
+            // everything dated to the first read of the run; the integrators start at this
+            // read, the device's own Ah counter (the logged capacity) covers the run before
+            testStartTime = ev.atMs;
+            testStaleMs = 0;
+            statsReset(testStats, ev.atMs);
+            const BatteryModule &b = activeBattery();
+            PredictLimits limits = { toMilli(b.lowVoltageProtect), toMilli(b.overAhLimit),
+                                     predictParseHourLimit(b.overHourLimit), toMilli(b.capacityAh) };
+            predictReset(endPredictor, limits, meas, testStartTime);
+            historyBegin(ev.atMs / 1000);
+            currentTestBattery = String(activeBattery().name);
+            time_t startEpoch = time(nullptr);
+            testStartEpoch = startEpoch > 100000 ? (uint32_t)startEpoch - (now - ev.atMs) / 1000 : 0;
+            checkpointTest(CHECKPOINT_BEGIN);
+            Serial.printf("Test started: %s (%lu ms after its first read)\n",
+                          currentTestBattery.c_str(), (unsigned long)ev.latencyMs);
         }
+        telemetryAddSample(meas, activeBattery().name, testInProgress);
         
-        // NEW: check if test completed (current dropped to ~0)
-        if (testInProgress && measI < 0.01f) {
-            float finalCap = capacityAh.toFloat();
-            float testDuration = (millis() - testStartTime) / 3600000.0f; // hours
+        if (testInProgress) {
+            statsAddSample(testStats, meas, millis());
+            predictAddSample(endPredictor, meas, millis());
+            int last = sampleSlot(samplesWritten - 1);
+            SampleRecord rec = { sampleTimestampAt(last), scaledVoltageAt(last),
+                                 scaledCurrentAt(last), scaledPowerAt(last), 0 };
+            historyAppend(rec);
+            if (checkpointDue(millis())) checkpointTest(CHECKPOINT_PROGRESS);
+        }
+
+        // test completed: current dropped to ~0, dated to the first read that showed it
+        if (testInProgress && ev.event == DetectEvent::End) {
+            float finalCap = ev.capacity_mAh / 1000.0f;
+            float testDuration = (ev.atMs - testStartTime) / 3600000.0f; // hours
             if (finalCap > 0.001f) {
-                saveTestResult(currentTestBattery.c_str(), finalCap, testDuration);
+                float dcir = 0;
+                dcirTakeForLog(dcir);
+                saveTestResult(currentTestBattery.c_str(), finalCap, testDuration, dcir);
             }
             testInProgress = false;
-            Serial.printf("Test completed: %.3f Ah in %.2f hours\n", finalCap, testDuration);
+            historyFlush();
+            checkpointTest(CHECKPOINT_END);
+            Serial.printf("Test completed: %.3f Ah in %.2f hours (%ld mWh integrated)\n",
+                          finalCap, testDuration, (long)statsEnergy_mWh(testStats));
         }
         
         lastRead = millis();
@@ -0,0 +1,158 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "FZ35_Fixed.h"
+
+/**
+ * @file FZ35_LogFormat.h
+ * @brief Parsers for the exported text formats: the test log CSV (/testlog.csv,
+ *        /export/tests.csv) and the sample NDJSON lines (/export/samples.ndjson,
+ *        /export/history.ndjson), plus the date stamps of the test index.
+ *        No Arduino dependency, so host tools (tools/fz35_analyze) parse exactly
+ *        like the firmware does.
+ */
+
+// ---------- dates ----------
+
+// days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant's algorithm)
+inline int32_t daysFromCivil(int32_t y, uint32_t m, uint32_t d) {
+    y -= m <= 2;
+    int32_t era = (y >= 0 ? y : y - 399) / 400;
+    uint32_t yoe = (uint32_t)(y - era * 400);
+    uint32_t doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int32_t)doe - 719468;
+}
+
+// "YYYY-MM-DD[ HH:MM]" <-> minutes since 1970 (0 if malformed)
+inline uint32_t testStampFromDate(const char *date) {
+    int y = 0, mo = 0, d = 0, h = 0, mi = 0;
+    int n = sscanf(date, "%d-%d-%d %d:%d", &y, &mo, &d, &h, &mi);
+    if (n < 3 || y < 1970 || mo < 1 || mo > 12 || d < 1 || d > 31) return 0;
+    if (n < 5) h = mi = 0;
+    return (uint32_t)daysFromCivil(y, mo, d) * 1440UL + h * 60 + mi;
+}
+
+inline void testStampToDate(uint32_t stamp, char *buf, size_t len) {
+    int32_t z = stamp / 1440 + 719468;
+    int32_t era = z / 146097;
+    uint32_t doe = (uint32_t)(z - era * 146097);
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    uint32_t mp = (5 * doy + 2) / 153;
+    uint32_t d = doy - (153 * mp + 2) / 5 + 1;
+    uint32_t m = mp < 10 ? mp + 3 : mp - 9;
+    int32_t y = (int32_t)yoe + era * 400 + (m <= 2);
+    uint32_t mins = stamp % 1440;
+    snprintf(buf, len, "%04d-%02u-%02u %02u:%02u", (int)y, (unsigned)m, (unsigned)d,
+             (unsigned)(mins / 60), (unsigned)(mins % 60));
+}
+
+// ---------- test log ----------
+
+/**
+ * @struct TestLogRow
+ * @brief One line of the test log: date,batteryType,finalAh,timeHours[,dcirMilliOhm]
+ *        (written by saveTestResult()).
+ */
+struct TestLogRow {
+    char date[20];          // YYYY-MM-DD HH:MM
+    char batteryType[50];
+    int32_t capacity_mAh;
+    int32_t time_cH;        // 0.01 h
+    int32_t dcir_cmOhm;     // 0.01 mOhm, 0 = not measured
+};
+
+// copy field [s, end) into buf (terminated, truncated to len - 1)
+inline void logField(const char *s, const char *end, char *buf, size_t len) {
+    size_t n = (size_t)(end - s) < len - 1 ? (size_t)(end - s) : len - 1;
+    memcpy(buf, s, n);
+    buf[n] = '\0';
+}
+
+// number field, 0 if empty or not a number (like String::toFloat())
+inline int32_t logNumber(const char *s, const char *end, uint8_t scaleDigits) {
+    char buf[24];
+    logField(s, end, buf, sizeof(buf));
+    int32_t v = 0;
+    return parseFixed(buf, scaleDigits, v) ? v : 0;
+}
+
+/**
+ * @brief Parse one test log line of len bytes (no terminator needed, trailing CR/LF ok).
+ * @return false if it has fewer than four fields.
+ */
+inline bool parseTestLogLine(const char *line, size_t len, TestLogRow &r) {
+    const char *end = line + len;
+    while (end > line && (end[-1] == '\n' || end[-1] == '\r')) --end;
+    const char *comma[4];
+    int commas = 0;
+    for (const char *p = line; p < end && commas < 4; ++p) {
+        if (*p == ',') comma[commas++] = p;
+    }
+    if (commas < 3 || comma[0] == line) return false;
+
+    logField(line, comma[0], r.date, sizeof(r.date));
+    logField(comma[0] + 1, comma[1], r.batteryType, sizeof(r.batteryType));
+    r.capacity_mAh = logNumber(comma[1] + 1, comma[2], 3);
+    const char *timeEnd = commas > 3 ? comma[3] : end;
+    r.time_cH = logNumber(comma[2] + 1, timeEnd, 2);
+    r.dcir_cmOhm = commas > 3 ? logNumber(comma[3] + 1, end, 2) : 0;
+    return true;
+}
+
+// ---------- sample exports ----------
+
+/**
+ * @struct SampleRow
+ * @brief One NDJSON sample line: {"t":s,"v":x.xx,"i":x.xx,"p":x.xx} or {"lost":true}.
+ */
+struct SampleRow {
+    bool lost;
+    uint32_t t_s;
+    int32_t voltage_mV;
+    int32_t current_mA;
+    int32_t power_mW;
+};
+
+// start of the value of "key": in [s, end), nullptr if absent
+inline const char *sampleValue(const char *s, const char *end, const char *key) {
+    size_t keyLen = strlen(key);
+    for (const char *p = s; p + keyLen + 2 < end; ++p) {
+        if (*p == '"' && p[keyLen + 1] == '"' && p[keyLen + 2] == ':' && !memcmp(p + 1, key, keyLen))
+            return p + keyLen + 3;
+    }
+    return nullptr;
+}
+
+// numeric value of "key", scaled by 10^scaleDigits
+inline bool sampleField(const char *s, const char *end, const char *key, uint8_t scaleDigits, int32_t &out) {
+    const char *v = sampleValue(s, end, key);
+    if (!v) return false;
+    const char *e = v;
+    while (e < end && *e != ',' && *e != '}') ++e;
+    char buf[24];
+    logField(v, e, buf, sizeof(buf));
+    return parseFixed(buf, scaleDigits, out);
+}
+
+/**
+ * @brief Parse one sample line of len bytes (space padding and newline ok).
+ * @return false if it is neither a sample nor a lost marker.
+ */
+inline bool parseSampleLine(const char *line, size_t len, SampleRow &r) {
+    const char *end = line + len;
+    r = SampleRow();
+    int32_t t = 0;
+    if (sampleValue(line, end, "lost")) {
+        r.lost = true;
+        return true;
+    }
+    if (!sampleField(line, end, "t", 0, t)) return false;
+    r.t_s = (uint32_t)t;
+    return sampleField(line, end, "v", 3, r.voltage_mV) &&
+           sampleField(line, end, "i", 3, r.current_mA) &&
+           sampleField(line, end, "p", 3, r.power_mW);
+}
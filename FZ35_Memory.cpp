@@ -0,0 +1,104 @@
+#include "FZ35_Memory.h"
+
+/**
+ * @file FZ35_Memory.cpp
+ * @brief Region table, boot-stage heap marks and the memory map report.
+ */
+
+// section bounds from the ESP8266 linker script
+extern "C" char _data_start[], _data_end[], _rodata_start[], _rodata_end[], _bss_start[], _bss_end[];
+
+/**
+ * @struct MemRegion
+ * @brief One registered buffer.
+ */
+struct MemRegion {
+    const char *module;
+    const char *name;
+    MemKind kind;
+    uint32_t bytes;
+};
+
+/**
+ * @struct MemMark
+ * @brief Free heap / largest block after a boot stage.
+ */
+struct MemMark {
+    const char *stage;
+    uint32_t freeHeap;
+    uint32_t maxBlock;
+};
+
+static MemRegion regions[MEM_MAX_REGIONS];
+static int regionCount = 0;
+static MemMark marks[MEM_MAX_MARKS];
+static int markCount = 0;
+
+int memRegister(const char *module, const char *name, MemKind kind, uint32_t bytes) {
+    if (regionCount >= MEM_MAX_REGIONS) return -1;
+    regions[regionCount] = { module, name, kind, bytes };
+    return regionCount++;
+}
+
+void memUpdate(int id, uint32_t bytes) {
+    if (id >= 0 && id < regionCount) regions[id].bytes = bytes;
+}
+
+void memMark(const char *stage) {
+    if (markCount >= MEM_MAX_MARKS) return;
+    marks[markCount++] = { stage, ESP.getFreeHeap(), ESP.getMaxFreeBlockSize() };
+}
+
+static uint32_t regionTotal(MemKind kind) {
+    uint32_t sum = 0;
+    for (int i = 0; i < regionCount; ++i) {
+        if (regions[i].kind == kind) sum += regions[i].bytes;
+    }
+    return sum;
+}
+
+void memPrintMap() {
+    Serial.println("== Memory map ==");
+    Serial.printf("DRAM  .data %u  .rodata %u  .bss %u\n",
+                  (unsigned)(_data_end - _data_start), (unsigned)(_rodata_end - _rodata_start),
+                  (unsigned)(_bss_end - _bss_start));
+    for (int i = 0; i < markCount; ++i) {
+        int32_t used = i ? (int32_t)marks[i - 1].freeHeap - (int32_t)marks[i].freeHeap : 0;
+        Serial.printf("heap after %-8s free %6u  max block %6u  (stage %+ld)\n", marks[i].stage,
+                      (unsigned)marks[i].freeHeap, (unsigned)marks[i].maxBlock, (long)-used);
+    }
+    for (int i = 0; i < regionCount; ++i) {
+        Serial.printf("  %-12s %-16s %-6s %6u\n", regions[i].module, regions[i].name,
+                      regions[i].kind == MemKind::Heap ? "heap" : "static", (unsigned)regions[i].bytes);
+    }
+    Serial.printf("registered: static %u, heap %u; free heap now %u, max block %u, frag %u%%\n",
+                  (unsigned)regionTotal(MemKind::Static), (unsigned)regionTotal(MemKind::Heap),
+                  (unsigned)ESP.getFreeHeap(), (unsigned)ESP.getMaxFreeBlockSize(),
+                  (unsigned)ESP.getHeapFragmentation());
+}
+
+String memMapJson() {
+    String json = "{\"dram\":{\"data\":" + String((unsigned long)(_data_end - _data_start));
+    json.reserve(256 + regionCount * 64);
+    json += ",\"rodata\":" + String((unsigned long)(_rodata_end - _rodata_start));
+    json += ",\"bss\":" + String((unsigned long)(_bss_end - _bss_start)) + "}";
+    json += ",\"heap\":{\"free\":" + String((unsigned long)ESP.getFreeHeap());
+    json += ",\"max_block\":" + String((unsigned long)ESP.getMaxFreeBlockSize());
+    json += ",\"frag\":" + String(ESP.getHeapFragmentation()) + "}";
+    json += ",\"stack_free\":" + String((unsigned long)ESP.getFreeContStack());
+    json += ",\"boot\":[";
+    for (int i = 0; i < markCount; ++i) {
+        if (i) json += ",";
+        json += "{\"stage\":\"" + String(marks[i].stage) + "\",\"free\":" + String((unsigned long)marks[i].freeHeap);
+        json += ",\"max_block\":" + String((unsigned long)marks[i].maxBlock) + "}";
+    }
+    json += "],\"regions\":[";
+    for (int i = 0; i < regionCount; ++i) {
+        if (i) json += ",";
+        json += "{\"module\":\"" + String(regions[i].module) + "\",\"name\":\"" + String(regions[i].name) + "\"";
+        json += ",\"kind\":\"" + String(regions[i].kind == MemKind::Heap ? "heap" : "static") + "\"";
+        json += ",\"bytes\":" + String((unsigned long)regions[i].bytes) + "}";
+    }
+    json += "]}";
+    return json;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @file FZ35_Memory.h
+ * @brief Memory budget: modules register their static and heap buffers, setup()
+ *        marks the free heap after each boot stage, and the sample ring is sized
+ *        from what is left. The resulting map is printed at boot and served at /memory.
+ */
+
+#define MEM_MAX_REGIONS 24
+#define MEM_MAX_MARKS   8
+
+enum class MemKind : uint8_t {
+    Static,   // .data / .bss
+    Heap
+};
+
+/**
+ * @brief Register a buffer. module and name must be string literals.
+ * @return Region id for memUpdate(), or -1 when the table is full.
+ */
+int memRegister(const char *module, const char *name, MemKind kind, uint32_t bytes);
+void memUpdate(int id, uint32_t bytes);
+
+/**
+ * @brief Record the free heap after a boot stage (e.g. "wifi", "logs").
+ */
+void memMark(const char *stage);
+
+void memPrintMap();
+String memMapJson();
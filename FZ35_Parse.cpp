@@ -0,0 +1,117 @@
+#include "FZ35_Comm.h"
+#include "FZ35_Fixed.h"
+#include "FZ35_Trace.h"
+
+/**
+ * @file FZ35_Parse.cpp
+ * @brief Device line parser. Kept out of the sketch so host tools (tools/fz35_replay)
+ *        can link it against the Comm code.
+ */
+
+/**
+ * @brief Device parse callback. Extracts protection values and live CSV measurement line
+ * into the selected channel (fzActive).
+ */
+void parseFZ35(const String &lineIn) {
+    TraceScope trace("parseFZ35");
+    FzChannel &ch = *fzActive;
+    String s = lineIn;
+    s.trim();
+    if (s.length() == 0) return;
+
+    Serial.printf("Parsing line: \"%s\"\n", s.c_str());
+    bool parsedSummary = false;
+    bool parsedCSV = false;
+
+    auto extractNumber = [](const String &tok)->String {
+        String out;
+        for (size_t i=0;i<tok.length();++i) {
+            char c = tok.charAt(i);
+            if ((c >= '0' && c <= '9') || c == '.' || c == '-' ) out += c;
+        }
+        out.trim();
+        return out;
+    };
+
+    // summary tokens (OVP:, OCP:, OPP:, LVP:, OAH:, OHP:)
+    if (s.indexOf("OVP:") >= 0 || s.indexOf("OCP:") >= 0 || s.indexOf("OPP:") >= 0) {
+        int pos = 0;
+        while (pos < s.length()) {
+            int comma = s.indexOf(',', pos);
+            if (comma < 0) comma = s.length();
+            String token = s.substring(pos, comma);
+            token.trim();
+            int colon = token.indexOf(':');
+            if (colon > 0) {
+                String key = token.substring(0, colon);
+                String val = token.substring(colon + 1);
+                key.trim(); val.trim();
+                for (size_t k=0;k<key.length();++k) key.setCharAt(k, toupper(key.charAt(k)));
+                if (key == "OVP") ch.OVP = val;
+                else if (key == "OCP") ch.OCP = val;
+                else if (key == "OPP") ch.OPP = val;
+                else if (key == "LVP") ch.LVP = val;
+                else if (key == "OAH") ch.OAH = val;
+                else if (key == "OHP") ch.OHP = val;
+            }
+            pos = comma + 1;
+        }
+        parsedSummary = true;
+        Serial.println("Parsed summary parameters.");
+    }
+
+    // CSV measurement: look for V, A and Ah tokens (keep previous values if not present)
+    if ((s.indexOf('V') >= 0) && (s.indexOf('A') >= 0) && (s.indexOf("Ah") >= 0)) {
+        bool gotCurrent = false;
+        int pos = 0;
+        while (pos < s.length()) {
+            int comma = s.indexOf(',', pos);
+            if (comma < 0) comma = s.length();
+            String tok = s.substring(pos, comma);
+            tok.trim();
+            if (tok.length() > 0) {
+                String lowerTok = tok;
+                lowerTok.toLowerCase();
+                if (lowerTok.endsWith("ah")) {
+                    String num = extractNumber(tok);
+                    if (num.length() && parseMilli(num.c_str(), ch.meas.capacity_mAh)) ch.capacityAh = num;
+                } else if (lowerTok.endsWith("v")) {
+                    String num = extractNumber(tok);
+                    if (num.length() && parseMilli(num.c_str(), ch.meas.voltage_mV)) ch.voltage = num;
+                } else if (lowerTok.endsWith("a")) {
+                    // exclude 'ah' case (already handled)
+                    if (! (lowerTok.endsWith("ah")) ) {
+                        String num = extractNumber(tok);
+                        if (num.length() && parseMilli(num.c_str(), ch.meas.current_mA)) {
+                            ch.current = num;
+                            gotCurrent = true;
+                        }
+                    }
+                } else {
+                    // fallback: treat as time string
+                    ch.energyWh = tok;
+                }
+            }
+            pos = comma + 1;
+        }
+        // compute power from latest numeric values (integer mV * mA)
+        ch.meas.power_mW = mulMilli(ch.meas.voltage_mV, ch.meas.current_mA);
+        char pbuf[16];
+        formatFixed(pbuf, sizeof(pbuf), (int64_t)ch.meas.voltage_mV * ch.meas.current_mA, 6, 2);
+        ch.power = pbuf;
+        // a line without a readable current leaves the read stale (FZ35_Detect.h)
+        if (gotCurrent) ch.csvLines++;
+        parsedCSV = true;
+        Serial.println("Parsed CSV measurement.");
+    }
+
+    if (!parsedSummary && !parsedCSV) {
+        Serial.println("Line not recognized, ignored.");
+    }
+
+    // status remains whatever logic sets it elsewhere; don't zero fields here
+    Serial.printf("== Parsed Data ==\nOVP=%s OCP=%s OPP=%s LVP=%s OAH=%s OHP=%s\n",
+                  ch.OVP.c_str(), ch.OCP.c_str(), ch.OPP.c_str(), ch.LVP.c_str(), ch.OAH.c_str(), ch.OHP.c_str());
+    Serial.printf("meas V=%s I=%s Ah=%s T=%s P=%s STATUS=%s\n",
+                  ch.voltage.c_str(), ch.current.c_str(), ch.capacityAh.c_str(), ch.energyWh.c_str(), ch.power.c_str(), ch.status.c_str());
+}
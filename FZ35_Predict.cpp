@@ -0,0 +1,135 @@
+#include "FZ35_Predict.h"
+#include <math.h>
+
+/**
+ * @file FZ35_Predict.cpp
+ * @brief RLS update and limit extrapolation.
+ */
+
+void predictReset(EndPredictor &p, const PredictLimits &limits, const Measurement &m, uint32_t nowMs) {
+    p = EndPredictor();
+    p.limits = limits;
+    p.startMs = nowMs;
+    p.lastMs = nowMs;
+    p.startCap_mAh = m.capacity_mAh;
+    p.lastCap_mAh = m.capacity_mAh;
+    // weak prior: the first samples dominate the fit
+    for (int i = 0; i < PREDICT_PARAMS; ++i) p.P[i][i] = 1e4f;
+}
+
+/**
+ * @brief One RLS step with forgetting factor lambda, regressor x = [1, t, t^2]:
+ *   k = P x / (lambda + x'P x),  theta += k (v - x'theta),  P = (P - k x'P) / lambda
+ */
+void predictAddSample(EndPredictor &p, const Measurement &m, uint32_t nowMs) {
+    // memory ~ PREDICT_WINDOW_FRACTION of the samples so far: long enough to average
+    // out the 10 mV display steps, short enough to follow the end-of-discharge knee
+    float memory = p.samples * PREDICT_WINDOW_FRACTION;
+    if (memory < PREDICT_MIN_SAMPLES) memory = PREDICT_MIN_SAMPLES;
+    const float lambda = 1.0f - 1.0f / memory;
+    float t = (nowMs - p.startMs) / 3600000.0f;
+    float v = m.voltage_mV / 1000.0f;
+    const float x[PREDICT_PARAMS] = { 1.0f, t, t * t };
+
+    if (p.samples == 0) p.theta[0] = v; // start the intercept at the first reading
+
+    float px[PREDICT_PARAMS];
+    float denom = lambda, err = v;
+    for (int i = 0; i < PREDICT_PARAMS; ++i) {
+        px[i] = 0;
+        for (int j = 0; j < PREDICT_PARAMS; ++j) px[i] += p.P[i][j] * x[j];
+        denom += x[i] * px[i];
+        err -= x[i] * p.theta[i];
+    }
+    for (int i = 0; i < PREDICT_PARAMS; ++i) p.theta[i] += px[i] / denom * err;
+    // P symmetric, so x'P = (P x)'; update both halves from the upper one
+    for (int i = 0; i < PREDICT_PARAMS; ++i) {
+        for (int j = i; j < PREDICT_PARAMS; ++j) {
+            p.P[i][j] = (p.P[i][j] - px[i] * px[j] / denom) / lambda;
+            p.P[j][i] = p.P[i][j];
+        }
+    }
+
+    p.lastMs = nowMs;
+    p.lastCap_mAh = m.capacity_mAh;
+    p.samples++;
+}
+
+/**
+ * @brief Hours from t until the fitted curve reaches lvp (negative = not reached).
+ * Uses the quadratic when it crosses, else the tangent at t.
+ */
+static float hoursToLvp(const EndPredictor &p, float t, float lvp) {
+    float a = p.theta[0], b = p.theta[1], c = p.theta[2];
+    float vNow = a + b * t + c * t * t;
+    float slope = b + 2 * c * t;
+    if (vNow <= lvp) return 0;
+    if (c < 0) {
+        // root of c*u^2 + slope*u + (vNow - lvp) = 0 with u > 0
+        float disc = slope * slope - 4 * c * (vNow - lvp);
+        return (-slope - sqrtf(disc)) / (2 * c);
+    }
+    if (slope < -1e-6f) return (lvp - vNow) / slope;
+    return -1;
+}
+
+EndPrediction predictEstimate(const EndPredictor &p) {
+    EndPrediction e = {};
+    if (p.samples < PREDICT_MIN_SAMPLES) return e;
+
+    float elapsed_s = (p.lastMs - p.startMs) / 1000.0f;
+    float t = elapsed_s / 3600.0f;
+    float best = 1e12f;
+
+    float rate_mAhps = elapsed_s > 0 ? (p.lastCap_mAh - p.startCap_mAh) / elapsed_s : 0;
+    if (p.limits.lvp_mV > 0) {
+        float s = hoursToLvp(p, t, p.limits.lvp_mV / 1000.0f) * 3600.0f;
+        // on the plateau the fit crosses far away or not at all: LVP comes no later than
+        // the rated capacity at the average rate (a weak cell reaches it sooner)
+        if (p.limits.rated_mAh > 0 && rate_mAhps > 0) {
+            float r = (p.limits.rated_mAh - p.lastCap_mAh) / rate_mAhps;
+            if (r < 0) r = 0;
+            if (s < 0 || r < s) s = r;
+        }
+        if (s >= 0 && s < best) { best = s; e.limit = PredictLimit::Lvp; }
+    }
+
+    if (p.limits.oah_mAh > 0 && rate_mAhps > 0) {
+        float s = (p.limits.oah_mAh - p.lastCap_mAh) / rate_mAhps;
+        if (s < 0) s = 0;
+        if (s < best) { best = s; e.limit = PredictLimit::Oah; }
+    }
+
+    if (p.limits.ohp_s > 0) {
+        float s = p.limits.ohp_s > elapsed_s ? p.limits.ohp_s - elapsed_s : 0;
+        if (s < best) { best = s; e.limit = PredictLimit::Ohp; }
+    }
+
+    if (e.limit == PredictLimit::None) return e;
+    e.valid = true;
+    e.remaining_s = (uint32_t)(best + 0.5f);
+    e.finalCap_mAh = p.lastCap_mAh + (int32_t)(rate_mAhps * best + 0.5f);
+    e.slope_uVps = (int32_t)((p.theta[1] + 2 * p.theta[2] * t) * 1e6f / 3600.0f);
+    return e;
+}
+
+const char *predictLimitToString(PredictLimit l) {
+    switch (l) {
+        case PredictLimit::Lvp: return "lvp";
+        case PredictLimit::Oah: return "oah";
+        case PredictLimit::Ohp: return "ohp";
+        default: return "none";
+    }
+}
+
+uint32_t predictParseHourLimit(const char *hhmm) {
+    if (!hhmm) return 0;
+    uint32_t h = 0, m = 0;
+    const char *s = hhmm;
+    if (*s < '0' || *s > '9') return 0;
+    while (*s >= '0' && *s <= '9') h = h * 10 + (*s++ - '0');
+    if (*s++ != ':') return 0;
+    if (*s < '0' || *s > '9') return 0;
+    while (*s >= '0' && *s <= '9') m = m * 10 + (*s++ - '0');
+    return h * 3600 + m * 60;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <stdint.h>
+#include "FZ35_Fixed.h"
+
+/**
+ * @file FZ35_Predict.h
+ * @brief Online end-of-test prediction. A recursive least squares fit
+ *        V(t) = a + b*t + c*t^2 with exponential forgetting tracks the recent voltage
+ *        slope and its bend; the time to the profile's LVP follows from the fit, the time to OAH from the
+ *        average discharge rate, and the time to OHP from the clock. The earliest
+ *        limit wins. Before the knee the fit reaches LVP late or never; the rated
+ *        capacity at the average rate bounds the LVP estimate. O(1) per sample, no sample history.
+ *        No Arduino dependency.
+ */
+
+#define PREDICT_WINDOW_FRACTION 0.1f // forgetting memory as a fraction of the test so far
+#define PREDICT_MIN_SAMPLES 60
+#define PREDICT_PARAMS 3
+
+enum class PredictLimit : uint8_t {
+    None,
+    Lvp,
+    Oah,
+    Ohp
+};
+
+/**
+ * @struct PredictLimits
+ * @brief Termination limits of the active profile (0 = not set).
+ */
+struct PredictLimits {
+    int32_t lvp_mV;
+    int32_t oah_mAh;
+    uint32_t ohp_s;
+    int32_t rated_mAh;   // profile capacity: bounds the LVP estimate on the plateau
+};
+
+/**
+ * @struct EndPredictor
+ * @brief RLS state. Time is in hours since test start, voltage in volts; the
+ *        3x3 covariance update is ~50 float ops once per sample.
+ */
+struct EndPredictor {
+    PredictLimits limits;
+    uint32_t startMs;
+    uint32_t lastMs;
+    uint32_t samples;
+    int32_t startCap_mAh;
+    int32_t lastCap_mAh;
+    float theta[PREDICT_PARAMS];            // V = theta0 + theta1*h + theta2*h^2
+    float P[PREDICT_PARAMS][PREDICT_PARAMS]; // covariance (symmetric)
+};
+
+/**
+ * @struct EndPrediction
+ * @brief Estimate at one instant.
+ */
+struct EndPrediction {
+    bool valid;
+    PredictLimit limit;      // limit expected to end the test
+    uint32_t remaining_s;
+    int32_t finalCap_mAh;    // device capacity counter at the predicted end
+    int32_t slope_uVps;      // fitted voltage slope (µV/s)
+};
+
+void predictReset(EndPredictor &p, const PredictLimits &limits, const Measurement &m, uint32_t nowMs);
+void predictAddSample(EndPredictor &p, const Measurement &m, uint32_t nowMs);
+EndPrediction predictEstimate(const EndPredictor &p);
+const char *predictLimitToString(PredictLimit l);
+
+/**
+ * @brief "HH:MM" -> seconds (0 if malformed).
+ */
+uint32_t predictParseHourLimit(const char *hhmm);
@@ -0,0 +1,245 @@
+#include "FZ35_ProfileStore.h"
+#include "FZ35_Profiles.h"
+#include "FZ35_Memory.h"
+#include "FZ35_Trace.h"
+
+/**
+ * @file FZ35_ProfileStore.cpp
+ * @brief Fixed-record profile file plus the RAM indexes built from it at boot:
+ *        usedSlots (ascending, ordinal -> slot for paging) and a hash-sorted name index.
+ */
+
+static int slotCount = 0;            // records in file (used + free)
+static int usedCount = 0;
+static int indexCapacity = 0;
+static uint16_t *usedSlots = nullptr; // ascending
+static uint32_t *nameHash = nullptr;  // ascending, parallel to nameSlot
+static uint16_t *nameSlot = nullptr;
+static int memId = -1;
+
+static uint32_t hashName(const char *s) {
+    uint32_t h = 2166136261UL; // FNV-1a
+    while (*s) { h ^= (uint8_t)*s++; h *= 16777619UL; }
+    return h;
+}
+
+static size_t recordOffset(int slot) {
+    return sizeof(ProfileStoreHeader) + (size_t)slot * sizeof(UserProfileRecord);
+}
+
+static bool growIndex() {
+    if (usedCount < indexCapacity) return true;
+    int cap = indexCapacity + 16;
+    uint16_t *us = (uint16_t*)realloc(usedSlots, cap * sizeof(uint16_t));
+    if (us) usedSlots = us;
+    uint32_t *nh = (uint32_t*)realloc(nameHash, cap * sizeof(uint32_t));
+    if (nh) nameHash = nh;
+    uint16_t *ns = (uint16_t*)realloc(nameSlot, cap * sizeof(uint16_t));
+    if (ns) nameSlot = ns;
+    if (!us || !nh || !ns) return false;
+    indexCapacity = cap;
+    memUpdate(memId, cap * (2 * sizeof(uint16_t) + sizeof(uint32_t)));
+    return true;
+}
+
+// first position in the name index whose hash is >= h
+static int nameLowerBound(uint32_t h) {
+    int lo = 0, hi = usedCount;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (nameHash[mid] < h) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+static int usedLowerBound(uint16_t slot) {
+    int lo = 0, hi = usedCount;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (usedSlots[mid] < slot) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+static void indexInsert(uint16_t slot, const char *name) {
+    if (!growIndex()) return;
+    uint32_t h = hashName(name);
+    int p = nameLowerBound(h);
+    memmove(&nameHash[p + 1], &nameHash[p], (usedCount - p) * sizeof(uint32_t));
+    memmove(&nameSlot[p + 1], &nameSlot[p], (usedCount - p) * sizeof(uint16_t));
+    nameHash[p] = h;
+    nameSlot[p] = slot;
+    int u = usedLowerBound(slot);
+    memmove(&usedSlots[u + 1], &usedSlots[u], (usedCount - u) * sizeof(uint16_t));
+    usedSlots[u] = slot;
+    usedCount++;
+}
+
+static void indexRemove(uint16_t slot) {
+    for (int p = 0; p < usedCount; ++p) {
+        if (nameSlot[p] != slot) continue;
+        memmove(&nameHash[p], &nameHash[p + 1], (usedCount - p - 1) * sizeof(uint32_t));
+        memmove(&nameSlot[p], &nameSlot[p + 1], (usedCount - p - 1) * sizeof(uint16_t));
+        break;
+    }
+    int u = usedLowerBound(slot);
+    if (u < usedCount && usedSlots[u] == slot) {
+        memmove(&usedSlots[u], &usedSlots[u + 1], (usedCount - u - 1) * sizeof(uint16_t));
+    }
+    usedCount--;
+}
+
+static bool writeRecord(int slot, const UserProfileRecord &rec) {
+    TraceScope trace("fs profiles");
+    File f = LittleFS.open(PROFILE_STORE_FILE, "r+");
+    if (!f) return false;
+    bool ok = f.seek(recordOffset(slot), SeekSet) &&
+              f.write((const uint8_t*)&rec, sizeof(rec)) == sizeof(rec);
+    f.close();
+    return ok;
+}
+
+/**
+ * @brief Open (or create) the profile file and rebuild the RAM indexes.
+ * Requires LittleFS to be mounted (initTestLog()).
+ */
+void initProfileStore() {
+    memId = memRegister("ProfileStore", "name index", MemKind::Heap, 0);
+    ProfileStoreHeader hdr = {};
+    if (LittleFS.exists(PROFILE_STORE_FILE)) {
+        File f = LittleFS.open(PROFILE_STORE_FILE, "r");
+        if (f && f.read((uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr) &&
+            hdr.magic == PROFILE_STORE_MAGIC && hdr.recordSize == sizeof(UserProfileRecord)) {
+            slotCount = (f.size() - sizeof(hdr)) / sizeof(UserProfileRecord);
+            if (slotCount > MAX_USER_PROFILES) slotCount = MAX_USER_PROFILES;
+            UserProfileRecord rec;
+            for (int slot = 0; slot < slotCount; ++slot) {
+                if (f.read((uint8_t*)&rec, sizeof(rec)) != sizeof(rec)) { slotCount = slot; break; }
+                if (rec.used) {
+                    rec.name[PROFILE_NAME_LEN - 1] = '\0';
+                    indexInsert((uint16_t)slot, rec.name);
+                }
+            }
+            f.close();
+            Serial.printf("Loaded %d user profiles (%d slots)\n", usedCount, slotCount);
+            return;
+        }
+        if (f) f.close();
+        Serial.println("Profile store header mismatch, recreating");
+    }
+
+    File f = LittleFS.open(PROFILE_STORE_FILE, "w");
+    if (!f) {
+        Serial.println("Failed to create profile store");
+        return;
+    }
+    hdr.magic = PROFILE_STORE_MAGIC;
+    hdr.version = 1;
+    hdr.recordSize = sizeof(UserProfileRecord);
+    f.write((const uint8_t*)&hdr, sizeof(hdr));
+    f.close();
+    slotCount = 0;
+}
+
+int userProfileCount() { return usedCount; }
+
+int userProfileSlotAt(int ordinal) {
+    if (ordinal < 0 || ordinal >= usedCount) return -1;
+    return usedSlots[ordinal];
+}
+
+bool readUserProfile(int slot, UserProfileRecord &out) {
+    if (slot < 0 || slot >= slotCount) return false;
+    File f = LittleFS.open(PROFILE_STORE_FILE, "r");
+    if (!f) return false;
+    bool ok = f.seek(recordOffset(slot), SeekSet) &&
+              f.read((uint8_t*)&out, sizeof(out)) == sizeof(out);
+    f.close();
+    out.name[PROFILE_NAME_LEN - 1] = '\0';
+    return ok && out.used;
+}
+
+/**
+ * @brief Binary search the hash index, then confirm the name from the record.
+ */
+int findUserProfileByName(const char *name) {
+    uint32_t h = hashName(name);
+    UserProfileRecord rec;
+    for (int p = nameLowerBound(h); p < usedCount && nameHash[p] == h; ++p) {
+        if (readUserProfile(nameSlot[p], rec) && strcmp(rec.name, name) == 0) return nameSlot[p];
+    }
+    return -1;
+}
+
+/**
+ * @brief Name must be non-empty, unique and safe to embed in JSON and the CSV log.
+ */
+static bool validName(const char *name) {
+    if (!name[0]) return false;
+    for (const char *c = name; *c; ++c) {
+        if (*c < 0x20 || *c == '"' || *c == '\\' || *c == ',') return false;
+    }
+    return true;
+}
+
+static bool validHourLimit(const char *ohp) {
+    return strlen(ohp) == 5 && isdigit(ohp[0]) && isdigit(ohp[1]) && ohp[2] == ':' &&
+           isdigit(ohp[3]) && isdigit(ohp[4]) && ohp[3] <= '5';
+}
+
+int saveUserProfile(int slot, UserProfileRecord rec, String &err) {
+    rec.used = 1;
+    rec.reserved = 0;
+    rec.name[PROFILE_NAME_LEN - 1] = '\0';
+    rec.ohp[sizeof(rec.ohp) - 1] = '\0';
+
+    if (!validName(rec.name)) { err = "invalid name"; return -1; }
+    if (!validHourLimit(rec.ohp)) { err = "ohp must be HH:MM"; return -1; }
+    if (rec.chem > (uint8_t)BatteryChemistry::CoinCell) { err = "invalid chem"; return -1; }
+
+    // same rule the static_assert applies to the built-in table
+    BatteryModule b = { rec.name, (BatteryChemistry)rec.chem, rec.nominal_mV / 1000.0f,
+                        rec.capacity_mAh / 1000.0f, rec.maxLoad_mA / 1000.0f,
+                        rec.recLoad_mA / 1000.0f, rec.lvp_mV / 1000.0f,
+                        rec.oah_mAh / 1000.0f, rec.ohp };
+    if (!isProfileValid(b) || rec.nominal_mV <= 0 || rec.capacity_mAh <= 0 || rec.oah_mAh <= 0 ||
+        rec.lvp_mV <= 0) {
+        err = "values out of range (0 < lvp <= nominal, load <= max load and rated current)";
+        return -1;
+    }
+
+    for (size_t i = 0; i < batteryModulesCount; ++i) {
+        if (strcmp(batteryModules[i].name, rec.name) == 0) { err = "name used by built-in profile"; return -1; }
+    }
+    int existing = findUserProfileByName(rec.name);
+    if (existing >= 0 && existing != slot) { err = "name already exists"; return -1; }
+
+    if (slot >= 0) {
+        UserProfileRecord old;
+        if (!readUserProfile(slot, old)) { err = "unknown id"; return -1; }
+        if (!writeRecord(slot, rec)) { err = "write failed"; return -1; }
+        indexRemove((uint16_t)slot);
+        indexInsert((uint16_t)slot, rec.name);
+    } else {
+        // reuse the first free slot, else append
+        slot = 0;
+        for (int u = 0; u < usedCount && usedSlots[u] == slot; ++u) slot++;
+        if (slot >= MAX_USER_PROFILES) { err = "profile store full"; return -1; }
+        if (!growIndex()) { err = "out of memory"; return -1; }
+        if (!writeRecord(slot, rec)) { err = "write failed"; return -1; }
+        if (slot >= slotCount) slotCount = slot + 1;
+        indexInsert((uint16_t)slot, rec.name);
+    }
+    Serial.printf("Saved user profile [%d] %s\n", slot, rec.name);
+    return slot;
+}
+
+bool deleteUserProfile(int slot) {
+    UserProfileRecord rec;
+    if (!readUserProfile(slot, rec)) return false;
+    rec.used = 0;
+    if (!writeRecord(slot, rec)) return false;
+    indexRemove((uint16_t)slot);
+    Serial.printf("Deleted user profile [%d] %s\n", slot, rec.name);
+    return true;
+}
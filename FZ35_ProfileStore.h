@@ -0,0 +1,57 @@
+#pragma once
+#include <Arduino.h>
+#include <LittleFS.h>
+
+/**
+ * @file FZ35_ProfileStore.h
+ * @brief User-defined battery profiles persisted in a fixed-record binary file.
+ *        Record slot = profile id (O(1) seek); a RAM name index sorted by hash gives
+ *        O(log n) lookup by name. Built-in profiles (FZ35_Profiles.h) stay read-only.
+ */
+
+#define PROFILE_STORE_FILE  "/profiles.bin"
+#define PROFILE_STORE_MAGIC 0x46505A46UL // "FZPF"
+#define MAX_USER_PROFILES   512
+#define PROFILE_NAME_LEN    38
+
+/**
+ * @struct UserProfileRecord
+ * @brief One on-flash profile (72 bytes). Values in milli-units like Measurement.
+ */
+struct UserProfileRecord {
+    uint8_t used;          // 0 = free slot
+    uint8_t chem;          // BatteryChemistry
+    uint16_t reserved;
+    int32_t nominal_mV;
+    int32_t capacity_mAh;
+    int32_t maxLoad_mA;
+    int32_t recLoad_mA;
+    int32_t lvp_mV;
+    int32_t oah_mAh;
+    char ohp[6];           // "HH:MM"
+    char name[PROFILE_NAME_LEN];
+};
+static_assert(sizeof(UserProfileRecord) == 72, "UserProfileRecord layout is part of the file format");
+
+/**
+ * @struct ProfileStoreHeader
+ * @brief File header; recordSize guards against layout changes.
+ */
+struct ProfileStoreHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;
+};
+
+void initProfileStore();
+int userProfileCount();
+int userProfileSlotAt(int ordinal);
+bool readUserProfile(int slot, UserProfileRecord &out);
+int findUserProfileByName(const char *name);
+
+/**
+ * @brief Create (slot < 0) or overwrite a profile.
+ * @return Slot written, or -1 with err set.
+ */
+int saveUserProfile(int slot, UserProfileRecord rec, String &err);
+bool deleteUserProfile(int slot);
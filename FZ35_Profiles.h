@@ -0,0 +1,242 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "FZ35_Fixed.h"
+#if defined(ARDUINO)
+#include <pgmspace.h>
+#else
+#define PROGMEM
+#endif
+
+/**
+ * @file FZ35_Profiles.h
+ * @brief Built-in battery profile table as constexpr data. Clamping to the device
+ *        ratings, 0.1 V OVP quantization and the command payloads are all computed
+ *        at compile time (batteryDerived, kept in flash); setActiveBattery() only
+ *        copies the selected entry out with memcpy_P.
+ *        No Arduino dependency, so host tools can share the definitions.
+ */
+
+enum class BatteryChemistry {
+    LiIon,
+    LiFePO4,
+    LeadAcid,
+    CoinCell
+};
+
+constexpr const char* chemistryToString(BatteryChemistry c) {
+    return c == BatteryChemistry::LiIon    ? "Li-ion"
+         : c == BatteryChemistry::LiFePO4  ? "LiFePO4"
+         : c == BatteryChemistry::LeadAcid ? "Lead Acid"
+         :                                   "Coin Cell";
+}
+
+/**
+ * @struct BatteryModule
+ * @brief Defines one test profile.
+ * @param nominalVoltage Approx full voltage.
+ * @param capacityAh Nominal capacity in Ah.
+ * @param maxLoadA Maximum safe current.
+ * @param recommendedLoadA Suggested test current (C-rate based).
+ * @param lowVoltageProtect Cutoff voltage.
+ * @param overAhLimit Amp-hour termination limit.
+ * @param overHourLimit Time termination HH:MM.
+ */
+struct BatteryModule {
+    const char* name;
+    BatteryChemistry chem;
+    float nominalVoltage;
+    float capacityAh;
+    float maxLoadA;
+    float recommendedLoadA; // NEW: recommended test load current (A)
+    float lowVoltageProtect; // NEW: LVP cutoff voltage
+    float overAhLimit;       // NEW: OAH in Ah (capacity limit)
+    const char* overHourLimit; // NEW: OHP in HH:MM format
+};
+
+// device rated limits (do not exceed)
+constexpr float RATED_VOLTAGE_MAX = 25.0f;
+constexpr float RATED_CURRENT_MAX = 5.0f;
+constexpr float RATED_POWER_MAX   = 35.0f;
+constexpr float MIN_TEST_LOAD_A   = 0.05f;
+
+// ===== battery table with complete protection parameters =====
+// Recommended test loads based on typical discharge test standards:
+// - Li-ion/LiPo: 0.2C–1C (we use 0.5C conservative)
+// - LiFePO4: 0.5C–1C (we use 0.5C)
+// - Lead Acid: 0.05C–0.2C (we use 0.1C)
+// - Primary lithium (coin cells): 0.1C–0.5C (we use 0.2C)
+// - Alkaline: 0.1C–0.5C (we use 0.2C)
+// - NiMH: 0.2C–1C (we use 0.5C)
+
+inline constexpr BatteryModule batteryModules[] = {
+  // name, chem, nominalV, capacityAh, maxLoadA, recommendedLoadA, LVP, OAH, OHP
+  { "24V Generic 5.00A", BatteryChemistry::LiIon, 24.20f, 30.0f, 5.10f, 5.00f, 18.0f, 36.0f, "10:00" }, // 6S Li-ion: 3.0V*6=18V cutoff
+  { "24V Lead Acid 5.00A", BatteryChemistry::LeadAcid, 24.00f, 50.0f, 10.00f, 5.00f, 21.0f, 60.0f, "10:00" }, // 12 cells: 1.75V*12=21V
+  { "24V LiFePO4 5.00A", BatteryChemistry::LiFePO4, 24.20f, 20.0f, 20.00f, 5.00f, 20.0f, 24.0f, "05:00" }, // 8S: 2.5V*8=20V
+
+  // Single-cell Li-ion (3.0V cutoff)
+  { "18650 Li-ion 4.2V 1.30A", BatteryChemistry::LiIon, 4.20f, 2.6f, 3.0f, 1.30f, 3.0f, 3.2f, "02:00" },
+  { "21700 Li-ion 4.2V 2.00A", BatteryChemistry::LiIon, 4.20f, 4.0f, 5.0f, 2.00f, 3.0f, 4.8f, "02:30" },
+  { "14500 Li-ion 4.2V 0.40A", BatteryChemistry::LiIon, 4.20f, 0.8f, 1.5f, 0.40f, 3.0f, 1.0f, "02:00" },
+  { "16340 Li-ion 4.2V 0.35A", BatteryChemistry::LiIon, 4.20f, 0.7f, 1.5f, 0.35f, 3.0f, 0.85f, "02:00" },
+
+  // LiFePO4 cells (2.5V cutoff)
+  { "18650 LiFePO4 3.65V 0.75A", BatteryChemistry::LiFePO4, 3.65f, 1.5f, 3.0f, 0.75f, 2.5f, 1.8f, "02:00" },
+  { "26650 LiFePO4 3.65V 1.65A", BatteryChemistry::LiFePO4, 3.65f, 3.3f, 5.0f, 1.65f, 2.5f, 4.0f, "02:30" },
+
+  // Primary Lithium (2.0V cutoff)
+  { "CR2 3.3V 0.16A", BatteryChemistry::CoinCell, 3.30f, 0.8f, 1.0f, 0.16f, 2.0f, 1.0f, "05:00" },
+  { "CR123A 3.3V 0.30A", BatteryChemistry::CoinCell, 3.30f, 1.5f, 1.5f, 0.30f, 2.0f, 1.8f, "05:00" },
+
+  // Alkaline (0.9V cutoff)
+  { "AA Alkaline 1.6V 0.48A", BatteryChemistry::LeadAcid, 1.60f, 2.4f, 1.0f, 0.48f, 0.9f, 3.0f, "05:00" },
+  { "AAA Alkaline 1.6V 0.24A", BatteryChemistry::LeadAcid, 1.60f, 1.2f, 0.5f, 0.24f, 0.9f, 1.5f, "05:00" },
+
+  // NiMH (0.9V cutoff)
+  { "AA NiMH 1.5V 1.00A", BatteryChemistry::LeadAcid, 1.50f, 2.0f, 2.0f, 1.00f, 0.9f, 2.5f, "02:00" },
+  { "AAA NiMH 1.5V 0.40A", BatteryChemistry::LeadAcid, 1.50f, 0.8f, 1.0f, 0.40f, 0.9f, 1.0f, "02:00" },
+
+  // 9V batteries
+  { "PP3 9V Alkaline 0.06A", BatteryChemistry::LeadAcid, 9.60f, 0.6f, 0.2f, 0.06f, 5.4f, 0.75f, "10:00" }, // 6 cells: 0.9V*6=5.4V
+  { "PP3 8.4V Li-ion 0.30A", BatteryChemistry::LiIon, 8.40f, 0.6f, 0.5f, 0.30f, 6.0f, 0.75f, "02:00" }, // 2S: 3.0V*2=6V
+
+  // LiPo packs
+  { "2S LiPo 7.4V 1.10A", BatteryChemistry::LiIon, 8.40f, 2.2f, 5.0f, 1.10f, 6.0f, 2.6f, "02:00" }, // 2S: 3.0V*2
+  { "3S LiPo 11.1V 1.10A", BatteryChemistry::LiIon, 12.60f, 2.2f, 5.0f, 1.10f, 9.0f, 2.6f, "02:00" }, // 3S: 3.0V*3
+  { "4S LiPo 14.8V 1.10A", BatteryChemistry::LiIon, 16.80f, 2.2f, 2.0f, 1.10f, 12.0f, 2.6f, "02:00" }, // 4S: 3.0V*4
+  { "5S LiPo 18.5V 1.10A", BatteryChemistry::LiIon, 21.00f, 2.2f, 2.0f, 1.10f, 15.0f, 2.6f, "02:00" }, // 5S: 3.0V*5
+
+  // LiFePO4 pack
+  { "4S LiFePO4 12.8V 5.00A", BatteryChemistry::LiFePO4, 14.60f, 10.0f, 5.0f, 5.00f, 10.0f, 12.0f, "02:30" }, // 4S: 2.5V*4
+
+  // Lead Acid (10.5V for 12V battery = 1.75V/cell)
+  { "12V SLA 14.4V 0.70A", BatteryChemistry::LeadAcid, 14.40f, 7.0f, 5.0f, 0.70f, 10.5f, 8.5f, "10:00" },
+};
+constexpr size_t batteryModulesCount = sizeof(batteryModules) / sizeof(batteryModules[0]);
+
+/**
+ * @brief A profile is acceptable if LVP sits below nominal voltage and the recommended
+ * test current respects both the cell rating and the device rating.
+ */
+constexpr bool isProfileValid(const BatteryModule &b) {
+    return b.lowVoltageProtect <= b.nominalVoltage
+        && b.recommendedLoadA <= b.maxLoadA
+        && b.recommendedLoadA <= RATED_CURRENT_MAX
+        && b.recommendedLoadA > 0.0f;
+}
+
+constexpr bool allProfilesValid() {
+    for (size_t i = 0; i < batteryModulesCount; ++i) {
+        if (!isProfileValid(batteryModules[i])) return false;
+    }
+    return true;
+}
+static_assert(allProfilesValid(),
+              "batteryModules[]: LVP above nominal voltage or recommended current above rating");
+
+/**
+ * @struct ProfileText
+ * @brief Small fixed-size string usable in constant expressions.
+ */
+struct ProfileText {
+    char s[16];
+    constexpr const char* c_str() const { return s; }
+};
+
+constexpr ProfileText makeProfileText(const char *prefix, int32_t milli, uint8_t decimals, const char *suffix) {
+    ProfileText t = {};
+    size_t n = 0;
+    while (*prefix && n < sizeof(t.s) - 1) t.s[n++] = *prefix++;
+    n += formatMilli(t.s + n, sizeof(t.s) - n, milli, decimals);
+    while (*suffix && n < sizeof(t.s) - 1) t.s[n++] = *suffix++;
+    t.s[n] = '\0';
+    return t;
+}
+
+constexpr int32_t toMilli(float x) {
+    return x >= 0.0f ? (int32_t)(x * 1000.0f + 0.5f) : -(int32_t)(-x * 1000.0f + 0.5f);
+}
+
+/**
+ * @struct BatteryDerived
+ * @brief Device-ready values of one profile. Text fields hold the full command payload;
+ *        the value part (for UI strings) starts after the "XXX:" prefix.
+ */
+struct BatteryDerived {
+    bool clamped;
+    int32_t ovp_mV;
+    int32_t load_mA;
+    ProfileText ovp;     // "24.2" (sent through sendParamVariants)
+    ProfileText load;    // "1.30" (sent as "1.30A")
+    ProfileText ocpCmd;  // "OCP:1.45"
+    ProfileText oppCmd;  // "OPP:35.00"
+    ProfileText lvpCmd;  // "LVP:18.0"
+    ProfileText oahCmd;  // "OAH:36.000"
+    ProfileText ohpCmd;  // "OHP:10:00"
+};
+constexpr size_t PROFILE_CMD_PREFIX_LEN = 4; // "OCP:"
+
+/**
+ * @brief Clamp profile V/I/P to the device ratings and format the payloads.
+ * Same rules as before, now evaluated once per profile by the compiler.
+ */
+constexpr BatteryDerived deriveBattery(const BatteryModule &b) {
+    BatteryDerived d = {};
+
+    // requested values from profile
+    float reqOVP = b.nominalVoltage;
+    float reqOCP = b.maxLoadA;
+    bool clamped = false;
+
+    // clamp voltage and current
+    if (reqOVP > RATED_VOLTAGE_MAX) { reqOVP = RATED_VOLTAGE_MAX; clamped = true; }
+    if (reqOCP > RATED_CURRENT_MAX) { reqOCP = RATED_CURRENT_MAX; clamped = true; }
+
+    // ensure power limit: if product still > max, reduce current to fit power budget
+    if (reqOVP * reqOCP > RATED_POWER_MAX) {
+        float allowedI = RATED_POWER_MAX / reqOVP;
+        if (allowedI < reqOCP) { reqOCP = allowedI; clamped = true; }
+    }
+
+    // Quantize OVP to 0.1V steps (device accepts 0.1V resolution) and recompute OPP
+    int32_t ovp_mV = fixedRoundDiv(toMilli(reqOVP), 100) * 100;
+    float reqOPP = (ovp_mV / 1000.0f) * reqOCP;
+
+    float loadA = b.recommendedLoadA;
+    if (loadA < MIN_TEST_LOAD_A) loadA = MIN_TEST_LOAD_A;
+
+    d.clamped = clamped;
+    d.ovp_mV = ovp_mV;
+    d.load_mA = toMilli(loadA);
+    d.ovp = makeProfileText("", ovp_mV, 1, "");
+    d.load = makeProfileText("", d.load_mA, 2, "");
+    d.ocpCmd = makeProfileText("OCP:", toMilli(reqOCP), 2, "");
+    d.oppCmd = makeProfileText("OPP:", toMilli(reqOPP), 2, "");
+    d.lvpCmd = makeProfileText("LVP:", toMilli(b.lowVoltageProtect), 1, "");
+    d.oahCmd = makeProfileText("OAH:", toMilli(b.overAhLimit), 3, "");
+    ProfileText ohp = {};
+    const char *src = "OHP:";
+    size_t n = 0;
+    while (*src) ohp.s[n++] = *src++;
+    for (src = b.overHourLimit; *src && n < sizeof(ohp.s) - 1; ) ohp.s[n++] = *src++;
+    d.ohpCmd = ohp;
+    return d;
+}
+
+/**
+ * @struct BatteryDerivedTable
+ * @brief Wrapper so the whole derived table can be produced by one constexpr call.
+ */
+struct BatteryDerivedTable {
+    BatteryDerived entries[batteryModulesCount];
+};
+
+constexpr BatteryDerivedTable deriveAllBatteries() {
+    BatteryDerivedTable t = {};
+    for (size_t i = 0; i < batteryModulesCount; ++i) t.entries[i] = deriveBattery(batteryModules[i]);
+    return t;
+}
+
+// ~2.8 KB, so it lives in flash rather than DRAM (read it with memcpy_P)
+inline constexpr BatteryDerivedTable batteryDerived PROGMEM = deriveAllBatteries();
@@ -0,0 +1,311 @@
+#include "FZ35_Program.h"
+#include "FZ35_Profiles.h"
+#include "FZ35_Comm.h"
+
+/**
+ * @file FZ35_Program.cpp
+ * @brief Program parser, step sequencer and transition timing statistics.
+ */
+
+extern String LOAD_ENABLE_CMD;
+extern String LOAD_DISABLE_CMD;
+
+static ProgramStep programSteps[MAX_PROGRAM_STEPS];
+static int programCount = 0;
+static int stepIdx = -1;          // -1 = idle
+static uint64_t stepEndUs = 0;
+static uint64_t nextEdgeUs = 0;   // pulse steps only
+static uint64_t cycleStartUs = 0;
+static bool pulseHigh = false;
+static int32_t appliedCurrent_mA = -1;
+static ProgramTiming timing;
+static const char *lastStopReason = "";
+static uint32_t deferredAfterMs = 0;   // lastRead of the read counted as deferred
+
+// start / stop requested by a web handler, carried out by the next programTick()
+static ProgramStep queuedSteps[MAX_PROGRAM_STEPS];
+static int queuedCount = 0;
+static const char *queuedStop = nullptr;
+
+static const int32_t RATED_CURRENT_MA = toMilli(RATED_CURRENT_MAX);
+static const int32_t RATED_POWER_MW = toMilli(RATED_POWER_MAX);
+
+// ---------- parsing ----------
+
+static bool parseField(const String &tok, uint8_t scale, int32_t &out) {
+    return tok.length() > 0 && parseFixed(tok.c_str(), scale, out) && out >= 0;
+}
+
+// the bad step is quoted in the error, which ends up in a JSON string
+static String jsonEscaped(const String &s) {
+    String out;
+    for (size_t i = 0; i < s.length(); ++i) {
+        char c = s[i];
+        if (c == '"' || c == '\\') out += '\\';
+        if ((uint8_t)c >= 0x20) out += c;
+    }
+    return out;
+}
+
+int parseProgram(const String &text, ProgramStep *steps, int maxSteps, String &err) {
+    int count = 0;
+    int pos = 0;
+    while (pos < (int)text.length()) {
+        int semi = text.indexOf(';', pos);
+        if (semi < 0) semi = text.length();
+        String stepText = text.substring(pos, semi);
+        stepText.trim();
+        pos = semi + 1;
+        if (stepText.length() == 0) continue;
+        if (count >= maxSteps) { err = "too many steps"; return -1; }
+
+        String f[6];
+        int nf = 0, fp = 0;
+        while (nf < 6) {
+            int comma = stepText.indexOf(',', fp);
+            if (comma < 0) comma = stepText.length();
+            f[nf] = stepText.substring(fp, comma);
+            f[nf].trim();
+            nf++;
+            fp = comma + 1;
+            if (fp > (int)stepText.length()) break;
+        }
+
+        ProgramStep st = {};
+        int32_t v[5] = { 0, 0, 0, 0, 0 };
+        bool ok = false;
+        char kind = f[0].length() ? (char)tolower(f[0].charAt(0)) : '?';
+        if (kind == 'c' && nf == 3) {
+            ok = parseField(f[1], 3, v[0]) && parseField(f[2], 3, v[1]);
+            st.type = ProgramStepType::Constant;
+            st.currentA_mA = v[0];
+            st.duration_ms = (uint32_t)v[1];
+        } else if (kind == 'p' && nf == 6) {
+            ok = parseField(f[1], 3, v[0]) && parseField(f[2], 3, v[1]) && parseField(f[3], 3, v[2]) &&
+                 parseField(f[4], 3, v[3]) && parseField(f[5], 3, v[4]);
+            st.type = ProgramStepType::Pulse;
+            st.currentA_mA = v[0];
+            st.currentB_mA = v[1];
+            st.period_ms = (uint32_t)v[2];
+            st.high_ms = (uint32_t)v[3];
+            st.duration_ms = (uint32_t)v[4];
+            if (ok && (st.period_ms < 50 || st.high_ms == 0 || st.high_ms >= st.period_ms)) {
+                err = "pulse needs period >= 0.05 s and 0 < high < period";
+                return -1;
+            }
+        } else if (kind == 'w' && nf == 3) {
+            ok = parseField(f[1], 3, v[0]) && parseField(f[2], 3, v[1]);
+            st.type = ProgramStepType::ConstantPower;
+            st.power_mW = v[0];
+            st.duration_ms = (uint32_t)v[1];
+        }
+        if (!ok || st.duration_ms == 0) {
+            err = "bad step " + String(count + 1) + ": " + jsonEscaped(stepText);
+            return -1;
+        }
+        if (st.currentA_mA > RATED_CURRENT_MA || st.currentB_mA > RATED_CURRENT_MA || st.power_mW > RATED_POWER_MW) {
+            err = "step " + String(count + 1) + " exceeds rated current/power";
+            return -1;
+        }
+        steps[count++] = st;
+    }
+    if (count == 0) err = "empty program";
+    return count > 0 ? count : -1;
+}
+
+// ---------- sequencing ----------
+
+/**
+ * @brief Send a new load current. Scheduled changes record their lateness against
+ * the deadline; constant-power corrections are unscheduled and not counted.
+ */
+static void applyCurrent(int32_t mA, uint64_t deadlineUs, bool scheduled) {
+    if (mA < 0) mA = 0;
+    if (mA > RATED_CURRENT_MA) mA = RATED_CURRENT_MA;
+    mA = fixedRoundDiv(mA, 10) * 10;   // what the command carries (0.01 A)
+    if (mA != appliedCurrent_mA) {
+        char cmd[16];
+        size_t n = formatMilli(cmd, sizeof(cmd) - 1, mA, 2);
+        cmd[n] = 'A';
+        cmd[n + 1] = '\0';
+        sendCommandNoNL(cmd);
+        appliedCurrent_mA = mA;
+    }
+    if (!scheduled) return;
+
+    uint64_t now = micros64();
+    uint32_t late = now > deadlineUs ? (uint32_t)(now - deadlineUs) : 0;
+    if (timing.transitions == 0 || late < timing.minLate_us) timing.minLate_us = late;
+    if (late > timing.maxLate_us) timing.maxLate_us = late;
+    timing.sumLate_us += late;
+    timing.sumSqLate_us += (uint64_t)late * late;
+    timing.transitions++;
+}
+
+static int32_t constantPowerCurrent(const ProgramStep &st, const Measurement &m) {
+    if (m.voltage_mV <= 0) return 0;
+    return (int32_t)(((int64_t)st.power_mW * 1000) / m.voltage_mV);
+}
+
+static void beginStep(int idx, uint64_t startUs) {
+    if (idx >= programCount) {
+        stopProgram("completed");
+        return;
+    }
+    stepIdx = idx;
+    const ProgramStep &st = programSteps[idx];
+    stepEndUs = startUs + (uint64_t)st.duration_ms * 1000ULL;
+    Serial.printf("Program step %d/%d\n", idx + 1, programCount);
+    switch (st.type) {
+        case ProgramStepType::Constant:
+            applyCurrent(st.currentA_mA, startUs, true);
+            break;
+        case ProgramStepType::Pulse:
+            pulseHigh = true;
+            cycleStartUs = startUs;
+            nextEdgeUs = startUs + (uint64_t)st.high_ms * 1000ULL;
+            applyCurrent(st.currentA_mA, startUs, true);
+            break;
+        case ProgramStepType::ConstantPower:
+            applyCurrent(constantPowerCurrent(st, meas), startUs, true);
+            break;
+    }
+}
+
+static uint64_t nextEventUs() {
+    const ProgramStep &st = programSteps[stepIdx];
+    if (st.type == ProgramStepType::Pulse && nextEdgeUs < stepEndUs) return nextEdgeUs;
+    return stepEndUs;
+}
+
+bool startProgram(const ProgramStep *steps, int count) {
+    if (count <= 0 || count > MAX_PROGRAM_STEPS) return false;
+    memcpy(programSteps, steps, count * sizeof(ProgramStep));
+    programCount = count;
+    memset(&timing, 0, sizeof(timing));
+    appliedCurrent_mA = -1;
+    lastStopReason = "";
+    beginStep(0, micros64());
+    sendCommandNoNL(LOAD_ENABLE_CMD);
+    return true;
+}
+
+void stopProgram(const char *reason) {
+    queuedCount = 0;
+    if (stepIdx < 0) return;
+    stepIdx = -1;
+    appliedCurrent_mA = -1;
+    lastStopReason = reason;
+    sendCommandNoNL(LOAD_DISABLE_CMD);
+    Serial.printf("Program stopped: %s (%u transitions, max late %u us)\n",
+                  reason, (unsigned)timing.transitions, (unsigned)timing.maxLate_us);
+}
+
+bool programActive() { return stepIdx >= 0 || queuedCount > 0; }
+
+bool programQueue(const ProgramStep *steps, int count) {
+    if (count <= 0 || count > MAX_PROGRAM_STEPS) return false;
+    memcpy(queuedSteps, steps, count * sizeof(ProgramStep));
+    queuedCount = count;
+    return true;
+}
+
+void programQueueStop(const char *reason) {
+    queuedCount = 0;
+    queuedStop = reason;
+}
+
+/**
+ * @brief Fire every event due at the time of the call. Each new deadline is derived
+ * from the previous deadline, not from "now", so a late tick does not shift the rest
+ * of the program. A pulse edge already followed by a due event (after a long forced
+ * read) is skipped instead of replayed: the load goes straight to the current it
+ * should have now.
+ */
+void programTick() {
+    if (queuedStop) {
+        const char *reason = queuedStop;
+        queuedStop = nullptr;
+        stopProgram(reason);
+    }
+    if (queuedCount) {
+        int count = queuedCount;
+        queuedCount = 0;
+        if (stepIdx >= 0) stopProgram("replaced");
+        startProgram(queuedSteps, count);
+    }
+    uint64_t now = micros64();
+    while (stepIdx >= 0) {
+        uint64_t due = nextEventUs();
+        if (now < due) return;
+        const ProgramStep &st = programSteps[stepIdx];
+        if (due == stepEndUs) {
+            beginStep(stepIdx + 1, stepEndUs);
+            continue;
+        }
+        int32_t mA;
+        if (pulseHigh) {
+            pulseHigh = false;
+            nextEdgeUs = cycleStartUs + (uint64_t)st.period_ms * 1000ULL;
+            mA = st.currentB_mA;
+        } else {
+            pulseHigh = true;
+            cycleStartUs = due;
+            nextEdgeUs = due + (uint64_t)st.high_ms * 1000ULL;
+            mA = st.currentA_mA;
+        }
+        if (nextEventUs() <= now) timing.edgesSkipped++;
+        else applyCurrent(mA, due, true);
+    }
+}
+
+void programOnSample(const Measurement &m) {
+    if (stepIdx < 0) return;
+    const ProgramStep &st = programSteps[stepIdx];
+    if (st.type != ProgramStepType::ConstantPower) return;
+    int32_t target = constantPowerCurrent(st, m);
+    // 10 mA deadband: the load resolves 0.01 A anyway
+    if (abs(target - appliedCurrent_mA) >= 10) applyCurrent(target, 0, false);
+}
+
+uint32_t programMsUntilNextEvent() {
+    if (stepIdx < 0) return UINT32_MAX;
+    uint64_t now = micros64();
+    uint64_t due = nextEventUs();
+    return due > now ? (uint32_t)((due - now) / 1000ULL) : 0;
+}
+
+void programNoteDeferredRead(uint32_t lastReadMs) {
+    // loop() asks on every pass while the read is held back: count it once
+    if (timing.readsDeferred && lastReadMs == deferredAfterMs) return;
+    deferredAfterMs = lastReadMs;
+    timing.readsDeferred++;
+}
+
+String programStatusJson() {
+    String json = "{\"state\":\"";
+    json += stepIdx >= 0 ? "running" : queuedCount ? "queued" : "idle";
+    json += "\",\"step\":" + String(stepIdx + 1) + ",\"steps\":" + String(programCount);
+    if (stepIdx >= 0) {
+        uint64_t now = micros64();
+        json += ",\"step_remaining_ms\":" + String((unsigned long)(stepEndUs > now ? (stepEndUs - now) / 1000ULL : 0));
+        json += ",\"applied_a\":";
+        char num[16];
+        formatMilli(num, sizeof(num), appliedCurrent_mA, 2);
+        json += num;
+    }
+    json += ",\"last_stop\":\"" + String(lastStopReason) + "\"";
+    json += ",\"transitions\":" + String((unsigned long)timing.transitions);
+    if (timing.transitions) {
+        // reporting only: float is fine off the sample path
+        float mean = (float)timing.sumLate_us / timing.transitions;
+        float var = (float)timing.sumSqLate_us / timing.transitions - mean * mean;
+        json += ",\"latency_us\":{\"min\":" + String((unsigned long)timing.minLate_us);
+        json += ",\"mean\":" + String((unsigned long)(mean + 0.5f));
+        json += ",\"max\":" + String((unsigned long)timing.maxLate_us);
+        json += ",\"jitter\":" + String((unsigned long)(var > 0 ? sqrtf(var) + 0.5f : 0)) + "}";
+    }
+    json += ",\"edges_skipped\":" + String((unsigned long)timing.edgesSkipped);
+    json += ",\"reads_deferred\":" + String((unsigned long)timing.readsDeferred) + "}";
+    return json;
+}
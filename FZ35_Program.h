@@ -0,0 +1,100 @@
+#pragma once
+#include <Arduino.h>
+#include "FZ35_Fixed.h"
+
+/**
+ * @file FZ35_Program.h
+ * @brief Timed discharge programs: a list of constant-current, pulse and constant-power
+ *        steps run from a deadline-based tick scheduler (programTick() from loop()).
+ *        Deadlines are absolute micros() values, so lateness never accumulates; the
+ *        lateness of every load change is recorded as transition latency / jitter.
+ *
+ * Step syntax (semicolon separated, values in A / W / seconds):
+ *   c,<A>,<s>                          constant current for s seconds
+ *   p,<A high>,<A low>,<period>,<high>,<s>  pulse: high for <high> of every <period>
+ *   w,<W>,<s>                          constant power, current re-derived from each sample
+ */
+
+#define MAX_PROGRAM_STEPS 16
+
+// loop() skips a read that would end less than PROGRAM_READ_MARGIN_MS before the next
+// load change, but never postpones one more than PROGRAM_MAX_READ_DEFER_MS
+#define PROGRAM_READ_MARGIN_MS     20
+#define PROGRAM_MAX_READ_DEFER_MS  5000
+
+enum class ProgramStepType : uint8_t {
+    Constant,
+    Pulse,
+    ConstantPower
+};
+
+/**
+ * @struct ProgramStep
+ * @brief One program step in integer units.
+ */
+struct ProgramStep {
+    ProgramStepType type;
+    int32_t currentA_mA;   // constant / pulse high current
+    int32_t currentB_mA;   // pulse low current
+    int32_t power_mW;      // constant power target
+    uint32_t period_ms;    // pulse period
+    uint32_t high_ms;      // pulse high time within the period
+    uint32_t duration_ms;
+};
+
+/**
+ * @struct ProgramTiming
+ * @brief Lateness of load changes against their scheduled deadlines (microseconds).
+ */
+struct ProgramTiming {
+    uint32_t transitions;
+    uint32_t minLate_us;
+    uint32_t maxLate_us;
+    uint64_t sumLate_us;
+    uint64_t sumSqLate_us;
+    uint32_t edgesSkipped;    // pulse edges overtaken by the next event, not sent
+    uint32_t readsDeferred;
+};
+
+/**
+ * @brief Parse a step list (see syntax above).
+ * @return Step count, or -1 with err set (JSON-escaped, the handler quotes it).
+ */
+int parseProgram(const String &text, ProgramStep *steps, int maxSteps, String &err);
+
+// from loop() only: they send to the active channel
+bool startProgram(const ProgramStep *steps, int count);
+void stopProgram(const char *reason);
+
+/**
+ * @brief Request handlers queue a start / stop instead; the next programTick() carries
+ *        it out on channel 0. A queued start replaces a running program.
+ */
+bool programQueue(const ProgramStep *steps, int count);
+void programQueueStop(const char *reason);
+
+/** @brief A program is running or queued to start. */
+bool programActive();
+
+/**
+ * @brief Scheduler tick: fires every load change whose deadline has passed.
+ */
+void programTick();
+
+/**
+ * @brief Feed a fresh measurement (constant-power regulation).
+ */
+void programOnSample(const Measurement &m);
+
+/**
+ * @brief Milliseconds until the next scheduled load change (UINT32_MAX when idle).
+ * loop() defers a blocking read when it would overrun this.
+ */
+uint32_t programMsUntilNextEvent();
+
+/**
+ * @brief loop() held back the read due since lastReadMs (counted once per read).
+ */
+void programNoteDeferredRead(uint32_t lastReadMs);
+
+String programStatusJson();
@@ -0,0 +1,82 @@
+#include "FZ35_Stats.h"
+
+/**
+ * @file FZ35_Stats.cpp
+ * @brief Implements the running test aggregates and their JSON form.
+ */
+
+void statsReset(TestStats &st, uint32_t nowMs) {
+    memset(&st, 0, sizeof(st));
+    st.startMs = nowMs;
+    st.lastMs = nowMs;
+}
+
+/**
+ * @brief Fold one sample in. Integrates with the trapezoid rule between this and the
+ * previous sample; the first sample only seeds the integrators.
+ */
+void statsAddSample(TestStats &st, const Measurement &m, uint32_t nowMs) {
+    if (st.samples == 0) {
+        st.minV_mV = st.maxV_mV = m.voltage_mV;
+        st.minI_mA = st.maxI_mA = m.current_mA;
+    } else {
+        uint32_t dt = nowMs - st.lastMs;
+        int64_t pSum = (int64_t)st.lastPower_mW + m.power_mW;
+        int64_t iSum = (int64_t)st.lastCurrent_mA + m.current_mA;
+        if (pSum > 0) st.energy_mWms += (uint64_t)pSum * dt / 2;
+        if (iSum > 0) st.charge_mAms += (uint64_t)iSum * dt / 2;
+        if (m.voltage_mV < st.minV_mV) st.minV_mV = m.voltage_mV;
+        if (m.voltage_mV > st.maxV_mV) st.maxV_mV = m.voltage_mV;
+        if (m.current_mA < st.minI_mA) st.minI_mA = m.current_mA;
+        if (m.current_mA > st.maxI_mA) st.maxI_mA = m.current_mA;
+    }
+    if (m.power_mW > st.peakP_mW) st.peakP_mW = m.power_mW;
+    st.sumV_mV += m.voltage_mV;
+    st.sumI_mA += m.current_mA;
+    st.lastPower_mW = m.power_mW;
+    st.lastCurrent_mA = m.current_mA;
+    st.lastMs = nowMs;
+    st.samples++;
+}
+
+int32_t statsEnergy_mWh(const TestStats &st) {
+    return (int32_t)((st.energy_mWms + 1800000ULL) / 3600000ULL);
+}
+
+int32_t statsCharge_mAh(const TestStats &st) {
+    return (int32_t)((st.charge_mAms + 1800000ULL) / 3600000ULL);
+}
+
+/**
+ * @brief Serialize aggregates; values are formatted from integers (no float).
+ */
+String statsToJson(const TestStats &st, bool active) {
+    char num[24];
+    auto add = [&](String &json, const char *key, int64_t value, uint8_t scale, uint8_t decimals) {
+        formatFixed(num, sizeof(num), value, scale, decimals);
+        json += ",\"";
+        json += key;
+        json += "\":";
+        json += num;
+    };
+
+    String json = "{\"active\":";
+    json.reserve(320);
+    json += active ? "true" : "false";
+    json += ",\"samples\":" + String((unsigned long)st.samples);
+    json += ",\"duration_s\":" + String((unsigned long)((st.lastMs - st.startMs) / 1000UL));
+    // mW*ms -> Wh is a divide by 3.6e9; keep 4 decimals via 10^-7 Wh units
+    add(json, "wh", (int64_t)(st.energy_mWms / 360ULL), 7, 4);
+    add(json, "ah", (int64_t)(st.charge_mAms / 360ULL), 7, 4);
+    if (st.samples) {
+        add(json, "v_min", st.minV_mV, 3, 3);
+        add(json, "v_mean", st.sumV_mV / (int64_t)st.samples, 3, 3);
+        add(json, "v_max", st.maxV_mV, 3, 3);
+        add(json, "i_min", st.minI_mA, 3, 3);
+        add(json, "i_mean", st.sumI_mA / (int64_t)st.samples, 3, 3);
+        add(json, "i_max", st.maxI_mA, 3, 3);
+        add(json, "p_peak", st.peakP_mW, 3, 3);
+    }
+    json += "}";
+    return json;
+}
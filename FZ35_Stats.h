@@ -0,0 +1,37 @@
+#pragma once
+#include <Arduino.h>
+#include "FZ35_Fixed.h"
+
+/**
+ * @file FZ35_Stats.h
+ * @brief Running per-test aggregates updated in O(1) per sample from the acquisition
+ *        path: trapezoidal energy and charge integration, min/max/mean V and I, peak power.
+ *        All accumulators are integers so a 10-hour test stays exact.
+ */
+
+/**
+ * @struct TestStats
+ * @brief Aggregates since the last statsReset().
+ * @param energy_mWms Integrated power (mW * ms); Wh = energy_mWms / 3.6e9.
+ * @param charge_mAms Integrated current (mA * ms); Ah = charge_mAms / 3.6e9.
+ */
+struct TestStats {
+    uint32_t samples;
+    uint32_t startMs;
+    uint32_t lastMs;
+    int32_t  lastPower_mW;
+    int32_t  lastCurrent_mA;
+    uint64_t energy_mWms;
+    uint64_t charge_mAms;
+    int32_t  minV_mV, maxV_mV;
+    int64_t  sumV_mV;
+    int32_t  minI_mA, maxI_mA;
+    int64_t  sumI_mA;
+    int32_t  peakP_mW;
+};
+
+void statsReset(TestStats &st, uint32_t nowMs);
+void statsAddSample(TestStats &st, const Measurement &m, uint32_t nowMs);
+int32_t statsEnergy_mWh(const TestStats &st);
+int32_t statsCharge_mAh(const TestStats &st);
+String statsToJson(const TestStats &st, bool active);
@@ -0,0 +1,612 @@
+#include "FZ35_Telemetry.h"
+#include "FZ35_Memory.h"
+#include "FZ35_Trace.h"
+#include "FZ35_WiFi.h"
+#include <ESPAsyncTCP.h>
+#include <LittleFS.h>
+#include <time.h>
+
+/**
+ * @file FZ35_Telemetry.cpp
+ * @brief Batch building, RAM queue + spool file, and the MQTT / InfluxDB link.
+ *        AsyncClient callbacks only record events; telemetryTick() acts on them,
+ *        so the queues are only touched from loop().
+ */
+
+enum class Link : uint8_t {
+    Idle,        // not connected; connects when a batch is queued
+    Connecting,
+    Handshake,   // MQTT: CONNECT sent, waiting for CONNACK
+    Ready,       // may send the head batch
+    Waiting,     // InfluxDB: request sent, waiting for the status line
+    Backoff
+};
+
+static TelemetryConfig cfg;
+static TelemetryConfig pendingCfg;   // from telemetryConfigure(), applied by telemetryTick()
+static bool pendingConfig = false;
+static AsyncClient client;
+static Link state = Link::Idle;
+static uint32_t stateMs = 0;
+static uint32_t retryAtMs = 0;
+static uint32_t backoffMs = TELEMETRY_BACKOFF_MIN;
+static uint32_t lastTxMs = 0;
+
+// events recorded by the AsyncClient callbacks
+static bool evConnected = false;
+static bool evDisconnected = false;
+static const char *evError = nullptr;
+static uint8_t rx[16];
+static uint8_t rxLen = 0;
+static uint32_t bytesAdded = 0;   // per connection
+static uint32_t bytesAcked = 0;
+
+// open batch
+static char batch[TELEMETRY_BATCH_BYTES];
+static size_t batchLen = 0;
+static uint16_t batchLines = 0;
+static uint32_t batchStartMs = 0;
+
+// closed batches: [uint16 len][uint16 lines][payload] in RAM, then in the spool file.
+// RAM always holds the older ones: new batches go to the spool while it is not empty.
+static uint8_t ramQ[TELEMETRY_RAM_BYTES];
+static size_t ramLen = 0;
+static uint16_t ramBatches = 0;
+static uint32_t spoolSize = 0;
+static uint32_t spoolOff = 0;     // first unsent record
+static uint16_t spoolBatches = 0;
+
+// head batch on the wire
+static bool inFlight = false;
+static uint32_t inFlightEnd = 0;
+static uint32_t sentMs = 0;
+
+// counters
+static uint32_t samples = 0;
+static uint32_t batchesSent = 0;
+static uint32_t linesSent = 0;
+static uint32_t bytesSent = 0;
+static uint32_t batchesSpooled = 0;
+static uint32_t batchesRejected = 0;
+static uint32_t linesDropped = 0;
+static uint32_t connects = 0;
+static uint32_t failures = 0;
+static uint32_t lastDeliveryMs = 0;
+static uint32_t maxDeliveryMs = 0;
+static const char *lastError = "";
+static uint32_t minuteStartMs = 0;
+static uint32_t minuteLines = 0, minuteBytes = 0;
+static uint32_t lastMinuteLines = 0, lastMinuteBytes = 0;
+
+struct QueueRecord {
+    uint16_t len;
+    uint16_t lines;
+};
+
+static void setDefaults() {
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.magic = TELEMETRY_CONFIG_MAGIC;
+    cfg.proto = TelemetryProto::Mqtt;
+    cfg.port = 1883;
+    cfg.batchSamples = 10;
+    cfg.interval_s = 10;
+    strcpy(cfg.topic, "fz35/telemetry");
+}
+
+// ---------- queue ----------
+
+static uint16_t queuedBatches() {
+    return ramBatches + spoolBatches;
+}
+
+// drops the sent prefix: the unsent tail is copied to a new file that replaces the spool
+static bool compactSpool() {
+    TraceScope trace("fs spool");
+    File src = LittleFS.open(TELEMETRY_SPOOL_FILE, "r");
+    File dst = LittleFS.open(TELEMETRY_SPOOL_TMP, "w");
+    bool ok = src && dst && src.seek(spoolOff);
+    char chunk[256];
+    uint32_t left = spoolSize - spoolOff;
+    while (ok && left) {
+        size_t n = src.read((uint8_t*)chunk, left < sizeof(chunk) ? left : sizeof(chunk));
+        ok = n && dst.write((const uint8_t*)chunk, n) == n;
+        left -= n;
+    }
+    if (src) src.close();
+    if (dst) dst.close();
+    if (!ok) {
+        LittleFS.remove(TELEMETRY_SPOOL_TMP);
+        return false;
+    }
+    LittleFS.remove(TELEMETRY_SPOOL_FILE);
+    LittleFS.rename(TELEMETRY_SPOOL_TMP, TELEMETRY_SPOOL_FILE);
+    spoolSize -= spoolOff;
+    spoolOff = 0;
+    return true;
+}
+
+static void closeBatch() {
+    if (!batchLines) return;
+    QueueRecord rec = { (uint16_t)batchLen, batchLines };
+    size_t need = sizeof(rec) + batchLen;
+
+    if (!spoolBatches && ramLen + need <= sizeof(ramQ)) {
+        memcpy(ramQ + ramLen, &rec, sizeof(rec));
+        memcpy(ramQ + ramLen + sizeof(rec), batch, batchLen);
+        ramLen += need;
+        ramBatches++;
+    } else if (spoolSize - spoolOff + need <= TELEMETRY_SPOOL_MAX &&
+               (spoolSize + need <= TELEMETRY_SPOOL_MAX || compactSpool())) {
+        TraceScope trace("fs spool");
+        File f = LittleFS.open(TELEMETRY_SPOOL_FILE, "a");
+        if (f && f.write((const uint8_t*)&rec, sizeof(rec)) == sizeof(rec) &&
+            f.write((const uint8_t*)batch, batchLen) == batchLen) {
+            spoolSize += need;
+            spoolBatches++;
+            batchesSpooled++;
+        } else {
+            linesDropped += batchLines;
+        }
+        if (f) f.close();
+    } else {
+        linesDropped += batchLines;
+    }
+    batchLen = 0;
+    batchLines = 0;
+}
+
+// header of the oldest queued batch
+static bool headRecord(QueueRecord &rec) {
+    if (ramBatches) {
+        memcpy(&rec, ramQ, sizeof(rec));
+        return true;
+    }
+    if (!spoolBatches) return false;
+    File f = LittleFS.open(TELEMETRY_SPOOL_FILE, "r");
+    bool ok = f && f.seek(spoolOff) && f.read((uint8_t*)&rec, sizeof(rec)) == sizeof(rec);
+    if (f) f.close();
+    if (!ok) {
+        // spool lost or damaged: forget it
+        LittleFS.remove(TELEMETRY_SPOOL_FILE);
+        spoolSize = spoolOff = 0;
+        spoolBatches = 0;
+    }
+    return ok;
+}
+
+// hands the payload of the oldest batch to the client (copied)
+static bool addHeadPayload(const QueueRecord &rec) {
+    if (ramBatches) return client.add((const char*)ramQ + sizeof(rec), rec.len) == rec.len;
+    File f = LittleFS.open(TELEMETRY_SPOOL_FILE, "r");
+    if (!f || !f.seek(spoolOff + sizeof(rec))) {
+        if (f) f.close();
+        return false;
+    }
+    char chunk[256];
+    size_t left = rec.len;
+    while (left) {
+        size_t n = f.read((uint8_t*)chunk, left < sizeof(chunk) ? left : sizeof(chunk));
+        if (!n || client.add(chunk, n) != n) break;
+        left -= n;
+    }
+    f.close();
+    return left == 0;
+}
+
+static void popHead() {
+    QueueRecord rec;
+    if (ramBatches) {
+        memcpy(&rec, ramQ, sizeof(rec));
+        size_t n = sizeof(rec) + rec.len;
+        memmove(ramQ, ramQ + n, ramLen - n);
+        ramLen -= n;
+        ramBatches--;
+        return;
+    }
+    if (!headRecord(rec)) return;
+    spoolOff += sizeof(rec) + rec.len;
+    spoolBatches--;
+    if (!spoolBatches) {
+        LittleFS.remove(TELEMETRY_SPOOL_FILE);
+        spoolSize = spoolOff = 0;
+    }
+}
+
+// ---------- link ----------
+
+static void fail(const char *why) {
+    failures++;
+    lastError = why;
+    Serial.printf("Telemetry: %s, retry in %lu ms\n", why, (unsigned long)backoffMs);
+    state = Link::Backoff;   // set first: close() reports a disconnect
+    client.close(true);
+    inFlight = false;
+    retryAtMs = millis() + backoffMs;
+    backoffMs = backoffMs * 2 > TELEMETRY_BACKOFF_MAX ? TELEMETRY_BACKOFF_MAX : backoffMs * 2;
+}
+
+static void send(const void *data, size_t len) {
+    client.add((const char*)data, len);
+    bytesAdded += len;
+}
+
+static size_t putRemainingLength(uint8_t *p, uint32_t n) {
+    size_t i = 0;
+    do {
+        uint8_t b = n & 0x7F;
+        n >>= 7;
+        p[i++] = n ? (b | 0x80) : b;
+    } while (n);
+    return i;
+}
+
+static size_t putString(uint8_t *p, const char *s) {
+    size_t n = strlen(s);
+    p[0] = n >> 8;
+    p[1] = n & 0xFF;
+    memcpy(p + 2, s, n);
+    return n + 2;
+}
+
+static void sendMqttConnect() {
+    char id[20];
+    snprintf(id, sizeof(id), "fz35-%06x", (unsigned)ESP.getChipId());
+    uint8_t var[10] = { 0, 4, 'M', 'Q', 'T', 'T', 4, 0x02 /* clean session */,
+                        0, TELEMETRY_KEEPALIVE_S };
+    uint8_t pkt[48];
+    size_t n = 0;
+    pkt[n++] = 0x10;
+    n += putRemainingLength(pkt + n, sizeof(var) + 2 + strlen(id));
+    memcpy(pkt + n, var, sizeof(var));
+    n += sizeof(var);
+    n += putString(pkt + n, id);
+    send(pkt, n);
+    client.send();
+}
+
+static void startConnect(uint32_t now) {
+    evConnected = evDisconnected = false;
+    evError = nullptr;
+    rxLen = 0;
+    bytesAdded = bytesAcked = 0;
+    inFlight = false;
+    stateMs = now;
+    state = Link::Connecting;
+    connects++;
+    if (!client.connect(cfg.host, cfg.port)) fail("connect failed");
+}
+
+// the head batch with its protocol framing, or false while the TCP buffer is short
+static bool sendHead(uint32_t now) {
+    QueueRecord rec;
+    if (!headRecord(rec)) return false;
+
+    uint8_t hdr[320];
+    size_t n = 0;
+    if (cfg.proto == TelemetryProto::Mqtt) {
+        size_t topicLen = strlen(cfg.topic);
+        hdr[n++] = 0x30; // PUBLISH, QoS 0
+        n += putRemainingLength(hdr + n, 2 + topicLen + rec.len);
+        n += putString(hdr + n, cfg.topic);
+    } else {
+        n = snprintf((char*)hdr, sizeof(hdr),
+                     "POST /write?db=%s&precision=s HTTP/1.1\r\nHost: %s\r\n"
+                     "Content-Type: text/plain\r\nContent-Length: %u\r\nConnection: close\r\n\r\n",
+                     cfg.topic, cfg.host, (unsigned)rec.len);
+    }
+    if (client.space() < n + rec.len) return false;
+
+    send(hdr, n);
+    if (!addHeadPayload(rec)) {
+        fail("spool read");
+        return false;
+    }
+    bytesAdded += rec.len;
+    client.send();
+    inFlight = true;
+    inFlightEnd = bytesAdded;
+    sentMs = now;
+    lastTxMs = now;
+    if (cfg.proto == TelemetryProto::Influx) {
+        rxLen = 0;
+        stateMs = now;
+        state = Link::Waiting;
+    }
+    return true;
+}
+
+static void delivered(uint32_t now) {
+    QueueRecord rec;
+    if (headRecord(rec)) {
+        batchesSent++;
+        linesSent += rec.lines;
+        bytesSent += rec.len;
+        minuteLines += rec.lines;
+        minuteBytes += rec.len;
+    }
+    popHead();
+    inFlight = false;
+    lastDeliveryMs = now - sentMs;
+    if (lastDeliveryMs > maxDeliveryMs) maxDeliveryMs = lastDeliveryMs;
+    backoffMs = TELEMETRY_BACKOFF_MIN;
+}
+
+static void attachHandlers() {
+    client.onConnect([](void*, AsyncClient*) { evConnected = true; });
+    client.onDisconnect([](void*, AsyncClient*) { evDisconnected = true; });
+    client.onError([](void*, AsyncClient*, int8_t) { evError = "tcp error"; });
+    client.onTimeout([](void*, AsyncClient*, uint32_t) { evError = "ack timeout"; });
+    client.onAck([](void*, AsyncClient*, size_t len, uint32_t) { bytesAcked += len; });
+    client.onData([](void*, AsyncClient*, void *data, size_t len) {
+        // only the first bytes matter (CONNACK / HTTP status line)
+        size_t n = len < sizeof(rx) - rxLen ? len : sizeof(rx) - rxLen;
+        memcpy(rx + rxLen, data, n);
+        rxLen += n;
+    });
+}
+
+// ---------- public ----------
+
+void initTelemetry() {
+    setDefaults();
+    File f = LittleFS.open(TELEMETRY_CONFIG_FILE, "r");
+    TelemetryConfig stored;
+    if (f && f.read((uint8_t*)&stored, sizeof(stored)) == sizeof(stored) &&
+        stored.magic == TELEMETRY_CONFIG_MAGIC) {
+        cfg = stored;
+        cfg.host[sizeof(cfg.host) - 1] = '\0';
+        cfg.topic[sizeof(cfg.topic) - 1] = '\0';
+    }
+    if (f) f.close();
+
+    // batches spooled before a reboot are sent again (at least once);
+    // a reset between remove and rename in compactSpool() leaves only the tmp file
+    if (!LittleFS.exists(TELEMETRY_SPOOL_FILE) && LittleFS.exists(TELEMETRY_SPOOL_TMP)) {
+        LittleFS.rename(TELEMETRY_SPOOL_TMP, TELEMETRY_SPOOL_FILE);
+    }
+    f = LittleFS.open(TELEMETRY_SPOOL_FILE, "r");
+    if (f) {
+        QueueRecord rec;
+        uint32_t size = f.size();
+        while (spoolSize + sizeof(rec) <= size && f.read((uint8_t*)&rec, sizeof(rec)) == sizeof(rec) &&
+               rec.len <= TELEMETRY_BATCH_BYTES && spoolSize + sizeof(rec) + rec.len <= size) {
+            f.seek(spoolSize + sizeof(rec) + rec.len);
+            spoolSize += sizeof(rec) + rec.len;
+            spoolBatches++;
+        }
+        f.close();
+        if (!spoolBatches) LittleFS.remove(TELEMETRY_SPOOL_FILE);
+        else Serial.printf("Telemetry: %u spooled batches pending\n", spoolBatches);
+    }
+
+    attachHandlers();
+    memRegister("Telemetry", "batch + queue", MemKind::Static, sizeof(batch) + sizeof(ramQ));
+}
+
+const TelemetryConfig &telemetryConfig() {
+    return pendingConfig ? pendingCfg : cfg;
+}
+
+// host and topic end up in JSON, an URL and an MQTT topic: printable, no quoting needed
+static bool plainText(const char *s, size_t cap) {
+    if (!memchr(s, 0, cap)) return false;
+    for (; *s; ++s) {
+        if (*s <= ' ' || *s > '~' || strchr("\"\\&?#+%", *s)) return false;
+    }
+    return true;
+}
+
+bool telemetryConfigure(const TelemetryConfig &next) {
+    if (next.enabled && (!next.host[0] || !next.port || !next.topic[0])) return false;
+    if (next.batchSamples < 1 || next.batchSamples > 500) return false;
+    if (next.interval_s < 1 || next.interval_s > 3600) return false;
+    if (!plainText(next.host, sizeof(next.host)) || !plainText(next.topic, sizeof(next.topic))) return false;
+    pendingCfg = next;
+    pendingCfg.magic = TELEMETRY_CONFIG_MAGIC;
+    pendingConfig = true;
+    return true;
+}
+
+// the batch is closed with the old batch size, then the link restarts with the new settings
+static void applyConfig() {
+    pendingConfig = false;
+    closeBatch();
+    state = Link::Idle;
+    client.close(true);
+    inFlight = false;
+    backoffMs = TELEMETRY_BACKOFF_MIN;
+    cfg = pendingCfg;
+
+    File f = LittleFS.open(TELEMETRY_CONFIG_FILE, "w");
+    if (f) {
+        f.write((const uint8_t*)&cfg, sizeof(cfg));
+        f.close();
+    }
+    Serial.printf("Telemetry: %s %s://%s:%u/%s\n", cfg.enabled ? "on" : "off",
+                  cfg.proto == TelemetryProto::Mqtt ? "mqtt" : "influx",
+                  cfg.host, cfg.port, cfg.topic);
+}
+
+// tag values: backslash before space, comma and '='
+static size_t escapeTag(char *dst, size_t cap, const char *s) {
+    size_t n = 0;
+    for (; *s && n + 2 < cap; ++s) {
+        if (*s == ' ' || *s == ',' || *s == '=') dst[n++] = '\\';
+        dst[n++] = *s;
+    }
+    dst[n] = '\0';
+    return n;
+}
+
+void telemetryAddSample(const Measurement &m, const char *battery, bool testRunning) {
+    if (!cfg.enabled) return;
+    samples++;
+
+    char line[192];
+    size_t n = snprintf(line, sizeof(line), "fz35,dev=%06x,battery=", (unsigned)ESP.getChipId());
+    n += escapeTag(line + n, 80, battery && *battery ? battery : "none");
+    const struct { const char *key; int32_t milli; } fields[] = {
+        { " v=", m.voltage_mV }, { ",i=", m.current_mA }, { ",p=", m.power_mW }, { ",ah=", m.capacity_mAh } };
+    for (const auto &fld : fields) {
+        n += snprintf(line + n, sizeof(line) - n, "%s", fld.key);
+        n += formatMilli(line + n, sizeof(line) - n, fld.milli, 3);
+    }
+    n += snprintf(line + n, sizeof(line) - n, ",test=%di", testRunning ? 1 : 0);
+    time_t now = time(nullptr);
+    if (now > 100000) n += snprintf(line + n, sizeof(line) - n, " %lu", (unsigned long)now);
+    line[n++] = '\n';
+
+    if (batchLen + n > sizeof(batch)) closeBatch();
+    if (!batchLines) batchStartMs = millis();
+    memcpy(batch + batchLen, line, n);
+    batchLen += n;
+    batchLines++;
+    if (batchLines >= cfg.batchSamples) closeBatch();
+}
+
+void telemetryTick() {
+    uint32_t now = millis();
+    if (pendingConfig) applyConfig();
+    if (now - minuteStartMs >= 60000) {
+        lastMinuteLines = minuteLines;
+        lastMinuteBytes = minuteBytes;
+        minuteLines = minuteBytes = 0;
+        minuteStartMs = now;
+    }
+    if (!cfg.enabled) {
+        if (state != Link::Idle) {
+            state = Link::Idle;
+            client.close(true);
+        }
+        return;
+    }
+    if (batchLines && now - batchStartMs >= cfg.interval_s * 1000UL) closeBatch();
+
+    // completions first: a server may answer and close in the same poll
+    if (state == Link::Ready && inFlight && (int32_t)(bytesAcked - inFlightEnd) >= 0) delivered(now);
+    if (state == Link::Waiting && rxLen >= 12) {
+        int code = memcmp(rx, "HTTP/1.", 7) ? 0 : atoi((const char*)rx + 9);
+        if (code >= 200 && code < 300) {
+            delivered(now);
+        } else if (code >= 400 && code < 500 && code != 408 && code != 429) {
+            // the server will never take this batch
+            batchesRejected++;
+            lastError = "batch rejected";
+            popHead();
+            inFlight = false;
+        } else {
+            fail(code ? "server error" : "bad response");
+            return;
+        }
+        state = Link::Idle;
+        client.close(true);
+        evDisconnected = false;
+        return;
+    }
+    if (evError && state != Link::Backoff && state != Link::Idle) {
+        fail(evError);
+        return;
+    }
+    if (evDisconnected) {
+        evDisconnected = false;
+        if (state != Link::Backoff && state != Link::Idle) {
+            fail("connection lost");
+            return;
+        }
+    }
+
+    switch (state) {
+    case Link::Backoff:
+        if ((int32_t)(now - retryAtMs) < 0) break;
+        state = Link::Idle;
+        // fall through
+    case Link::Idle:
+        // without a station link a connect can only fail (and grow the backoff)
+        if (queuedBatches() && wifiStationUp()) startConnect(now);
+        break;
+    case Link::Connecting:
+        if (evConnected) {
+            evConnected = false;
+            stateMs = now;
+            lastTxMs = now;
+            if (cfg.proto == TelemetryProto::Mqtt) {
+                sendMqttConnect();
+                state = Link::Handshake;
+            } else {
+                state = Link::Ready;
+            }
+        } else if (now - stateMs > TELEMETRY_TIMEOUT_MS) {
+            fail("connect timeout");
+        }
+        break;
+    case Link::Handshake:
+        if (rxLen >= 4) {
+            if (rx[0] != 0x20 || rx[3] != 0) {
+                fail("connack refused");
+                break;
+            }
+            rxLen = 0;
+            state = Link::Ready;
+        } else if (now - stateMs > TELEMETRY_TIMEOUT_MS) {
+            fail("no connack");
+        }
+        break;
+    case Link::Ready:
+        if (!inFlight && queuedBatches()) {
+            sendHead(now);
+        } else if (inFlight && now - sentMs > TELEMETRY_TIMEOUT_MS) {
+            fail("no tcp ack");
+        } else if (!inFlight && now - lastTxMs > TELEMETRY_KEEPALIVE_S * 500UL) {
+            static const uint8_t ping[2] = { 0xC0, 0x00 };
+            send(ping, sizeof(ping));
+            client.send();
+            lastTxMs = now;
+        }
+        break;
+    case Link::Waiting:
+        if (now - stateMs > TELEMETRY_TIMEOUT_MS) fail("no response");
+        break;
+    }
+}
+
+String telemetryConfigJson() {
+    const TelemetryConfig &cfg = telemetryConfig();
+    String json = "{\"enabled\":" + String(cfg.enabled ? "true" : "false");
+    json += ",\"proto\":\"" + String(cfg.proto == TelemetryProto::Mqtt ? "mqtt" : "influx") + "\"";
+    json += ",\"host\":\"" + String(cfg.host) + "\"";
+    json += ",\"port\":" + String(cfg.port);
+    json += ",\"topic\":\"" + String(cfg.topic) + "\"";
+    json += ",\"batch\":" + String(cfg.batchSamples);
+    json += ",\"interval\":" + String(cfg.interval_s) + "}";
+    return json;
+}
+
+void telemetryNetworkUp() {
+    backoffMs = TELEMETRY_BACKOFF_MIN;
+    if (state == Link::Backoff) retryAtMs = millis();
+}
+
+String telemetryStatusJson() {
+    static const char *const names[] = { "idle", "connecting", "handshake", "ready", "waiting", "backoff" };
+    String json = "{\"enabled\":" + String(cfg.enabled ? "true" : "false");
+    json += ",\"link\":\"" + String(names[(int)state]) + "\"";
+    json += ",\"samples\":" + String((unsigned long)samples);
+    json += ",\"open_lines\":" + String(batchLines);
+    json += ",\"queued_batches\":" + String(queuedBatches());
+    json += ",\"ram_bytes\":" + String((unsigned long)ramLen);
+    json += ",\"spool_bytes\":" + String((unsigned long)(spoolSize - spoolOff));
+    json += ",\"spooled\":" + String((unsigned long)batchesSpooled);
+    json += ",\"dropped_lines\":" + String((unsigned long)linesDropped);
+    json += ",\"rejected\":" + String((unsigned long)batchesRejected);
+    json += ",\"sent_batches\":" + String((unsigned long)batchesSent);
+    json += ",\"sent_lines\":" + String((unsigned long)linesSent);
+    json += ",\"sent_bytes\":" + String((unsigned long)bytesSent);
+    json += ",\"lines_last_min\":" + String((unsigned long)lastMinuteLines);
+    json += ",\"bytes_last_min\":" + String((unsigned long)lastMinuteBytes);
+    json += ",\"delivery_ms\":" + String((unsigned long)lastDeliveryMs);
+    json += ",\"delivery_ms_max\":" + String((unsigned long)maxDeliveryMs);
+    json += ",\"connects\":" + String((unsigned long)connects);
+    json += ",\"failures\":" + String((unsigned long)failures);
+    json += ",\"last_error\":\"" + String(lastError) + "\"}";
+    return json;
+}
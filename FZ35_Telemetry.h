@@ -0,0 +1,81 @@
+#pragma once
+#include <Arduino.h>
+#include "FZ35_Fixed.h"
+
+/**
+ * @file FZ35_Telemetry.h
+ * @brief Outbound telemetry: every sample becomes one InfluxDB line-protocol line,
+ *        lines are batched (TELEMETRY_BATCH_BYTES, cfg.batchSamples or cfg.interval_s,
+ *        whichever comes first) and each batch is published either as one MQTT 3.1.1
+ *        QoS 0 message or as one HTTP POST to an InfluxDB /write endpoint.
+ *
+ *        Closed batches wait in a RAM queue; when it is full (broker unreachable) they
+ *        are appended to a bounded spool file and sent oldest first once the broker is
+ *        back. A batch leaves the queue when TCP has acknowledged it (MQTT) or the
+ *        server answered 2xx (InfluxDB). Connection handling is non-blocking
+ *        (AsyncClient callbacks + telemetryTick() from loop()).
+ *
+ * Line: fz35,dev=<chip id>,battery=<profile> v=3.912,i=1.000,p=3.912,ah=0.123,test=1i <epoch s>
+ * (timestamp omitted until the clock is synced; the server then stamps on arrival).
+ */
+
+#define TELEMETRY_CONFIG_FILE  "/telemetry.bin"
+#define TELEMETRY_CONFIG_MAGIC 0x4C545A46UL   // "FZTL"
+#define TELEMETRY_SPOOL_FILE   "/telemetry.spool"
+#define TELEMETRY_SPOOL_TMP    "/telemetry.spool.tmp"
+#define TELEMETRY_BATCH_BYTES  1024           // one open batch (payload only)
+#define TELEMETRY_RAM_BYTES    4096           // closed batches waiting in RAM
+#define TELEMETRY_SPOOL_MAX    (64UL * 1024)  // unsent spool bytes; newer batches are dropped beyond it
+#define TELEMETRY_TIMEOUT_MS   10000          // connect / CONNACK / HTTP response
+#define TELEMETRY_BACKOFF_MIN  2000
+#define TELEMETRY_BACKOFF_MAX  60000
+#define TELEMETRY_KEEPALIVE_S  60             // MQTT keepalive (PINGREQ at half of it when idle)
+
+enum class TelemetryProto : uint8_t {
+    Mqtt,      // PUBLISH <topic>, payload = batch of lines
+    Influx     // POST /write?db=<topic>&precision=s, one connection per batch
+};
+
+/**
+ * @struct TelemetryConfig
+ * @brief Persisted settings. topic is the MQTT topic or the InfluxDB database.
+ */
+struct TelemetryConfig {
+    uint32_t magic;
+    uint8_t enabled;
+    TelemetryProto proto;
+    uint16_t port;
+    uint16_t batchSamples;   // close a batch after this many lines
+    uint16_t interval_s;     // ... or when its first line is this old
+    char host[64];
+    char topic[64];
+};
+
+void initTelemetry();
+
+/**
+ * @brief Check and queue a new configuration; the next telemetryTick() saves it and
+ *        drops the current connection. Safe to call from a request handler.
+ * @return false if the values are out of range (nothing changed).
+ */
+bool telemetryConfigure(const TelemetryConfig &cfg);
+/** @brief The configuration in use, or the queued one until telemetryTick() applies it. */
+const TelemetryConfig &telemetryConfig();
+
+/**
+ * @brief Append one sample to the open batch. Called from the sample path in loop().
+ */
+void telemetryAddSample(const Measurement &m, const char *battery, bool testRunning);
+
+/**
+ * @brief Close due batches, (re)connect with backoff and send the oldest batch.
+ */
+void telemetryTick();
+
+/**
+ * @brief The WiFi station is (back) up: a link in backoff retries now.
+ */
+void telemetryNetworkUp();
+
+String telemetryConfigJson();
+String telemetryStatusJson();
@@ -0,0 +1,205 @@
+#include "FZ35_TestIndex.h"
+#include "FZ35_Memory.h"
+#include "FZ35_Trace.h"
+
+/**
+ * @file FZ35_TestIndex.cpp
+ * @brief Type table, posting files and range queries.
+ */
+
+/**
+ * @struct TestIndexHeader
+ * @brief types.bin header; csvSize ties the table to the CSV it was built from.
+ */
+struct TestIndexHeader {
+    uint32_t magic;
+    uint16_t recordSize;
+    uint16_t count;
+    uint32_t csvSize;
+};
+
+static TestTypeStats *types = nullptr;
+static int typeCount = 0;
+static int typeCapacity = 0;
+static File bulkFile;        // posting file kept open during a rebuild
+static int bulkId = -1;
+static int memId = -1;
+
+static String postingPath(uint16_t id) {
+    return String(TEST_INDEX_DIR) + "/" + String(id) + ".idx";
+}
+
+static void saveTypes(uint32_t csvSize) {
+    File f = LittleFS.open(TEST_INDEX_TYPES, "w");
+    if (!f) {
+        Serial.println("Failed to write test index");
+        return;
+    }
+    TestIndexHeader hdr = { TEST_INDEX_MAGIC, sizeof(TestTypeStats), (uint16_t)typeCount, csvSize };
+    f.write((const uint8_t*)&hdr, sizeof(hdr));
+    f.write((const uint8_t*)types, typeCount * sizeof(TestTypeStats));
+    f.close();
+}
+
+static bool growTypes() {
+    if (typeCount < typeCapacity) return true;
+    if (typeCapacity >= MAX_TEST_TYPES) return false;
+    int cap = typeCapacity + 8;
+    TestTypeStats *t = (TestTypeStats*)realloc(types, cap * sizeof(TestTypeStats));
+    if (!t) return false;
+    types = t;
+    typeCapacity = cap;
+    if (memId < 0) memId = memRegister("TestIndex", "type table", MemKind::Heap, 0);
+    memUpdate(memId, cap * sizeof(TestTypeStats));
+    return true;
+}
+
+bool testIndexLoad(uint32_t csvSize) {
+    typeCount = 0;
+    LittleFS.mkdir(TEST_INDEX_DIR);
+    File f = LittleFS.open(TEST_INDEX_TYPES, "r");
+    if (!f) return false;
+    TestIndexHeader hdr = {};
+    bool ok = f.read((uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr) && hdr.magic == TEST_INDEX_MAGIC &&
+              hdr.recordSize == sizeof(TestTypeStats) && hdr.csvSize == csvSize && hdr.count <= MAX_TEST_TYPES;
+    for (int i = 0; ok && i < hdr.count; ++i) {
+        ok = growTypes() && f.read((uint8_t*)&types[typeCount], sizeof(TestTypeStats)) == sizeof(TestTypeStats);
+        if (ok) typeCount++;
+    }
+    f.close();
+    if (!ok) typeCount = 0;
+    return ok;
+}
+
+void testIndexClear() {
+    // every possible posting file, not just the loaded types: a stale table (the case
+    // that leads here) lists none, and a rebuild appends to whatever is left
+    for (uint16_t id = 0; id < MAX_TEST_TYPES; ++id) {
+        String path = postingPath(id);
+        if (LittleFS.exists(path)) LittleFS.remove(path.c_str());
+    }
+    LittleFS.remove(TEST_INDEX_TYPES);
+    LittleFS.mkdir(TEST_INDEX_DIR);
+    typeCount = 0;
+}
+
+const TestTypeStats *findTestType(const char *name) {
+    for (int i = 0; i < typeCount; ++i) {
+        if (strcmp(types[i].name, name) == 0) return &types[i];
+    }
+    return nullptr;
+}
+
+int testTypeCount() { return typeCount; }
+
+const TestTypeStats *testTypeAt(int i) {
+    return (i >= 0 && i < typeCount) ? &types[i] : nullptr;
+}
+
+void testIndexAdd(const char *type, uint32_t stamp, int32_t capacity_mAh, uint32_t csvOffset, bool bulk) {
+    TestTypeStats *t = (TestTypeStats*)findTestType(type);
+    if (!t) {
+        if (!growTypes()) {
+            Serial.printf("Test index: no room for type %s (max %d)\n", type, MAX_TEST_TYPES);
+            return;
+        }
+        t = &types[typeCount];
+        memset(t, 0, sizeof(*t));
+        strncpy(t->name, type, sizeof(t->name) - 1);
+        t->id = (uint16_t)typeCount;
+        t->min_mAh = INT32_MAX;
+        t->max_mAh = INT32_MIN;
+        typeCount++;
+    } else if (stamp < t->lastStamp) {
+        // saved before NTP sync or after the clock was set back: no binary search
+        t->flags |= TEST_TYPE_UNORDERED;
+    }
+
+    TestIndexEntry e = { stamp, capacity_mAh, csvOffset };
+    TraceScope trace("fs index");
+    if (bulk) {
+        if (bulkId != t->id) {
+            if (bulkFile) bulkFile.close();
+            bulkFile = LittleFS.open(postingPath(t->id).c_str(), "a");
+            bulkId = t->id;
+        }
+        if (bulkFile) bulkFile.write((const uint8_t*)&e, sizeof(e));
+    } else {
+        File f = LittleFS.open(postingPath(t->id).c_str(), "a");
+        if (!f) {
+            Serial.println("Failed to append test index");
+            return;
+        }
+        f.write((const uint8_t*)&e, sizeof(e));
+        f.close();
+    }
+
+    t->count++;
+    t->sum_mAh += capacity_mAh;
+    if (capacity_mAh < t->min_mAh) t->min_mAh = capacity_mAh;
+    if (capacity_mAh > t->max_mAh) t->max_mAh = capacity_mAh;
+    t->last_mAh = capacity_mAh;
+    t->lastStamp = stamp;
+}
+
+/**
+ * @brief Persist the type table for a CSV of csvSize bytes (also ends a bulk rebuild).
+ */
+void testIndexCommit(uint32_t csvSize) {
+    if (bulkFile) bulkFile.close();
+    bulkId = -1;
+    saveTypes(csvSize);
+}
+
+static bool readEntry(File &f, uint32_t i, TestIndexEntry &e) {
+    return f.seek(i * sizeof(TestIndexEntry), SeekSet) &&
+           f.read((uint8_t*)&e, sizeof(e)) == sizeof(e);
+}
+
+bool testIndexQuery(const TestTypeStats &type, uint32_t fromStamp, uint32_t toStamp,
+                    uint8_t maxOffsets, TestQueryResult &out) {
+    memset(&out, 0, sizeof(out));
+    out.min_mAh = INT32_MAX;
+    out.max_mAh = INT32_MIN;
+    if (maxOffsets > sizeof(out.offsets) / sizeof(out.offsets[0])) maxOffsets = sizeof(out.offsets) / sizeof(out.offsets[0]);
+
+    File f = LittleFS.open(postingPath(type.id).c_str(), "r");
+    if (!f) return false;
+    uint32_t n = f.size() / sizeof(TestIndexEntry);
+
+    // postings are in save order; while that is also stamp order, the range starts at
+    // the first stamp >= fromStamp and ends at the first one past toStamp. Otherwise
+    // every posting is checked.
+    bool ordered = !(type.flags & TEST_TYPE_UNORDERED);
+    uint32_t lo = 0, hi = ordered ? n : 0;
+    TestIndexEntry e;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (!readEntry(f, mid, e)) { f.close(); return false; }
+        if (e.stamp < fromStamp) lo = mid + 1; else hi = mid;
+    }
+
+    // newest matches are kept in a small ring, reported newest first
+    uint32_t ring[sizeof(out.offsets) / sizeof(out.offsets[0])];
+    uint32_t seen = 0;
+    f.seek(lo * sizeof(TestIndexEntry), SeekSet);
+    for (uint32_t i = lo; i < n; ++i) {
+        if (f.read((uint8_t*)&e, sizeof(e)) != sizeof(e)) break;
+        if (e.stamp < fromStamp || e.stamp > toStamp) {
+            if (ordered) break;
+            continue;
+        }
+        out.count++;
+        out.sum_mAh += e.capacity_mAh;
+        if (e.capacity_mAh < out.min_mAh) out.min_mAh = e.capacity_mAh;
+        if (e.capacity_mAh > out.max_mAh) out.max_mAh = e.capacity_mAh;
+        out.last_mAh = e.capacity_mAh;
+        out.lastStamp = e.stamp;
+        if (maxOffsets) ring[seen++ % maxOffsets] = e.csvOffset;
+    }
+    f.close();
+
+    out.offsetCount = (uint8_t)(seen < maxOffsets ? seen : maxOffsets);
+    for (uint8_t i = 0; i < out.offsetCount; ++i) out.offsets[i] = ring[(seen - 1 - i) % maxOffsets];
+    return true;
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "FZ35_LogFormat.h"
+
+/**
+ * @file FZ35_TestIndex.h
+ * @brief Secondary index over the test log CSV, keyed by battery type.
+ *        RAM: one entry per type with running aggregates (count, mean, min, max, last),
+ *        updated in O(1) per saved result. Flash: one posting file per type with
+ *        fixed 12-byte records (stamp, capacity, CSV offset) in save order, so a date
+ *        range is found by binary search and only the matching records are read.
+ *        The CSV stays the source of truth; the index is rebuilt from it if stale.
+ */
+
+#define TEST_INDEX_DIR    "/tl"
+#define TEST_INDEX_TYPES  "/tl/types.bin"
+#define TEST_INDEX_MAGIC  0x32495446UL // "FTI2" (was "FTIX" before the flags)
+#define MAX_TEST_TYPES    64
+#define TEST_TYPE_NAME_LEN 50          // = TestResult::batteryType
+
+/**
+ * @struct TestTypeStats
+ * @brief Aggregates of every logged result of one battery type (capacity in mAh).
+ */
+struct TestTypeStats {
+    char name[TEST_TYPE_NAME_LEN];
+    uint16_t id;         // posting file /tl/<id>.idx
+    uint16_t flags;      // TEST_TYPE_*
+    uint32_t count;
+    int64_t sum_mAh;
+    int32_t min_mAh;
+    int32_t max_mAh;
+    int32_t last_mAh;
+    uint32_t lastStamp;  // minutes since 1970-01-01 (device local time)
+};
+#define TEST_TYPE_UNORDERED 0x0001   // a stamp went backwards: range queries scan
+
+/**
+ * @struct TestIndexEntry
+ * @brief One posting record (file format).
+ */
+struct TestIndexEntry {
+    uint32_t stamp;
+    int32_t capacity_mAh;
+    uint32_t csvOffset;
+};
+static_assert(sizeof(TestIndexEntry) == 12, "TestIndexEntry layout is part of the file format");
+
+/**
+ * @struct TestQueryResult
+ * @brief Aggregates over a date range of one type, plus the newest matching offsets.
+ */
+struct TestQueryResult {
+    uint32_t count;
+    int64_t sum_mAh;
+    int32_t min_mAh;
+    int32_t max_mAh;
+    int32_t last_mAh;
+    uint32_t lastStamp;
+    uint8_t offsetCount;   // newest first
+    uint32_t offsets[50];
+};
+
+/**
+ * @brief Load the persisted type table; false if it does not describe a CSV of csvSize bytes.
+ */
+bool testIndexLoad(uint32_t csvSize);
+void testIndexClear();
+
+/**
+ * @brief Index one result. bulk = rebuild mode (defer the type table write to testIndexCommit()).
+ */
+void testIndexAdd(const char *type, uint32_t stamp, int32_t capacity_mAh, uint32_t csvOffset, bool bulk);
+void testIndexCommit(uint32_t csvSize);
+
+int testTypeCount();
+const TestTypeStats *testTypeAt(int i);
+const TestTypeStats *findTestType(const char *name);
+
+/**
+ * @brief Range query [fromStamp, toStamp] on one type's postings (binary search + range
+ * read; a linear scan for a type with TEST_TYPE_UNORDERED).
+ */
+bool testIndexQuery(const TestTypeStats &type, uint32_t fromStamp, uint32_t toStamp,
+                    uint8_t maxOffsets, TestQueryResult &out);
+
+// testStampFromDate() / testStampToDate(): FZ35_LogFormat.h
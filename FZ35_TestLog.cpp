@@ -1,24 +1,97 @@
 #include "FZ35_TestLog.h"
+#include "FZ35_TestIndex.h"
+#include "FZ35_Fixed.h"
+#include "FZ35_Memory.h"
+#include "FZ35_Trace.h"
 #include <time.h>
 
 /**
  * @file FZ35_TestLog.cpp
  * @brief Implements load/save/clear of test results plus JSON serialization.
+ *        The CSV file keeps every result; testResults[] holds the newest
+ *        MAX_TEST_RESULTS and FZ35_TestIndex answers per-type queries over all.
  */
 
 TestResult testResults[MAX_TEST_RESULTS];
 int testResultCount = 0;
+uint32_t testLogGeneration = 0;
+
+/**
+ * @brief Parse one CSV line: date,batteryType,finalAh,timeHours[,dcirMilliOhm]
+ */
+static bool parseLogLine(const String &line, TestResult &r) {
+    TestLogRow row;   // same parser as the host tools (FZ35_LogFormat.h)
+    if (!parseTestLogLine(line.c_str(), line.length(), row)) return false;
+    memcpy(r.date, row.date, sizeof(r.date));
+    memcpy(r.batteryType, row.batteryType, sizeof(r.batteryType));
+    r.finalAh = row.capacity_mAh / 1000.0f;
+    r.testTimeHours = row.time_cH / 100.0f;
+    r.dcirMilliOhm = row.dcir_cmOhm / 100.0f;
+    r.valid = true;
+    return true;
+}
+
+/**
+ * @brief Append to the RAM FIFO, dropping the oldest entry when full.
+ */
+static void pushResult(const TestResult &r) {
+    if (testResultCount >= MAX_TEST_RESULTS) {
+        // shift array left to make room (FIFO)
+        for (int i = 0; i < MAX_TEST_RESULTS - 1; i++) {
+            testResults[i] = testResults[i + 1];
+        }
+        testResultCount = MAX_TEST_RESULTS - 1;
+    }
+    testResults[testResultCount++] = r;
+}
+
+/**
+ * @brief Rebuild the per-type index with one pass over the CSV.
+ */
+static void rebuildTestIndex() {
+    testIndexClear();
+    File f = LittleFS.open(TEST_LOG_FILE, "r");
+    uint32_t size = 0;
+    if (f) {
+        size = f.size();
+        TestResult r;
+        while (f.available()) {
+            uint32_t offset = f.position();
+            String line = f.readStringUntil('\n');
+            line.trim();
+            if (line.length() == 0 || !parseLogLine(line, r)) continue;
+            testIndexAdd(r.batteryType, testStampFromDate(r.date), (int32_t)lroundf(r.finalAh * 1000.0f), offset, true);
+            yield();
+        }
+        f.close();
+    }
+    testIndexCommit(size);
+    Serial.printf("Rebuilt test index: %d battery types\n", testTypeCount());
+}
 
 void initTestLog() {
+    memRegister("TestLog", "testResults", MemKind::Static, sizeof(testResults));
     if (!LittleFS.begin()) {
         Serial.println("Failed to mount LittleFS");
         return;
     }
     loadTestLog();
+
+    uint32_t size = 0;
+    if (LittleFS.exists(TEST_LOG_FILE)) {
+        File f = LittleFS.open(TEST_LOG_FILE, "r");
+        if (f) { size = f.size(); f.close(); }
+    }
+    if (!testIndexLoad(size)) rebuildTestIndex();
 }
 
+/**
+ * @brief Load the newest MAX_TEST_RESULTS lines into RAM. Reads a window from the
+ * end of the file (doubled until it holds enough lines) instead of the whole log.
+ */
 void loadTestLog() {
     testResultCount = 0;
+    testLogGeneration++;
     if (!LittleFS.exists(TEST_LOG_FILE)) {
         Serial.println("No test log file found, starting fresh");
         return;
@@ -30,25 +103,23 @@ void loadTestLog() {
         return;
     }
     
-    while (f.available() && testResultCount < MAX_TEST_RESULTS) {
-        String line = f.readStringUntil('\n');
-        line.trim();
-        if (line.length() == 0) continue;
-        
-        // CSV format: date,batteryType,finalAh,timeHours
-        int comma1 = line.indexOf(',');
-        int comma2 = line.indexOf(',', comma1 + 1);
-        int comma3 = line.indexOf(',', comma2 + 1);
-        
-        if (comma1 > 0 && comma2 > comma1 && comma3 > comma2) {
-            TestResult &r = testResults[testResultCount];
-            line.substring(0, comma1).toCharArray(r.date, sizeof(r.date));
-            line.substring(comma1 + 1, comma2).toCharArray(r.batteryType, sizeof(r.batteryType));
-            r.finalAh = line.substring(comma2 + 1, comma3).toFloat();
-            r.testTimeHours = line.substring(comma3 + 1).toFloat();
-            r.valid = true;
-            testResultCount++;
+    size_t size = f.size();
+    size_t window = MAX_TEST_RESULTS * 96;
+    while (true) {
+        size_t start = size > window ? size - window : 0;
+        testResultCount = 0;
+        f.seek(start, SeekSet);
+        if (start > 0) f.readStringUntil('\n'); // skip the partial first line
+
+        TestResult r;
+        while (f.available()) {
+            String line = f.readStringUntil('\n');
+            line.trim();
+            if (line.length() == 0) continue;
+            if (parseLogLine(line, r)) pushResult(r);
         }
+        if (start == 0 || testResultCount >= MAX_TEST_RESULTS) break;
+        window *= 2;
     }
     f.close();
     Serial.printf("Loaded %d test results\n", testResultCount);
@@ -57,16 +128,8 @@ void loadTestLog() {
 /**
  * @brief Append result to memory + CSV (FIFO trim when full).
  */
-void saveTestResult(const char* batteryName, float finalAh, float timeHours) {
-    if (testResultCount >= MAX_TEST_RESULTS) {
-        // shift array left to make room (FIFO)
-        for (int i = 0; i < MAX_TEST_RESULTS - 1; i++) {
-            testResults[i] = testResults[i + 1];
-        }
-        testResultCount = MAX_TEST_RESULTS - 1;
-    }
-    
-    TestResult &r = testResults[testResultCount];
+void saveTestResult(const char* batteryName, float finalAh, float timeHours, float dcirMilliOhm) {
+    TestResult r;
     
     // Get current time (requires NTP setup or user input)
     time_t now = time(nullptr);
@@ -79,14 +142,21 @@ void saveTestResult(const char* batteryName, float finalAh, float timeHours) {
     r.batteryType[sizeof(r.batteryType) - 1] = '\0';
     r.finalAh = finalAh;
     r.testTimeHours = timeHours;
+    r.dcirMilliOhm = dcirMilliOhm;
     r.valid = true;
-    testResultCount++;
+    pushResult(r);
+    testLogGeneration++;
     
-    // Append to file
+    // Append to file, then index the new line by its offset
+    TraceScope trace("fs testlog");
     File f = LittleFS.open(TEST_LOG_FILE, "a");
     if (f) {
-        f.printf("%s,%s,%.3f,%.2f\n", r.date, r.batteryType, r.finalAh, r.testTimeHours);
+        uint32_t offset = f.size();
+        f.printf("%s,%s,%.3f,%.2f,%.2f\n", r.date, r.batteryType, r.finalAh, r.testTimeHours, r.dcirMilliOhm);
+        uint32_t size = f.size();
         f.close();
+        testIndexAdd(r.batteryType, testStampFromDate(r.date), (int32_t)lroundf(r.finalAh * 1000.0f), offset, false);
+        testIndexCommit(size);
         Serial.printf("Saved test result: %s - %.3f Ah\n", r.batteryType, r.finalAh);
     } else {
         Serial.println("Failed to save test result");
@@ -105,7 +175,8 @@ String getTestResultsJson() {
         json += "\"date\":\"" + String(r.date) + "\",";
         json += "\"battery\":\"" + String(r.batteryType) + "\",";
         json += "\"capacity\":" + String(r.finalAh, 3) + ",";
-        json += "\"time\":" + String(r.testTimeHours, 2);
+        json += "\"time\":" + String(r.testTimeHours, 2) + ",";
+        json += "\"dcir\":" + (r.dcirMilliOhm > 0 ? String(r.dcirMilliOhm, 2) : String("null"));
         json += "}";
     }
     json += "]}";
@@ -114,6 +185,91 @@ String getTestResultsJson() {
 
 void clearTestLog() {
     testResultCount = 0;
+    testLogGeneration++;
     LittleFS.remove(TEST_LOG_FILE);
+    testIndexClear();
     Serial.println("Test log cleared");
 }
+
+static void addMilliField(String &json, const char *key, int64_t mAh) {
+    char num[16];
+    formatFixed(num, sizeof(num), mAh, 3, 3);
+    json += ",\"";
+    json += key;
+    json += "\":";
+    json += num;
+}
+
+/**
+ * @brief Whole-history aggregates of every battery type (from RAM, no file access).
+ */
+String getTestTypesJson() {
+    String json = "{\"types\":[";
+    char date[20];
+    for (int i = 0; i < testTypeCount(); ++i) {
+        const TestTypeStats *t = testTypeAt(i);
+        if (i) json += ",";
+        json += "{\"battery\":\"" + String(t->name) + "\",\"count\":" + String((unsigned long)t->count);
+        if (t->count) {
+            addMilliField(json, "mean", t->sum_mAh / (int64_t)t->count);
+            addMilliField(json, "min", t->min_mAh);
+            addMilliField(json, "max", t->max_mAh);
+            addMilliField(json, "last", t->last_mAh);
+            testStampToDate(t->lastStamp, date, sizeof(date));
+            json += ",\"last_date\":\"" + String(date) + "\"";
+        }
+        json += "}";
+    }
+    json += "]}";
+    return json;
+}
+
+// the queried name is echoed as given: quoted and escaped
+static String jsonText(const char *s) {
+    String out = "\"";
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') out += '\\';
+        if ((uint8_t)*s >= 0x20) out += *s;
+    }
+    return out + "\"";
+}
+
+/**
+ * @brief Aggregates of one type over [fromStamp, toStamp] plus up to `limit` newest
+ * matching results, read from the CSV at their indexed offsets.
+ */
+String getTestQueryJson(const char *batteryType, uint32_t fromStamp, uint32_t toStamp, uint8_t limit) {
+    const TestTypeStats *t = findTestType(batteryType);
+    String json = "{\"battery\":" + jsonText(batteryType);
+    TestQueryResult q;
+    if (!t || !testIndexQuery(*t, fromStamp, toStamp, limit, q)) {
+        json += ",\"count\":0,\"results\":[]}";
+        return json;
+    }
+    json += ",\"count\":" + String((unsigned long)q.count);
+    if (q.count) {
+        addMilliField(json, "mean", q.sum_mAh / (int64_t)q.count);
+        addMilliField(json, "min", q.min_mAh);
+        addMilliField(json, "max", q.max_mAh);
+        addMilliField(json, "last", q.last_mAh);
+    }
+    json += ",\"results\":[";
+    File f = q.offsetCount ? LittleFS.open(TEST_LOG_FILE, "r") : File();
+    TestResult r;
+    bool first = true;
+    for (uint8_t i = 0; f && i < q.offsetCount; ++i) {
+        if (!f.seek(q.offsets[i], SeekSet)) continue;
+        String line = f.readStringUntil('\n');
+        line.trim();
+        if (!parseLogLine(line, r)) continue;
+        if (!first) json += ",";
+        first = false;
+        json += "{\"date\":\"" + String(r.date) + "\",";
+        json += "\"capacity\":" + String(r.finalAh, 3) + ",";
+        json += "\"time\":" + String(r.testTimeHours, 2) + ",";
+        json += "\"dcir\":" + (r.dcirMilliOhm > 0 ? String(r.dcirMilliOhm, 2) : String("null")) + "}";
+    }
+    if (f) f.close();
+    json += "]}";
+    return json;
+}
@@ -7,6 +7,7 @@
  * @brief Persistent FIFO log of completed discharge tests (LittleFS CSV).
  */
 
+// newest results kept in RAM for /test_results; the CSV file keeps all of them
 #define MAX_TEST_RESULTS 50
 #define TEST_LOG_FILE "/testlog.csv"
 
@@ -17,20 +18,31 @@
  * @param batteryType Profile name.
  * @param finalAh Measured capacity at end.
  * @param testTimeHours Duration from start to end.
+ * @param dcirMilliOhm DC internal resistance measured for this test (0 = none).
  */
 struct TestResult {
     char date[20];        // YYYY-MM-DD HH:MM
     char batteryType[50]; // battery name
     float finalAh;        // measured capacity
     float testTimeHours;  // duration in hours
+    float dcirMilliOhm;   // 0 = not measured
     bool valid;
 };
 
 extern TestResult testResults[MAX_TEST_RESULTS];
 extern int testResultCount;
+// bumped whenever the log content changes (keys the /test_results response cache)
+extern uint32_t testLogGeneration;
 
 void initTestLog();
-void saveTestResult(const char* batteryName, float finalAh, float timeHours);
+void saveTestResult(const char* batteryName, float finalAh, float timeHours, float dcirMilliOhm = 0);
 String getTestResultsJson();
 void loadTestLog();
 void clearTestLog();
+
+/**
+ * @brief Per-type queries over the whole log (FZ35_TestIndex.h).
+ * Stamps are minutes since 1970 (testStampFromDate()).
+ */
+String getTestTypesJson();
+String getTestQueryJson(const char *batteryType, uint32_t fromStamp, uint32_t toStamp, uint8_t limit);
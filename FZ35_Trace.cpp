@@ -0,0 +1,165 @@
+#include "FZ35_Trace.h"
+#include "FZ35_Memory.h"
+#include <ESPAsyncWebServer.h>
+#include <memory>
+#include <new>
+
+/**
+ * @file FZ35_Trace.cpp
+ * @brief Trace ring and the streamed Chrome trace_event dump.
+ */
+
+bool traceOn = false;
+uint32_t traceWritten = 0;
+
+// shared with running dumps, so a restart never frees a ring that is being sent
+static std::shared_ptr<TraceEvent> ring;
+static uint16_t capacity = 0;
+static int memId = -1;
+static uint32_t startUs = 0;
+static uint32_t stopUs = 0;
+
+void traceRecord(const char *name, char ph, uint8_t tid, uint16_t arg) {
+    TraceEvent &e = ring.get()[traceWritten % capacity];
+    e.ts = micros();
+    e.name = name;
+    e.arg = arg;
+    e.ph = ph;
+    e.tid = tid;
+    traceWritten++;
+}
+
+void traceDropLast() {
+    if (traceWritten) traceWritten--;
+}
+
+bool traceStart(uint16_t events) {
+    traceOn = false;
+    events = constrain(events, 16, TRACE_EVENTS_MAX);
+    if (!ring || events != capacity || ring.use_count() > 1) {
+        ring.reset();
+        capacity = 0;
+        TraceEvent *buf = new (std::nothrow) TraceEvent[events];
+        if (!buf) {
+            if (memId >= 0) memUpdate(memId, 0);
+            return false;
+        }
+        ring = std::shared_ptr<TraceEvent>(buf, [](TraceEvent *p) { delete[] p; });
+        capacity = events;
+        uint32_t bytes = (uint32_t)events * sizeof(TraceEvent);
+        if (memId < 0) memId = memRegister("Trace", "event ring", MemKind::Heap, bytes);
+        else memUpdate(memId, bytes);
+    }
+    traceWritten = 0;
+    startUs = micros();
+    stopUs = 0;
+    traceOn = true;
+    Serial.printf("Trace: started, %u events\n", capacity);
+    return true;
+}
+
+void traceStop() {
+    if (!traceOn) return;
+    traceOn = false;
+    stopUs = micros();
+}
+
+String traceStatusJson() {
+    uint32_t kept = traceWritten < capacity ? traceWritten : capacity;
+    String json = "{\"on\":" + String(traceOn ? "true" : "false");
+    json += ",\"capacity\":" + String(capacity);
+    json += ",\"events\":" + String((unsigned long)traceWritten);
+    json += ",\"kept\":" + String((unsigned long)kept);
+    json += ",\"event_bytes\":" + String((unsigned)sizeof(TraceEvent));
+    json += ",\"span_ms\":" + String((unsigned long)(((traceOn ? micros() : stopUs) - startUs) / 1000)) + "}";
+    return json;
+}
+
+// ---------- dump ----------
+
+/**
+ * @struct TraceDump
+ * @brief Streaming state: events [next, end) of a frozen ring, one JSON object at a time.
+ */
+struct TraceDump {
+    std::shared_ptr<TraceEvent> ring;
+    uint16_t capacity;
+    uint32_t next;
+    uint32_t end;
+    uint64_t base;          // unwrapped time of the oldest event
+    uint32_t prevTs;
+    uint64_t wrap;
+    uint8_t stage;
+    char pend[160];
+    uint8_t pendLen;
+    uint8_t pendOff;
+};
+
+static void formatEvent(TraceDump &d) {
+    const TraceEvent &e = d.ring.get()[d.next % d.capacity];
+    if (e.ts < d.prevTs) d.wrap += 0x100000000ULL; // micros() wraps every 71 minutes
+    d.prevTs = e.ts;
+    uint64_t ts = d.wrap + e.ts - d.base;
+    int n = snprintf(d.pend, sizeof(d.pend), ",{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%llu,\"pid\":1,\"tid\":%u",
+                     e.name, e.ph, (unsigned long long)ts, e.tid);
+    if (e.arg) n += snprintf(d.pend + n, sizeof(d.pend) - n, ",\"args\":{\"arg\":%u}", e.arg);
+    n += snprintf(d.pend + n, sizeof(d.pend) - n, "}");
+    d.pendLen = (uint8_t)min(n, (int)sizeof(d.pend) - 1);
+    d.next++;
+}
+
+static size_t fillTrace(TraceDump &d, uint8_t *buf, size_t maxLen) {
+    size_t w = 0;
+    while (w < maxLen) {
+        if (d.pendOff < d.pendLen) {
+            size_t len = min((size_t)(d.pendLen - d.pendOff), maxLen - w);
+            memcpy(buf + w, d.pend + d.pendOff, len);
+            d.pendOff += len;
+            w += len;
+            continue;
+        }
+        d.pendLen = d.pendOff = 0;
+        if (d.stage == 0) {
+            // thread names first; every event line then starts with ','
+            d.pendLen = (uint8_t)snprintf(d.pend, sizeof(d.pend),
+                "{\"displayTimeUnit\":\"ms\",\"traceEvents\":["
+                "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"loop\"}}");
+            d.stage = 1;
+        } else if (d.stage == 1) {
+            d.pendLen = (uint8_t)snprintf(d.pend, sizeof(d.pend),
+                ",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"async\"}}");
+            d.stage = 2;
+        } else if (d.stage == 2) {
+            if (d.next < d.end) formatEvent(d);
+            else d.stage = 3;
+        } else if (d.stage == 3) {
+            d.pendLen = (uint8_t)snprintf(d.pend, sizeof(d.pend), "]}");
+            d.stage = 4;
+        } else {
+            break;
+        }
+    }
+    return w;
+}
+
+void sendTraceJson(AsyncWebServerRequest *request) {
+    traceStop();
+    std::shared_ptr<TraceDump> d(new (std::nothrow) TraceDump());
+    if (!d) {
+        request->send(503, "text/plain", "out of memory");
+        return;
+    }
+    d->ring = ring;
+    d->capacity = capacity;
+    d->end = ring ? traceWritten : 0;
+    d->next = d->end > capacity ? d->end - capacity : 0;
+    if (d->next < d->end) {
+        d->base = d->ring.get()[d->next % capacity].ts;
+        d->prevTs = (uint32_t)d->base;
+    }
+    AsyncWebServerResponse *response = request->beginChunkedResponse("application/json",
+        [d](uint8_t *buf, size_t maxLen, size_t) -> size_t { return fillTrace(*d, buf, maxLen); });
+    response->addHeader("Cache-Control", "no-store");
+    response->addHeader("Content-Disposition", "attachment; filename=\"fz35-trace.json\"");
+    request->send(response);
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @file FZ35_Trace.h
+ * @brief Event trace for stall analysis: begin/end events with microsecond stamps in a
+ *        RAM ring, dumped at /trace.json as Chrome trace_event JSON (chrome://tracing,
+ *        Perfetto). Scopes cover loop() iterations, serial transactions (FZ35_Comm.h),
+ *        parseFZ35(), profile application steps, admitted HTTP handlers and LittleFS
+ *        writes. The ring is only allocated while tracing; a disabled TraceScope costs
+ *        one flag test.
+ *
+ * Threads in the viewer: tid 1 = loop(), tid 2 = async TCP context (HTTP handlers).
+ * The ESP8266 runs both cooperatively, so handler slices appear inside the
+ * loop() slice that yielded to them (delay() in a serial wait).
+ */
+
+#define TRACE_EVENTS_DEFAULT 512
+#define TRACE_EVENTS_MAX     2048
+#define TRACE_LOOP_MIN_US    1000   // loop() iterations shorter than this with nothing inside are dropped
+
+enum TraceTid : uint8_t {
+    TRACE_TID_LOOP = 1,
+    TRACE_TID_ASYNC = 2
+};
+
+/**
+ * @struct TraceEvent
+ * @brief One event; name must be a string literal (only the pointer is stored).
+ */
+struct TraceEvent {
+    uint32_t ts;        // micros(), unwrapped when dumped
+    const char *name;
+    uint16_t arg;       // scope argument (step number, ...), 0 = none
+    char ph;            // 'B' / 'E'
+    uint8_t tid;
+};
+
+// checked inline by every scope; everything else is out of line
+extern bool traceOn;
+extern uint32_t traceWritten;   // events recorded since the last start
+
+void traceRecord(const char *name, char ph, uint8_t tid, uint16_t arg);
+// removes the newest event (a begin with nothing after it, see TraceScope)
+void traceDropLast();
+
+/**
+ * @struct TraceScope
+ * @brief Begin event now, end event at scope exit. With minUs, a scope that ended
+ * sooner with no other event inside is removed again (keeps idle loop() passes out).
+ */
+struct TraceScope {
+    const char *name;
+    uint32_t seq;
+    uint32_t t0;
+    uint32_t minUs;
+    uint16_t arg;
+    uint8_t tid;
+    bool on;
+
+    TraceScope(const char *n, uint8_t t = TRACE_TID_LOOP, uint16_t a = 0, uint32_t min = 0)
+        : name(n), seq(0), t0(0), minUs(min), arg(a), tid(t), on(traceOn) {
+        if (!on) return;
+        seq = traceWritten;
+        t0 = micros();
+        traceRecord(name, 'B', tid, arg);
+    }
+    ~TraceScope() {
+        if (!on || !traceOn) return;
+        if (minUs && traceWritten == seq + 1 && micros() - t0 < minUs) traceDropLast();
+        else traceRecord(name, 'E', tid, arg);
+    }
+};
+
+/**
+ * @brief (Re)allocate the ring with the given number of events and start recording.
+ * @return false if the ring cannot be allocated.
+ */
+bool traceStart(uint16_t events);
+void traceStop();
+String traceStatusJson();
+
+class AsyncWebServerRequest;
+/**
+ * @brief Stop recording and stream the ring as trace_event JSON (chunked).
+ */
+void sendTraceJson(AsyncWebServerRequest *request);
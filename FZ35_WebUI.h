@@ -1,41 +1,85 @@
 #pragma once
 #include <ESPAsyncWebServer.h>
+#include <ESP8266WiFi.h>
 #include <pgmspace.h>
 #include "FZ35_Comm.h"
 #include "FZ35_TestLog.h"
+#include "FZ35_Fixed.h"
+#include "FZ35_Stats.h"
+#include "FZ35_Predict.h"
+#include "FZ35_HttpCache.h"
+#include "FZ35_ProfileStore.h"
+#include "FZ35_Program.h"
+#include "FZ35_Dcir.h"
+#include "FZ35_Export.h"
+#include "FZ35_TestIndex.h"
+#include "FZ35_Memory.h"
+#include "FZ35_Capture.h"
+#include "FZ35_Admission.h"
+#include "FZ35_Telemetry.h"
+#include "FZ35_Checkpoint.h"
+#include "FZ35_CmdBatch.h"
+#include "FZ35_Trace.h"
+#include "FZ35_Channel.h"
+#include "FZ35_Estop.h"
+#include "FZ35_WiFi.h"
 
 /**
  * @file FZ35_WebUI.h
- * @brief HTML/JS single-page interface (served from PROGMEM). Endpoints:
- *   /          -> dashboard
+ * @brief HTML/JS single-page interface (served from PROGMEM). Polled and heavy endpoints
+ *        are wrapped in admitted() (FZ35_Admission.h). Endpoints:
+ *   /          -> dashboard (gzip-precompressed, ETag / 304)
+ *   /channels  -> all loads: values, read rate and latency per channel
  *   /params    -> current protection + measurement summary JSON
- *   /cmd?op=   -> control operations (enable/disable/start/stop)
- *   /batteries -> list of profiles
+ *   /cmd?op=   -> control operations (enable/disable/start/stop); disable is an emergency stop
+ *   /estop, /estop_status -> stop every load now (preempts serial I/O), stop latency
+ *   (/params, /cmd, /select_batt, /data?points=, /stats take &ch=N for load N; default 0)
+ *   /cmd_batch (POST cmds=[&stop_on_error=0]), /cmd_batch_status?id= -> validated command lists
+ *   /batteries?offset=&limit= -> paged list of profiles
+ *   /profile?id=, /profile_save (POST), /profile_delete (POST) -> user profiles
  *   /select_batt?idx=N
  *   /data?points=N -> sampled graph data
+ *   /data?width=W[&from=&to=|&last=s][&col=c][&src=history] -> per-pixel min/max/first/last columns
+ *   /stats     -> running aggregates of the current/last test
+ *   /program_start (POST steps=), /program_stop, /program_status -> timed programs
+ *   /dcir?low=&high=&repeats=&settle=, /dcir_status -> pulse internal resistance
  *   /test_results, /clear_test_log
+ *   /test_query[?battery=&from=&to=|days=&limit=] -> per-type aggregates over the whole log
+ *   /export/tests.csv, /export/samples.ndjson, /export/history.ndjson -> streamed downloads
+ *   /capture_start, /capture_stop, /capture_status, /capture.bin -> serial traffic capture
+ *   /admission -> rate limit / load shedding counters and read timing
+ *   /memory    -> boot memory map (sections, heap per boot stage, registered buffers)
+ *   /telemetry_config (GET / POST), /telemetry_status -> MQTT / InfluxDB publisher
+ *   /checkpoint_status -> crash-safe test checkpoints (write cost, resume / finalize counts)
+ *   /trace_start?events=N, /trace_stop, /trace_status, /trace.json -> event timeline (Chrome trace)
+ *   /wifi_status, /wifi_config (POST ssid=&pass=) -> background reconnects, fallback AP, missed reads
+ *   (any other path while the fallback AP is up -> redirect to the dashboard: captive portal)
  *   /get_time, /set_time
  */
 
 // externs provided by main .ino and other modules
+// (live values and test state per load: FZ35_Channel.h)
 extern AsyncWebServer server;
-extern String voltage, current, power, capacityAh, energyWh, status;
-extern String OVP, OCP, OPP, LVP, OAH, OHP;
-extern String TEST_LOAD; // NEW
+extern EndPredictor endPredictor;
 extern String LOAD_ENABLE_CMD;
 extern String LOAD_DISABLE_CMD;
 String sendCommand(const String &cmd, unsigned long timeout_ms); // forward decl (no default)
 
 // --- battery API used by the WebUI (forward declarations) ---
-String getBatteryListJson();
+String getBatteryListJson(int offset, int limit);
+String getBatteryProfileJson(int idx);
 bool setActiveBattery(int idx);
+void refreshActiveBattery();
+int getActiveBatteryIndex();
+extern uint32_t batteryListGeneration;
 
 // --- add missing externs so this header can reference the graph buffers/accessors ---
 extern int graphIndex;
+extern int graphPoints;
 extern int samplesStored;
-extern float scaledVoltageAt(int idx);
-extern float scaledCurrentAt(int idx);
-extern float scaledPowerAt(int idx);
+extern uint16_t scaledVoltageAt(int idx); // 0.01 V
+extern uint16_t scaledCurrentAt(int idx); // 0.01 A
+extern uint16_t scaledPowerAt(int idx);   // 0.1 W
 extern uint32_t sampleTimestampAt(int idx);
 
 // compact UI (PROGMEM) — shows param boxes, CSV boxes, graph with timestamps
@@ -85,6 +129,8 @@ const char index_html[] PROGMEM = R"rawliteral(
       <div class="param"><div class="lab">Measured Capacity (Ah)</div><div id="meas_ah" class="val">--</div></div>
       <div class="param"><div class="lab">Measured Time (HH:MM)</div><div id="meas_t" class="val">--</div></div>
       <div class="param"><div class="lab">Load Status (derived)</div><div id="load_status" class="val">--</div></div>
+      <div class="param"><div class="lab">Predicted End (remaining)</div><div id="pred_eta" class="val">--</div></div>
+      <div class="param"><div class="lab">Predicted Capacity (Ah)</div><div id="pred_ah" class="val">--</div></div>
     </div>
 
     <div id="controls">
@@ -103,6 +149,14 @@ const char index_html[] PROGMEM = R"rawliteral(
   <!-- Add this inside the top controls/params area (HTML portion of index_html) -->
   <label style="margin-left:8px;color:var(--muted);font-size:12px">Battery:</label>
   <select id="batterySelect" style="margin-left:6px;padding:6px;border-radius:6px;"></select>
+  <label style="margin-left:8px;color:var(--muted);font-size:12px">Window:</label>
+  <select id="graphWindow" style="margin-left:6px;padding:6px;border-radius:6px;">
+    <option value="300">5 min</option>
+    <option value="900">15 min</option>
+    <option value="3600">1 h</option>
+    <option value="all">All in RAM</option>
+    <option value="test">Whole test</option>
+  </select>
 
   <canvas id="graph" width="1200" height="360"></canvas>
 
@@ -120,6 +174,46 @@ const char index_html[] PROGMEM = R"rawliteral(
       <div class="slabel">Samples</div>
       <div class="sval" id="samples_count">0</div>
     </div>
+    <div class="stat-card">
+      <div class="slabel">Graph Render (ms) — Last / Mean / Max (Frames)</div>
+      <div class="sval" id="render_stats">--</div>
+    </div>
+  </div>
+
+  <!-- Whole-test aggregates maintained on the device (/stats) -->
+  <div class="stats" id="testStatsArea">
+    <div class="stat-card">
+      <div class="slabel">Test Energy (Wh) / Charge (Ah)</div>
+      <div class="sval" id="ts_energy">-- / --</div>
+    </div>
+    <div class="stat-card">
+      <div class="slabel">Test Voltage — Min / Mean / Max</div>
+      <div class="sval" id="ts_v">-- / -- / --</div>
+    </div>
+    <div class="stat-card">
+      <div class="slabel">Test Current — Min / Mean / Max</div>
+      <div class="sval" id="ts_i">-- / -- / --</div>
+    </div>
+    <div class="stat-card">
+      <div class="slabel">Peak Power (W)</div>
+      <div class="sval" id="ts_p">--</div>
+    </div>
+  </div>
+
+  <!-- Pulse DCIR: result is stored with the next logged test -->
+  <div id="dcirControls" style="margin-top:12px;font-size:12px;color:var(--muted)">
+    DCIR step <input id="dcirLow" value="0.20" size="4"> A &rarr; <input id="dcirHigh" value="1.00" size="4"> A,
+    repeats <input id="dcirRepeats" value="6" size="2">
+    <button id="btnDcir" style="margin-left:8px;">Measure DCIR</button>
+    <span id="dcirResult" style="margin-left:8px;"></span>
+  </div>
+
+  <!-- WiFi: the device reconnects in the background; acquisition never waits for it -->
+  <div id="wifiControls" style="margin-top:12px;font-size:12px;color:var(--muted)">
+    WiFi <span id="wifiState">--</span>
+    <input id="wifiSsid" placeholder="SSID" size="12" style="margin-left:8px;">
+    <input id="wifiPass" type="password" placeholder="password" size="12">
+    <button id="btnWifi" style="margin-left:8px;">Connect</button>
   </div>
 
   <!-- NEW: Test Results Table -->
@@ -131,69 +225,45 @@ const char index_html[] PROGMEM = R"rawliteral(
         <th>Battery Type</th>
         <th>Final Capacity (Ah)</th>
         <th>Duration (h)</th>
+        <th>DCIR (m&Omega;)</th>
       </tr>
     </thead>
     <tbody id="testTableBody">
-      <tr><td colspan="4">Loading...</td></tr>
+      <tr><td colspan="5">Loading...</td></tr>
     </tbody>
   </table>
   <button id="btnClearLog" style="margin-top:8px;background:#c94a4a;">Clear Test Log</button>
 
-<script>
-(() => {
-  const el = id => document.getElementById(id);
-  const canvas = el('graph'), ctx = canvas.getContext('2d');
-  const MAX_POINTS = 200; // number of points requested
-  let night = false;
-
-  async function fetchParams(){
-    try {
-      const r = await fetch('/params'); if(!r.ok) return;
-      const j = await r.json();
-      el('ovp').textContent = j.ovp || '--';
-      el('ocp').textContent = j.ocp || '--';
-      el('opp').textContent = j.opp || '--';
-      el('lvp').textContent = j.lvp || '--';
-      el('oah').textContent = j.oah || '--';
-      el('ohp').textContent = j.ohp || '--';
-      el('meas_v').textContent = j.meas_v || '--';
-      el('meas_i').textContent = j.meas_i || '--';
-      el('meas_ah').textContent = j.meas_ah || '--';
-      el('meas_t').textContent = j.meas_t || '--';
-      el('load_status').textContent = j.load || '--';
-      el('tload').textContent = j.tload || '--';
-    } catch(e){}
-  }
-
-  async function fetchData(){
-    try {
-      const r = await fetch('/data?points=' + MAX_POINTS);
-      if(!r.ok) return null;
-      return await r.json();
-    } catch(e){ return null; }
-  }
+<!-- Graph renderer: runs in a Web Worker on an OffscreenCanvas (or on the page when
+     that is unavailable). It keeps the columns of a fixed time axis, fetches only the
+     columns from the newest one on (/data?width=&col=), draws just that strip, and
+     redraws everything only when the axis has to change. -->
+<script id="graphWorker" type="text/js-worker">
+function graphRenderer(canvas, base, post, mode){
+  const ctx = canvas.getContext('2d');
+  const PAD = 50, W = canvas.width - PAD*2, H = canvas.height - PAD*2;
+  const incremental = mode !== 'full';
+  let win = '300', night = false, busy = false;
+  let frame = null;       // {from, to, key}: time axis the columns are binned on
+  let cols = [];          // [col, n, v first/min/max/last, i ..., p ...] in 0.01 V / 0.01 A / 0.1 W
+  let ax = null;          // scales of the last full draw
+  let samples = 0, vlo = Infinity, vhi = -Infinity, newest = 0;
+  const perf = { mode, full: { frames:0, last:0, sum:0, max:0 }, incr: { frames:0, last:0, sum:0, max:0 }, fetch_ms: 0 };
 
-  // helper: compute a "nice" step for ticks
   function niceStep(range, targetCount){
     if (range <= 0 || !isFinite(range)) return 1;
     const raw = range / Math.max(1, targetCount);
     const exp = Math.floor(Math.log10(raw));
     const f = raw / Math.pow(10, exp);
-    let nf = 1;
-    if (f <= 1) nf = 1;
-    else if (f <= 2) nf = 2;
-    else if (f <= 5) nf = 5;
-    else nf = 10;
+    const nf = f <= 1 ? 1 : f <= 2 ? 2 : f <= 5 ? 5 : 10;
     return nf * Math.pow(10, exp);
   }
-  // helper: pick a time step (seconds) that yields ~6 ticks
+  // time step (seconds) that yields ~6 ticks
   function chooseTimeStep(spanSec){
     const steps = [1,2,5,10,15,30,60,120,300,600,900,1800,3600,7200,14400];
-    const target = 6;
     let best = steps[0], bestDiff = Infinity;
     for (const s of steps){
-      const cnt = spanSec / s;
-      const diff = Math.abs(cnt - target);
+      const diff = Math.abs(spanSec / s - 6);
       if (diff < bestDiff){ bestDiff = diff; best = s; }
     }
     return best;
@@ -204,115 +274,252 @@ const char index_html[] PROGMEM = R"rawliteral(
     return d.getHours().toString().padStart(2,'0') + ':' + d.getMinutes().toString().padStart(2,'0') + ':' + d.getSeconds().toString().padStart(2,'0');
   }
 
-  function computeStats(points){
-    if(!points || points.length === 0){
-      el('x_vals').textContent = '-- / -- / --';
-      el('y_vals').textContent = '-- / -- / --';
-      el('samples_count').textContent = '0';
-      return;
-    }
-    // X: min/mid/max timestamps
-    let tmin = Number.POSITIVE_INFINITY, tmax = 0;
-    let vmin = Number.POSITIVE_INFINITY, vmax = -Number.POSITIVE_INFINITY;
-    for(let p of points){
-      const t = p[3];
-      const v = p[0];
-      if(t < tmin) tmin = t;
-      if(t > tmax) tmax = t;
-      if(v < vmin) vmin = v;
-      if(v > vmax) vmax = v;
+  async function get(q){
+    const src = win === 'test' ? '&src=history' : '';
+    try {
+      const r = await fetch(base + '/data?width=' + W + src + q);
+      return r.ok ? await r.json() : null;
+    } catch(e){ return null; }
+  }
+
+  // axis for the source's span: the window plus ~10% room on the right, so new
+  // samples append for a while before the axis has to move
+  function frameFor(span){
+    const key = win;
+    if (win === 'all' || win === 'test') {
+      const from = span[0];
+      return { from, to: span[1] + Math.max(10, Math.ceil((span[1] - from) / 10)), key };
     }
-    const tmid = Math.floor((tmin + tmax) / 2);
-    const vmid = (vmin + vmax) / 2;
-    el('x_vals').textContent = formatTimeShort(tmin) + ' / ' + formatTimeShort(tmid) + ' / ' + formatTimeShort(tmax);
-    el('y_vals').textContent = vmin.toFixed(2) + ' / ' + vmid.toFixed(2) + ' / ' + vmax.toFixed(2);
-    el('samples_count').textContent = String(points.length);
+    const s = Number(win), to = span[1] + Math.max(5, Math.ceil(s / 10));
+    return { from: Math.max(0, to - s), to, key };
   }
 
-  function drawGraph(points){
-    ctx.fillStyle = night ? '#0b0b0b' : '#fff'; ctx.fillRect(0,0,canvas.width,canvas.height);
-    if(!points || points.length === 0){ ctx.fillStyle = night ? '#eee' : '#333'; ctx.fillText('No data',10,20); computeStats(points); return; }
-
-    const pad = 50, w = canvas.width - pad*2, h = canvas.height - pad*2;
-    // compute timestamp and voltage ranges
-    let tmin = Number.POSITIVE_INFINITY, tmax = 0;
-    let vmin = Number.POSITIVE_INFINITY, vmax = -Number.POSITIVE_INFINITY;
-    for(let p of points){
-      const t = p[3]; const v = p[0];
-      if(t < tmin) tmin = t; if(t > tmax) tmax = t;
-      if(v < vmin) vmin = v; if(v > vmax) vmax = v;
+  function totals(list, sign){
+    for (const c of list){
+      samples += sign * c[1];
+      if (sign > 0) { if (c[3] < vlo) vlo = c[3]; if (c[4] > vhi) vhi = c[4]; }
     }
-    if(tmin === tmax) { tmin -= 1; tmax += 1; }
-    if(vmin === vmax) { vmin -= 0.5; vmax += 0.5; }
+  }
 
-    // axes
-    ctx.strokeStyle = night ? '#444' : '#ccc'; ctx.lineWidth = 1;
-    ctx.beginPath(); ctx.moveTo(pad, pad); ctx.lineTo(pad, pad+h); ctx.lineTo(pad+w, pad+h); ctx.stroke();
-
-    // GRID: horizontal (voltage) and vertical (time)
-    const gridColor = night ? '#2a2a2a' : '#eee';
-    const labelColor = night ? '#bbb' : '#666';
-    ctx.setLineDash([4,4]); ctx.lineWidth = 1; ctx.strokeStyle = gridColor;
-    ctx.fillStyle = labelColor; ctx.font = '12px Arial';
-
-    // Y ticks (voltage)
-    const yStep = niceStep(vmax - vmin, 6);
-    const yStart = Math.floor(vmin / yStep) * yStep;
-    for(let yVal = yStart; yVal <= vmax + 1e-6; yVal += yStep){
-      const y = pad + h - ((yVal - vmin) / (vmax - vmin)) * h;
-      ctx.beginPath(); ctx.moveTo(pad, y); ctx.lineTo(pad+w, y); ctx.stroke();
-      // label
-      ctx.textAlign = 'right'; ctx.fillText(yVal.toFixed(2) + ' V', pad - 6, y + 4);
+  const xOf = c => PAD + c[0] + 0.5;  // one column per pixel
+
+  // background, grid and series right of column i0 - 1 (i0 = 0: the whole plot)
+  function paint(i0){
+    const xs = i0 > 0 ? xOf(cols[i0 - 1]) + 1.5 : PAD;
+    ctx.save();
+    ctx.beginPath(); ctx.rect(xs, PAD - 2, PAD + W + 2 - xs, H + 3); ctx.clip();
+    ctx.fillStyle = night ? '#0b0b0b' : '#fff'; ctx.fillRect(xs, PAD - 2, PAD + W + 2 - xs, H + 3);
+
+    ctx.setLineDash([4,4]); ctx.lineWidth = 1; ctx.strokeStyle = night ? '#2a2a2a' : '#eee';
+    for (let yVal = ax.vmin; yVal <= ax.vmax + 1e-6; yVal += ax.yStep){
+      const y = ax.y(yVal);
+      ctx.beginPath(); ctx.moveTo(PAD, y); ctx.lineTo(PAD + W, y); ctx.stroke();
+    }
+    for (let ts = ax.tStart; ts <= ax.tmax + 1e-6; ts += ax.tStep){
+      if (ts < ax.tmin) continue;
+      const x = ax.x(ts);
+      ctx.beginPath(); ctx.moveTo(x, PAD); ctx.lineTo(x, PAD + H); ctx.stroke();
     }
+    ctx.setLineDash([]);
+    ctx.strokeStyle = night ? '#444' : '#ccc';
+    ctx.beginPath(); ctx.moveTo(PAD, PAD + H); ctx.lineTo(PAD + W, PAD + H); ctx.stroke();
 
-    // X ticks (time)
-    const tSpan = tmax - tmin;
-    const tStep = chooseTimeStep(tSpan);
-    const tStart = Math.floor(tmin / tStep) * tStep;
-    for(let ts = tStart; ts <= tmax + 1e-6; ts += tStep){
-      const x = pad + ((ts - tmin) / (tmax - tmin)) * w;
-      ctx.beginPath(); ctx.moveTo(x, pad); ctx.lineTo(x, pad+h); ctx.stroke();
-      // label
-      ctx.textAlign = 'center'; ctx.fillText(formatTimeShort(ts), x, pad+h+18);
+    // one M4 series: first -> min -> max -> last inside each pixel column, so
+    // sags and spikes shorter than a pixel still show as vertical strokes
+    function series(k, scale, yOf, color, lineW){
+      ctx.beginPath(); ctx.strokeStyle = color; ctx.lineWidth = lineW;
+      const o = 2 + k*4, s = Math.max(0, i0 - 1);
+      for (let i = s; i < cols.length; i++){
+        const c = cols[i], x = xOf(c);
+        if (i < i0) { ctx.moveTo(x, yOf(c[o+3] / scale)); continue; }  // joint with the kept part
+        if (i === s) ctx.moveTo(x, yOf(c[o] / scale)); else ctx.lineTo(x, yOf(c[o] / scale));
+        ctx.lineTo(x, yOf(c[o+1] / scale)); ctx.lineTo(x, yOf(c[o+2] / scale)); ctx.lineTo(x, yOf(c[o+3] / scale));
+      }
+      ctx.stroke();
     }
-    ctx.setLineDash([]); // reset dashes
-
-    // draw voltage line (blue)
-    ctx.beginPath(); ctx.strokeStyle='#0077ff'; ctx.lineWidth=2;
-    for(let i=0;i<points.length;i++){
-      const ts = points[i][3];
-      const x = pad + ((ts - tmin) / (tmax - tmin)) * w;
-      const y = pad + h - ((points[i][0] - vmin) / (vmax - vmin)) * h;
-      if(i === 0) ctx.moveTo(x,y); else ctx.lineTo(x,y);
+    // voltage (blue); current (green) and power (orange) scaled to voltage range (rough)
+    const vmax = ax.vmax;
+    series(0, 100, ax.y, '#0077ff', 2);
+    series(1, 100, a => PAD + H - (a / Math.max(1.0, vmax)) * H, '#00aa44', 1);
+    series(2, 10, p => PAD + H - (p / Math.max(1.0, vmax)) * H, '#ff7700', 1);
+    ctx.restore();
+  }
+
+  function drawFull(){
+    ctx.fillStyle = night ? '#0b0b0b' : '#fff'; ctx.fillRect(0, 0, canvas.width, canvas.height);
+    if (!frame || cols.length === 0) { ax = null; ctx.fillStyle = night ? '#eee' : '#333'; ctx.font = '12px Arial'; ctx.fillText('No data', 10, 20); return; }
+
+    // voltage axis snapped to ticks with a step of room each side, so a slowly
+    // moving voltage stays inside it for many updates
+    const lo = vlo / 100, hi = vhi / 100;
+    const yStep = niceStep(Math.max(hi - lo, 0.1), 6);
+    const vmin = (Math.floor(lo / yStep + 1e-9) - 1) * yStep, vmax = (Math.ceil(hi / yStep - 1e-9) + 1) * yStep;
+    const tmin = frame.from, tmax = frame.to, tStep = chooseTimeStep(tmax - tmin);
+    ax = { vmin, vmax, yStep, tmin, tmax, tStep, tStart: Math.floor(tmin / tStep) * tStep,
+           y: v => PAD + H - ((v - vmin) / (vmax - vmin)) * H,
+           x: t => PAD + ((t - tmin) / (tmax - tmin)) * W };
+
+    paint(0);
+    ctx.strokeStyle = night ? '#444' : '#ccc'; ctx.lineWidth = 1;
+    ctx.beginPath(); ctx.moveTo(PAD, PAD); ctx.lineTo(PAD, PAD + H); ctx.stroke();
+    ctx.fillStyle = night ? '#bbb' : '#666'; ctx.font = '12px Arial';
+    ctx.textAlign = 'right';
+    for (let yVal = vmin; yVal <= vmax + 1e-6; yVal += yStep) ctx.fillText(yVal.toFixed(2) + ' V', PAD - 6, ax.y(yVal) + 4);
+    ctx.textAlign = 'center';
+    for (let ts = ax.tStart; ts <= tmax + 1e-6; ts += tStep) if (ts >= tmin) ctx.fillText(formatTimeShort(ts), ax.x(ts), PAD + H + 18);
+    ctx.fillStyle = night ? '#ddd' : '#000';
+    ctx.textAlign = 'left'; ctx.fillText('V (blue)  I (green)  P (orange)', PAD, PAD - 8);
+  }
+
+  function timed(kind, fn){
+    const t0 = performance.now();
+    fn();
+    const ms = performance.now() - t0, s = perf[kind];
+    s.frames++; s.last = ms; s.sum += ms; if (ms > s.max) s.max = ms;
+  }
+
+  function report(){
+    const stat = s => ({ frames: s.frames, last: +s.last.toFixed(2), mean: s.frames ? +(s.sum / s.frames).toFixed(2) : 0, max: +s.max.toFixed(2) });
+    const out = { perf: { mode, full: stat(perf.full), incr: stat(perf.incr), fetch_ms: Math.round(perf.fetch_ms) } };
+    if (cols.length) {
+      const tmax = Math.min(newest, frame.to), tmid = Math.floor((frame.from + tmax) / 2);
+      out.x = formatTimeShort(frame.from) + ' / ' + formatTimeShort(tmid) + ' / ' + formatTimeShort(tmax);
+      out.y = (vlo / 100).toFixed(2) + ' / ' + ((vlo + vhi) / 200).toFixed(2) + ' / ' + (vhi / 100).toFixed(2);
     }
-    ctx.stroke();
-
-    // current line (green) scaled to voltage range (rough)
-    ctx.beginPath(); ctx.strokeStyle='#00aa44'; ctx.lineWidth=1;
-    for(let i=0;i<points.length;i++){
-      const ts = points[i][3];
-      const x = pad + ((ts - tmin) / (tmax - tmin)) * w;
-      const y = pad + h - ((points[i][1]) / Math.max(1.0, vmax) ) * h;
-      if(i === 0) ctx.moveTo(x,y); else ctx.lineTo(x,y);
+    out.n = samples;
+    post(out);
+  }
+
+  async function update(){
+    const t0 = performance.now();
+    if (frame && frame.key !== win) frame = null;
+    // newest column kept: it may have grown since, so it is fetched again
+    const c0 = incremental && frame && cols.length ? cols[cols.length - 1][0] : 0;
+    let lod = null;
+    if (frame) {
+      lod = await get('&from=' + frame.from + '&to=' + frame.to + (c0 ? '&col=' + c0 : ''));
+      if (!lod) return;
+      if (lod.span[1] > frame.to || lod.span[1] < frame.from) frame = null;  // ran off the axis, or the clock moved
     }
-    ctx.stroke();
-
-    // power line (orange)
-    ctx.beginPath(); ctx.strokeStyle='#ff7700'; ctx.lineWidth=1;
-    for(let i=0;i<points.length;i++){
-      const ts = points[i][3];
-      const x = pad + ((ts - tmin) / (tmax - tmin)) * w;
-      const y = pad + h - ((points[i][2]) / Math.max(1.0, vmax) ) * h;
-      if(i === 0) ctx.moveTo(x,y); else ctx.lineTo(x,y);
+    if (!frame) {
+      const probe = lod || await get('&from=1&to=0');  // columns-free: just the source's span
+      if (!probe) return;
+      newest = probe.span[1];
+      cols = []; samples = 0; vlo = Infinity; vhi = -Infinity;
+      if (newest) {
+        const f = frameFor(probe.span);
+        lod = await get('&from=' + f.from + '&to=' + f.to);
+        if (!lod) return;
+        frame = f;
+        cols = lod.cols; totals(cols, 1);
+      }
+      perf.fetch_ms = performance.now() - t0;
+      timed('full', drawFull);
+      report();
+      return;
     }
-    ctx.stroke();
+    perf.fetch_ms = performance.now() - t0;
+    newest = lod.span[1];
 
-    // legend
-    ctx.fillStyle = night ? '#ddd' : '#000';
-    ctx.textAlign = 'left'; ctx.fillText('V (blue)  I (green)  P (orange)', pad, pad - 8);
+    let i0 = 0;
+    if (c0) { i0 = cols.length; while (i0 > 0 && cols[i0 - 1][0] >= c0) i0--; }
+    totals(cols.splice(i0), -1);
+    totals(lod.cols, 1);
+    for (const c of lod.cols) cols.push(c);
+
+    if (!incremental || !ax || i0 === 0 || vlo / 100 < ax.vmin || vhi / 100 > ax.vmax) timed('full', drawFull);
+    else timed('incr', () => paint(i0));
+    report();
+  }
+
+  return function(m){
+    const redraw = m.night !== undefined && m.night !== night;
+    if (m.win !== undefined) win = m.win;
+    if (m.night !== undefined) night = m.night;
+    if (redraw && !m.fetch) timed('full', drawFull);
+    if (m.fetch && !busy) { busy = true; update().finally(() => { busy = false; }); }
+  };
+}
+
+if (typeof WorkerGlobalScope !== 'undefined' && self instanceof WorkerGlobalScope) {
+  let render = null;
+  self.onmessage = e => {
+    const m = e.data;
+    if (m.canvas) render = graphRenderer(m.canvas, m.base, out => self.postMessage(out), m.mode);
+    else if (render) render(m);
+  };
+}
+</script>
+<script>
+(() => {
+  const el = id => document.getElementById(id);
+  const canvas = el('graph');
+  let night = false;
+
+  // graph rendering (#graphWorker): off the main thread when OffscreenCanvas can
+  // draw 2d; ?render=main keeps it on the page, ?render=full also redraws the whole
+  // graph every update (the old behaviour, to compare frame times against)
+  const graphSrc = el('graphWorker').textContent;
+  let renderMode = new URLSearchParams(location.search).get('render');
+  if (renderMode !== 'main' && renderMode !== 'full') {
+    let offscreen = false;
+    try { offscreen = !!(window.Worker && canvas.transferControlToOffscreen && new OffscreenCanvas(1, 1).getContext('2d')); } catch(e){}
+    renderMode = offscreen ? 'worker' : 'main';
+  }
+  function showRender(m){
+    el('x_vals').textContent = m.x || '-- / -- / --';
+    el('y_vals').textContent = m.y || '-- / -- / --';
+    el('samples_count').textContent = String(m.n || 0);
+    const p = m.perf, f = s => s.frames ? `${s.last} / ${s.mean} / ${s.max} (${s.frames})` : '--';
+    el('render_stats').textContent = `${p.mode}: incr ${f(p.incr)}, full ${f(p.full)}, fetch ${p.fetch_ms}`;
+    window.fzRenderStats = p;  // for comparing modes from the console
+  }
+  let render;
+  if (renderMode === 'worker') {
+    const worker = new Worker(URL.createObjectURL(new Blob([graphSrc], { type: 'text/javascript' })));
+    const off = canvas.transferControlToOffscreen();
+    worker.postMessage({ canvas: off, base: location.origin, mode: renderMode }, [off]);
+    worker.onmessage = e => showRender(e.data);
+    render = m => worker.postMessage(m);
+  } else {
+    render = new Function(graphSrc + '\nreturn graphRenderer;')()(canvas, location.origin, showRender, renderMode);
+  }
+
+  async function fetchParams(){
+    try {
+      const r = await fetch('/params'); if(!r.ok) return;
+      const j = await r.json();
+      el('ovp').textContent = j.ovp || '--';
+      el('ocp').textContent = j.ocp || '--';
+      el('opp').textContent = j.opp || '--';
+      el('lvp').textContent = j.lvp || '--';
+      el('oah').textContent = j.oah || '--';
+      el('ohp').textContent = j.ohp || '--';
+      el('meas_v').textContent = j.meas_v || '--';
+      el('meas_i').textContent = j.meas_i || '--';
+      el('meas_ah').textContent = j.meas_ah || '--';
+      el('meas_t').textContent = j.meas_t || '--';
+      el('load_status').textContent = (j.load || '--') + (j.stale ? ' (stale)' : '');
+      el('tload').textContent = j.tload || '--';
+      if (j.eta_s == null) el('pred_eta').textContent = '--';
+      else {
+        const h = Math.floor(j.eta_s / 3600), m = Math.floor(j.eta_s % 3600 / 60);
+        el('pred_eta').textContent = `${h}:${String(m).padStart(2,'0')} (${j.eta_limit.toUpperCase()})`;
+      }
+      el('pred_ah').textContent = j.pred_ah || '--';
+    } catch(e){}
+  }
 
-    // update stats
-    computeStats(points);
+  async function fetchTestStats(){
+    try {
+      const r = await fetch('/stats'); if(!r.ok) return;
+      const j = await r.json();
+      if(!j.samples){ return; }
+      el('ts_energy').textContent = j.wh.toFixed(3) + ' / ' + j.ah.toFixed(3) + (j.active ? '' : ' (last)');
+      el('ts_v').textContent = j.v_min.toFixed(2) + ' / ' + j.v_mean.toFixed(2) + ' / ' + j.v_max.toFixed(2);
+      el('ts_i').textContent = j.i_min.toFixed(2) + ' / ' + j.i_mean.toFixed(2) + ' / ' + j.i_max.toFixed(2);
+      el('ts_p').textContent = j.p_peak.toFixed(2);
+    } catch(e){}
   }
 
   // command send (no response expected)
@@ -329,15 +536,24 @@ const char index_html[] PROGMEM = R"rawliteral(
 
   async function loadBatteryList() {
     try {
-      const r = await fetch('/batteries');
-      if (!r.ok) return;
-      const j = await r.json();
+      // page through the catalog (built-in + user profiles)
+      const opts = [];
+      let active = -1, offset = 0, total = 1;
+      while (offset < total) {
+        const r = await fetch('/batteries?offset=' + offset + '&limit=50');
+        if (!r.ok) return;
+        const j = await r.json();
+        active = j.active; total = j.total;
+        if (j.batteries.length === 0) break;
+        j.batteries.forEach((name, i) => opts.push([j.ids[i], name]));
+        offset += j.batteries.length;
+      }
       const sel = document.getElementById('batterySelect');
       sel.innerHTML = '';
-      j.batteries.forEach((name, idx) => {
+      opts.forEach(([id, name]) => {
         const opt = document.createElement('option');
-        opt.value = idx; opt.text = name;
-        if (idx === j.active) opt.selected = true;
+        opt.value = id; opt.text = name;
+        if (id === active) opt.selected = true;
         sel.appendChild(opt);
       });
     } catch(e){}
@@ -350,7 +566,7 @@ const char index_html[] PROGMEM = R"rawliteral(
       const j = await r.json();
       const tbody = document.getElementById('testTableBody');
       if (j.results.length === 0) {
-        tbody.innerHTML = '<tr><td colspan="4">No test results yet</td></tr>';
+        tbody.innerHTML = '<tr><td colspan="5">No test results yet</td></tr>';
         return;
       }
       tbody.innerHTML = '';
@@ -360,6 +576,7 @@ const char index_html[] PROGMEM = R"rawliteral(
         row.insertCell(1).textContent = result.battery;
         row.insertCell(2).textContent = result.capacity.toFixed(3);
         row.insertCell(3).textContent = result.time.toFixed(2);
+        row.insertCell(4).textContent = result.dcir == null ? '--' : result.dcir.toFixed(2);
       });
     } catch(e) {
       console.error('Failed to load test results', e);
@@ -374,6 +591,46 @@ const char index_html[] PROGMEM = R"rawliteral(
     } catch(e) {}
   });
 
+  async function pollDcir() {
+    try {
+      const r = await fetch('/dcir_status'); if (!r.ok) return;
+      const j = await r.json();
+      if (j.state !== 'idle') { el('dcirResult').textContent = 'measuring...'; setTimeout(pollDcir, 1000); return; }
+      el('dcirResult').textContent = j.valid
+        ? `${j.r_mohm} m\u03A9 \u00B1${j.r_sd_mohm} (${j.steps} steps, sample window ${j.timing_us.window_mean}/${j.timing_us.window_max} \u00B5s mean/max)`
+        : (j.error || '--');
+    } catch(e){}
+  }
+
+  document.getElementById('btnDcir').addEventListener('click', async () => {
+    const q = 'low=' + encodeURIComponent(el('dcirLow').value) + '&high=' + encodeURIComponent(el('dcirHigh').value) +
+              '&repeats=' + encodeURIComponent(el('dcirRepeats').value);
+    try {
+      const r = await fetch('/dcir?' + q);
+      if (!r.ok) { el('dcirResult').textContent = await r.text(); return; }
+      setTimeout(pollDcir, 500);
+    } catch(e){}
+  });
+
+  async function pollWifi() {
+    try {
+      const r = await fetch('/wifi_status'); if (!r.ok) return;
+      const j = await r.json();
+      const link = j.state === 'connected' ? `${j.ssid} ${j.rssi} dBm` :
+                   j.state === 'backoff' ? `offline ${Math.round(j.offline_ms / 1000)} s, retry in ${Math.round(j.retry_in_ms / 1000)} s` : j.state;
+      el('wifiState').textContent = `${link}${j.ap ? ', AP ' + j.ap_ip : ''} — ${j.reconnects} reconnects ` +
+        `(last ${j.reconnect_ms} ms), reads while offline ${j.reads_offline}, missed ${j.missed_offline}`;
+    } catch(e){}
+  }
+
+  document.getElementById('btnWifi').addEventListener('click', async () => {
+    const body = new URLSearchParams({ ssid: el('wifiSsid').value, pass: el('wifiPass').value });
+    try {
+      const r = await fetch('/wifi_config', { method: 'POST', body });
+      el('wifiState').textContent = r.ok ? 'switching...' : await r.text();
+    } catch(e){}
+  });
+
   document.getElementById('batterySelect').addEventListener('change', async (ev) => {
     const idx = ev.target.value;
     try {
@@ -383,7 +640,7 @@ const char index_html[] PROGMEM = R"rawliteral(
     } catch(e){}
   });
 
-  document.getElementById('toggleNight').addEventListener('click', ()=>{ night = !night; document.body.classList.toggle('night', night); });
+  document.getElementById('toggleNight').addEventListener('click', ()=>{ night = !night; document.body.classList.toggle('night', night); render({ night }); });
   document.getElementById('btnEnable').addEventListener('click', ()=> sendCmdNoResp('enable'));
   document.getElementById('btnDisable').addEventListener('click', ()=> sendCmdNoResp('disable'));
 
@@ -432,16 +689,19 @@ const char index_html[] PROGMEM = R"rawliteral(
 
   async function fetchAndDraw(){
     await fetchParams();
-    const data = await fetchData();
-    if(data && data.points) drawGraph(data.points);
+    fetchTestStats();
+    render({ win: el('graphWindow').value, night, fetch: true });
   }
 
+  el('graphWindow').addEventListener('change', fetchAndDraw);
   setInterval(fetchParams, 1000);
   setInterval(fetchAndDraw, 2000);
   loadBatteryList();
   setInterval(loadBatteryList, 5000); // optional periodic refresh
   loadTestResults();
   setInterval(loadTestResults, 30000); // refresh every 30s
+  pollWifi();
+  setInterval(pollWifi, 5000);
   fetchAndDraw();
 })();
 </script>
@@ -449,36 +709,91 @@ const char index_html[] PROGMEM = R"rawliteral(
 </html>
 )rawliteral";
 
+// gzip copy of index_html; regenerate with tools/gen_webui_gz.py after editing the page
+#include "FZ35_WebUI_gz.h"
+static_assert(sizeof(index_html) - 1 == INDEX_HTML_RAW_LEN,
+              "FZ35_WebUI_gz.h is stale: run tools/gen_webui_gz.py");
+
+// dashboard revalidates daily; a reflash changes the ETag so reloads pick it up at once
+#define INDEX_HTML_CACHE_CONTROL "public, max-age=86400"
+
+// ?ch=N selects the load (FZ35_Channel.h), default 0; sends 404 for an unknown id
+static FzChannel *requestChannel(AsyncWebServerRequest *request) {
+    int id = request->hasParam("ch") ? request->getParam("ch")->value().toInt() : 0;
+    FzChannel *ch = channelById(id);
+    if (!ch) request->send(404, "text/plain", "no such channel");
+    return ch;
+}
+
 // register routes and endpoints
 /**
  * @brief Register all HTTP routes with the global AsyncWebServer.
  */
 inline void setupWebUI() {
-    server.on("/", HTTP_GET, [](AsyncWebServerRequest *request){
-        request->send_P(200, "text/html", index_html);
-    });
+    // memoized bodies for /batteries and /test_results (rebuilt on generation change)
+    static CachedResponse batteriesCache;
+    static CachedResponse testResultsCache;
+
+    server.on("/", HTTP_GET, admitted("/", AdmitClass::Poll, [](AsyncWebServerRequest *request){
+        if (request->hasHeader("If-None-Match") &&
+            request->getHeader("If-None-Match")->value() == INDEX_HTML_ETAG) {
+            AsyncWebServerResponse *response = request->beginResponse(304);
+            response->addHeader("ETag", INDEX_HTML_ETAG);
+            response->addHeader("Cache-Control", INDEX_HTML_CACHE_CONTROL);
+            request->send(response);
+            return;
+        }
+        // every current browser sends gzip; keep the raw page for odd clients
+        if (!request->hasHeader("Accept-Encoding") ||
+            request->getHeader("Accept-Encoding")->value().indexOf("gzip") < 0) {
+            request->send_P(200, "text/html", index_html);
+            return;
+        }
+        AsyncWebServerResponse *response =
+            request->beginResponse_P(200, "text/html", index_html_gz, index_html_gz_len);
+        response->addHeader("Content-Encoding", "gzip");
+        response->addHeader("ETag", INDEX_HTML_ETAG);
+        response->addHeader("Cache-Control", INDEX_HTML_CACHE_CONTROL);
+        response->addHeader("Vary", "Accept-Encoding");
+        request->send(response);
+    }));
 
-    server.on("/params", HTTP_GET, [](AsyncWebServerRequest *request){
-        bool loadOn = false;
-        float cf = current.toFloat();
-        if (cf > 0.0f) loadOn = true;
+    server.on("/params", HTTP_GET, admitted("/params", AdmitClass::Poll, [](AsyncWebServerRequest *request){
+        FzChannel *ch = requestChannel(request);
+        if (!ch) return;
+        bool loadOn = ch->meas.current_mA > 0;
 
         String json = "{";
-        json += "\"ovp\":\"" + OVP + "\",";
-        json += "\"ocp\":\"" + OCP + "\",";
-        json += "\"opp\":\"" + OPP + "\",";
-        json += "\"lvp\":\"" + LVP + "\",";
-        json += "\"oah\":\"" + OAH + "\",";
-        json += "\"ohp\":\"" + OHP + "\",";
-        json += "\"tload\":\"" + TEST_LOAD + "\","; // NEW
-        json += "\"meas_v\":\"" + voltage + "\",";
-        json += "\"meas_i\":\"" + current + "\",";
-        json += "\"meas_ah\":\"" + capacityAh + "\",";
-        json += "\"meas_t\":\"" + energyWh + "\",";
-        json += "\"load\":\"" + String(loadOn ? "ON" : "OFF") + "\"";
+        json += "\"ovp\":\"" + ch->OVP + "\",";
+        json += "\"ocp\":\"" + ch->OCP + "\",";
+        json += "\"opp\":\"" + ch->OPP + "\",";
+        json += "\"lvp\":\"" + ch->LVP + "\",";
+        json += "\"oah\":\"" + ch->OAH + "\",";
+        json += "\"ohp\":\"" + ch->OHP + "\",";
+        json += "\"tload\":\"" + ch->testLoad + "\","; // NEW
+        json += "\"meas_v\":\"" + ch->voltage + "\",";
+        json += "\"meas_i\":\"" + ch->current + "\",";
+        json += "\"meas_ah\":\"" + ch->capacityAh + "\",";
+        json += "\"meas_t\":\"" + ch->energyWh + "\",";
+        json += "\"load\":\"" + String(loadOn ? "ON" : "OFF") + "\",";
+        // no fresh read for DETECT_STALE_MS: the values above are the last good ones
+        json += "\"stale\":" + String(detectStale(ch->detect, millis()) ? "true" : "false") + ",";
+        // end-of-test prediction (null until enough samples of a running test; channel 0 only)
+        EndPrediction e = {};
+        if (ch->id == 0 && testInProgress) e = predictEstimate(endPredictor);
+        if (e.valid) {
+            char num[16];
+            formatMilli(num, sizeof(num), e.finalCap_mAh, 3);
+            json += "\"eta_s\":" + String((unsigned long)e.remaining_s) + ",";
+            json += "\"eta_limit\":\"" + String(predictLimitToString(e.limit)) + "\",";
+            json += "\"pred_ah\":\"" + String(num) + "\",";
+            json += "\"slope_uvps\":" + String((long)e.slope_uVps);
+        } else {
+            json += "\"eta_s\":null,\"eta_limit\":null,\"pred_ah\":null";
+        }
         json += "}";
         request->send(200, "application/json", json);
-    });
+    }));
 
     server.on("/cmd", HTTP_GET, [](AsyncWebServerRequest *request){
         if (!request->hasParam("op")) {
@@ -493,14 +808,147 @@ inline void setupWebUI() {
         else if (op == "stop") deviceCmd = "stop";     // NEW
         else { request->send(400, "text/plain", "unknown op"); return; }
 
-        sendCommandNoNL(deviceCmd);
-        request->send(200, "text/plain", "sent");
+        FzChannel *ch = requestChannel(request);
+        if (!ch) return;
+        if (op == "disable") {
+            // preempts whatever loop() is doing on the link (FZ35_Estop.h)
+            estopRequest(1u << ch->id);
+            request->send(200, "text/plain", "stopping");
+            return;
+        }
+        // sent from loop(): a handler may run while another channel is selected
+        channelQueueCmd(*ch, deviceCmd);
+        request->send(200, "text/plain", "queued");
     });
 
-    // /batteries -> JSON list (uses battery API)
-    server.on("/batteries", HTTP_GET, [](AsyncWebServerRequest *request){
-        String json = getBatteryListJson();
-        request->send(200, "application/json", json);
+    // /estop -> disable every load, never rejected
+    server.on("/estop", HTTP_GET, [](AsyncWebServerRequest *request){
+        estopRequest((1u << FZ_CHANNELS) - 1);
+        request->send(200, "text/plain", "stopping");
+    });
+
+    server.on("/estop_status", HTTP_GET, admitted("/estop_status", AdmitClass::Poll, [](AsyncWebServerRequest *request){
+        request->send(200, "application/json", estopStatusJson());
+    }));
+
+    // /cmd_batch (POST cmds="load:1.3;ocp:1.5;ovp:4.2;lvp:3.0;on;start"[, stop_on_error=0])
+    // validated here, sent from loop(); poll /cmd_batch_status?id= for the results
+    server.on("/cmd_batch", HTTP_POST, [](AsyncWebServerRequest *request){
+        if (!request->hasParam("cmds", true)) {
+            request->send(400, "application/json", "{\"ok\":false,\"error\":\"missing cmds\"}");
+            return;
+        }
+        static BatchCommand cmds[CMD_BATCH_MAX];
+        String err;
+        int n = parseCmdBatch(request->getParam("cmds", true)->value(), cmds, CMD_BATCH_MAX, err);
+        if (n < 0) {
+            request->send(400, "application/json", "{\"ok\":false,\"error\":\"" + err + "\"}");
+            return;
+        }
+        bool stopOnError = !request->hasParam("stop_on_error", true) ||
+                           request->getParam("stop_on_error", true)->value() != "0";
+        uint32_t id = requestCmdBatch(cmds, n, stopOnError, err);
+        if (!id) {
+            request->send(409, "application/json", "{\"ok\":false,\"error\":\"" + err + "\"}");
+            return;
+        }
+        request->send(202, "application/json", cmdBatchStatusJson(id));
+    });
+
+    server.on("/cmd_batch_status", HTTP_GET, admitted("/cmd_batch_status", AdmitClass::Poll, [](AsyncWebServerRequest *request){
+        uint32_t id = request->hasParam("id") ? (uint32_t)request->getParam("id")->value().toInt() : 0;
+        String json = cmdBatchStatusJson(id);
+        if (json.length() == 0) request->send(404, "application/json", "{\"ok\":false,\"error\":\"unknown job\"}");
+        else request->send(200, "application/json", json);
+    }));
+
+    // /batteries?offset=&limit= -> JSON page (uses battery API), memoized per change
+    server.on("/batteries", HTTP_GET, admitted("/batteries", AdmitClass::Poll, [](AsyncWebServerRequest *request){
+        int offset = 0, limit = 50;
+        if (request->hasParam("offset")) offset = request->getParam("offset")->value().toInt();
+        if (request->hasParam("limit")) limit = request->getParam("limit")->value().toInt();
+        if (offset < 0) offset = 0;
+        if (limit <= 0 || limit > 100) limit = 50;
+        sendCachedJson(request, batteriesCache, batteryListGeneration,
+                       ((uint32_t)offset << 8) | (uint32_t)limit,
+                       [=](){ return getBatteryListJson(offset, limit); });
+    }));
+
+    // /profile?id=N -> full definition of one profile
+    server.on("/profile", HTTP_GET, [](AsyncWebServerRequest *request){
+        if (!request->hasParam("id")) {
+            request->send(400, "application/json", "{\"ok\":false}");
+            return;
+        }
+        String json = getBatteryProfileJson(request->getParam("id")->value().toInt());
+        if (json.length() == 0) request->send(404, "application/json", "{\"ok\":false}");
+        else request->send(200, "application/json", json);
+    });
+
+    // /profile_save (POST form: [id], name, chem, nominal, capacity, max_load, load, lvp, oah, ohp)
+    // creates a user profile, or overwrites one when id is given
+    server.on("/profile_save", HTTP_POST, [](AsyncWebServerRequest *request){
+        static const char* const required[] = {
+            "name", "chem", "nominal", "capacity", "max_load", "load", "lvp", "oah", "ohp" };
+        for (const char *key : required) {
+            if (!request->hasParam(key, true)) {
+                request->send(400, "application/json", String("{\"ok\":false,\"error\":\"missing ") + key + "\"}");
+                return;
+            }
+        }
+        auto milli = [&](const char *key) {
+            int32_t v = -1;
+            parseMilli(request->getParam(key, true)->value().c_str(), v);
+            return v;
+        };
+        UserProfileRecord rec = {};
+        request->getParam("name", true)->value().toCharArray(rec.name, sizeof(rec.name));
+        request->getParam("ohp", true)->value().toCharArray(rec.ohp, sizeof(rec.ohp));
+        rec.chem = (uint8_t)request->getParam("chem", true)->value().toInt();
+        rec.nominal_mV = milli("nominal");
+        rec.capacity_mAh = milli("capacity");
+        rec.maxLoad_mA = milli("max_load");
+        rec.recLoad_mA = milli("load");
+        rec.lvp_mV = milli("lvp");
+        rec.oah_mAh = milli("oah");
+
+        int slot = -1;
+        if (request->hasParam("id", true)) {
+            int id = request->getParam("id", true)->value().toInt();
+            if (id < (int)batteryModulesCount) {
+                request->send(400, "application/json", "{\"ok\":false,\"error\":\"built-in profiles are read-only\"}");
+                return;
+            }
+            slot = id - (int)batteryModulesCount;
+        }
+        String err;
+        slot = saveUserProfile(slot, rec, err);
+        if (slot < 0) {
+            request->send(400, "application/json", "{\"ok\":false,\"error\":\"" + err + "\"}");
+            return;
+        }
+        batteryListGeneration++;
+        int id = (int)batteryModulesCount + slot;
+        // keep an active, edited profile in sync without re-applying it (that would stop a
+        // running test); the user re-selects it to send the new values to the load
+        if (id == getActiveBatteryIndex()) refreshActiveBattery();
+        request->send(200, "application/json", "{\"ok\":true,\"id\":" + String(id) + "}");
+    });
+
+    // /profile_delete (POST id=N) -> remove a user profile (not while active)
+    server.on("/profile_delete", HTTP_POST, [](AsyncWebServerRequest *request){
+        if (!request->hasParam("id", true)) {
+            request->send(400, "application/json", "{\"ok\":false}");
+            return;
+        }
+        int id = request->getParam("id", true)->value().toInt();
+        if (id < (int)batteryModulesCount || id == getActiveBatteryIndex()) {
+            request->send(400, "application/json", "{\"ok\":false,\"error\":\"built-in or active profile\"}");
+            return;
+        }
+        bool ok = deleteUserProfile(id - (int)batteryModulesCount);
+        if (ok) batteryListGeneration++;
+        request->send(ok ? 200 : 404, "application/json", String("{\"ok\":") + (ok ? "true" : "false") + "}");
     });
 
     // /select_batt?idx=N -> select battery by index
@@ -509,18 +957,35 @@ inline void setupWebUI() {
             request->send(400, "application/json", "{\"ok\":false}");
             return;
         }
+        FzChannel *ch = requestChannel(request);
+        if (!ch) return;
         int idx = request->getParam("idx")->value().toInt();
-        Serial.printf("HTTP /select_batt called, idx=%d\n", idx);
-        bool ok = setActiveBattery(idx);
+        Serial.printf("HTTP /select_batt called, ch=%u idx=%d\n", ch->id, idx);
+        bool ok = channelSelectBattery(*ch, idx);
         request->send(200, "application/json", String("{\"ok\":") + (ok ? "true" : "false") + "}");
     });
 
     // /data?points=N -> return most recent N points as [[v,i,p,ts],...]
-    server.on("/data", HTTP_GET, [](AsyncWebServerRequest *request){
+    // /data?width=W -> decimated columns (FZ35_Export.cpp)
+    server.on("/data", HTTP_GET, admitted("/data", AdmitClass::Heavy, [](AsyncWebServerRequest *request){
+        FzChannel *ch = requestChannel(request);
+        if (!ch) return;
+        if (request->hasParam("width")) {
+            if (ch->id != 0) {
+                request->send(400, "text/plain", "width= needs channel 0");
+                return;
+            }
+            sendDecimatedSamples(request);
+            return;
+        }
         int reqPoints = 200;
         if(request->hasParam("points")) reqPoints = request->getParam("points")->value().toInt();
         if(reqPoints <= 0) reqPoints = 1;
         if(reqPoints > 500) reqPoints = 500;
+        if (ch->id != 0) {
+            request->send(200, "application/json", channelSamplesJson(*ch, reqPoints));
+            return;
+        }
 
         int total = samplesStored;
         if (total <= 0) {
@@ -532,27 +997,259 @@ inline void setupWebUI() {
         if (toSend > total) toSend = total;
 
         String json = "{\"points\":[";
-        int startIdx = (graphIndex - toSend + GRAPH_POINTS) % GRAPH_POINTS;
+        json.reserve(16 + toSend * 32);
+        char num[16];
+        int startIdx = (graphIndex - toSend + graphPoints) % graphPoints;
         for(int i=0;i<toSend;i++){
-            int idx = (startIdx + i) % GRAPH_POINTS;
+            int idx = (startIdx + i) % graphPoints;
             if(i) json += ",";
             json += "[";
-            json += String(scaledVoltageAt(idx), 2); json += ",";
-            json += String(scaledCurrentAt(idx), 2); json += ",";
-            json += String(scaledPowerAt(idx), 2); json += ",";
+            formatFixed(num, sizeof(num), scaledVoltageAt(idx), 2, 2); json += num; json += ",";
+            formatFixed(num, sizeof(num), scaledCurrentAt(idx), 2, 2); json += num; json += ",";
+            formatFixed(num, sizeof(num), scaledPowerAt(idx), 1, 2); json += num; json += ",";
             json += String((unsigned long)sampleTimestampAt(idx));
             json += "]";
         }
         json += "]}";
         request->send(200, "application/json", json);
+    }));
+
+    // /stats -> running aggregates of the current (or last finished) test
+    server.on("/stats", HTTP_GET, admitted("/stats", AdmitClass::Poll, [](AsyncWebServerRequest *request){
+        FzChannel *ch = requestChannel(request);
+        if (!ch) return;
+        request->send(200, "application/json", statsToJson(ch->stats, ch->testInProgress));
+    }));
+
+    server.on("/channels", HTTP_GET, admitted("/channels", AdmitClass::Poll, [](AsyncWebServerRequest *request){
+        request->send(200, "application/json", channelsJson());
+    }));
+
+    // /program_start (POST steps=...) -> parse and run a timed discharge program
+    server.on("/program_start", HTTP_POST, [](AsyncWebServerRequest *request){
+        if (!request->hasParam("steps", true)) {
+            request->send(400, "application/json", "{\"ok\":false,\"error\":\"missing steps\"}");
+            return;
+        }
+        static ProgramStep steps[MAX_PROGRAM_STEPS];
+        String err;
+        int n = parseProgram(request->getParam("steps", true)->value(), steps, MAX_PROGRAM_STEPS, err);
+        if (n < 0) {
+            request->send(400, "application/json", "{\"ok\":false,\"error\":\"" + err + "\"}");
+            return;
+        }
+        if (dcirBusy()) {
+            request->send(409, "application/json", "{\"ok\":false,\"error\":\"DCIR measurement running\"}");
+            return;
+        }
+        if (cmdBatchBusy()) {
+            request->send(409, "application/json", "{\"ok\":false,\"error\":\"command batch running\"}");
+            return;
+        }
+        // started from loop(): a handler may run while another channel is selected
+        programQueue(steps, n);
+        request->send(200, "application/json", "{\"ok\":true,\"steps\":" + String(n) + "}");
     });
 
-    // NEW: /test_results endpoint
-    server.on("/test_results", HTTP_GET, [](AsyncWebServerRequest *request){
-        String json = getTestResultsJson();
-        request->send(200, "application/json", json);
+    server.on("/program_stop", HTTP_GET, [](AsyncWebServerRequest *request){
+        programQueueStop("user");
+        request->send(200, "application/json", programStatusJson());
+    });
+
+    server.on("/program_status", HTTP_GET, admitted("/program_status", AdmitClass::Poll, [](AsyncWebServerRequest *request){
+        request->send(200, "application/json", programStatusJson());
+    }));
+
+    // /dcir?low=&high=[&repeats=][&settle=] (A, ms): queued, run from loop()
+    server.on("/dcir", HTTP_GET, [](AsyncWebServerRequest *request){
+        if (!request->hasParam("low") || !request->hasParam("high")) {
+            request->send(400, "text/plain", "need low and high (A)");
+            return;
+        }
+        DcirConfig cfg = {};
+        int32_t repeats = 6, settle = 300;
+        if (!parseMilli(request->getParam("low")->value().c_str(), cfg.low_mA) ||
+            !parseMilli(request->getParam("high")->value().c_str(), cfg.high_mA)) {
+            request->send(400, "text/plain", "bad current");
+            return;
+        }
+        if (request->hasParam("repeats")) repeats = request->getParam("repeats")->value().toInt();
+        if (request->hasParam("settle")) settle = request->getParam("settle")->value().toInt();
+        cfg.repeats = (uint16_t)constrain(repeats, 0, 1000);
+        cfg.settle_ms = (uint16_t)constrain(settle, 0, 60000);
+        String err;
+        if (!requestDcir(cfg, err)) {
+            request->send(409, "text/plain", err);
+            return;
+        }
+        request->send(202, "application/json", dcirStatusJson());
+    });
+
+    server.on("/dcir_status", HTTP_GET, admitted("/dcir_status", AdmitClass::Poll, [](AsyncWebServerRequest *request){
+        request->send(200, "application/json", dcirStatusJson());
+    }));
+
+    server.on("/capture_start", HTTP_GET, [](AsyncWebServerRequest *request){
+        if (!captureStart()) {
+            request->send(500, "text/plain", "cannot create capture file");
+            return;
+        }
+        request->send(200, "application/json", captureStatusJson());
     });
 
+    server.on("/capture_stop", HTTP_GET, [](AsyncWebServerRequest *request){
+        captureStop();
+        request->send(200, "application/json", captureStatusJson());
+    });
+
+    server.on("/capture_status", HTTP_GET, admitted("/capture_status", AdmitClass::Poll, [](AsyncWebServerRequest *request){
+        request->send(200, "application/json", captureStatusJson());
+    }));
+
+    // the file is still being appended while a capture runs
+    server.on("/capture.bin", HTTP_GET, admitted("/capture.bin", AdmitClass::Heavy, [](AsyncWebServerRequest *request){
+        if (captureOn) {
+            request->send(409, "text/plain", "stop the capture first");
+            return;
+        }
+        if (!LittleFS.exists(CAPTURE_FILE)) {
+            request->send(404, "text/plain", "no capture");
+            return;
+        }
+        request->send(LittleFS, CAPTURE_FILE, "application/octet-stream", true);
+    }));
+
+    server.on("/admission", HTTP_GET, [](AsyncWebServerRequest *request){
+        request->send(200, "application/json", admissionStatusJson());
+    });
+
+    server.on("/memory", HTTP_GET, admitted("/memory", AdmitClass::Poll, [](AsyncWebServerRequest *request){
+        request->send(200, "application/json", memMapJson());
+    }));
+
+    server.on("/telemetry_config", HTTP_GET, [](AsyncWebServerRequest *request){
+        request->send(200, "application/json", telemetryConfigJson());
+    });
+
+    // /telemetry_config (POST form, any of: enabled, proto=mqtt|influx, host, port, topic,
+    // batch, interval); fields not given keep their value
+    server.on("/telemetry_config", HTTP_POST, [](AsyncWebServerRequest *request){
+        TelemetryConfig next = telemetryConfig();
+        auto number = [&](const char *key, long lo, long hi, long &out) {
+            if (!request->hasParam(key, true)) return true;
+            out = request->getParam(key, true)->value().toInt();
+            return out >= lo && out <= hi;
+        };
+        auto text = [&](const char *key, char *dst, size_t cap) {
+            if (!request->hasParam(key, true)) return true;
+            const String &v = request->getParam(key, true)->value();
+            if (v.length() >= cap) return false;
+            strcpy(dst, v.c_str());
+            return true;
+        };
+        long enabled = next.enabled, port = next.port, batch = next.batchSamples, interval = next.interval_s;
+        bool ok = number("enabled", 0, 1, enabled) && number("port", 1, 65535, port) &&
+                  number("batch", 1, 500, batch) && number("interval", 1, 3600, interval) &&
+                  text("host", next.host, sizeof(next.host)) && text("topic", next.topic, sizeof(next.topic));
+        if (ok && request->hasParam("proto", true)) {
+            const String &proto = request->getParam("proto", true)->value();
+            if (proto == "mqtt") next.proto = TelemetryProto::Mqtt;
+            else if (proto == "influx") next.proto = TelemetryProto::Influx;
+            else ok = false;
+        }
+        next.enabled = enabled;
+        next.port = port;
+        next.batchSamples = batch;
+        next.interval_s = interval;
+        if (!ok || !telemetryConfigure(next)) {
+            request->send(400, "application/json", "{\"ok\":false,\"error\":\"invalid telemetry settings\"}");
+            return;
+        }
+        request->send(200, "application/json", telemetryConfigJson());
+    });
+
+    server.on("/telemetry_status", HTTP_GET, admitted("/telemetry_status", AdmitClass::Poll, [](AsyncWebServerRequest *request){
+        request->send(200, "application/json", telemetryStatusJson());
+    }));
+
+    server.on("/checkpoint_status", HTTP_GET, admitted("/checkpoint_status", AdmitClass::Poll, [](AsyncWebServerRequest *request){
+        request->send(200, "application/json", checkpointStatusJson());
+    }));
+
+    server.on("/wifi_status", HTTP_GET, admitted("/wifi_status", AdmitClass::Poll, [](AsyncWebServerRequest *request){
+        request->send(200, "application/json", wifiStatusJson());
+    }));
+
+    // takes effect in the next wifiTick(); the answer goes out over the old link
+    server.on("/wifi_config", HTTP_POST, [](AsyncWebServerRequest *request){
+        if (!request->hasParam("ssid", true) ||
+            !wifiConfigure(request->getParam("ssid", true)->value(),
+                           request->hasParam("pass", true) ? request->getParam("pass", true)->value() : String())) {
+            request->send(400, "text/plain", "ssid 1-32 chars, password empty or 8-64 chars");
+            return;
+        }
+        request->send(200, "application/json", wifiStatusJson());
+    });
+
+    // restarting discards the previous recording; the ring stays allocated until reboot
+    server.on("/trace_start", HTTP_GET, [](AsyncWebServerRequest *request){
+        uint16_t events = TRACE_EVENTS_DEFAULT;
+        if (request->hasParam("events")) events = (uint16_t)constrain(request->getParam("events")->value().toInt(), 0, TRACE_EVENTS_MAX);
+        if (!traceStart(events)) {
+            request->send(500, "text/plain", "cannot allocate trace ring");
+            return;
+        }
+        request->send(200, "application/json", traceStatusJson());
+    });
+
+    server.on("/trace_stop", HTTP_GET, [](AsyncWebServerRequest *request){
+        traceStop();
+        request->send(200, "application/json", traceStatusJson());
+    });
+
+    server.on("/trace_status", HTTP_GET, admitted("/trace_status", AdmitClass::Poll, [](AsyncWebServerRequest *request){
+        request->send(200, "application/json", traceStatusJson());
+    }));
+
+    // stops the recording; open in chrome://tracing or ui.perfetto.dev
+    server.on("/trace.json", HTTP_GET, admitted("/trace.json", AdmitClass::Heavy, [](AsyncWebServerRequest *request){
+        sendTraceJson(request);
+    }));
+
+    // NEW: /test_results endpoint
+    server.on("/test_results", HTTP_GET, admitted("/test_results", AdmitClass::Heavy, [](AsyncWebServerRequest *request){
+        sendCachedJson(request, testResultsCache, testLogGeneration, 0, getTestResultsJson);
+    }));
+
+    // /test_query -> all types' aggregates; with battery= -> that type over a date range
+    // (from/to = YYYY-MM-DD, inclusive; or days=N back from now) plus the newest limit results
+    server.on("/test_query", HTTP_GET, admitted("/test_query", AdmitClass::Heavy, [](AsyncWebServerRequest *request){
+        if (!request->hasParam("battery")) {
+            request->send(200, "application/json", getTestTypesJson());
+            return;
+        }
+        uint32_t from = 0, to = UINT32_MAX;
+        if (request->hasParam("from")) from = testStampFromDate(request->getParam("from")->value().c_str());
+        if (request->hasParam("to")) {
+            to = testStampFromDate(request->getParam("to")->value().c_str());
+            if (to) to += 1439; // whole day
+        }
+        if (request->hasParam("days")) {
+            time_t now = time(nullptr);
+            struct tm *t = localtime(&now);
+            char date[20];
+            snprintf(date, sizeof(date), "%04d-%02d-%02d %02d:%02d", t->tm_year + 1900, t->tm_mon + 1,
+                     t->tm_mday, t->tm_hour, t->tm_min);
+            uint32_t nowStamp = testStampFromDate(date);
+            uint32_t span = (uint32_t)request->getParam("days")->value().toInt() * 1440UL;
+            from = nowStamp > span ? nowStamp - span : 0;
+        }
+        int limit = 20;
+        if (request->hasParam("limit")) limit = constrain(request->getParam("limit")->value().toInt(), 0, 50);
+        String type = request->getParam("battery")->value();
+        request->send(200, "application/json", getTestQueryJson(type.c_str(), from, to, (uint8_t)limit));
+    }));
+
     // NEW: /clear_test_log endpoint
     server.on("/clear_test_log", HTTP_GET, [](AsyncWebServerRequest *request){
         clearTestLog();
@@ -583,5 +1280,17 @@ inline void setupWebUI() {
         request->send(200, "text/plain", "time set");
     });
 
+    registerExportRoutes(server);
+
+    // captive portal: phones probe some well-known URL through the AP's DNS (which
+    // answers with our address); sending them to the dashboard opens it for the user
+    server.onNotFound([](AsyncWebServerRequest *request){
+        if (wifiApActive() && request->host() != WiFi.softAPIP().toString()) {
+            request->redirect("http://" + WiFi.softAPIP().toString() + "/");
+            return;
+        }
+        request->send(404, "text/plain", "not found");
+    });
+
     server.begin();
 }
\ No newline at end of file
@@ -0,0 +1,552 @@
+#pragma once
+#include <Arduino.h>
+#include <pgmspace.h>
+
+/**
+ * @file FZ35_WebUI_gz.h
+ * @brief GENERATED by tools/gen_webui_gz.py from index_html in FZ35_WebUI.h - do not edit.
+ *        27511 bytes raw -> 8562 bytes gzip.
+ */
+
+#define INDEX_HTML_RAW_LEN 27511
+#define INDEX_HTML_ETAG "\"14a38040cefd8e5b\""
+
+const uint8_t index_html_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x3d, 0x6b, 0x77, 0xd3, 0x48,
+    0x96, 0xdf, 0xf3, 0x2b, 0x0a, 0xf7, 0x0c, 0x96, 0x3a, 0xf2, 0x33, 0x21, 0x0d, 0x76, 0x12, 0x36,
+    0xcd, 0x63, 0xe0, 0x2c, 0x34, 0x1c, 0x42, 0xc3, 0xee, 0x32, 0x9c, 0x20, 0x4b, 0x65, 0x5b, 0x44,
+    0x96, 0xd4, 0x92, 0x9c, 0xc4, 0x93, 0xc9, 0x9e, 0xf9, 0x0b, 0x7b, 0xce, 0xfe, 0xc2, 0xf9, 0x25,
+    0x7b, 0x1f, 0x55, 0x52, 0x49, 0x96, 0x9d, 0xc0, 0x32, 0xcd, 0x24, 0x91, 0x54, 0xb7, 0x6e, 0xdd,
+    0xba, 0x75, 0xdf, 0x55, 0xd2, 0xec, 0x1c, 0xde, 0xf3, 0x63, 0x2f, 0x5f, 0x25, 0x52, 0xcc, 0xf3,
+    0x45, 0x78, 0xbc, 0x73, 0xa8, 0xff, 0x48, 0xd7, 0x87, 0x3f, 0x0b, 0x99, 0xbb, 0xc2, 0x9b, 0xbb,
+    0x69, 0x26, 0xf3, 0xa3, 0xd6, 0x32, 0x9f, 0x76, 0x1e, 0xb6, 0xf4, 0xe3, 0xc8, 0x5d, 0xc8, 0xa3,
+    0xd6, 0x45, 0x20, 0x2f, 0x93, 0x38, 0xcd, 0x5b, 0xc2, 0x8b, 0xa3, 0x5c, 0x46, 0x00, 0x76, 0x19,
+    0xf8, 0xf9, 0xfc, 0xc8, 0x97, 0x17, 0x81, 0x27, 0x3b, 0x74, 0xe3, 0x04, 0x51, 0x90, 0x07, 0x6e,
+    0xd8, 0xc9, 0x3c, 0x37, 0x94, 0x47, 0x03, 0xc4, 0x91, 0x07, 0x79, 0x28, 0x8f, 0x9f, 0xff, 0xd7,
+    0xde, 0x03, 0xf1, 0xca, 0x9d, 0x1c, 0xf6, 0xf8, 0x7e, 0xe7, 0x30, 0xcb, 0x57, 0xf8, 0x57, 0x88,
+    0x51, 0x1a, 0xc7, 0xb9, 0xb8, 0x16, 0x9d, 0xce, 0x64, 0x36, 0xfa, 0x69, 0x3a, 0x9d, 0x8e, 0xe1,
+    0x72, 0x0a, 0x97, 0xc3, 0xe1, 0x10, 0x2f, 0x3d, 0x37, 0xf5, 0xe1, 0xf9, 0x3e, 0xfc, 0x3b, 0xc0,
+    0xfb, 0xc5, 0x32, 0x97, 0xf0, 0xe0, 0xe1, 0xc3, 0x87, 0x63, 0x71, 0x03, 0xfd, 0xbb, 0x51, 0x30,
+    0x9b, 0x97, 0x08, 0x06, 0x43, 0xfc, 0xa7, 0x71, 0x48, 0x29, 0x4b, 0x1c, 0x03, 0x17, 0xff, 0x19,
+    0x38, 0x1e, 0x3d, 0x7a, 0xc4, 0x38, 0x26, 0xb1, 0xbf, 0xba, 0x9e, 0xb8, 0xde, 0xf9, 0x2c, 0x8d,
+    0x97, 0x91, 0x3f, 0xba, 0x70, 0x53, 0x0b, 0xd1, 0xd9, 0x63, 0x2f, 0x0e, 0xe3, 0x54, 0xdd, 0x4f,
+    0xe1, 0x7e, 0x0a, 0xb3, 0xef, 0x4c, 0xdd, 0x45, 0x10, 0xae, 0x46, 0x27, 0x29, 0xcc, 0xd5, 0x79,
+    0x21, 0xc3, 0x0b, 0x99, 0x07, 0x9e, 0xeb, 0x64, 0x6e, 0x94, 0x75, 0x32, 0x99, 0x06, 0xd3, 0xf1,
+    0xc2, 0x4d, 0x67, 0x41, 0x34, 0x7a, 0x98, 0x5c, 0x11, 0x89, 0x79, 0x9c, 0x5c, 0xfb, 0x41, 0x96,
+    0x84, 0xee, 0x6a, 0x34, 0x0d, 0xe5, 0xd5, 0x78, 0xe6, 0x26, 0xd8, 0x38, 0xc6, 0x9b, 0xce, 0x65,
+    0x0a, 0x77, 0xf8, 0x6b, 0xec, 0x86, 0xc1, 0x2c, 0xea, 0x04, 0xb9, 0x5c, 0x64, 0x23, 0x0f, 0x98,
+    0x2c, 0x53, 0xea, 0x9e, 0xb8, 0xa9, 0xbb, 0x58, 0xa7, 0x0f, 0x67, 0x65, 0x8f, 0x13, 0xd7, 0xf7,
+    0x83, 0x68, 0x86, 0xe8, 0xc4, 0xa0, 0x0f, 0x38, 0x27, 0x71, 0xea, 0xcb, 0xb4, 0x93, 0xba, 0x7e,
+    0xb0, 0xcc, 0x46, 0x07, 0xf0, 0x64, 0x11, 0x44, 0xbc, 0x40, 0xa3, 0xc1, 0x3e, 0x42, 0xe4, 0xf2,
+    0x2a, 0xef, 0xd0, 0x58, 0xe6, 0x28, 0xa1, 0x3b, 0xb9, 0xa6, 0xe9, 0x65, 0xc1, 0xdf, 0xe4, 0x68,
+    0x30, 0x00, 0x40, 0x73, 0xf6, 0xc4, 0x33, 0xfb, 0x46, 0x74, 0x2f, 0xdc, 0x90, 0xe1, 0x2e, 0x25,
+    0x72, 0x7e, 0xf4, 0x4b, 0xbf, 0x3f, 0x36, 0xfa, 0xd1, 0x80, 0x34, 0xfd, 0x0e, 0x4c, 0x1b, 0xc7,
+    0x27, 0xec, 0x48, 0x79, 0x02, 0xab, 0x54, 0x61, 0x83, 0xd0, 0x7c, 0x10, 0xeb, 0x33, 0x1f, 0x8b,
+    0x1a, 0x73, 0x68, 0xa5, 0x7e, 0x42, 0xf1, 0x4b, 0xe3, 0x30, 0xbb, 0x56, 0x63, 0x84, 0x72, 0x9a,
+    0x8f, 0xdc, 0x65, 0x1e, 0x8f, 0x1b, 0x19, 0xdc, 0xcc, 0xd1, 0x9f, 0x66, 0x80, 0x70, 0x7e, 0xad,
+    0x78, 0xd2, 0xef, 0xff, 0x19, 0x28, 0xbe, 0xd2, 0x2c, 0x1a, 0xf6, 0x91, 0x47, 0x73, 0x9e, 0xdc,
+    0xde, 0x41, 0xc9, 0xd2, 0x11, 0xb0, 0x44, 0x64, 0x71, 0x18, 0xf8, 0x40, 0x86, 0xe7, 0x8d, 0x37,
+    0x2c, 0x88, 0xa6, 0x63, 0x12, 0xc6, 0xde, 0xb9, 0xc9, 0x8a, 0xc1, 0x50, 0xf1, 0x22, 0xcb, 0xdd,
+    0x3c, 0x6b, 0xe4, 0x05, 0x82, 0x8c, 0x85, 0xd1, 0x87, 0x98, 0xd3, 0xc4, 0x08, 0x42, 0x42, 0x23,
+    0x02, 0xa2, 0x0d, 0x94, 0x08, 0x2d, 0x1b, 0xb0, 0x08, 0x82, 0x30, 0xad, 0xcb, 0x86, 0x30, 0x84,
+    0x83, 0xe6, 0x5a, 0xc7, 0xde, 0xcd, 0x40, 0x30, 0x64, 0x68, 0x8a, 0xc6, 0x70, 0x93, 0x68, 0x64,
+    0x75, 0xd9, 0x38, 0x00, 0xd9, 0x30, 0x66, 0xb3, 0xcf, 0x0c, 0x98, 0x2c, 0xf3, 0x3c, 0x8e, 0xae,
+    0xeb, 0xd4, 0xad, 0x13, 0xa7, 0xf8, 0xde, 0x37, 0x59, 0xfd, 0x53, 0xbf, 0xff, 0xd0, 0x7b, 0x24,
+    0x15, 0x01, 0x68, 0x30, 0x10, 0x65, 0xee, 0x4e, 0x42, 0xb9, 0x75, 0x41, 0x15, 0x76, 0xe8, 0x16,
+    0xba, 0x49, 0x26, 0x47, 0xfa, 0xa2, 0xbe, 0x42, 0x1b, 0x96, 0x95, 0x06, 0x99, 0x3b, 0xb9, 0x7f,
+    0x6d, 0x28, 0x9c, 0xa9, 0x49, 0x28, 0x88, 0x7a, 0x90, 0x49, 0x0c, 0x13, 0x5c, 0x18, 0xf2, 0x52,
+    0xe1, 0x13, 0x61, 0x5a, 0x57, 0x67, 0x6e, 0xad, 0x30, 0x16, 0x2c, 0x10, 0x42, 0xff, 0xdb, 0x42,
+    0xfa, 0x81, 0x2b, 0xac, 0x72, 0x4e, 0x07, 0x38, 0x25, 0xfb, 0x5a, 0x9b, 0x06, 0x63, 0x0d, 0xd1,
+    0x04, 0x98, 0x4a, 0xca, 0x2b, 0x86, 0x8c, 0x87, 0x85, 0x3d, 0xec, 0x29, 0xb3, 0x7b, 0xd8, 0x53,
+    0x96, 0x1f, 0x2d, 0x1f, 0x5a, 0xe1, 0x43, 0x3f, 0xb8, 0x10, 0x5e, 0xe8, 0x66, 0xd9, 0x51, 0x0b,
+    0x38, 0xd1, 0xc2, 0x67, 0xd5, 0xa7, 0xa4, 0xc0, 0xea, 0x39, 0xb4, 0xdc, 0xeb, 0x74, 0xc4, 0xf3,
+    0x65, 0x18, 0x92, 0x7f, 0xc8, 0xc4, 0x34, 0x4e, 0x45, 0x92, 0xc6, 0xb9, 0xf4, 0xf2, 0x20, 0x8e,
+    0x04, 0x91, 0x25, 0x41, 0xdb, 0x32, 0xb0, 0xb6, 0x45, 0x1f, 0x03, 0x1b, 0x01, 0xb4, 0x8e, 0xcd,
+    0x47, 0x20, 0x66, 0xad, 0xe3, 0x37, 0x1f, 0xde, 0x0a, 0xeb, 0xcd, 0x85, 0x4c, 0xc5, 0x87, 0x38,
+    0xcc, 0xdd, 0x99, 0x14, 0x6f, 0x19, 0xab, 0x7d, 0xd8, 0x03, 0x58, 0xee, 0x10, 0xf8, 0x47, 0xad,
+    0xf8, 0x22, 0x69, 0xe9, 0x9e, 0x30, 0xd9, 0xd6, 0x71, 0xa7, 0xa3, 0x20, 0xe8, 0xf7, 0xb7, 0x0c,
+    0xf9, 0x44, 0x0f, 0xf9, 0x64, 0x99, 0xa6, 0x60, 0x23, 0x36, 0x0e, 0xe9, 0xfd, 0xb0, 0x21, 0xdf,
+    0xea, 0x21, 0xdf, 0xc6, 0x97, 0xf8, 0x7b, 0xc3, 0x80, 0xc9, 0x8f, 0x1a, 0xf0, 0x15, 0xb2, 0xf5,
+    0x55, 0x7c, 0x79, 0x1b, 0x57, 0xc3, 0x1f, 0xc7, 0xd5, 0x93, 0x17, 0x6a, 0x8a, 0x27, 0x8b, 0xe4,
+    0x9f, 0xff, 0xf8, 0x9f, 0x17, 0xf1, 0x32, 0x15, 0xaf, 0x82, 0x45, 0xb0, 0x3e, 0x4b, 0x77, 0xfe,
+    0xa3, 0xc6, 0x7c, 0xa1, 0xd9, 0x4a, 0xa3, 0xf5, 0xc4, 0xfb, 0x60, 0x21, 0x37, 0x0c, 0x3a, 0xbf,
+    0x7d, 0xa2, 0xea, 0x72, 0x83, 0x26, 0x08, 0x52, 0xa5, 0xa3, 0x96, 0xe9, 0x87, 0xd0, 0x24, 0x54,
+    0x55, 0xe4, 0xb5, 0x74, 0xb3, 0x65, 0x2a, 0x7d, 0x61, 0x3d, 0x39, 0xfd, 0x60, 0x83, 0x1d, 0x08,
+    0x97, 0xa0, 0x2d, 0x97, 0x41, 0x3e, 0x17, 0x53, 0xd4, 0x1e, 0xb2, 0xad, 0xdf, 0xaa, 0x24, 0x05,
+    0x52, 0xbd, 0x9a, 0xd6, 0x87, 0xfa, 0xfc, 0x16, 0x00, 0x72, 0x76, 0xf1, 0x83, 0xf8, 0x5a, 0x8c,
+    0xa7, 0x15, 0xc4, 0x3a, 0x69, 0x1c, 0x2f, 0xf8, 0xe1, 0xe3, 0xb9, 0x89, 0xeb, 0x05, 0xf9, 0x0a,
+    0x06, 0x9c, 0x37, 0x8e, 0xf8, 0xc3, 0x44, 0xa7, 0x18, 0x92, 0x44, 0xc6, 0x7a, 0xf1, 0x62, 0xf4,
+    0xfa, 0x75, 0xe3, 0x88, 0xf9, 0x8f, 0xd2, 0xc8, 0xd8, 0xf5, 0xc5, 0x29, 0x78, 0xd9, 0x65, 0x26,
+    0x2c, 0xf0, 0x19, 0xc1, 0x05, 0x18, 0xff, 0xba, 0x36, 0x02, 0xcc, 0x59, 0x46, 0x30, 0x3f, 0x68,
+    0xd4, 0xb7, 0x30, 0xc5, 0xc0, 0x03, 0x3f, 0x23, 0x9e, 0x45, 0x20, 0x93, 0xa9, 0x5c, 0xb8, 0x10,
+    0xb3, 0x47, 0xb3, 0xfa, 0xc8, 0x09, 0xc0, 0x9d, 0x41, 0xf4, 0xff, 0xc3, 0x87, 0xdd, 0xb6, 0xa2,
+    0x34, 0xe8, 0x1d, 0x56, 0x74, 0x4d, 0x2f, 0xb1, 0xb3, 0x8e, 0x0b, 0x4b, 0xf5, 0xe3, 0x28, 0x83,
+    0x1a, 0xf3, 0x78, 0x36, 0x0b, 0xe5, 0x6f, 0x18, 0x92, 0xb4, 0x8e, 0xe9, 0xcf, 0x61, 0x8f, 0x9b,
+    0x9b, 0xa0, 0x27, 0x79, 0xf4, 0x2c, 0xc2, 0x78, 0xa2, 0xd0, 0x71, 0x33, 0xfc, 0x18, 0xfa, 0x0f,
+    0xa7, 0x43, 0x7f, 0xbc, 0xae, 0xf6, 0xdc, 0x47, 0xe0, 0xc2, 0xde, 0x82, 0xfd, 0x69, 0x90, 0x6d,
+    0x44, 0xef, 0x3d, 0xda, 0x77, 0xf7, 0x5d, 0x40, 0xa7, 0x80, 0x1a, 0xf1, 0x99, 0x16, 0xe6, 0xb7,
+    0x67, 0x1f, 0x47, 0xe2, 0x74, 0x15, 0x79, 0x22, 0x47, 0xd1, 0x55, 0x23, 0x19, 0x06, 0xa5, 0x3a,
+    0x36, 0x42, 0xa2, 0x8c, 0x37, 0x0e, 0x7e, 0x70, 0x70, 0x50, 0x99, 0x18, 0xc5, 0x43, 0xad, 0x63,
+    0xc2, 0x8e, 0x9d, 0xd6, 0xe6, 0xa5, 0xb9, 0x8f, 0x43, 0xbf, 0x93, 0xd9, 0x32, 0xcc, 0x37, 0xda,
+    0xc5, 0x5b, 0x53, 0x8b, 0x56, 0x55, 0xae, 0xea, 0x43, 0x78, 0x0b, 0xff, 0x96, 0x11, 0x54, 0x44,
+    0xd8, 0x9f, 0xf4, 0xc7, 0xad, 0x06, 0x79, 0x31, 0x05, 0x87, 0x38, 0x77, 0xe2, 0xfb, 0x10, 0x88,
+    0x05, 0x99, 0x08, 0xa2, 0x2c, 0xf0, 0x25, 0x5c, 0xc3, 0x4f, 0x9c, 0x08, 0x2d, 0x4a, 0x3d, 0x12,
+    0xe7, 0x4c, 0xb8, 0xa9, 0x84, 0xe0, 0xeb, 0xc5, 0xfb, 0xd7, 0xaf, 0x04, 0xa6, 0xc0, 0x18, 0xdf,
+    0xc4, 0x53, 0xe8, 0xe4, 0xcb, 0xab, 0x33, 0xcc, 0xa3, 0x6d, 0xc5, 0xed, 0x43, 0x32, 0xe6, 0xdb,
+    0xa9, 0xab, 0x84, 0x7a, 0xd5, 0x90, 0xba, 0x75, 0xfc, 0xab, 0x9b, 0x43, 0xc8, 0xb4, 0x1a, 0x1d,
+    0xf6, 0x08, 0x13, 0xe1, 0xcc, 0x64, 0x08, 0x7e, 0x9a, 0x57, 0x8f, 0x9b, 0x4f, 0xe9, 0x49, 0x23,
+    0x17, 0x30, 0x66, 0x36, 0xa2, 0xea, 0x86, 0x88, 0x1a, 0x19, 0xc3, 0x28, 0x7f, 0x08, 0xc5, 0x1f,
+    0x81, 0x0b, 0xf1, 0xe5, 0x26, 0x82, 0x29, 0xcb, 0x62, 0x90, 0xef, 0x26, 0x97, 0x57, 0x30, 0x4e,
+    0x88, 0xed, 0xe4, 0x3e, 0x8f, 0x5a, 0x7b, 0xfd, 0x7e, 0xeb, 0xf8, 0x01, 0x66, 0x2e, 0x87, 0x3d,
+    0x6e, 0x69, 0x04, 0x7b, 0x84, 0x60, 0x83, 0xdb, 0xe1, 0x20, 0xc7, 0x43, 0x40, 0x31, 0xdf, 0x0a,
+    0xe5, 0x86, 0x60, 0x8d, 0x4e, 0xc0, 0x65, 0x07, 0x91, 0x78, 0x77, 0xf2, 0x7a, 0x2b, 0x6c, 0x2e,
+    0x33, 0x30, 0x34, 0x1f, 0xe7, 0x31, 0xe8, 0x2f, 0x5e, 0x9b, 0xc0, 0x25, 0xff, 0xf1, 0xc6, 0x73,
+    0xa3, 0x0b, 0x37, 0x2b, 0xb9, 0xd5, 0x12, 0x5c, 0x56, 0x69, 0x61, 0xd6, 0xd2, 0x12, 0x9c, 0x85,
+    0x12, 0x89, 0xb8, 0x72, 0x0c, 0x5d, 0x4a, 0xf0, 0x29, 0x25, 0x92, 0x94, 0xfb, 0x50, 0x04, 0xfe,
+    0x1f, 0xc2, 0x42, 0x4d, 0xb4, 0x85, 0x0b, 0xd6, 0xfd, 0x3f, 0x85, 0x75, 0xc1, 0xf1, 0x81, 0x8d,
+    0x2c, 0xe8, 0x2d, 0x02, 0xbf, 0x07, 0x19, 0x84, 0x16, 0x56, 0xc3, 0x46, 0x53, 0x3e, 0xda, 0x22,
+    0x22, 0xe8, 0xf2, 0x04, 0x04, 0xbe, 0x21, 0x03, 0x28, 0x72, 0xc2, 0x56, 0x93, 0xed, 0xe7, 0x34,
+    0xb1, 0x75, 0x0c, 0x34, 0xbc, 0x27, 0x1a, 0xfe, 0xf9, 0x8f, 0xff, 0x15, 0xaf, 0x81, 0x59, 0x3d,
+    0xf8, 0xed, 0xe3, 0x6f, 0xf7, 0x6a, 0xa3, 0xe3, 0xc0, 0xc4, 0x91, 0x09, 0xb8, 0x3a, 0x83, 0xcb,
+    0x0c, 0xed, 0x3e, 0x74, 0x51, 0xbf, 0x9a, 0x74, 0xf9, 0x7b, 0x48, 0x03, 0x8e, 0xe8, 0x88, 0xe9,
+    0xc3, 0xf7, 0xd2, 0xb7, 0xfa, 0x17, 0xd2, 0x77, 0xea, 0x2e, 0x92, 0x50, 0x66, 0x77, 0xa0, 0x22,
+    0x63, 0xc8, 0x33, 0x0f, 0xec, 0x36, 0x48, 0x5a, 0xff, 0x47, 0x51, 0xf0, 0x17, 0x94, 0x41, 0xf1,
+    0x4e, 0x82, 0x6d, 0x4b, 0x21, 0xdf, 0xcc, 0x98, 0x4b, 0xaf, 0xdc, 0x2c, 0x47, 0x06, 0x49, 0x37,
+    0x62, 0x3e, 0x09, 0xeb, 0x39, 0xe6, 0x77, 0x99, 0x7d, 0x07, 0x52, 0x53, 0x42, 0x76, 0xc6, 0x32,
+    0x76, 0xdc, 0xcc, 0xac, 0x9a, 0x61, 0x26, 0xc5, 0xe9, 0xa0, 0xe2, 0x08, 0x77, 0x36, 0x4b, 0xe5,
+    0xcc, 0x85, 0x6b, 0x81, 0xa1, 0x4a, 0x0e, 0x3f, 0x10, 0x45, 0x80, 0xa6, 0xa1, 0xb1, 0xe6, 0xda,
+    0xa3, 0xb0, 0x7a, 0x84, 0xdc, 0xde, 0x2e, 0xd9, 0x88, 0xee, 0xf4, 0xff, 0x2d, 0xdd, 0xef, 0x91,
+    0xa8, 0x67, 0x91, 0x4c, 0x67, 0x10, 0xc2, 0x7c, 0x9c, 0xdb, 0xc0, 0x8f, 0x27, 0x73, 0x30, 0x69,
+    0xd2, 0x08, 0x68, 0xb6, 0xb2, 0x23, 0xcf, 0xce, 0x24, 0x75, 0x2f, 0x44, 0xe8, 0x47, 0xad, 0x1d,
+    0x91, 0xa6, 0xe5, 0xdb, 0x10, 0xee, 0x62, 0xd5, 0xee, 0x46, 0xdd, 0xc5, 0xbf, 0x46, 0xb6, 0x89,
+    0x3a, 0x9d, 0x3f, 0x7c, 0x3f, 0x75, 0xc1, 0xbf, 0x86, 0xba, 0xb7, 0xd2, 0x3d, 0x57, 0xb9, 0xb8,
+    0xf5, 0xf1, 0x8e, 0xcb, 0x98, 0xdc, 0x51, 0x9a, 0xdf, 0x2e, 0xc3, 0x4c, 0x8a, 0xa7, 0x4f, 0x5e,
+    0xbe, 0x1b, 0x89, 0x94, 0x22, 0x18, 0x01, 0x31, 0x47, 0x96, 0xc7, 0x98, 0x6e, 0x50, 0x26, 0x88,
+    0xb2, 0x1c, 0xc9, 0xab, 0x5c, 0x84, 0x10, 0xa7, 0xc2, 0x43, 0x92, 0x7c, 0x43, 0x98, 0x71, 0x40,
+    0xdf, 0x0b, 0xd2, 0x27, 0x3a, 0xc6, 0xad, 0x39, 0xd3, 0xa2, 0x74, 0x75, 0x6b, 0x8d, 0x4e, 0x31,
+    0x01, 0x89, 0x01, 0x1c, 0x32, 0x11, 0x87, 0x41, 0x94, 0x2c, 0xf3, 0x62, 0x84, 0x57, 0xe8, 0xa9,
+    0x95, 0x13, 0xeb, 0x77, 0x87, 0xe0, 0x81, 0x10, 0xdb, 0x51, 0x6b, 0xbf, 0x75, 0x2c, 0x4e, 0xc4,
+    0xfd, 0xd4, 0x4d, 0xd3, 0x71, 0xbd, 0xcf, 0x0b, 0x70, 0x51, 0x45, 0xa7, 0x41, 0xb7, 0x5f, 0xed,
+    0xe4, 0xd0, 0x80, 0xa9, 0x4c, 0x24, 0xba, 0xaa, 0x5a, 0xd7, 0x77, 0xfc, 0xb8, 0xe8, 0x7d, 0xa0,
+    0xbb, 0x0e, 0xb5, 0x82, 0xd6, 0x02, 0x67, 0xe8, 0xb3, 0x25, 0xf1, 0x56, 0x49, 0x1c, 0x4d, 0xaf,
+    0x1a, 0xaa, 0x1e, 0x66, 0x89, 0x1b, 0x19, 0xc3, 0x6e, 0x8d, 0x23, 0x29, 0x46, 0x02, 0xf8, 0x26,
+    0xcb, 0x14, 0x3c, 0x0f, 0x46, 0xa6, 0xed, 0x49, 0x25, 0x44, 0x8b, 0x11, 0xb8, 0x73, 0x8c, 0x22,
+    0xa9, 0xa1, 0x8c, 0xa7, 0xc7, 0xc2, 0xf5, 0xfe, 0x58, 0x06, 0x59, 0x40, 0xa1, 0x41, 0x24, 0xb1,
+    0x30, 0x71, 0xe9, 0x06, 0x39, 0x57, 0xcb, 0x82, 0xb5, 0x25, 0xbe, 0x0c, 0xa6, 0xc1, 0x0f, 0x5b,
+    0x62, 0xa4, 0xd4, 0x98, 0x36, 0xe2, 0x46, 0xeb, 0x27, 0x59, 0x68, 0xf5, 0xf4, 0x84, 0xb9, 0x22,
+    0x04, 0x03, 0x91, 0x70, 0x4b, 0x24, 0xa1, 0xeb, 0x49, 0x30, 0xc2, 0x60, 0xb8, 0x8f, 0x5a, 0xa7,
+    0xa7, 0x2f, 0x9f, 0xea, 0x75, 0x19, 0x0c, 0x6f, 0xab, 0x7b, 0xd4, 0xf0, 0xbd, 0x05, 0xbd, 0x69,
+    0x09, 0xdc, 0x79, 0xc2, 0xec, 0x30, 0xcb, 0x2e, 0x21, 0xc4, 0xab, 0xe1, 0x2f, 0x1f, 0x17, 0x63,
+    0x34, 0x2e, 0xfe, 0x47, 0x40, 0xb7, 0x65, 0xf4, 0x27, 0xbc, 0x0e, 0xe6, 0xba, 0xd7, 0x16, 0x8f,
+    0x32, 0x25, 0xb2, 0x43, 0x2c, 0x00, 0x99, 0x78, 0x4f, 0x91, 0x93, 0x5a, 0x86, 0xf9, 0x5e, 0x03,
+    0xcf, 0x87, 0x7d, 0x0c, 0x73, 0xcd, 0x4e, 0x87, 0xbd, 0xf9, 0x1e, 0xc1, 0x73, 0xd8, 0xa5, 0x5d,
+    0x0b, 0xa1, 0xd2, 0x84, 0xe7, 0x5c, 0x5d, 0x55, 0x06, 0x24, 0x4f, 0xf5, 0x25, 0x35, 0x1d, 0x3f,
+    0x85, 0x65, 0x38, 0xec, 0xc1, 0x45, 0xe5, 0xa9, 0x0a, 0xfe, 0xc5, 0x7b, 0xe0, 0xd5, 0x7a, 0xeb,
+    0xf3, 0x20, 0x72, 0xc3, 0x7a, 0xf6, 0x5c, 0x07, 0x7a, 0xba, 0x4c, 0x5d, 0x92, 0x35, 0xab, 0xb1,
+    0x15, 0x95, 0xde, 0x5a, 0xdc, 0x7f, 0xb3, 0x00, 0x87, 0x3a, 0xae, 0x00, 0xc0, 0x75, 0xaa, 0x8d,
+    0x98, 0x41, 0xfb, 0x61, 0x8e, 0xe5, 0xe1, 0xea, 0x14, 0x7f, 0x85, 0x27, 0x2d, 0x73, 0x6a, 0x87,
+    0xb9, 0x0f, 0x19, 0x53, 0x88, 0x12, 0x75, 0xd4, 0x7a, 0xc0, 0x85, 0x0d, 0x08, 0xe8, 0xbb, 0xdd,
+    0x2e, 0xe0, 0xf2, 0x8f, 0x2b, 0xa8, 0x8b, 0x6a, 0x73, 0x8f, 0x98, 0x47, 0x97, 0xd5, 0x45, 0x7e,
+    0x12, 0x4a, 0x17, 0xac, 0xd0, 0xac, 0x49, 0xfe, 0x1f, 0x56, 0x8b, 0xf3, 0x65, 0xaa, 0x4c, 0x9d,
+    0x78, 0x65, 0xa1, 0x6b, 0x29, 0x01, 0x3b, 0xb4, 0xec, 0x1c, 0xd3, 0x70, 0x18, 0x22, 0x53, 0xb0,
+    0xc1, 0xcb, 0x88, 0x94, 0xd5, 0x15, 0x1f, 0xe5, 0x44, 0x7c, 0x8c, 0xd3, 0x73, 0xd0, 0x4b, 0xa0,
+    0x00, 0x34, 0xe5, 0xcd, 0x74, 0x9a, 0x79, 0xa9, 0x94, 0xd1, 0x13, 0x0e, 0xcb, 0xad, 0x38, 0xd5,
+    0xb1, 0x46, 0x82, 0x5e, 0xf5, 0x72, 0x2e, 0x23, 0x9e, 0x7a, 0x3e, 0x77, 0xc9, 0x8c, 0x2f, 0x23,
+    0xf7, 0xc2, 0x0d, 0x42, 0x9c, 0x8d, 0xdd, 0x15, 0x2f, 0x73, 0x71, 0x2e, 0x65, 0x92, 0x51, 0x0f,
+    0x60, 0xca, 0x72, 0x01, 0x43, 0x41, 0xae, 0xe8, 0x8a, 0x69, 0x70, 0x85, 0x86, 0x1d, 0x33, 0x74,
+    0xf7, 0x2a, 0xc8, 0x1c, 0x31, 0x95, 0xb9, 0x37, 0x87, 0xa8, 0x26, 0x8e, 0xc2, 0x15, 0x82, 0x33,
+    0x5a, 0xdd, 0x67, 0x9a, 0xc6, 0x0b, 0xe5, 0x16, 0x2e, 0x71, 0x5a, 0x71, 0x24, 0x91, 0x10, 0xab,
+    0xe7, 0xbb, 0xb9, 0xfb, 0x98, 0x53, 0x84, 0xfb, 0x00, 0x7c, 0x64, 0x3b, 0xc2, 0x4f, 0xdd, 0xcb,
+    0x4c, 0x7c, 0x5d, 0x02, 0x18, 0x51, 0x95, 0xe5, 0x69, 0x90, 0x38, 0x98, 0x02, 0x30, 0x4e, 0x70,
+    0x33, 0x04, 0x81, 0xf6, 0x67, 0x05, 0xf9, 0x6e, 0x34, 0xe3, 0x41, 0x71, 0x32, 0x34, 0x06, 0x12,
+    0x24, 0xe6, 0x30, 0xdd, 0x3c, 0xc6, 0x4d, 0xe0, 0x68, 0x26, 0xbb, 0xa4, 0x13, 0x87, 0xc0, 0x8b,
+    0x20, 0x31, 0x53, 0x39, 0xe2, 0x95, 0x56, 0x67, 0xdc, 0xfb, 0xe8, 0x7d, 0xcd, 0x3a, 0x97, 0xfc,
+    0xf4, 0x78, 0x67, 0xba, 0x8c, 0xb8, 0xfa, 0x4f, 0xc0, 0xef, 0x14, 0xc3, 0x2d, 0x4e, 0x5a, 0x1c,
+    0x30, 0x8c, 0x99, 0x74, 0x20, 0x83, 0xce, 0x72, 0x47, 0x2c, 0x62, 0x5f, 0xda, 0xd7, 0x3b, 0x38,
+    0xe1, 0x08, 0xe8, 0xf6, 0xf2, 0x2b, 0x71, 0x24, 0x18, 0xb0, 0x3b, 0x93, 0x39, 0x5a, 0x41, 0xc0,
+    0x6e, 0xb5, 0x87, 0x7e, 0xdb, 0x1e, 0x17, 0x60, 0x6f, 0x4f, 0x9e, 0x02, 0xd8, 0x83, 0xbe, 0x23,
+    0x3e, 0x96, 0xe0, 0xc4, 0x0c, 0xd1, 0xc1, 0xc6, 0x9f, 0x87, 0x8e, 0x78, 0x51, 0xb6, 0x70, 0xf2,
+    0xa4, 0x9b, 0x4a, 0x34, 0x41, 0x04, 0x6b, 0xbc, 0x80, 0x38, 0x04, 0x34, 0xea, 0x88, 0x48, 0x11,
+    0xf7, 0x8e, 0x8e, 0x44, 0x1b, 0x0b, 0xb2, 0x6d, 0x04, 0x0b, 0x65, 0x0e, 0x8e, 0x39, 0x82, 0xc6,
+    0x36, 0xa4, 0x9a, 0x6d, 0x47, 0xf0, 0x16, 0xf3, 0x91, 0x98, 0x42, 0xe8, 0x0f, 0x73, 0x98, 0x2c,
+    0xb3, 0x95, 0xbe, 0xd3, 0xf0, 0x53, 0x0c, 0x88, 0xe1, 0x61, 0x04, 0x48, 0xc6, 0x4a, 0xeb, 0x7a,
+    0x3d, 0x71, 0x8d, 0x2b, 0xe9, 0x00, 0x67, 0x1d, 0x90, 0x8c, 0xd5, 0xcd, 0xa8, 0x14, 0x81, 0x8a,
+    0x8c, 0xb8, 0xe0, 0xb5, 0x26, 0x41, 0xc4, 0xb1, 0xad, 0xc2, 0x88, 0x4a, 0x05, 0x08, 0x3f, 0x7d,
+    0xd6, 0xe8, 0x18, 0xe3, 0x27, 0x78, 0x0e, 0x14, 0x39, 0xe2, 0x02, 0x84, 0x2a, 0xcd, 0xf2, 0x1e,
+    0xe5, 0x76, 0xee, 0x15, 0xa4, 0xe0, 0xc8, 0xd9, 0x40, 0x80, 0xe6, 0x01, 0x9b, 0xf1, 0xcf, 0x67,
+    0x14, 0xf3, 0x7e, 0xb7, 0x3f, 0x10, 0x1f, 0x20, 0x5a, 0xa2, 0x8b, 0x13, 0xba, 0x18, 0x88, 0x8f,
+    0x6a, 0x10, 0xf7, 0xaa, 0x46, 0x33, 0x0f, 0x42, 0x1b, 0xf8, 0x24, 0xba, 0x48, 0x25, 0x62, 0xe6,
+    0x72, 0x35, 0x4a, 0x92, 0xea, 0xa9, 0x52, 0x10, 0xe8, 0x0e, 0xeb, 0x71, 0x11, 0xc6, 0x70, 0xf1,
+    0x32, 0x9a, 0xe2, 0x09, 0x80, 0x15, 0xdc, 0xcf, 0x03, 0xb8, 0xef, 0x94, 0x0f, 0x94, 0x1c, 0x03,
+    0x70, 0xb9, 0x0e, 0x89, 0x4c, 0xa7, 0xf0, 0xe4, 0x9a, 0x96, 0xc0, 0xa1, 0x01, 0x46, 0x70, 0x47,
+    0x9c, 0xcc, 0x46, 0x80, 0x15, 0xc7, 0xc5, 0xbf, 0xd9, 0x72, 0x81, 0x7f, 0x60, 0x92, 0xa3, 0xbe,
+    0xb8, 0x71, 0x68, 0x01, 0xef, 0x06, 0x49, 0x5a, 0x76, 0xb6, 0xc8, 0x46, 0x02, 0x6e, 0xc7, 0xe8,
+    0x09, 0x0a, 0x21, 0x8d, 0xc0, 0x7d, 0x9f, 0x42, 0x08, 0x64, 0xa5, 0x28, 0xf1, 0xb0, 0x44, 0x18,
+    0xc5, 0x83, 0xe4, 0x41, 0x42, 0x45, 0x92, 0x29, 0x44, 0x30, 0x15, 0xdc, 0x28, 0x0e, 0x81, 0x6e,
+    0xf1, 0xf7, 0xbf, 0x8b, 0x7b, 0x41, 0xf6, 0x1c, 0x27, 0x24, 0xf9, 0xb9, 0x6d, 0x83, 0x72, 0xe5,
+    0xcb, 0x34, 0x12, 0x83, 0xf1, 0x0e, 0xab, 0x2f, 0xce, 0x0b, 0x78, 0x04, 0xd3, 0xe2, 0x9e, 0x18,
+    0xda, 0xe6, 0xf3, 0x2e, 0x10, 0x64, 0x0d, 0xaa, 0x63, 0x98, 0x3d, 0xe4, 0x55, 0x02, 0x3d, 0x08,
+    0x72, 0x1a, 0xc6, 0x71, 0x6a, 0xd1, 0x25, 0x44, 0x83, 0x83, 0x3e, 0x8c, 0x74, 0x69, 0x57, 0x80,
+    0xa7, 0x84, 0xfc, 0x52, 0xa3, 0x4e, 0xe2, 0x4b, 0x6b, 0x00, 0x73, 0x06, 0x1c, 0x15, 0xb0, 0x08,
+    0xe1, 0xa6, 0x48, 0xfa, 0x40, 0x3c, 0x86, 0x9f, 0x11, 0xdf, 0x0c, 0xe1, 0x66, 0xa8, 0x6f, 0x1e,
+    0xc0, 0xcd, 0x03, 0xb8, 0x19, 0xf4, 0xc7, 0x2a, 0x4c, 0xa3, 0xd9, 0x40, 0xd7, 0x9f, 0x9b, 0x91,
+    0xe3, 0x6e, 0x24, 0x88, 0x07, 0x09, 0x31, 0xc5, 0x8f, 0x56, 0x86, 0x01, 0x90, 0x0f, 0xc9, 0x17,
+    0xd9, 0x9e, 0x55, 0x20, 0x43, 0x3f, 0x13, 0xff, 0x7d, 0x00, 0x20, 0xde, 0x79, 0x66, 0xf2, 0xdb,
+    0x9b, 0xc7, 0x71, 0x26, 0xb1, 0x34, 0x40, 0x5c, 0x47, 0x7f, 0x71, 0x2a, 0x3d, 0xc5, 0x6a, 0x26,
+    0x19, 0x31, 0x92, 0xc8, 0x0f, 0x9c, 0xa1, 0xf3, 0xc0, 0x81, 0x81, 0x07, 0x0f, 0x9c, 0xbd, 0xbe,
+    0x73, 0x00, 0x17, 0xc3, 0x3e, 0x5c, 0xe1, 0x65, 0xdf, 0x79, 0x04, 0x3f, 0x83, 0x87, 0xf0, 0x0b,
+    0x0b, 0x37, 0xce, 0x2f, 0x43, 0xbc, 0xdd, 0xdf, 0xef, 0xf7, 0x3f, 0xf3, 0x24, 0x50, 0x38, 0x27,
+    0x2c, 0x6c, 0x84, 0xf0, 0x53, 0xff, 0xb3, 0x43, 0x0f, 0x9e, 0x06, 0xd3, 0xa9, 0x21, 0xa5, 0x0c,
+    0x8d, 0xa1, 0x98, 0xa5, 0x86, 0x47, 0x79, 0xa7, 0x2e, 0x8a, 0x2a, 0x4d, 0x97, 0xcf, 0x1d, 0x89,
+    0x23, 0xee, 0x24, 0xd3, 0xb4, 0xc3, 0x0a, 0x64, 0x60, 0x5d, 0x0e, 0x14, 0xdb, 0x59, 0x60, 0x08,
+    0xf6, 0xb0, 0x18, 0xcf, 0xbe, 0x36, 0x87, 0xc6, 0xc6, 0x71, 0x41, 0x1c, 0x6f, 0xb5, 0x0b, 0xf5,
+    0x5b, 0xf1, 0x1e, 0x1b, 0x35, 0xa7, 0x0b, 0xde, 0x01, 0x91, 0x0b, 0x37, 0x27, 0xde, 0xcd, 0xe3,
+    0x34, 0xb7, 0xf2, 0xac, 0x64, 0x5d, 0x30, 0xb5, 0xee, 0xf1, 0xbd, 0x46, 0xd1, 0xee, 0x74, 0xda,
+    0xa6, 0x24, 0xf8, 0xa8, 0xe2, 0xf2, 0x52, 0x60, 0xdc, 0xc1, 0x5d, 0x61, 0x79, 0x07, 0xfd, 0x7e,
+    0xdf, 0xae, 0xac, 0xba, 0x8f, 0x96, 0x17, 0x37, 0xce, 0x32, 0xcb, 0xee, 0xe6, 0xf1, 0x29, 0xb8,
+    0x91, 0x68, 0x06, 0x97, 0x89, 0xeb, 0x43, 0xe4, 0x08, 0xa3, 0x0e, 0x9d, 0x76, 0xbf, 0x6d, 0x8b,
+    0x5d, 0xd1, 0x1e, 0xb5, 0xe1, 0x37, 0xc1, 0x43, 0x16, 0x07, 0x51, 0xe7, 0xb7, 0xf4, 0x38, 0x65,
+    0x81, 0xd9, 0xda, 0x83, 0x19, 0x00, 0xbf, 0xdc, 0x0c, 0x4b, 0xcf, 0xa5, 0x63, 0x91, 0xb9, 0xf5,
+    0x47, 0x55, 0x64, 0x52, 0x0f, 0x66, 0x47, 0xc6, 0x1a, 0x4d, 0x38, 0x86, 0x29, 0x6d, 0x10, 0xea,
+    0xf6, 0x7d, 0x68, 0x38, 0x9a, 0x07, 0x98, 0x65, 0xad, 0xda, 0x20, 0xe1, 0x6d, 0xc5, 0x91, 0x1c,
+    0x22, 0xac, 0xea, 0xe2, 0xa6, 0xd0, 0xdf, 0xc5, 0xb0, 0x9c, 0x8d, 0x85, 0x85, 0x6e, 0x0a, 0x29,
+    0x36, 0x5d, 0x2d, 0x12, 0xff, 0x11, 0x7e, 0x70, 0xb4, 0x5d, 0xf1, 0x47, 0xb1, 0xe0, 0x8a, 0x73,
+    0x69, 0x37, 0x3e, 0x87, 0x41, 0x19, 0x4b, 0xda, 0xfd, 0x9a, 0xc5, 0x91, 0x65, 0xc3, 0xa0, 0x64,
+    0x57, 0x79, 0x89, 0xc1, 0x27, 0x21, 0x72, 0x70, 0x7a, 0x85, 0x92, 0x91, 0xd1, 0xbd, 0xd1, 0x33,
+    0x05, 0xad, 0x22, 0xaf, 0x80, 0xf2, 0x88, 0x36, 0x37, 0x83, 0x85, 0xf0, 0x64, 0x1b, 0x12, 0x45,
+    0x10, 0x36, 0x4e, 0x39, 0x2e, 0xa9, 0x92, 0x0a, 0xc1, 0xf3, 0x12, 0x34, 0x6c, 0xd0, 0xff, 0xb3,
+    0x48, 0x63, 0x88, 0x12, 0x54, 0x7c, 0x92, 0xa2, 0x8b, 0x02, 0x03, 0x18, 0xe3, 0x52, 0x33, 0x3e,
+    0x6d, 0xa1, 0xdd, 0x24, 0x01, 0x5f, 0x4c, 0x98, 0x5d, 0xf0, 0xfa, 0x01, 0x44, 0xad, 0x13, 0x09,
+    0x77, 0x72, 0xcd, 0xfb, 0x2f, 0xe2, 0x0b, 0x59, 0x91, 0x3b, 0x34, 0xb0, 0xcf, 0xc1, 0x1e, 0x21,
+    0x11, 0x15, 0xbe, 0x83, 0x33, 0x63, 0xbe, 0x8f, 0x0b, 0x53, 0x59, 0x2c, 0x82, 0x0b, 0x6e, 0x14,
+    0xad, 0x65, 0x75, 0x55, 0xec, 0x1a, 0xdf, 0x29, 0xc4, 0x39, 0xa2, 0xe9, 0x7d, 0xd2, 0xaa, 0x5b,
+    0x70, 0xf4, 0x5a, 0x68, 0xbf, 0x39, 0x62, 0x88, 0xc1, 0x67, 0x60, 0x7c, 0x69, 0x4a, 0xc1, 0x24,
+    0xd1, 0x8d, 0x27, 0x83, 0xd0, 0xb2, 0x34, 0x44, 0x87, 0x7a, 0x61, 0x4d, 0x66, 0xd0, 0xb7, 0x6d,
+    0xf2, 0xb8, 0x68, 0xf5, 0x4b, 0x1d, 0xd3, 0x7a, 0x7e, 0x24, 0x7e, 0x5b, 0x2e, 0x26, 0x10, 0x9b,
+    0x00, 0x89, 0x36, 0x8e, 0xa2, 0x09, 0xa9, 0x0e, 0xf3, 0xc0, 0x1c, 0x25, 0x53, 0x68, 0x2b, 0x3a,
+    0xc3, 0x74, 0x8e, 0xca, 0x2e, 0x7d, 0xc2, 0xd6, 0x11, 0x99, 0x5d, 0x38, 0x7d, 0x26, 0xe1, 0xa6,
+    0xe2, 0x7c, 0xf2, 0x18, 0x82, 0x8f, 0xcc, 0x0a, 0x03, 0x74, 0xd9, 0x59, 0x30, 0xd3, 0xcc, 0x35,
+    0xac, 0x91, 0x87, 0xd6, 0x08, 0x01, 0x0a, 0x63, 0xa4, 0xd7, 0x73, 0xf7, 0x88, 0xba, 0x80, 0x12,
+    0x7b, 0x40, 0xb0, 0x69, 0x7c, 0xe8, 0xf1, 0xb1, 0xe8, 0x03, 0xaf, 0xe9, 0xde, 0xfb, 0xb4, 0xf7,
+    0x19, 0x8c, 0x11, 0x78, 0x67, 0x5b, 0xb9, 0x68, 0x7c, 0x32, 0x56, 0x6d, 0xfb, 0x9f, 0x01, 0x16,
+    0x3c, 0xb5, 0xad, 0xdc, 0x35, 0x3e, 0x31, 0x6d, 0x12, 0x91, 0xcc, 0xc4, 0x5c, 0xbd, 0x41, 0xf3,
+    0x05, 0xaa, 0x76, 0x4c, 0x41, 0xd8, 0x2e, 0xc0, 0xf6, 0x91, 0x55, 0xfd, 0xee, 0x83, 0x31, 0xc9,
+    0x1a, 0x06, 0xa8, 0x1c, 0xcc, 0xa0, 0x5b, 0x17, 0x09, 0x84, 0xbb, 0xa1, 0x12, 0xeb, 0x32, 0x64,
+    0x77, 0x20, 0x32, 0x0c, 0x7c, 0x2a, 0x4e, 0xe3, 0x31, 0x39, 0x98, 0x0a, 0x49, 0x2d, 0x4e, 0x54,
+    0xf5, 0x0d, 0xfa, 0xc0, 0xbb, 0x81, 0xb0, 0xe0, 0x2f, 0xb8, 0x5c, 0x25, 0xf6, 0x54, 0x46, 0x4f,
+    0xc2, 0x38, 0xb7, 0x4d, 0x16, 0x26, 0x58, 0x0e, 0x04, 0xc0, 0x8a, 0x58, 0x5e, 0xe1, 0xda, 0x42,
+    0x67, 0xe0, 0x01, 0x28, 0x24, 0x50, 0x6d, 0x61, 0x14, 0xf5, 0x89, 0xd1, 0x7e, 0x46, 0x4b, 0x34,
+    0xe8, 0xa2, 0xc3, 0x83, 0x49, 0x28, 0x0b, 0x99, 0x5f, 0x75, 0x33, 0xf7, 0x42, 0x5a, 0x76, 0x79,
+    0x3f, 0x91, 0x90, 0x71, 0xbc, 0x85, 0x15, 0x85, 0x87, 0xf4, 0x00, 0x92, 0xfc, 0xdc, 0xba, 0x82,
+    0x10, 0x16, 0xe7, 0xde, 0x11, 0x43, 0x47, 0x31, 0x01, 0x4d, 0xc2, 0x10, 0x1e, 0x60, 0xd3, 0x0b,
+    0xb8, 0xde, 0x53, 0xf0, 0x5e, 0x18, 0x24, 0x26, 0xc2, 0x69, 0x10, 0x86, 0xa7, 0x98, 0xce, 0xa0,
+    0x21, 0xa6, 0x19, 0x83, 0x85, 0xc2, 0x7d, 0x2a, 0xf8, 0x47, 0xc6, 0x09, 0x4f, 0x31, 0xb5, 0xc7,
+    0x05, 0xec, 0xbb, 0xbb, 0x8f, 0xb7, 0x53, 0xce, 0x42, 0xe6, 0xaf, 0x82, 0x48, 0x3e, 0x75, 0xb3,
+    0xb9, 0xf5, 0x69, 0xdf, 0xd9, 0xff, 0xac, 0x88, 0x09, 0xe1, 0xe1, 0x47, 0x8a, 0x91, 0x21, 0x12,
+    0xe0, 0x47, 0x90, 0x21, 0xc4, 0xe7, 0x72, 0x9d, 0xa2, 0xa1, 0x8b, 0xff, 0x98, 0x22, 0x29, 0x65,
+    0xdb, 0xf0, 0x90, 0xe8, 0x54, 0x57, 0x1f, 0x28, 0x60, 0x76, 0xaf, 0xba, 0x17, 0x10, 0x73, 0x8e,
+    0xf9, 0xfe, 0x50, 0x3d, 0x80, 0x40, 0x12, 0x98, 0x2b, 0x3b, 0x07, 0xea, 0xf9, 0x2e, 0x3d, 0x5f,
+    0xa1, 0xaf, 0xaf, 0x79, 0xd3, 0x15, 0xe3, 0x58, 0x59, 0x08, 0x57, 0x98, 0xd2, 0x46, 0xc6, 0xa3,
+    0x3d, 0x7a, 0x1f, 0x5b, 0x30, 0x7b, 0x47, 0xac, 0x8c, 0xf9, 0xf0, 0x33, 0xe4, 0x48, 0xf9, 0x9c,
+    0x27, 0xa5, 0xd9, 0x7e, 0x53, 0x25, 0x3d, 0xcf, 0x78, 0xd0, 0x9c, 0xbc, 0xcc, 0x18, 0xef, 0x99,
+    0xf0, 0xdc, 0x24, 0x3c, 0xcf, 0x14, 0xd9, 0x79, 0x85, 0x6c, 0xd4, 0x16, 0xec, 0xc0, 0xf0, 0x60,
+    0x31, 0x68, 0x87, 0x10, 0x1c, 0x9f, 0x1c, 0x57, 0x26, 0x76, 0xc5, 0x63, 0x5c, 0x01, 0xf0, 0x9d,
+    0xa6, 0x75, 0x45, 0xeb, 0x5a, 0x9d, 0xd6, 0x95, 0x5e, 0xeb, 0x17, 0x5b, 0xa6, 0xb5, 0xb6, 0xdc,
+    0x9f, 0x0d, 0x61, 0xdb, 0xb4, 0xb8, 0xfb, 0xfb, 0xfb, 0xbc, 0xb2, 0x9e, 0xe7, 0xb5, 0xb7, 0x08,
+    0xbb, 0xc9, 0xf3, 0x2a, 0x29, 0x75, 0xce, 0x6f, 0x22, 0x74, 0x47, 0x25, 0x11, 0x68, 0x13, 0x5e,
+    0xef, 0x2b, 0x55, 0x1f, 0x71, 0xb6, 0x22, 0x3a, 0xc7, 0xb8, 0x19, 0x45, 0x7f, 0x70, 0x2f, 0xea,
+    0x98, 0x93, 0x0b, 0xb5, 0x03, 0x2b, 0x5d, 0x6f, 0xce, 0xb6, 0x43, 0x19, 0x04, 0x74, 0x68, 0x1a,
+    0x5d, 0xe6, 0xce, 0x32, 0xb6, 0x1d, 0x49, 0x70, 0x0e, 0xb6, 0x23, 0xc3, 0x50, 0x48, 0xa2, 0xb7,
+    0x74, 0x31, 0x99, 0xe7, 0x6e, 0x59, 0x0e, 0xfa, 0x83, 0x4d, 0x97, 0x10, 0x3b, 0x08, 0xc8, 0x78,
+    0xf1, 0x64, 0x2e, 0x3e, 0x46, 0xe2, 0x32, 0x16, 0x0a, 0x6d, 0x41, 0x98, 0x30, 0xeb, 0xdc, 0xe1,
+    0x74, 0x07, 0x44, 0xe9, 0xcd, 0xd4, 0x11, 0x54, 0x51, 0x83, 0x8c, 0x02, 0xd5, 0xa6, 0x94, 0xdc,
+    0x26, 0x4e, 0x55, 0x39, 0x4d, 0xfd, 0xd6, 0x55, 0x8e, 0xae, 0xab, 0x72, 0x82, 0x76, 0x78, 0x08,
+    0x9c, 0x3b, 0xff, 0x79, 0xdf, 0x21, 0x67, 0x64, 0x7a, 0x0f, 0x36, 0x55, 0x85, 0xfc, 0x14, 0x12,
+    0x1c, 0x70, 0xc4, 0x18, 0x80, 0x18, 0xa2, 0x49, 0xeb, 0x86, 0x32, 0x9a, 0xe5, 0x73, 0x78, 0xb0,
+    0xbb, 0x5b, 0x50, 0x59, 0xa4, 0xd3, 0x4c, 0x0e, 0xd8, 0x3d, 0x88, 0x7c, 0x51, 0x2a, 0xc9, 0x10,
+    0x16, 0x38, 0x59, 0xa2, 0x11, 0x53, 0x40, 0x9e, 0xa2, 0x2a, 0x92, 0x2b, 0x84, 0xfd, 0x14, 0xef,
+    0x82, 0xe7, 0x50, 0x79, 0xa0, 0x8d, 0xf3, 0xd5, 0x12, 0x0f, 0xa1, 0x0c, 0x2e, 0xc6, 0xd7, 0x18,
+    0xac, 0x6f, 0x59, 0xbd, 0x3e, 0x97, 0x49, 0x8e, 0x87, 0xfe, 0xf2, 0xda, 0x10, 0xe8, 0xfe, 0x21,
+    0x37, 0x68, 0x1c, 0xa1, 0x82, 0x5f, 0x62, 0x8d, 0xbc, 0xaa, 0x07, 0x0d, 0x60, 0xe5, 0x3c, 0x9b,
+    0x20, 0x77, 0x07, 0x55, 0x92, 0x1b, 0x61, 0x86, 0x77, 0x80, 0xd9, 0x6b, 0x18, 0xf3, 0xc6, 0x90,
+    0x84, 0x26, 0x9d, 0x04, 0x9e, 0x5c, 0xe8, 0xd3, 0x58, 0x93, 0x70, 0x29, 0x11, 0xb9, 0x3e, 0x2d,
+    0x35, 0xc3, 0x92, 0x12, 0x6f, 0xca, 0x26, 0xbc, 0xc7, 0x10, 0x73, 0xfe, 0xc8, 0x83, 0xf8, 0x18,
+    0x32, 0xe8, 0xce, 0x9c, 0x36, 0x5a, 0xe0, 0x2f, 0x67, 0x73, 0xdb, 0xf0, 0x6c, 0x64, 0x61, 0x0b,
+    0x5b, 0xcb, 0x23, 0x2b, 0x01, 0x06, 0xa9, 0x81, 0x68, 0xde, 0x21, 0xa3, 0xea, 0xa0, 0x63, 0xe9,
+    0xff, 0xf2, 0x0b, 0xf8, 0x13, 0x47, 0x0c, 0xed, 0x0a, 0xdc, 0x40, 0xc3, 0x95, 0x6e, 0xfc, 0x05,
+    0x08, 0x9b, 0xe5, 0x56, 0xb2, 0xd4, 0x2e, 0xa6, 0xf3, 0x70, 0x05, 0xc9, 0xed, 0xcf, 0xe2, 0x05,
+    0xe3, 0x73, 0x5d, 0x30, 0x1e, 0x4e, 0x21, 0x96, 0x0a, 0xdf, 0x10, 0xf1, 0x61, 0xa9, 0xa1, 0x8a,
+    0x2e, 0xb9, 0x05, 0xdd, 0x74, 0xfa, 0xcb, 0x2f, 0x54, 0x55, 0x19, 0x18, 0x56, 0x2b, 0x95, 0xb4,
+    0x21, 0x62, 0xd9, 0xeb, 0xb1, 0x12, 0xd6, 0x1c, 0xf0, 0xa4, 0xa9, 0xa5, 0x3d, 0xfd, 0xf7, 0x7a,
+    0x54, 0xa0, 0x04, 0xfe, 0x67, 0x96, 0x8d, 0x9c, 0x6a, 0xa9, 0xc8, 0x2e, 0x83, 0xd9, 0x7b, 0x5c,
+    0xcf, 0x81, 0x28, 0xd6, 0xd0, 0x36, 0x12, 0x67, 0x52, 0x19, 0xa3, 0x6c, 0xb2, 0x99, 0x1c, 0x74,
+    0xa1, 0x44, 0xcb, 0xde, 0xde, 0x9e, 0xa6, 0x05, 0xd4, 0x08, 0xcb, 0x4a, 0x58, 0xbb, 0x17, 0xf4,
+    0xfe, 0x80, 0x41, 0xe4, 0x7b, 0x2a, 0x79, 0xfd, 0x16, 0x0b, 0xcc, 0x3c, 0xda, 0xcc, 0xdc, 0x21,
+    0x24, 0x69, 0x2a, 0xd8, 0x1c, 0x33, 0x5f, 0x2a, 0xa2, 0x46, 0xc1, 0x7b, 0x16, 0x61, 0x84, 0x4f,
+    0x52, 0x44, 0x59, 0x37, 0xab, 0xa5, 0xcb, 0x09, 0x3a, 0xc4, 0x56, 0x94, 0x26, 0x90, 0x69, 0x45,
+    0x23, 0x4b, 0x39, 0x02, 0x34, 0x86, 0xf1, 0x65, 0xb8, 0xd2, 0xf8, 0x40, 0x39, 0xb1, 0x2e, 0xa8,
+    0xd1, 0x66, 0xb9, 0xbb, 0x2a, 0x8e, 0xc5, 0x60, 0x66, 0x04, 0x56, 0x68, 0xe1, 0x46, 0x2b, 0xb1,
+    0x4c, 0x7c, 0xdc, 0x8b, 0x35, 0xe4, 0x92, 0xa2, 0x4a, 0x8c, 0x2d, 0x7b, 0x2c, 0x5c, 0x14, 0x49,
+    0x62, 0x3c, 0x49, 0xf7, 0x66, 0x1a, 0x4a, 0xb1, 0x00, 0x31, 0x48, 0x15, 0x5e, 0x0a, 0x21, 0x01,
+    0xe8, 0x0e, 0x20, 0x72, 0xb0, 0x32, 0x05, 0x71, 0xf3, 0x41, 0xa5, 0x8e, 0x81, 0xb1, 0x06, 0xf4,
+    0xb2, 0x8c, 0xea, 0x08, 0x8d, 0xc6, 0xe8, 0xc8, 0x75, 0x3f, 0xb2, 0xc9, 0x66, 0x82, 0x80, 0xd1,
+    0x43, 0x47, 0x2b, 0x8b, 0x55, 0x46, 0xef, 0x44, 0x10, 0x77, 0xe9, 0xa8, 0x2e, 0xbb, 0x46, 0x17,
+    0x73, 0xc0, 0x9c, 0x07, 0x24, 0x01, 0xe8, 0xaa, 0x34, 0x84, 0xf1, 0xf1, 0x23, 0x0c, 0xeb, 0x73,
+    0x35, 0x97, 0x5a, 0x51, 0x83, 0xe0, 0x3a, 0x84, 0x41, 0xcd, 0x81, 0xfa, 0x5d, 0xd3, 0x24, 0x98,
+    0x2c, 0x47, 0xd3, 0x98, 0xd3, 0xa3, 0x9c, 0x1e, 0xe5, 0xea, 0x11, 0x45, 0x27, 0x23, 0xb3, 0x10,
+    0x44, 0xc4, 0xf4, 0x18, 0x00, 0xa9, 0x65, 0xc8, 0x9d, 0xb2, 0x58, 0x27, 0x56, 0x23, 0x71, 0x51,
+    0xd3, 0x40, 0xeb, 0x02, 0x7e, 0x5f, 0x50, 0xa4, 0xd2, 0x13, 0xd6, 0x05, 0x13, 0x45, 0xf7, 0xac,
+    0x84, 0x66, 0xf7, 0x2b, 0x08, 0xb2, 0xcb, 0xee, 0x96, 0x95, 0x6b, 0xfa, 0xb1, 0xab, 0x39, 0x1f,
+    0xec, 0xfa, 0x51, 0x15, 0xd1, 0x84, 0x8a, 0xbe, 0xfb, 0xdf, 0x1c, 0x77, 0x34, 0x84, 0xa4, 0x77,
+    0x0e, 0x45, 0xd6, 0xc2, 0x90, 0xed, 0xb1, 0xd2, 0x66, 0xc5, 0x9c, 0x4c, 0x94, 0x91, 0x38, 0x38,
+    0x38, 0xd8, 0xa2, 0x98, 0x05, 0x16, 0xac, 0x45, 0x9f, 0xe0, 0x21, 0x7f, 0x84, 0xa0, 0x94, 0x65,
+    0x43, 0x68, 0x5c, 0x8d, 0x8b, 0x1b, 0x83, 0x62, 0x8e, 0x88, 0xab, 0x3a, 0x8f, 0x6d, 0x20, 0x56,
+    0xcf, 0x71, 0x8f, 0xc0, 0x1a, 0x52, 0xbd, 0x44, 0x7c, 0x68, 0xeb, 0xf0, 0xff, 0xc0, 0x31, 0xc2,
+    0x65, 0x68, 0xdb, 0xb7, 0x37, 0x50, 0xc6, 0xef, 0xb7, 0xd4, 0x49, 0x6b, 0x0e, 0x7d, 0x1b, 0xe2,
+    0x5e, 0x25, 0x63, 0x2a, 0xda, 0x3d, 0x3e, 0x52, 0x62, 0x50, 0xa1, 0x74, 0xbd, 0x10, 0x65, 0x3b,
+    0x45, 0xcc, 0x5b, 0x2c, 0x07, 0x22, 0x7e, 0x78, 0xeb, 0x2a, 0xf8, 0xbe, 0xcf, 0xab, 0xd0, 0x07,
+    0x6f, 0xb0, 0x61, 0x4a, 0xb8, 0xbf, 0xb7, 0x66, 0x21, 0x3f, 0x28, 0x0f, 0x2b, 0xc4, 0xcb, 0xc2,
+    0xb7, 0x8a, 0xb7, 0x85, 0x53, 0x65, 0xc6, 0x69, 0xee, 0x3d, 0x6c, 0xf0, 0x28, 0x58, 0xbe, 0xf4,
+    0xad, 0xf3, 0x00, 0x33, 0xd2, 0x69, 0xb5, 0xae, 0x91, 0x63, 0xe2, 0x89, 0x85, 0x69, 0x9c, 0x68,
+    0xe4, 0xc9, 0x6e, 0x14, 0x5f, 0x6a, 0x81, 0x9a, 0x46, 0x56, 0xc5, 0x32, 0x2d, 0xb2, 0x26, 0x58,
+    0xd4, 0x97, 0x3e, 0xc7, 0x75, 0xd8, 0xf6, 0x09, 0x87, 0x51, 0x49, 0x7a, 0xd6, 0xe5, 0x8a, 0xf5,
+    0xee, 0xee, 0x18, 0xae, 0x29, 0xf0, 0x3d, 0x02, 0x2c, 0x78, 0x93, 0x2d, 0x17, 0xb8, 0x06, 0x78,
+    0x83, 0x0b, 0x00, 0xa8, 0x8f, 0xe1, 0x29, 0xfa, 0x4d, 0xfe, 0xc3, 0x80, 0x6b, 0x33, 0x49, 0x25,
+    0x9e, 0x48, 0xb4, 0x6a, 0x55, 0x54, 0x97, 0xca, 0x8b, 0xa8, 0xd5, 0x56, 0x51, 0x24, 0x2f, 0x06,
+    0x57, 0xc5, 0x72, 0xb1, 0xcb, 0x14, 0x18, 0x72, 0xe7, 0x88, 0x85, 0xc4, 0x5a, 0x93, 0x86, 0x84,
+    0x55, 0xda, 0xb5, 0x98, 0xb4, 0x5e, 0xf1, 0xd0, 0x36, 0x05, 0x75, 0x24, 0x54, 0xb1, 0x1d, 0xb1,
+    0x2d, 0x50, 0xc8, 0xca, 0xb6, 0x9b, 0x0a, 0xaf, 0xe2, 0x65, 0x4e, 0x86, 0x10, 0x59, 0x32, 0xaa,
+    0x95, 0xfc, 0x91, 0x60, 0x0b, 0x1b, 0xba, 0x78, 0x6f, 0xeb, 0xfa, 0x7e, 0xf9, 0x18, 0xef, 0x6d,
+    0xb3, 0x98, 0x4f, 0x06, 0x92, 0x4a, 0x0a, 0xaa, 0x9f, 0x6a, 0x81, 0x51, 0x75, 0xc1, 0x87, 0x4a,
+    0x1c, 0xa5, 0xeb, 0xae, 0x57, 0x9f, 0x94, 0x45, 0x67, 0x17, 0x14, 0x44, 0x16, 0xef, 0x4f, 0x38,
+    0x85, 0x89, 0xb7, 0xc9, 0x40, 0xfb, 0xd5, 0xaa, 0xbc, 0x55, 0xfa, 0x04, 0x10, 0xf1, 0x9c, 0x56,
+    0xa7, 0x57, 0x44, 0x59, 0x02, 0x27, 0xd9, 0x25, 0x3f, 0x51, 0xd3, 0x92, 0xb2, 0x1b, 0xeb, 0x76,
+    0x4f, 0x60, 0x41, 0x71, 0x4d, 0x97, 0x60, 0xbc, 0xed, 0xed, 0x30, 0x9e, 0x39, 0x14, 0x26, 0xd2,
+    0x56, 0xe1, 0x7a, 0xed, 0xba, 0x05, 0x61, 0x2c, 0x16, 0x41, 0xec, 0x72, 0x9d, 0x07, 0x88, 0xdd,
+    0x0c, 0x58, 0x38, 0x6d, 0x13, 0xc0, 0x0c, 0x71, 0x71, 0x4c, 0xd4, 0x4a, 0x55, 0x87, 0xe2, 0x26,
+    0xdc, 0xcf, 0xb3, 0xa0, 0x65, 0x63, 0xcd, 0x96, 0x43, 0x06, 0xeb, 0xce, 0x5a, 0x86, 0x0b, 0xc7,
+    0xc1, 0xd7, 0xfd, 0xfb, 0x6a, 0x39, 0xb0, 0x88, 0x86, 0x3b, 0x74, 0x58, 0xad, 0xab, 0x6e, 0xb4,
+    0xe9, 0xf8, 0x45, 0x6d, 0x2f, 0xa9, 0x2a, 0x12, 0x66, 0x23, 0x23, 0x8c, 0x5b, 0x16, 0xee, 0x4a,
+    0xcc, 0xdd, 0x0b, 0x29, 0x66, 0x69, 0x7c, 0x09, 0x09, 0x1f, 0x08, 0x12, 0xc7, 0x3f, 0x01, 0x6d,
+    0xde, 0xf2, 0x1e, 0xac, 0x2f, 0xdc, 0x19, 0x78, 0x33, 0x83, 0x3c, 0x0f, 0xc9, 0x33, 0x77, 0x09,
+    0x35, 0x25, 0x78, 0x61, 0xc6, 0x83, 0x8f, 0x39, 0xcd, 0x32, 0x1f, 0x61, 0x9d, 0x09, 0x6b, 0x63,
+    0x23, 0xd1, 0x2f, 0xb7, 0x23, 0xc2, 0xd8, 0xaf, 0x50, 0x5c, 0xcc, 0xb1, 0x14, 0x4b, 0x06, 0xe1,
+    0x12, 0x32, 0x96, 0xb9, 0xdb, 0xf7, 0x51, 0x5e, 0xa8, 0xf2, 0x5c, 0x91, 0xba, 0xf6, 0xfd, 0x3c,
+    0x36, 0x9e, 0xe6, 0xb8, 0xb6, 0x96, 0xd7, 0xa7, 0x9a, 0x37, 0x6e, 0x08, 0x63, 0x13, 0xdc, 0x62,
+    0xc5, 0xdb, 0xae, 0x6c, 0x4c, 0xdc, 0x83, 0x11, 0xf4, 0x16, 0x81, 0xf9, 0x1c, 0x1e, 0x77, 0x75,
+    0xed, 0xf3, 0xb8, 0xc4, 0x0a, 0x91, 0xaf, 0xd9, 0x72, 0x28, 0x4c, 0x21, 0xae, 0x6d, 0x76, 0xc2,
+    0x02, 0x80, 0xe9, 0x85, 0x50, 0x73, 0x5a, 0x54, 0x94, 0x1d, 0xa1, 0xea, 0xd8, 0x1e, 0xbe, 0x05,
+    0x49, 0x85, 0x65, 0xdf, 0x10, 0xa5, 0x32, 0xc4, 0xae, 0x2b, 0x66, 0x92, 0xc6, 0x13, 0x44, 0x8d,
+    0xfc, 0x00, 0x1a, 0xd6, 0x18, 0x32, 0xc0, 0xf9, 0xe3, 0x16, 0x01, 0x0d, 0xab, 0xf6, 0x4f, 0x3b,
+    0x53, 0xf0, 0x02, 0x23, 0xbd, 0x07, 0x5e, 0x2b, 0x9e, 0x9b, 0x3c, 0x20, 0xec, 0x75, 0x2e, 0x14,
+    0x7b, 0x93, 0xd4, 0xaa, 0xa7, 0x5c, 0xe6, 0xec, 0xc5, 0x36, 0xac, 0xb1, 0xe5, 0x39, 0xae, 0x6d,
+    0x79, 0x8e, 0xeb, 0x5b, 0x9e, 0x26, 0x8b, 0x79, 0x80, 0x72, 0xa6, 0xe6, 0x4e, 0x5e, 0x51, 0x62,
+    0x2f, 0x07, 0x37, 0xf2, 0xdc, 0x6d, 0x52, 0xb1, 0x2e, 0x11, 0x68, 0xb7, 0xaa, 0x49, 0x7e, 0xd3,
+    0xa2, 0x8b, 0x62, 0xf9, 0xa6, 0x46, 0x42, 0xcd, 0xb3, 0xc4, 0x25, 0xc7, 0xcb, 0xb1, 0xae, 0x50,
+    0xe3, 0x8d, 0x63, 0xd4, 0x23, 0x74, 0x1a, 0x5c, 0x31, 0xbb, 0x1b, 0xdd, 0xa0, 0xee, 0xc5, 0x0e,
+    0x97, 0x37, 0xd8, 0x9d, 0x22, 0xa1, 0x33, 0xb6, 0x51, 0xd8, 0x8b, 0x55, 0x37, 0x01, 0x4c, 0xd3,
+    0xf3, 0x2d, 0xc3, 0x15, 0xcb, 0x69, 0xc8, 0xaf, 0x8a, 0x5a, 0xa9, 0x90, 0xd2, 0xd7, 0xbb, 0xd0,
+    0xca, 0x49, 0x70, 0xb5, 0xbc, 0xaf, 0x6a, 0x26, 0x45, 0x61, 0x85, 0x37, 0x4a, 0x2c, 0x55, 0x4c,
+    0x56, 0x8a, 0xaf, 0x2b, 0xc9, 0xa8, 0xe1, 0x10, 0x21, 0x61, 0xdf, 0xa0, 0xdf, 0xe9, 0xe8, 0xaa,
+    0xb9, 0xc1, 0x34, 0x18, 0x39, 0x84, 0x44, 0x07, 0x0b, 0xd4, 0x8e, 0xe8, 0x68, 0x06, 0xea, 0xba,
+    0xbf, 0x62, 0x73, 0xc9, 0xd9, 0xb5, 0xc2, 0xbf, 0x82, 0xb0, 0x99, 0xa8, 0x64, 0x99, 0xcd, 0xa9,
+    0x82, 0x53, 0x6a, 0x8f, 0x69, 0x9f, 0x70, 0x6b, 0x1a, 0xfc, 0x19, 0xfc, 0xc1, 0x79, 0x1c, 0xa9,
+    0xdd, 0xea, 0xc2, 0x35, 0x70, 0xe9, 0x92, 0x12, 0x29, 0x7c, 0xac, 0xed, 0x3c, 0x4c, 0x4c, 0x95,
+    0x13, 0xec, 0xed, 0x2b, 0x44, 0xc5, 0x19, 0x05, 0x81, 0xc3, 0x02, 0x04, 0x70, 0x1c, 0xc2, 0x8b,
+    0xa2, 0x06, 0x5f, 0xec, 0x8a, 0x94, 0x0b, 0x49, 0xbe, 0x40, 0x6d, 0x93, 0x68, 0x67, 0x60, 0x2d,
+    0x2a, 0x6e, 0x80, 0x4f, 0xa6, 0x60, 0x68, 0xa3, 0x5e, 0xe2, 0x47, 0x23, 0x0f, 0x4e, 0x5d, 0x4e,
+    0xe9, 0x94, 0x2f, 0xf0, 0xdc, 0x6c, 0xa0, 0xab, 0x72, 0xdd, 0x16, 0x5d, 0xdc, 0x5f, 0xaa, 0xf4,
+    0xb0, 0xd5, 0xa9, 0x0d, 0x6a, 0x32, 0x21, 0x1b, 0xb0, 0xdb, 0xc5, 0xa1, 0x0e, 0xd5, 0x5c, 0xc2,
+    0x2b, 0xb2, 0x60, 0xf8, 0x7b, 0x0b, 0x16, 0xba, 0x5b, 0xf8, 0xc3, 0x83, 0x10, 0x24, 0xf5, 0xc2,
+    0xf3, 0x21, 0x28, 0x54, 0xea, 0x9c, 0x48, 0x9e, 0x62, 0xdd, 0x4c, 0xfb, 0x41, 0x08, 0x64, 0x23,
+    0x37, 0x0c, 0x57, 0x16, 0xb3, 0xf0, 0xba, 0x7a, 0x9a, 0x04, 0xc3, 0x26, 0xde, 0x7c, 0x19, 0xef,
+    0x00, 0x07, 0x29, 0x18, 0x5f, 0x25, 0x12, 0x24, 0x82, 0x0f, 0xdf, 0xfc, 0x25, 0x8c, 0x27, 0x6e,
+    0x78, 0xea, 0xc5, 0x89, 0x3a, 0xb4, 0x52, 0x4c, 0xa8, 0x8d, 0x43, 0x67, 0x32, 0xc4, 0x37, 0x53,
+    0x20, 0x74, 0x02, 0xcd, 0x68, 0xea, 0xc4, 0x46, 0x08, 0xf5, 0x80, 0x0f, 0x44, 0x19, 0x6e, 0x09,
+    0xfb, 0x76, 0xe3, 0x08, 0x62, 0xbc, 0x0c, 0x6b, 0x00, 0x47, 0x42, 0x12, 0x7d, 0x66, 0xc0, 0x8b,
+    0x0f, 0xbb, 0x58, 0x9d, 0x30, 0xe7, 0xcd, 0x25, 0x14, 0xbb, 0x44, 0x58, 0x3d, 0xfe, 0xa3, 0x01,
+    0x20, 0x50, 0xec, 0xf2, 0x11, 0x20, 0x8a, 0x05, 0x8f, 0x79, 0x3c, 0x0c, 0x1f, 0x5e, 0xf3, 0x88,
+    0x14, 0x45, 0x20, 0x14, 0x1d, 0x0e, 0x32, 0x24, 0x8f, 0xd7, 0x04, 0xd1, 0xe9, 0x41, 0x40, 0x8e,
+    0xc6, 0x9a, 0x47, 0x87, 0x3d, 0x3e, 0xa6, 0x54, 0x9c, 0x57, 0x3a, 0xde, 0xd1, 0xac, 0x2d, 0xb6,
+    0xaf, 0x24, 0x26, 0x67, 0x18, 0xcd, 0x1d, 0x0b, 0x3f, 0xf6, 0x96, 0xa8, 0x35, 0xb8, 0x15, 0xfd,
+    0x2c, 0x24, 0x05, 0xfa, 0x75, 0xf5, 0xd2, 0xb7, 0x20, 0xf6, 0x2a, 0x4f, 0xa6, 0xa8, 0xb7, 0x32,
+    0x60, 0xb6, 0xa1, 0xd5, 0xa6, 0xe9, 0xf0, 0x9e, 0x34, 0xf2, 0xad, 0x72, 0x16, 0x68, 0xac, 0xf6,
+    0xb8, 0x66, 0xc6, 0x19, 0x33, 0x2c, 0xa4, 0x58, 0x3f, 0x19, 0x07, 0xa6, 0xec, 0x51, 0xe1, 0x1a,
+    0xf1, 0x0c, 0x3b, 0x5c, 0xa4, 0xd2, 0xf5, 0xf9, 0xfc, 0x55, 0xfd, 0xc4, 0x99, 0x47, 0xfe, 0x0a,
+    0x30, 0x92, 0x08, 0x0e, 0xfd, 0xb1, 0x78, 0xcc, 0x58, 0x8f, 0xa8, 0x2b, 0x9f, 0x2e, 0x0b, 0x72,
+    0xf3, 0x54, 0x9a, 0x53, 0x80, 0xd0, 0x11, 0x1d, 0x20, 0x2b, 0x2e, 0xce, 0x7c, 0x15, 0xfb, 0x67,
+    0x26, 0x99, 0x74, 0x10, 0x4c, 0xc9, 0x23, 0x88, 0x17, 0x80, 0xc4, 0xa1, 0x2f, 0x26, 0x12, 0x22,
+    0xa5, 0x00, 0x1c, 0x27, 0xed, 0x60, 0x7a, 0xf1, 0x22, 0xc1, 0x43, 0x49, 0xec, 0x2a, 0x50, 0xfa,
+    0x33, 0x0e, 0x93, 0x32, 0xda, 0x85, 0x63, 0x36, 0x11, 0xba, 0x53, 0xda, 0x81, 0x2f, 0x18, 0xc5,
+    0x53, 0x6e, 0xdb, 0x94, 0xc7, 0x3d, 0xe1, 0x6f, 0x85, 0x8c, 0x2b, 0x22, 0xf7, 0x1a, 0x0f, 0x5c,
+    0xf1, 0x89, 0x84, 0xdf, 0xdf, 0xbd, 0x3a, 0x95, 0x6e, 0xea, 0xcd, 0xdf, 0xd2, 0x9b, 0x56, 0x60,
+    0x17, 0x3d, 0x3a, 0xc0, 0xd8, 0xcd, 0xe8, 0xa9, 0xdd, 0x25, 0x9f, 0xc7, 0xdd, 0x78, 0x05, 0x4a,
+    0x59, 0x78, 0x5d, 0x9c, 0xdb, 0x42, 0xce, 0x90, 0xf4, 0xd7, 0x1b, 0x48, 0x5b, 0xb5, 0xdb, 0x45,
+    0x02, 0x62, 0xcd, 0x6d, 0xf3, 0xf4, 0x96, 0x3a, 0x14, 0x50, 0x69, 0xbc, 0x77, 0xcf, 0xe2, 0xdd,
+    0xf6, 0xae, 0x3a, 0x1f, 0x88, 0xf6, 0x9f, 0x4b, 0x85, 0x39, 0x84, 0x3a, 0xd9, 0x54, 0xea, 0xc3,
+    0xd8, 0xef, 0xe3, 0x62, 0x09, 0x11, 0x08, 0x67, 0x55, 0x5b, 0x53, 0xaa, 0xbb, 0xda, 0x6b, 0xc7,
+    0xda, 0x50, 0xcf, 0xcb, 0x53, 0x01, 0xfa, 0x0c, 0x88, 0xc1, 0xa0, 0x92, 0x1e, 0x88, 0xed, 0xf8,
+    0x90, 0x1d, 0xe5, 0xcb, 0x34, 0xdd, 0xb5, 0x23, 0x22, 0xb8, 0xe5, 0xf1, 0x4e, 0x2b, 0xc7, 0xb5,
+    0x52, 0x1e, 0xab, 0xcd, 0xaf, 0xd3, 0x54, 0x97, 0x83, 0x6c, 0x1e, 0x79, 0x8b, 0xb6, 0x79, 0x96,
+    0xbe, 0x3d, 0x2e, 0x7a, 0xad, 0x36, 0xf5, 0x5a, 0x6d, 0xeb, 0x55, 0x79, 0x29, 0x65, 0xad, 0xb3,
+    0x3a, 0xeb, 0x01, 0xd6, 0x16, 0x71, 0xf4, 0x2b, 0xd9, 0x61, 0x42, 0xc8, 0xd1, 0xa9, 0x3b, 0x14,
+    0x14, 0x51, 0xee, 0x6a, 0xa4, 0xa1, 0x5f, 0xfe, 0x74, 0xcd, 0xd9, 0xea, 0x0d, 0x8c, 0x89, 0xd7,
+    0x98, 0xa8, 0x16, 0xd7, 0xee, 0xd5, 0x8d, 0xb0, 0xf0, 0x8a, 0xe1, 0x6f, 0xec, 0x2f, 0xc8, 0xa6,
+    0x0a, 0x69, 0xe6, 0x4b, 0x28, 0x6b, 0x94, 0x01, 0xf6, 0x84, 0x8c, 0xce, 0xcd, 0x88, 0xa2, 0x7e,
+    0xc0, 0x3a, 0xb5, 0x12, 0xce, 0x3a, 0x6f, 0x38, 0x49, 0x55, 0x8f, 0x28, 0x3f, 0xd5, 0xc7, 0xca,
+    0x04, 0x76, 0xd3, 0x31, 0xc9, 0xcd, 0x17, 0x1e, 0x4c, 0x49, 0xcd, 0xf4, 0x6f, 0xbc, 0x16, 0xfc,
+    0x82, 0x16, 0xc4, 0x2b, 0x1c, 0xae, 0xa2, 0x97, 0x67, 0xcd, 0x42, 0x23, 0x81, 0x43, 0x1a, 0x47,
+    0x3d, 0x91, 0x15, 0xac, 0xa9, 0x37, 0x15, 0x7d, 0x69, 0x10, 0x7b, 0x3a, 0x55, 0xa1, 0x44, 0xc2,
+    0xae, 0x98, 0x68, 0x7e, 0xa8, 0xd4, 0x8b, 0x65, 0xd7, 0x02, 0x2d, 0xeb, 0x82, 0x20, 0x81, 0xb6,
+    0xbf, 0x99, 0x7c, 0x95, 0x5e, 0x0e, 0xf7, 0x18, 0x92, 0x8a, 0x5f, 0xc1, 0x2d, 0x58, 0x9f, 0xb4,
+    0x12, 0x7f, 0x76, 0x40, 0x07, 0xd0, 0xd7, 0x8c, 0xf0, 0xc0, 0x06, 0x1e, 0xed, 0x74, 0x41, 0x78,
+    0xc9, 0xa2, 0xb6, 0xc1, 0x2b, 0x55, 0xcf, 0xa0, 0xc5, 0x74, 0x9c, 0xe9, 0x56, 0x8d, 0xd0, 0x21,
+    0x1d, 0x53, 0x55, 0x31, 0xf6, 0xd7, 0xaa, 0x37, 0xd9, 0x46, 0x3e, 0x1c, 0x3a, 0x12, 0x85, 0xfe,
+    0xc7, 0x69, 0x30, 0xc3, 0xf2, 0x28, 0xb2, 0x68, 0x64, 0xaa, 0x05, 0x30, 0xff, 0x13, 0x74, 0xf8,
+    0x5c, 0x45, 0xbc, 0xe6, 0xb5, 0x0c, 0x6d, 0x60, 0x87, 0x55, 0x04, 0x28, 0xca, 0x47, 0x2d, 0x10,
+    0xaa, 0x81, 0x2c, 0xe5, 0x58, 0xd8, 0xf1, 0x5c, 0x57, 0xfb, 0x20, 0xcf, 0x9e, 0xeb, 0x48, 0xa6,
+    0xb0, 0x7d, 0x10, 0x80, 0xff, 0x35, 0x52, 0x71, 0x4e, 0xc5, 0xf3, 0x8d, 0xdb, 0xb6, 0x65, 0x17,
+    0xa7, 0x5f, 0xd7, 0xa6, 0x56, 0x92, 0xe8, 0x18, 0x13, 0xdc, 0x98, 0x46, 0x93, 0xa0, 0x29, 0x33,
+    0xa9, 0xf4, 0xfb, 0xf6, 0xb3, 0x4c, 0x6d, 0xf5, 0x0a, 0x2b, 0xa6, 0x4b, 0x78, 0x4e, 0x0c, 0x0f,
+    0x2a, 0xd5, 0xd3, 0x01, 0xee, 0xf9, 0xb5, 0xe8, 0xa9, 0xcf, 0x2f, 0xe9, 0x76, 0x54, 0x9f, 0xf8,
+    0x22, 0x59, 0xd3, 0x9a, 0xaf, 0x5d, 0x78, 0xaa, 0xcc, 0x41, 0xbb, 0x02, 0xec, 0x35, 0x02, 0x7b,
+    0xcd, 0xc0, 0x49, 0x23, 0x70, 0xd2, 0x08, 0x1c, 0x36, 0x92, 0x11, 0x6e, 0x20, 0xc3, 0x9d, 0x37,
+    0x61, 0x76, 0xe7, 0x8d, 0xc0, 0xf3, 0x46, 0x32, 0xe6, 0x8d, 0x98, 0xf9, 0xdb, 0x0a, 0x0d, 0xf0,
+    0xdc, 0xb0, 0xb1, 0x4b, 0xb0, 0xa9, 0x4b, 0xb0, 0xb1, 0x4b, 0xe3, 0x1c, 0x54, 0xcb, 0xc6, 0x4e,
+    0xf9, 0xa6, 0x3e, 0x79, 0x23, 0x53, 0xcb, 0x8f, 0x0c, 0xac, 0xf5, 0xb3, 0x80, 0xbb, 0xf8, 0x9d,
+    0x02, 0xd5, 0x0d, 0xcb, 0x45, 0xf0, 0x08, 0x80, 0x21, 0x33, 0x02, 0xa7, 0x24, 0x2c, 0xba, 0xb4,
+    0xf9, 0x80, 0x5d, 0x45, 0x62, 0x72, 0xec, 0xd7, 0x40, 0x47, 0x6e, 0xe2, 0x33, 0x73, 0xe4, 0xaf,
+    0x5d, 0x99, 0xbb, 0x67, 0x60, 0x2b, 0x39, 0x20, 0xb5, 0x09, 0x8b, 0xfe, 0x0c, 0xc1, 0x1a, 0xa2,
+    0xea, 0x24, 0x0a, 0x55, 0x2d, 0xe5, 0x79, 0x5e, 0xad, 0xdc, 0x69, 0xec, 0x3d, 0x81, 0x67, 0x46,
+    0x31, 0xca, 0x6c, 0x6e, 0xff, 0x33, 0xb5, 0x03, 0xd8, 0x41, 0xdf, 0xc8, 0xa4, 0xb7, 0x92, 0x02,
+    0xde, 0x63, 0x7e, 0x33, 0xfa, 0xd3, 0xb5, 0xf6, 0x6f, 0x6b, 0x87, 0x19, 0xc9, 0x39, 0xf1, 0x00,
+    0x21, 0x7e, 0x8a, 0x04, 0xb2, 0xf4, 0xdf, 0x13, 0xf0, 0x75, 0x4f, 0xc0, 0xe4, 0x59, 0x36, 0x78,
+    0xab, 0x7a, 0x6e, 0x5d, 0x0c, 0xd7, 0xb8, 0xfa, 0xaa, 0xa5, 0xca, 0xc3, 0x5a, 0x24, 0xb1, 0xd1,
+    0x80, 0xbc, 0xd7, 0x2f, 0x41, 0x7e, 0x8b, 0x0d, 0x51, 0x5e, 0xf3, 0xfb, 0x4d, 0x08, 0xf6, 0x03,
+    0xb1, 0xe1, 0xf0, 0xa0, 0x38, 0x01, 0x39, 0xae, 0x4c, 0xb8, 0x78, 0x2f, 0xb2, 0x61, 0xca, 0x97,
+    0xf3, 0xa2, 0x22, 0xb9, 0x67, 0x96, 0x2c, 0xbf, 0x76, 0xdd, 0x5a, 0x0b, 0x2c, 0xa4, 0x0b, 0xd3,
+    0xbd, 0x20, 0xf1, 0x24, 0xb1, 0x14, 0x16, 0xc6, 0x0d, 0x76, 0x4d, 0x3a, 0x9b, 0xf5, 0xf7, 0xe2,
+    0x0c, 0x52, 0xe4, 0xe6, 0xea, 0x28, 0x35, 0x42, 0xd0, 0xb1, 0xa5, 0xb5, 0x52, 0xfe, 0xae, 0x8d,
+    0xd6, 0xa4, 0xfa, 0xc1, 0xb6, 0xd1, 0x82, 0xad, 0xa3, 0x05, 0xdb, 0x47, 0x6b, 0xb2, 0x65, 0xc9,
+    0x59, 0x22, 0xdd, 0xf3, 0xf5, 0xca, 0x6e, 0x83, 0xe0, 0x50, 0x5d, 0x6d, 0xb1, 0xe0, 0x63, 0x7a,
+    0xf8, 0x99, 0x90, 0x08, 0x13, 0x8a, 0x2c, 0x81, 0x55, 0x96, 0x78, 0x12, 0x5c, 0xe2, 0x97, 0x3c,
+    0xec, 0x75, 0x09, 0x43, 0xe0, 0x27, 0x0b, 0xff, 0xb7, 0xf8, 0x1d, 0x00, 0x5b, 0x71, 0x52, 0xcb,
+    0xf5, 0xb3, 0x67, 0xa1, 0x4a, 0x14, 0x8a, 0x4f, 0x39, 0xb4, 0x69, 0x73, 0x1b, 0x1a, 0xea, 0xea,
+    0x7d, 0x0a, 0xa8, 0xf8, 0x25, 0xa2, 0x3b, 0x9f, 0xdb, 0x6d, 0xf7, 0x00, 0xed, 0xe3, 0x38, 0xa1,
+    0x52, 0x98, 0x8c, 0x3c, 0x70, 0xa6, 0xbf, 0xbf, 0x7b, 0xf9, 0x04, 0xa2, 0xad, 0x38, 0x02, 0xac,
+    0x48, 0x4f, 0xc1, 0x27, 0x98, 0x21, 0x0c, 0x90, 0xd0, 0x19, 0x16, 0x16, 0xc6, 0x4c, 0xb4, 0x81,
+    0x7c, 0x88, 0x74, 0xfe, 0x58, 0x06, 0xde, 0x79, 0xb8, 0x1a, 0x8b, 0x4b, 0x48, 0x3c, 0x67, 0x11,
+    0x9e, 0x92, 0x4d, 0xdc, 0x15, 0x5a, 0xad, 0xa2, 0x38, 0xd5, 0x40, 0x2f, 0xf5, 0x5d, 0xe3, 0xe8,
+    0xb6, 0x1e, 0x32, 0x4d, 0x63, 0xbd, 0x57, 0xb7, 0x49, 0x65, 0x71, 0x54, 0xf5, 0x5a, 0xd8, 0xab,
+    0x20, 0xcb, 0x2d, 0x1d, 0xea, 0x99, 0xcc, 0x80, 0xa9, 0xd0, 0xab, 0x49, 0x90, 0x54, 0xe2, 0x91,
+    0x11, 0x8e, 0x24, 0x21, 0xe0, 0x09, 0x63, 0xc8, 0x42, 0x27, 0xcb, 0x20, 0xcc, 0x3b, 0x90, 0x37,
+    0xee, 0x8a, 0x65, 0x26, 0xe9, 0x0b, 0x5d, 0xd3, 0x00, 0x75, 0xb0, 0x7a, 0x1e, 0x29, 0xc9, 0x55,
+    0x85, 0x53, 0xd7, 0xa2, 0xf1, 0xc5, 0x10, 0x56, 0xa3, 0x23, 0xd1, 0x81, 0xf4, 0x05, 0x53, 0x11,
+    0x99, 0xf3, 0xab, 0x1e, 0x54, 0xc2, 0x2a, 0x37, 0x6e, 0x85, 0x2e, 0x94, 0x29, 0x98, 0x43, 0x06,
+    0x58, 0x2f, 0x76, 0xae, 0xaf, 0x17, 0x7f, 0xcf, 0x22, 0x90, 0xd9, 0x63, 0xee, 0x4b, 0x2b, 0xa7,
+    0xd0, 0x60, 0x59, 0x93, 0xac, 0xe5, 0xd1, 0x83, 0x7e, 0xbb, 0x5e, 0xd4, 0x6c, 0xb2, 0x41, 0xb7,
+    0x5b, 0x21, 0x51, 0xce, 0x49, 0x5b, 0x89, 0x71, 0x31, 0x1b, 0xf0, 0x4c, 0x78, 0x55, 0x1d, 0xe8,
+    0x6b, 0xb7, 0x20, 0xb1, 0x76, 0x02, 0x64, 0x02, 0xe1, 0xf4, 0x79, 0x09, 0x6c, 0x02, 0x42, 0x8c,
+    0xff, 0xcc, 0x85, 0xf9, 0x59, 0xf8, 0x61, 0x34, 0x47, 0x04, 0x54, 0x8a, 0x40, 0x16, 0x73, 0x11,
+    0xef, 0x13, 0x68, 0xaf, 0xcf, 0x27, 0xb3, 0x10, 0xe0, 0xb3, 0x79, 0xaa, 0x49, 0xcf, 0xfd, 0x48,
+    0xac, 0x8f, 0xbc, 0x76, 0x0e, 0x89, 0xf7, 0xfa, 0xa8, 0xb2, 0xb1, 0xa9, 0xa6, 0xd1, 0xae, 0x7c,
+    0x31, 0xa4, 0x64, 0x23, 0xf4, 0xea, 0xe2, 0xcb, 0x46, 0x29, 0x7d, 0xd3, 0xe4, 0xa8, 0x38, 0x1c,
+    0x2f, 0x98, 0xce, 0x62, 0x06, 0x9f, 0x02, 0x5f, 0x53, 0x59, 0x96, 0x82, 0x2a, 0x72, 0x63, 0x0e,
+    0xce, 0x29, 0x86, 0x1a, 0x1f, 0x23, 0x3b, 0x94, 0x61, 0x73, 0xed, 0xe0, 0x49, 0x97, 0x5e, 0xf4,
+    0xa5, 0x62, 0xcc, 0x98, 0xee, 0x51, 0x2b, 0x30, 0xb4, 0x86, 0x41, 0x6a, 0xc7, 0xd3, 0x7c, 0xe2,
+    0x35, 0xaf, 0x93, 0x4d, 0xb0, 0xfc, 0xdd, 0x0c, 0xe9, 0xeb, 0x92, 0x5a, 0x01, 0x8f, 0xf3, 0xe1,
+    0x43, 0xee, 0x4f, 0x40, 0x16, 0x7d, 0x50, 0xf5, 0xbc, 0x2c, 0x58, 0xdb, 0x77, 0xf6, 0x90, 0xa8,
+    0x6e, 0xe8, 0x20, 0xd5, 0x8b, 0x9e, 0x8d, 0xea, 0xb6, 0x49, 0x96, 0xf1, 0x88, 0xfb, 0x19, 0xbf,
+    0xdd, 0x9d, 0xb5, 0xab, 0xfb, 0x2e, 0xdf, 0xe3, 0x31, 0xd5, 0x36, 0x19, 0xbd, 0x7e, 0xb9, 0x65,
+    0x7d, 0x2b, 0x6f, 0x65, 0x56, 0x87, 0xfd, 0xda, 0x55, 0xd4, 0xd4, 0xcf, 0x2e, 0x15, 0x5c, 0x23,
+    0xec, 0x55, 0x39, 0x68, 0x7a, 0x9f, 0xf3, 0xb7, 0x98, 0xdf, 0x47, 0x57, 0xe8, 0xc4, 0x4a, 0xe6,
+    0xe5, 0x8b, 0x9d, 0xed, 0x72, 0x11, 0xaa, 0x13, 0xd4, 0x62, 0xda, 0x30, 0x48, 0xd1, 0xa7, 0x24,
+    0x51, 0x4b, 0x9c, 0x7a, 0x3d, 0xbe, 0x41, 0xd6, 0xd2, 0x18, 0xeb, 0xc4, 0x1a, 0x1b, 0xd8, 0xb2,
+    0xfc, 0x5d, 0xb9, 0x65, 0x48, 0xc3, 0x43, 0xd6, 0xcd, 0x0d, 0x4f, 0x64, 0x18, 0x5a, 0xfd, 0xba,
+    0x07, 0x64, 0xd4, 0x98, 0x0b, 0xca, 0x8d, 0x9d, 0x06, 0x1b, 0x3a, 0x29, 0x35, 0xda, 0xd8, 0x6f,
+    0xb8, 0xa1, 0x9f, 0xa7, 0x5e, 0xd7, 0x35, 0x62, 0x94, 0x8d, 0x38, 0xf6, 0x36, 0xe0, 0xc0, 0xd2,
+    0x5b, 0x83, 0xa7, 0x5f, 0xeb, 0xbf, 0xbf, 0x69, 0xc2, 0x5e, 0x90, 0xea, 0xa0, 0x1a, 0x83, 0x22,
+    0x08, 0x19, 0xc5, 0xc8, 0x6c, 0x6c, 0x40, 0xbe, 0xae, 0x33, 0x15, 0xf9, 0x8f, 0x43, 0xd9, 0x25,
+    0xf7, 0x65, 0xb5, 0x9f, 0xbb, 0x81, 0x3a, 0xbf, 0x48, 0x71, 0xbd, 0x29, 0x28, 0x6d, 0x47, 0x48,
+    0xbb, 0xe6, 0xdf, 0x36, 0x1b, 0xaa, 0xf2, 0xcd, 0x5f, 0x88, 0x5d, 0x5c, 0xdf, 0x7f, 0x76, 0x01,
+    0x6d, 0xe8, 0xf4, 0x30, 0x28, 0x84, 0x88, 0x21, 0x04, 0xaf, 0x0c, 0x18, 0x59, 0x63, 0x2d, 0xc3,
+    0x1c, 0x91, 0x8a, 0x01, 0x55, 0xd3, 0x20, 0x5d, 0x58, 0x6d, 0x7e, 0x13, 0xd8, 0x85, 0xa9, 0x9a,
+    0xa4, 0x3c, 0x6e, 0xdb, 0x55, 0x05, 0x34, 0x35, 0xba, 0x16, 0x43, 0x20, 0x82, 0x33, 0xd2, 0xe6,
+    0x10, 0x69, 0x29, 0x5c, 0x62, 0xdd, 0x36, 0xac, 0x73, 0x88, 0x66, 0xc9, 0x5b, 0x34, 0x35, 0xc3,
+    0x92, 0xc4, 0x61, 0x88, 0x9f, 0x2e, 0xf8, 0x26, 0x8b, 0x82, 0x6b, 0x53, 0xe4, 0x65, 0xe3, 0xef,
+    0x37, 0x25, 0x6c, 0x0c, 0x10, 0x91, 0xaa, 0x8a, 0x06, 0x7e, 0x28, 0xb1, 0x6a, 0x44, 0xa1, 0x58,
+    0xf9, 0x39, 0x84, 0xf5, 0x1c, 0x6b, 0x41, 0x9f, 0x53, 0xd0, 0x61, 0x18, 0x58, 0x59, 0x3a, 0x8c,
+    0x10, 0x2f, 0x73, 0x4b, 0x4f, 0xc8, 0x51, 0xaf, 0x91, 0x35, 0x46, 0xf4, 0x5b, 0x50, 0x7f, 0x45,
+    0x3f, 0x10, 0xf8, 0x85, 0x2c, 0x53, 0x85, 0x0f, 0xcc, 0xc1, 0xd9, 0x22, 0x9e, 0x2f, 0x6e, 0xc4,
+    0xe2, 0xaf, 0xcb, 0xfe, 0xde, 0xc9, 0x23, 0x01, 0x7f, 0xfa, 0xbf, 0x0e, 0xb8, 0x25, 0xf3, 0x55,
+    0x23, 0x25, 0x53, 0xf4, 0x96, 0xde, 0x0d, 0xbf, 0xac, 0xe7, 0xa8, 0x7d, 0x59, 0xfd, 0x7e, 0x14,
+    0xb6, 0x83, 0xd6, 0x00, 0xdd, 0x67, 0x4b, 0x3c, 0xe7, 0x89, 0x0f, 0x29, 0x9a, 0xbe, 0xe9, 0x35,
+    0x37, 0x61, 0xfd, 0x90, 0x86, 0x7a, 0x90, 0xd1, 0x09, 0x18, 0x7c, 0x9b, 0xd6, 0xfe, 0x52, 0x10,
+    0x37, 0xa2, 0xe4, 0x14, 0xe5, 0xbd, 0xc8, 0x83, 0x37, 0xbb, 0x94, 0x6d, 0x12, 0x8e, 0x1c, 0xfb,
+    0x46, 0xe9, 0xe6, 0xc5, 0xfd, 0x83, 0x8e, 0x42, 0xc5, 0x97, 0x9b, 0x42, 0x5b, 0xcd, 0xed, 0x57,
+    0xf1, 0x25, 0xe0, 0x27, 0x17, 0x4b, 0xf9, 0xc2, 0xfd, 0x79, 0x30, 0x9b, 0xdf, 0xd6, 0x09, 0x3f,
+    0xdf, 0x61, 0xf4, 0x32, 0xcf, 0x06, 0xc2, 0x7f, 0xed, 0xfb, 0xea, 0xd3, 0x1d, 0xb7, 0xa1, 0x51,
+    0x9f, 0xf2, 0x28, 0x30, 0x8d, 0xbf, 0x49, 0xd0, 0x1f, 0xb7, 0x2b, 0xef, 0xd5, 0x19, 0xc2, 0x7e,
+    0xab, 0x98, 0x6a, 0xa9, 0xa7, 0xca, 0x7a, 0x83, 0x28, 0x36, 0x8a, 0xed, 0x83, 0xe2, 0xe5, 0xc7,
+    0xfa, 0x22, 0x6e, 0x54, 0x60, 0xfc, 0xfc, 0xc4, 0x37, 0x29, 0x30, 0x7e, 0xfe, 0xe2, 0x47, 0x28,
+    0xb0, 0x3a, 0x67, 0x1b, 0x44, 0xe7, 0xa4, 0x39, 0xac, 0xc9, 0x54, 0x01, 0x56, 0x9f, 0x1e, 0xc1,
+    0xbd, 0x3f, 0xa5, 0x41, 0x59, 0x16, 0xf8, 0x37, 0xa4, 0x01, 0x29, 0x5c, 0xde, 0x08, 0xff, 0xd7,
+    0xc5, 0x17, 0x31, 0xaa, 0xad, 0xa9, 0x72, 0xbe, 0x06, 0x22, 0x7c, 0x45, 0x0b, 0x82, 0x4f, 0x42,
+    0x03, 0x7f, 0xf1, 0x84, 0x25, 0x20, 0x31, 0x4e, 0x59, 0x7d, 0xed, 0xaa, 0xc7, 0xb8, 0xfd, 0xde,
+    0x63, 0xad, 0x07, 0xf5, 0xc3, 0xca, 0x25, 0xb2, 0x02, 0x32, 0x8c, 0x1a, 0x38, 0x3d, 0x3f, 0x0b,
+    0xa2, 0x2a, 0x3c, 0x16, 0xe6, 0xd5, 0xc0, 0x66, 0xca, 0x5a, 0x7c, 0x9c, 0xa4, 0xa9, 0xb8, 0x82,
+    0x13, 0xbf, 0xc1, 0x19, 0xb9, 0x09, 0xfa, 0x2f, 0x47, 0x9c, 0xbc, 0xd5, 0xc9, 0x7f, 0x72, 0x16,
+    0x24, 0x54, 0x7a, 0xba, 0xa1, 0x2f, 0x0a, 0xd1, 0xb4, 0x8b, 0xef, 0xb1, 0xdc, 0x98, 0xdf, 0x66,
+    0xf9, 0x62, 0x08, 0xf6, 0x17, 0xaa, 0x08, 0x54, 0xa1, 0xb1, 0x82, 0x2f, 0x16, 0x78, 0x84, 0x11,
+    0xb7, 0xe6, 0x32, 0x95, 0xd3, 0x94, 0xac, 0x40, 0x50, 0x78, 0x7e, 0xa6, 0x9e, 0xdc, 0x38, 0x62,
+    0x11, 0x64, 0x19, 0x78, 0x3e, 0x6c, 0xe2, 0xcb, 0xa2, 0xed, 0xcb, 0xf7, 0x59, 0x07, 0x94, 0xaf,
+    0xef, 0xb2, 0x0e, 0x2a, 0x48, 0x6c, 0xda, 0x4f, 0xbb, 0x16, 0x28, 0x10, 0xa3, 0x92, 0xc9, 0x70,
+    0xa7, 0x35, 0xd4, 0x11, 0xf8, 0xe1, 0x95, 0xb2, 0x0d, 0xbf, 0xd4, 0xa2, 0xdb, 0x8a, 0x08, 0xe0,
+    0xce, 0x72, 0x4e, 0x1e, 0x78, 0xd6, 0xc6, 0x3d, 0x84, 0x85, 0xcc, 0xe7, 0x31, 0x0c, 0xda, 0x7e,
+    0xfb, 0xe6, 0xf4, 0x3d, 0x3c, 0x21, 0xfa, 0x6e, 0xec, 0xbb, 0x2d, 0xb8, 0x7a, 0x95, 0xb6, 0x9d,
+    0x5d, 0x06, 0x80, 0x5d, 0xf9, 0x1e, 0x58, 0xe3, 0x9a, 0x96, 0x6f, 0x51, 0xdd, 0xbb, 0x26, 0x43,
+    0x4d, 0x9c, 0xa6, 0x8f, 0x5f, 0x94, 0xac, 0x96, 0x17, 0x6b, 0xcc, 0x0e, 0x7c, 0x3c, 0xe0, 0x27,
+    0x2f, 0xba, 0xfc, 0x2a, 0x3f, 0xb3, 0xeb, 0xb6, 0xa0, 0x82, 0x13, 0x97, 0x33, 0x24, 0xe0, 0x31,
+    0x20, 0xd8, 0x64, 0x4a, 0xa1, 0xa9, 0x52, 0xa2, 0x48, 0xe5, 0x14, 0x02, 0x98, 0xb9, 0xf8, 0xfd,
+    0xa5, 0xfe, 0x6e, 0xb0, 0x3b, 0xc5, 0x17, 0x9e, 0x98, 0xcc, 0x75, 0xf3, 0x66, 0x6c, 0x11, 0x38,
+    0x74, 0xd0, 0xef, 0xbb, 0xd8, 0x64, 0x7c, 0x2b, 0x75, 0xab, 0x38, 0x5a, 0xf6, 0xd1, 0xf1, 0x75,
+    0xb1, 0x1b, 0x7e, 0x8f, 0xcf, 0x50, 0x94, 0x68, 0x29, 0x52, 0xa7, 0xcf, 0x66, 0x61, 0xd7, 0x2e,
+    0x63, 0xb5, 0xda, 0x04, 0xa6, 0xbf, 0xa8, 0x41, 0xd6, 0x9a, 0x36, 0x69, 0x34, 0x22, 0x3a, 0xfd,
+    0x40, 0x74, 0x6f, 0x53, 0x15, 0xfe, 0xd2, 0xea, 0xad, 0xd4, 0xd5, 0x0a, 0x52, 0x6d, 0xa9, 0xba,
+    0xdd, 0x8a, 0x5f, 0x7d, 0x7a, 0xf5, 0x9b, 0x07, 0xf0, 0x75, 0x3f, 0x5b, 0x9f, 0x0b, 0x28, 0x3f,
+    0xce, 0x3a, 0x81, 0x78, 0x1d, 0x4b, 0x30, 0xf4, 0xe9, 0x04, 0x88, 0x97, 0xf9, 0xfb, 0x51, 0xb7,
+    0x10, 0xa2, 0x3f, 0xd6, 0xfa, 0x5d, 0x76, 0x21, 0xa2, 0x94, 0xa9, 0x78, 0xf1, 0xbf, 0xb2, 0x7f,
+    0x47, 0x1b, 0xfa, 0x39, 0x84, 0x4d, 0xd5, 0x32, 0x38, 0x74, 0x41, 0x32, 0x70, 0x48, 0xcb, 0xd6,
+    0x76, 0x7b, 0x8c, 0x13, 0xf9, 0x3d, 0x0a, 0xae, 0x8c, 0x5e, 0x01, 0x56, 0xfb, 0xe8, 0x3d, 0xfe,
+    0x86, 0x12, 0xdf, 0x66, 0xd1, 0x2a, 0xbe, 0x12, 0xdb, 0x2e, 0xf6, 0xe3, 0x9a, 0x8a, 0x7f, 0x30,
+    0x9f, 0x6f, 0x2e, 0xfe, 0x81, 0x1e, 0x9c, 0x21, 0xfe, 0xc7, 0x2a, 0x54, 0x29, 0x68, 0xad, 0x04,
+    0x15, 0x2a, 0xa6, 0x30, 0x92, 0xd6, 0x86, 0xf1, 0xe9, 0x13, 0xd0, 0xc8, 0x54, 0x89, 0x56, 0x0c,
+    0x70, 0x21, 0x5b, 0xf2, 0xf8, 0x55, 0x8c, 0x2f, 0x6b, 0xe9, 0x4f, 0x16, 0x14, 0xb9, 0x52, 0x7d,
+    0xff, 0x61, 0xe3, 0x94, 0xc4, 0x94, 0x92, 0xa5, 0x76, 0x35, 0x45, 0x6e, 0xc8, 0xb1, 0x1a, 0x31,
+    0x3c, 0xab, 0xd7, 0x0b, 0x0b, 0x19, 0x3b, 0x59, 0xe6, 0x71, 0x27, 0x2b, 0x3e, 0x00, 0x4c, 0xaf,
+    0x46, 0xcf, 0x24, 0x27, 0x64, 0x30, 0x67, 0xf5, 0xa1, 0x32, 0x6a, 0x0b, 0xc0, 0xb3, 0xa5, 0x71,
+    0x34, 0x83, 0x8e, 0xd6, 0xba, 0xd8, 0xdc, 0x85, 0xcd, 0x33, 0xc5, 0xe6, 0xf6, 0x56, 0xb6, 0xde,
+    0x5e, 0x8a, 0x53, 0x5f, 0xa6, 0x20, 0xda, 0x88, 0xdf, 0x54, 0x82, 0x2b, 0xe4, 0x8b, 0xbf, 0x4f,
+    0x31, 0xe6, 0x52, 0x74, 0x84, 0xaf, 0x71, 0xd2, 0xe7, 0x09, 0xb2, 0x5a, 0x7f, 0xa5, 0x54, 0x0a,
+    0x01, 0x8a, 0xb9, 0x79, 0x92, 0x78, 0xf3, 0x07, 0x3c, 0xcc, 0x7e, 0x1d, 0x83, 0x0a, 0xa3, 0xe3,
+    0x8e, 0xf1, 0x35, 0x9c, 0x97, 0x53, 0xc2, 0x20, 0xc1, 0x58, 0x01, 0x27, 0x8f, 0xc5, 0x00, 0x5f,
+    0x61, 0x5d, 0xe6, 0xe0, 0x42, 0x5d, 0xcd, 0xfb, 0x4a, 0xed, 0x8a, 0x86, 0x3b, 0x16, 0x07, 0x7d,
+    0x54, 0x1f, 0x83, 0x2d, 0x65, 0xfa, 0x0c, 0xb9, 0xa5, 0xd5, 0x7e, 0x6a, 0xac, 0x0c, 0x6e, 0xa8,
+    0x4f, 0x56, 0x6d, 0xc7, 0xd4, 0x46, 0x44, 0xd3, 0x23, 0x15, 0x74, 0xb0, 0xc2, 0x4c, 0xea, 0x66,
+    0x0c, 0xa9, 0x54, 0xc4, 0xa0, 0xf9, 0x16, 0xed, 0x36, 0x67, 0xdd, 0x33, 0x3f, 0x00, 0xd2, 0xec,
+    0xb3, 0x6e, 0xd3, 0x27, 0xfc, 0xef, 0x4e, 0xaa, 0x5e, 0x17, 0xe5, 0x42, 0x60, 0x0d, 0x65, 0x68,
+    0x50, 0xa4, 0xef, 0xc4, 0x4e, 0xd3, 0x7b, 0xf3, 0xef, 0x26, 0xe6, 0xdb, 0x14, 0xae, 0x56, 0xd4,
+    0x20, 0x0c, 0xde, 0x5c, 0x7a, 0xe7, 0x5a, 0x65, 0x6b, 0xa5, 0x0c, 0xdb, 0x6a, 0xcc, 0x12, 0x88,
+    0x75, 0x27, 0x91, 0xff, 0x34, 0x75, 0x2f, 0xf5, 0xfe, 0x9a, 0xc1, 0x54, 0xbd, 0x79, 0xaf, 0x0e,
+    0x7c, 0xd6, 0xb6, 0xe3, 0xcc, 0xf3, 0x09, 0xe0, 0x0e, 0x21, 0x37, 0x1d, 0x19, 0x87, 0xaa, 0x28,
+    0x53, 0x2d, 0x23, 0xb7, 0x88, 0x3f, 0xf6, 0x41, 0x38, 0x46, 0x54, 0x0c, 0x55, 0x5e, 0x93, 0xa2,
+    0xcc, 0xf5, 0x6e, 0x5b, 0x42, 0x1d, 0x93, 0x68, 0x9b, 0x8f, 0x01, 0xe6, 0x2f, 0xf1, 0x3d, 0x22,
+    0x18, 0xaa, 0x1a, 0x51, 0x14, 0x02, 0xb3, 0x06, 0xa1, 0xba, 0x53, 0xd0, 0xc1, 0x20, 0x6b, 0x3b,
+    0x17, 0xf5, 0x7e, 0x35, 0x00, 0xca, 0xc8, 0x94, 0xab, 0xe1, 0xc2, 0xb1, 0x1b, 0xe2, 0x21, 0xdf,
+    0x20, 0xf6, 0x03, 0x4f, 0x07, 0x42, 0x3b, 0x1b, 0xca, 0x30, 0x75, 0xbc, 0x06, 0x80, 0x23, 0xf6,
+    0xfa, 0x05, 0x62, 0x1d, 0x4f, 0xf1, 0xf9, 0xb7, 0xbd, 0x3e, 0x5a, 0x93, 0x32, 0xb3, 0xab, 0x63,
+    0xd2, 0x2d, 0x9a, 0xb4, 0x1d, 0x51, 0x5b, 0xe0, 0xf1, 0x0e, 0x0b, 0x82, 0x71, 0x00, 0xb1, 0xc7,
+    0x1f, 0xb8, 0x3b, 0xec, 0xf1, 0xff, 0xbd, 0xd6, 0xff, 0x01, 0xee, 0x60, 0xb4, 0xf7, 0x77, 0x6b,
+    0x00, 0x00,
+};
+const size_t index_html_gz_len = sizeof(index_html_gz);
@@ -0,0 +1,262 @@
+#include "FZ35_WiFi.h"
+#include "FZ35_Telemetry.h"
+#include <ESP8266WiFi.h>
+
+/**
+ * @file FZ35_WiFi.cpp
+ * @brief Station state machine, fallback AP and the outage / read gap counters.
+ *        The SDK's own auto-reconnect is off so that every attempt is ours (counted
+ *        and backed off); WiFi.persistent(false) keeps the attempts from rewriting the
+ *        flash config, only wifiConfigure() saves.
+ */
+
+enum class Wlan : uint8_t {
+    NoCredentials,   // fallback AP only, until /wifi_config gives some
+    Connecting,      // WiFi.begin() issued, polling status()
+    Connected,
+    Backoff          // waiting until retryAtMs
+};
+
+static DNSServer *captiveDns = nullptr;
+static Wlan state = Wlan::NoCredentials;
+static char ssid[33];
+static char pass[65];
+static bool pendingConfig = false;
+static uint32_t stateMs = 0;
+static uint32_t retryAtMs = 0;
+static uint32_t backoffMs = WIFI_BACKOFF_MIN;
+static uint32_t offlineSinceMs = 0;   // start of the current outage (boot counts as one)
+static bool everConnected = false;
+static bool apActive = false;
+static bool offlineInGap = true;      // link was down at some point since the last read
+static const char *lastFailure = "";
+
+// counters
+static uint32_t attempts = 0;
+static uint32_t disconnects = 0;
+static uint32_t reconnects = 0;
+static uint32_t firstConnectMs = 0;
+static uint32_t lastReconnectMs = 0;
+static uint32_t maxReconnectMs = 0;
+static uint32_t offlineTotalMs = 0;   // closed outages, boot included
+static uint32_t apStarts = 0;
+static uint32_t tickMaxUs = 0;
+
+// reads of load 0
+static bool haveRead = false;
+static uint32_t lastReadMs = 0;
+static uint32_t readsOffline = 0;
+static uint32_t missedOffline = 0;
+static uint32_t missedOnline = 0;
+static uint32_t maxGapOfflineMs = 0;
+static uint32_t maxGapOnlineMs = 0;
+
+static void startAttempt(uint32_t now) {
+    attempts++;
+    WiFi.begin(ssid, pass);   // returns at once; status() reports the outcome
+    state = Wlan::Connecting;
+    stateMs = now;
+}
+
+static void fail(uint32_t now, const char *why) {
+    lastFailure = why;
+    Serial.printf("WiFi: %s, retry in %lu ms\n", why, (unsigned long)backoffMs);
+    WiFi.disconnect();        // the SDK stops scanning until the next attempt
+    state = Wlan::Backoff;
+    retryAtMs = now + backoffMs;
+    backoffMs = backoffMs * 2 > WIFI_BACKOFF_MAX ? WIFI_BACKOFF_MAX : backoffMs * 2;
+}
+
+static void connected(uint32_t now) {
+    uint32_t outageMs = now - offlineSinceMs;
+    offlineTotalMs += outageMs;
+    if (everConnected) {
+        reconnects++;
+        lastReconnectMs = outageMs;
+        if (outageMs > maxReconnectMs) maxReconnectMs = outageMs;
+    } else {
+        firstConnectMs = outageMs;
+        everConnected = true;
+    }
+    state = Wlan::Connected;
+    backoffMs = WIFI_BACKOFF_MIN;
+    Serial.printf("WiFi: connected to %s, %s (offline %lu ms, %lu attempts so far)\n", ssid,
+                  WiFi.localIP().toString().c_str(), (unsigned long)outageMs, (unsigned long)attempts);
+    telemetryNetworkUp();
+}
+
+static void startAp() {
+    WiFi.mode(WIFI_AP_STA);
+    WiFi.softAP(WIFI_AP_SSID, WIFI_AP_PASS);
+    captiveDns->start(53, "*", WiFi.softAPIP());   // every name resolves to us (captive portal)
+    apActive = true;
+    apStarts++;
+    Serial.printf("WiFi: fallback AP %s at %s\n", WIFI_AP_SSID, WiFi.softAPIP().toString().c_str());
+}
+
+static void stopAp() {
+    captiveDns->stop();
+    WiFi.softAPdisconnect(true);   // back to station only
+    apActive = false;
+    Serial.println("WiFi: fallback AP off");
+}
+
+void setupWiFi(DNSServer &server) {
+    captiveDns = &server;
+    WiFi.persistent(false);
+    WiFi.setAutoReconnect(false);
+    WiFi.mode(WIFI_STA);
+    // credentials saved by the last configuration (this firmware's or the old portal's)
+    snprintf(ssid, sizeof(ssid), "%s", WiFi.SSID().c_str());
+    snprintf(pass, sizeof(pass), "%s", WiFi.psk().c_str());
+    offlineSinceMs = millis();
+    if (ssid[0]) {
+        Serial.printf("WiFi: connecting to %s in the background\n", ssid);
+        startAttempt(offlineSinceMs);
+    } else {
+        Serial.println("WiFi: no stored network");
+    }
+    wifiTick();   // without credentials the fallback AP comes up now
+}
+
+bool wifiConfigure(const String &newSsid, const String &newPass) {
+    if (newSsid.length() < 1 || newSsid.length() >= sizeof(ssid)) return false;
+    if (newPass.length() >= sizeof(pass) || (newPass.length() && newPass.length() < 8)) return false;
+    snprintf(ssid, sizeof(ssid), "%s", newSsid.c_str());
+    snprintf(pass, sizeof(pass), "%s", newPass.c_str());
+    pendingConfig = true;
+    return true;
+}
+
+void wifiTick() {
+    uint32_t t0 = micros();
+    uint32_t now = millis();
+    wl_status_t st = WiFi.status();
+    if (apActive) captiveDns->processNextRequest();
+
+    if (pendingConfig) {
+        pendingConfig = false;
+        if (state == Wlan::Connected) {
+            disconnects++;
+            offlineSinceMs = now;
+        }
+        WiFi.disconnect();
+        WiFi.persistent(true);    // the one flash write: these credentials survive a reboot
+        WiFi.begin(ssid, pass);
+        WiFi.persistent(false);
+        attempts++;
+        backoffMs = WIFI_BACKOFF_MIN;
+        state = Wlan::Connecting;
+        stateMs = now;
+        Serial.printf("WiFi: switching to %s\n", ssid);
+        st = WL_DISCONNECTED;
+    }
+
+    switch (state) {
+    case Wlan::NoCredentials:
+        break;
+    case Wlan::Connecting:
+        if (st == WL_CONNECTED) connected(now);
+        else if (st == WL_NO_SSID_AVAIL) fail(now, "network not found");
+        else if (st == WL_CONNECT_FAILED || st == WL_WRONG_PASSWORD) fail(now, "connect refused");
+        else if (now - stateMs > WIFI_CONNECT_TIMEOUT_MS) fail(now, "connect timeout");
+        break;
+    case Wlan::Connected:
+        if (st != WL_CONNECTED) {
+            disconnects++;
+            offlineSinceMs = now;
+            lastFailure = "link lost";
+            Serial.println("WiFi: link lost, reconnecting in the background");
+            state = Wlan::Backoff;
+            retryAtMs = now;   // first retry at once, then backed off
+        }
+        break;
+    case Wlan::Backoff:
+        // an attempt scans and moves the radio off the AP's channel: not while a client
+        // is on the fallback AP (probably configuring)
+        if ((int32_t)(now - retryAtMs) >= 0 && !(apActive && WiFi.softAPgetStationNum())) startAttempt(now);
+        break;
+    }
+
+    bool offline = state != Wlan::Connected;
+    if (offline) offlineInGap = true;
+    if (offline && !apActive && (!ssid[0] || now - offlineSinceMs >= WIFI_AP_AFTER_MS)) startAp();
+    else if (!offline && apActive && !WiFi.softAPgetStationNum()) stopAp();
+
+    uint32_t us = micros() - t0;
+    if (us > tickMaxUs) tickMaxUs = us;
+}
+
+void wifiNoteRead(uint32_t startMs, uint32_t intervalMs) {
+    if (haveRead) {
+        // a read starts interval + read time after the previous one; twice the interval
+        // or more means slots went by without a read
+        uint32_t gapMs = startMs - lastReadMs;
+        uint32_t missed = gapMs >= 2 * intervalMs ? gapMs / intervalMs - 1 : 0;
+        if (offlineInGap) {
+            missedOffline += missed;
+            if (gapMs > maxGapOfflineMs) maxGapOfflineMs = gapMs;
+        } else {
+            missedOnline += missed;
+            if (gapMs > maxGapOnlineMs) maxGapOnlineMs = gapMs;
+        }
+    }
+    if (offlineInGap) readsOffline++;
+    haveRead = true;
+    lastReadMs = startMs;
+    offlineInGap = state != Wlan::Connected;
+}
+
+bool wifiStationUp() {
+    return state == Wlan::Connected;
+}
+
+bool wifiHasCredentials() {
+    return ssid[0] != '\0';
+}
+
+bool wifiApActive() {
+    return apActive;
+}
+
+static String jsonText(const char *s) {
+    String out = "\"";
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') out += '\\';
+        if ((uint8_t)*s >= 0x20) out += *s;
+    }
+    return out + "\"";
+}
+
+String wifiStatusJson() {
+    static const char *const names[] = { "no_credentials", "connecting", "connected", "backoff" };
+    uint32_t now = millis();
+    bool up = state == Wlan::Connected;
+    String json = "{\"state\":\"" + String(names[(int)state]) + "\"";
+    json += ",\"ssid\":" + jsonText(ssid);
+    json += ",\"ip\":\"" + (up ? WiFi.localIP().toString() : String()) + "\"";
+    json += ",\"rssi\":" + String(up ? (long)WiFi.RSSI() : 0L);
+    json += ",\"ap\":" + String(apActive ? "true" : "false");
+    json += ",\"ap_ip\":\"" + (apActive ? WiFi.softAPIP().toString() : String()) + "\"";
+    json += ",\"ap_clients\":" + String(apActive ? WiFi.softAPgetStationNum() : 0);
+    json += ",\"ap_starts\":" + String((unsigned long)apStarts);
+    json += ",\"attempts\":" + String((unsigned long)attempts);
+    json += ",\"disconnects\":" + String((unsigned long)disconnects);
+    json += ",\"reconnects\":" + String((unsigned long)reconnects);
+    json += ",\"backoff_ms\":" + String((unsigned long)backoffMs);
+    json += ",\"retry_in_ms\":" + String(state == Wlan::Backoff && (int32_t)(retryAtMs - now) > 0
+                                         ? (unsigned long)(retryAtMs - now) : 0UL);
+    json += ",\"offline_ms\":" + String(up ? 0UL : (unsigned long)(now - offlineSinceMs));
+    json += ",\"offline_ms_total\":" + String((unsigned long)(offlineTotalMs + (up ? 0 : now - offlineSinceMs)));
+    json += ",\"first_connect_ms\":" + String((unsigned long)firstConnectMs);
+    json += ",\"reconnect_ms\":" + String((unsigned long)lastReconnectMs);
+    json += ",\"reconnect_ms_max\":" + String((unsigned long)maxReconnectMs);
+    json += ",\"tick_us_max\":" + String((unsigned long)tickMaxUs);
+    json += ",\"reads_offline\":" + String((unsigned long)readsOffline);
+    json += ",\"missed_offline\":" + String((unsigned long)missedOffline);
+    json += ",\"missed_online\":" + String((unsigned long)missedOnline);
+    json += ",\"gap_ms_max_offline\":" + String((unsigned long)maxGapOfflineMs);
+    json += ",\"gap_ms_max_online\":" + String((unsigned long)maxGapOnlineMs);
+    json += ",\"last_error\":" + jsonText(lastFailure) + "}";
+    return json;
+}
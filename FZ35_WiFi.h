@@ -1,30 +1,55 @@
 #pragma once
-#include <ESPAsyncWebServer.h>
+#include <Arduino.h>
 #include <DNSServer.h>
-#include <ESPAsyncWiFiManager.h>
-#include "FZ35_WebUI.h"
 
 /**
  * @file FZ35_WiFi.h
- * @brief WiFi provisioning using AsyncWiFiManager. Falls back to AP if connection fails.
+ * @brief Background WiFi connection manager. Nothing here blocks loop(): setupWiFi()
+ *        only issues the first connection attempt and wifiTick() polls the station.
+ *        A failed attempt or a lost link is retried with exponential backoff
+ *        (WIFI_BACKOFF_MIN doubling to WIFI_BACKOFF_MAX, reset once connected). After
+ *        WIFI_AP_AFTER_MS offline (at once without stored credentials) the fallback AP
+ *        "FZ35-Lab" comes up next to the station, with a captive DNS, so the dashboard
+ *        and /wifi_config stay reachable; it goes away once the station is back and no
+ *        client is on it. The web server listens on both interfaces and is never
+ *        restarted; telemetry is told when the link is back.
+ *
+ *        wifiNoteRead() sees every read of load 0: read gaps with the link down are
+ *        counted apart from those with it up, so /wifi_status shows whether an outage
+ *        ever cost a sample.
  */
 
+#define WIFI_AP_SSID             "FZ35-Lab"
+#define WIFI_AP_PASS             "12345678"
+#define WIFI_CONNECT_TIMEOUT_MS  15000    // one attempt: WiFi.begin() -> connected
+#define WIFI_BACKOFF_MIN         1000
+#define WIFI_BACKOFF_MAX         300000
+#define WIFI_AP_AFTER_MS         60000    // offline this long: fallback AP comes up
+
+/**
+ * @brief Start the first attempt with the stored credentials (or the fallback AP
+ *        without any). Returns at once.
+ */
+void setupWiFi(DNSServer &dns);
+
 /**
- * @brief Attempt autoConnect; starts AP "FZ35-Lab" if not successful.
+ * @brief Poll the station, retry when due, run the fallback AP and its DNS. From loop().
  */
-inline void setupWiFi(AsyncWebServer &server, DNSServer &dns) {
-    AsyncWiFiManager wifiManager(&server, &dns);
-    bool res = wifiManager.autoConnect("FZ35-Lab", "12345678");
-    if (!res) {
-        Serial.println("⚠️ WiFi failed -> AP mode started.");
-    } else {
-        Serial.printf("✅ Connected to %s\n", WiFi.localIP().toString().c_str());
-    }
-}
+void wifiTick();
 
 /**
- * @brief Register HTTP endpoints / start server.
+ * @brief Use these credentials from now on (saved to flash). The switch happens in
+ *        the next wifiTick(); safe to call from a request handler.
+ * @return false if they are out of range (nothing changed).
  */
-inline void setupWebServer(AsyncWebServer &server) {
-    setupWebUI(); // call the function in FZ35_WebUI.h
-}
+bool wifiConfigure(const String &ssid, const String &pass);
+
+/**
+ * @brief A read of load 0 started at startMs; reads are due every intervalMs.
+ */
+void wifiNoteRead(uint32_t startMs, uint32_t intervalMs);
+
+bool wifiStationUp();
+bool wifiHasCredentials();
+bool wifiApActive();
+String wifiStatusJson();
@@ -0,0 +1,378 @@
+// fz35_analyze: summarize test logs and discharge curves pulled off many devices.
+//
+// Inputs are files or directories (searched recursively):
+//   *.csv     test logs (/testlog.csv, /export/tests.csv): one finished test per line
+//   *.ndjson  discharge curves (/export/history.ndjson, /export/samples.ndjson)
+// Lines are parsed with the firmware's own parsers (FZ35_LogFormat.h) and matched to
+// the built-in profiles (FZ35_Profiles.h). Files are memory-mapped and spread over all
+// cores; each worker keeps its own totals, merged at the end.
+//
+// Per profile: capacity distribution (mean, sd, min, p10, p50, p90, max), mean capacity
+// in % of BatteryModule::capacityAh, the degradation trend (least-squares slope of
+// capacity over the test dates, % of nominal per year) and, from the curves, Ah and Wh
+// integrated over the samples. A curve belongs to the profile whose name appears in its
+// path ('_' counts as a space), e.g. curves/18650_Li-ion_4.2V_1.30A/dev7.ndjson.
+//
+//   fz35_analyze [-j threads] [-c] path...
+//
+// -c prints the profile table as CSV (for spreadsheets); throughput goes to stderr.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "FZ35_LogFormat.h"
+#include "FZ35_Profiles.h"
+
+namespace fs = std::filesystem;
+
+#define CURVE_MAX_GAP_S 60   // longer gaps (lost samples, reset) are not integrated
+
+struct TestPoint {
+    uint32_t stamp;          // minutes since 1970, 0 = clock not set
+    int32_t capacity_mAh;
+};
+
+struct ProfileAcc {
+    std::vector<TestPoint> tests;
+    uint32_t curves = 0;
+    uint64_t curveSamples = 0;
+    int64_t curveCharge_mAs = 0;
+    int64_t curveEnergy_mWs = 0;
+};
+
+struct Partial {
+    std::map<std::string, ProfileAcc> profiles;
+    uint64_t files = 0, failed = 0, bytes = 0;
+    uint64_t logRows = 0, samples = 0, badLines = 0;
+};
+
+// ---------- profile matching ----------
+
+static std::vector<std::string> profileKeys;   // lower case names of batteryModules[]
+
+static std::string lowerSpaced(const std::string &s) {
+    std::string out(s);
+    for (char &c : out) c = c == '_' ? ' ' : (char)tolower((unsigned char)c);
+    return out;
+}
+
+static std::string curveProfile(const std::string &path) {
+    std::string p = lowerSpaced(path);
+    int best = -1;
+    for (size_t i = 0; i < profileKeys.size(); ++i) {
+        if (p.find(profileKeys[i]) == std::string::npos) continue;
+        if (best < 0 || profileKeys[i].size() > profileKeys[best].size()) best = (int)i;
+    }
+    return best < 0 ? "(unassigned)" : batteryModules[best].name;
+}
+
+static double nominalAh(const std::string &name) {
+    for (size_t i = 0; i < batteryModulesCount; ++i) {
+        if (name == batteryModules[i].name) return batteryModules[i].capacityAh;
+    }
+    return 0;   // user profile or "Channel N": not in the firmware table
+}
+
+// ---------- parsing ----------
+
+template <typename F>
+static void forEachLine(const char *data, size_t size, F fn) {
+    const char *p = data, *end = data + size;
+    while (p < end) {
+        const char *nl = (const char *)memchr(p, '\n', end - p);
+        const char *lineEnd = nl ? nl : end;
+        if (lineEnd > p) fn(p, (size_t)(lineEnd - p));
+        p = lineEnd + 1;
+    }
+}
+
+static void parseTestLog(const char *data, size_t size, Partial &out) {
+    forEachLine(data, size, [&](const char *line, size_t len) {
+        TestLogRow row;
+        if (!parseTestLogLine(line, len, row)) {
+            if (len > 1) out.badLines++;
+            return;
+        }
+        out.logRows++;
+        out.profiles[row.batteryType].tests.push_back({ testStampFromDate(row.date), row.capacity_mAh });
+    });
+}
+
+static void parseCurve(const std::string &path, const char *data, size_t size, Partial &out) {
+    ProfileAcc &acc = out.profiles[curveProfile(path)];
+    bool havePrev = false;
+    SampleRow prev = {};
+    uint64_t n = 0;
+    forEachLine(data, size, [&](const char *line, size_t len) {
+        SampleRow s;
+        if (!parseSampleLine(line, len, s)) {
+            if (len > 1) out.badLines++;
+            return;
+        }
+        if (s.lost) {
+            havePrev = false;
+            return;
+        }
+        n++;
+        // trapezoids between consecutive samples
+        uint32_t dt = s.t_s - prev.t_s;
+        if (havePrev && s.t_s > prev.t_s && dt <= CURVE_MAX_GAP_S) {
+            acc.curveCharge_mAs += (int64_t)(s.current_mA + prev.current_mA) * dt / 2;
+            acc.curveEnergy_mWs += (int64_t)(s.power_mW + prev.power_mW) * dt / 2;
+        }
+        prev = s;
+        havePrev = true;
+    });
+    acc.curves++;
+    acc.curveSamples += n;
+    out.samples += n;
+}
+
+static void processFile(const std::string &path, Partial &out) {
+    int fd = open(path.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        if (fd >= 0) close(fd);
+        fprintf(stderr, "%s: %s\n", path.c_str(), strerror(errno));
+        out.failed++;
+        return;
+    }
+    out.files++;
+    size_t size = (size_t)st.st_size;
+    if (size == 0) {
+        close(fd);
+        return;
+    }
+    void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "%s: mmap: %s\n", path.c_str(), strerror(errno));
+        out.files--;
+        out.failed++;
+        return;
+    }
+    madvise(map, size, MADV_SEQUENTIAL);
+    const char *data = (const char *)map;
+    out.bytes += size;
+    bool curve = fs::path(path).extension() == ".ndjson" ||
+                 (fs::path(path).extension() != ".csv" && data[0] == '{');
+    if (curve) parseCurve(path, data, size, out);
+    else parseTestLog(data, size, out);
+    munmap(map, size);
+}
+
+static void merge(Partial &into, Partial &from) {
+    into.files += from.files;
+    into.failed += from.failed;
+    into.bytes += from.bytes;
+    into.logRows += from.logRows;
+    into.samples += from.samples;
+    into.badLines += from.badLines;
+    for (auto &kv : from.profiles) {
+        ProfileAcc &a = into.profiles[kv.first];
+        ProfileAcc &b = kv.second;
+        a.tests.insert(a.tests.end(), b.tests.begin(), b.tests.end());
+        a.curves += b.curves;
+        a.curveSamples += b.curveSamples;
+        a.curveCharge_mAs += b.curveCharge_mAs;
+        a.curveEnergy_mWs += b.curveEnergy_mWs;
+    }
+}
+
+// ---------- report ----------
+
+struct ProfileReport {
+    std::string name;
+    double nominal;
+    size_t tests;
+    double mean, sd, min, p10, p50, p90, max;   // Ah
+    double soh;                                 // mean in % of nominal, NAN if unknown
+    double trend;                               // % of nominal per year, NAN if undetermined
+    uint32_t curves;
+    double curveAh, curveWh;                    // per curve
+};
+
+static double percentile(const std::vector<int32_t> &sorted, int pct) {
+    size_t rank = (sorted.size() * pct + 99) / 100;   // nearest rank
+    return sorted[rank ? rank - 1 : 0] / 1000.0;
+}
+
+static ProfileReport summarize(const std::string &name, ProfileAcc &acc) {
+    ProfileReport r = {};
+    r.name = name;
+    r.nominal = nominalAh(name);
+    r.tests = acc.tests.size();
+    r.soh = r.trend = NAN;
+    r.curves = acc.curves;
+    if (acc.curves) {
+        r.curveAh = acc.curveCharge_mAs / 3600.0 / 1000.0 / acc.curves;
+        r.curveWh = acc.curveEnergy_mWs / 3600.0 / 1000.0 / acc.curves;
+    }
+    if (acc.tests.empty()) return r;
+
+    std::vector<int32_t> caps;
+    caps.reserve(acc.tests.size());
+    double sum = 0, sumSq = 0;
+    for (const TestPoint &t : acc.tests) {
+        caps.push_back(t.capacity_mAh);
+        sum += t.capacity_mAh;
+        sumSq += (double)t.capacity_mAh * t.capacity_mAh;
+    }
+    std::sort(caps.begin(), caps.end());
+    double n = (double)caps.size();
+    r.mean = sum / n / 1000.0;
+    r.sd = caps.size() > 1 ? sqrt(std::max(0.0, (sumSq - sum * sum / n) / (n - 1))) / 1000.0 : 0;
+    r.min = caps.front() / 1000.0;
+    r.max = caps.back() / 1000.0;
+    r.p10 = percentile(caps, 10);
+    r.p50 = percentile(caps, 50);
+    r.p90 = percentile(caps, 90);
+    if (r.nominal > 0) r.soh = 100.0 * r.mean / r.nominal;
+
+    // trend: least squares over dated tests, capacity in % of nominal vs. years
+    double ref = r.nominal > 0 ? r.nominal : r.mean;
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    uint32_t first = UINT32_MAX, last = 0, dated = 0;
+    for (const TestPoint &t : acc.tests) {
+        if (!t.stamp) continue;
+        double x = t.stamp / (1440.0 * 365.25);
+        double y = 100.0 * t.capacity_mAh / 1000.0 / ref;
+        sx += x; sy += y; sxx += x * x; sxy += x * y;
+        first = std::min(first, t.stamp);
+        last = std::max(last, t.stamp);
+        dated++;
+    }
+    if (dated >= 3 && last - first >= 1440 && ref > 0) {
+        double den = dated * sxx - sx * sx;
+        if (den > 0) r.trend = (dated * sxy - sx * sy) / den;
+    }
+    return r;
+}
+
+static std::string num(double v, int decimals) {
+    if (std::isnan(v)) return "-";
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+    return buf;
+}
+
+static void printTable(const std::vector<ProfileReport> &reports, bool csv) {
+    const char *cols[] = { "profile", "nominal_ah", "tests", "mean_ah", "sd_ah", "min_ah", "p10_ah",
+                           "p50_ah", "p90_ah", "max_ah", "soh_pct", "trend_pct_per_year",
+                           "curves", "curve_ah", "curve_wh" };
+    if (csv) {
+        for (size_t i = 0; i < sizeof(cols) / sizeof(cols[0]); ++i) printf("%s%s", i ? "," : "", cols[i]);
+        printf("\n");
+    } else {
+        printf("%-28s %7s %6s %7s %6s %6s %6s %6s %6s %6s %6s %9s %6s %7s %7s\n", "profile", "nom_Ah",
+               "tests", "mean", "sd", "min", "p10", "p50", "p90", "max", "soh%", "trend%/y",
+               "curves", "Ah/crv", "Wh/crv");
+    }
+    for (const ProfileReport &r : reports) {
+        std::string f[] = { r.nominal > 0 ? num(r.nominal, 2) : "-", std::to_string(r.tests),
+                            r.tests ? num(r.mean, 3) : "-", r.tests ? num(r.sd, 3) : "-",
+                            r.tests ? num(r.min, 3) : "-", r.tests ? num(r.p10, 3) : "-",
+                            r.tests ? num(r.p50, 3) : "-", r.tests ? num(r.p90, 3) : "-",
+                            r.tests ? num(r.max, 3) : "-", num(r.soh, 1), num(r.trend, 2),
+                            std::to_string(r.curves), r.curves ? num(r.curveAh, 3) : "-",
+                            r.curves ? num(r.curveWh, 2) : "-" };
+        if (csv) {
+            // profile names never contain commas (they are the CSV log's second field)
+            printf("%s", r.name.c_str());
+            for (const std::string &s : f) printf(",%s", s.c_str());
+            printf("\n");
+        } else {
+            printf("%-28.28s %7s %6s %7s %6s %6s %6s %6s %6s %6s %6s %9s %6s %7s %7s\n", r.name.c_str(),
+                   f[0].c_str(), f[1].c_str(), f[2].c_str(), f[3].c_str(), f[4].c_str(), f[5].c_str(),
+                   f[6].c_str(), f[7].c_str(), f[8].c_str(), f[9].c_str(), f[10].c_str(),
+                   f[11].c_str(), f[12].c_str(), f[13].c_str());
+        }
+    }
+}
+
+// ---------- main ----------
+
+static void usage() {
+    fprintf(stderr, "usage: fz35_analyze [-j threads] [-c] path...\n");
+}
+
+int main(int argc, char **argv) {
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    bool csv = false;
+    std::vector<std::string> roots;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "-j") && i + 1 < argc) threads = (unsigned)std::max(1, atoi(argv[++i]));
+        else if (!strcmp(argv[i], "-c")) csv = true;
+        else if (argv[i][0] == '-') { usage(); return 2; }
+        else roots.push_back(argv[i]);
+    }
+    if (roots.empty()) { usage(); return 2; }
+    for (size_t i = 0; i < batteryModulesCount; ++i) profileKeys.push_back(lowerSpaced(batteryModules[i].name));
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::string> files;
+    for (const std::string &root : roots) {
+        std::error_code ec;
+        if (fs::is_directory(root, ec)) {
+            for (auto it = fs::recursive_directory_iterator(root, ec); !ec && it != fs::end(it); it.increment(ec)) {
+                if (!it->is_regular_file(ec)) continue;
+                fs::path ext = it->path().extension();
+                if (ext == ".csv" || ext == ".ndjson") files.push_back(it->path().string());
+            }
+        } else {
+            files.push_back(root);   // named explicitly: any extension
+        }
+    }
+    // largest first, so one big file does not finish last on a single core
+    std::vector<std::pair<uintmax_t, std::string>> bySize;
+    bySize.reserve(files.size());
+    for (std::string &f : files) {
+        std::error_code ec;
+        uintmax_t size = fs::file_size(f, ec);
+        bySize.emplace_back(ec ? 0 : size, std::move(f));
+    }
+    std::sort(bySize.begin(), bySize.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+    auto t1 = std::chrono::steady_clock::now();
+
+    threads = std::min<unsigned>(threads, std::max<size_t>(1, bySize.size()));
+    std::vector<Partial> partial(threads);
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < threads; ++w) {
+        workers.emplace_back([&, w] {
+            for (size_t i; (i = next.fetch_add(1)) < bySize.size();) processFile(bySize[i].second, partial[w]);
+        });
+    }
+    for (std::thread &t : workers) t.join();
+    Partial total;
+    for (Partial &p : partial) merge(total, p);
+
+    std::vector<ProfileReport> reports;
+    for (auto &kv : total.profiles) reports.push_back(summarize(kv.first, kv.second));
+    auto t2 = std::chrono::steady_clock::now();
+
+    printTable(reports, csv);
+
+    double scan = std::chrono::duration<double>(t1 - t0).count();
+    double wall = std::chrono::duration<double>(t2 - t1).count();
+    uint64_t rows = total.logRows + total.samples;
+    FILE *info = csv ? stderr : stdout;
+    fprintf(info, "\n%llu files (%llu failed), %.1f MB: %llu test rows, %llu curve samples, %llu bad lines\n",
+            (unsigned long long)total.files, (unsigned long long)total.failed, total.bytes / 1e6,
+            (unsigned long long)total.logRows, (unsigned long long)total.samples,
+            (unsigned long long)total.badLines);
+    fprintf(info, "%u threads, scan %.3f s, analysis %.3f s: %.0f files/s, %.0f samples/s, %.1f MB/s\n",
+            threads, scan, wall, wall > 0 ? total.files / wall : 0, wall > 0 ? rows / wall : 0,
+            wall > 0 ? total.bytes / 1e6 / wall : 0);
+    return total.files ? 0 : 1;
+}
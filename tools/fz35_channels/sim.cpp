@@ -0,0 +1,217 @@
+// fz35_channels: run the firmware's multi-load scheduler (FZ35_Channel.cpp) and its own
+// Comm / parse code against FZ_CHANNELS virtual FZ35 loads on a virtual clock, and
+// report the sample rate each channel actually gets.
+//
+// Each virtual load answers "read" after a response delay with a summary line and a
+// CSV line, one byte per 1.04 ms (9600 baud); bytes land in a bounded RX buffer (the
+// SoftwareSerial buffer of the firmware) and are dropped when it is full. Transmit is
+// blocking, as on the ESP8266. The controller side is a copy of the sampling part of
+// loop(): channel 0 by a blocking readFZ35(), the others through channelsTick().
+// With -b the other channels are read the naive way instead (blocking readFZ35() for
+// each load in turn), for comparison.
+//
+//   fz35_channels [-t seconds] [-l response_ms] [-b] [-s]
+//
+// Nominal rate is 1 Hz for channels 1.. and, for channel 0, the loop() cadence (read
+// interval + read time, as in the firmware). Exits non-zero if a channel gets less than
+// 95% of its nominal sample count or loses received bytes.
+
+#include <deque>
+#include <map>
+#include <string>
+#include "FZ35_Comm.h"
+#include "FZ35_Channel.h"
+#include "FZ35_Battery.h"
+#include "FZ35_Memory.h"
+
+// ---------- virtual clock ----------
+
+#define CPU_TICK_US   2     // cost charged per clock read, so busy-wait loops advance
+#define LOOP_PASS_US  200   // loop() return + SDK / WiFi work between passes
+#define BYTE_US       1042  // 10 bits at 9600 baud
+
+static uint64_t nowUs = 0;
+uint64_t micros64() { return nowUs += CPU_TICK_US; }
+void delay(unsigned long ms) { nowUs += (uint64_t)ms * 1000; }
+
+// no emergency stops here
+bool estopPoll() { return false; }
+bool estopDelay(unsigned long ms) { delay(ms); return false; }
+
+// ---------- firmware pieces outside the scheduler ----------
+
+HostSerial Serial;
+SoftwareSerial fzSerial(RX_PIN, TX_PIN);
+String LOAD_ENABLE_CMD = "on";
+String LOAD_DISABLE_CMD = "off";
+
+bool captureOn = false;
+uint8_t captureDepth = 0;
+void captureRxByte(uint8_t) {}
+void captureTx(const String &, bool) {}
+void captureCall(uint8_t, uint16_t, const String &) {}
+
+bool traceOn = false;
+uint32_t traceWritten = 0;
+void traceRecord(const char *, char, uint8_t, uint16_t) {}
+void traceDropLast() {}
+
+int memRegister(const char *, const char *, MemKind, uint32_t) { return 0; }
+
+static std::map<std::string, int> testsLogged;   // battery name -> finished tests
+void saveTestResult(const char *batteryName, float, float, float) { testsLogged[batteryName]++; }
+
+// no profiles are applied in the simulation
+bool setActiveBattery(int) { return false; }
+String getBatteryName(int) { return String(); }
+int getActiveBatteryIndex() { return -1; }
+bool getBatteryDerived(int, BatteryDerived &, String &) { return false; }
+int sendProfilePayloads(const BatteryDerived &) { return 0; }
+
+// ---------- virtual loads ----------
+
+struct VirtualLoad {
+    uint32_t responseUs = 0;
+    std::string fromController;
+    std::deque<std::pair<uint64_t, char>> wire;   // answer bytes and their arrival time
+    std::deque<char> rxBuf;                        // controller side RX buffer
+    size_t rxCapacity = 64;
+    uint32_t overflow = 0;
+    uint32_t reads = 0;
+
+    // discharge at a constant current until endUs, then the load switches off
+    int32_t current_mA = 0;
+    uint64_t endUs = 0;
+
+    void deliver() {
+        while (!wire.empty() && wire.front().first <= nowUs) {
+            if (rxBuf.size() < rxCapacity) rxBuf.push_back(wire.front().second);
+            else overflow++;
+            wire.pop_front();
+        }
+    }
+
+    void answer() {
+        reads++;
+        uint64_t t = nowUs < endUs ? nowUs : endUs;
+        int32_t i_mA = nowUs < endUs ? current_mA : 0;
+        double mAh = current_mA * (t / 3600e6);
+        double v = 4.15 - 0.9 * (t / (double)endUs);
+        char text[160];
+        snprintf(text, sizeof(text),
+                 "OVP:25.2, OCP:5.10, OPP:35.00, LVP:2.8, OAH:0.000, OHP:00:00\r\n"
+                 "%.2fV,%.2fA,%.3fAh,%02u:%02u\r\n",
+                 v, i_mA / 1000.0, mAh / 1000.0, (unsigned)(t / 3600000000ULL), (unsigned)(t / 60000000ULL % 60));
+        uint64_t at = (wire.empty() ? nowUs : wire.back().first) + responseUs;
+        for (const char *p = text; *p; ++p) wire.emplace_back(at += BYTE_US, *p);
+    }
+};
+
+static std::map<const SoftwareSerial*, VirtualLoad> loads;
+
+int SoftwareSerial::available() {
+    VirtualLoad &l = loads[this];
+    l.deliver();
+    return (int)l.rxBuf.size();
+}
+
+int SoftwareSerial::read() {
+    VirtualLoad &l = loads[this];
+    l.deliver();
+    if (l.rxBuf.empty()) return -1;
+    char c = l.rxBuf.front();
+    l.rxBuf.pop_front();
+    return (uint8_t)c;
+}
+
+void SoftwareSerial::print(const String &s) {
+    VirtualLoad &l = loads[this];
+    nowUs += (uint64_t)s.length() * BYTE_US;   // SoftwareSerial TX is blocking
+    for (unsigned i = 0; i < s.length(); ++i) {
+        char c = s.charAt(i);
+        if (c == '\r') continue;
+        if (c != '\n') { l.fromController += c; continue; }
+        if (l.fromController == "read") l.answer();
+        l.fromController.clear();
+    }
+}
+
+void SoftwareSerial::println(const String &s) { print(s + "\r\n"); }
+
+// ---------- controller ----------
+
+static void usage() {
+    fprintf(stderr, "usage: fz35_channels [-t seconds] [-l response_ms] [-b] [-s]\n");
+}
+
+int main(int argc, char **argv) {
+    uint32_t seconds = 120;
+    uint32_t responseMs = 180;
+    bool blocking = false;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "-t") && i + 1 < argc) seconds = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-l") && i + 1 < argc) responseMs = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-b")) blocking = true;
+        else if (!strcmp(argv[i], "-s")) Serial.enabled = true;
+        else { usage(); return 2; }
+    }
+    if (seconds < 10) { usage(); return 2; }
+
+    initChannels();
+    for (int i = 0; i < FZ_CHANNELS; ++i) {
+        VirtualLoad &l = loads[channels[i].port];
+        l.rxCapacity = (size_t)channels[i].port->rxCapacity;
+        l.responseUs = (responseMs + 10 * i) * 1000;     // loads are not in lockstep
+        l.current_mA = 1000 + 250 * i;
+        l.endUs = (uint64_t)seconds * 1000000 * (6 + i) / 10;  // tests end at 60%..90% of the run
+    }
+
+    // sampling part of loop() (FZ35_Lab.ino)
+    const unsigned long readInterval = 1000;
+    unsigned long lastRead = 0;
+    unsigned long readDurationMs = 300;
+    uint64_t endUs = (uint64_t)seconds * 1000000;
+    while (nowUs < endUs) {
+        if (!blocking) channelsTick();
+        if (millis() - lastRead > readInterval) {
+            if (!blocking) channelsTick(readDurationMs);
+            unsigned long readStart = millis();
+            readFZ35();
+            readDurationMs = (readDurationMs * 3 + (millis() - readStart)) / 4;
+            channelNoteSample(channels[0], readStart, millis());
+            for (int i = 1; blocking && i < FZ_CHANNELS; ++i) {
+                ChannelScope scope(channels[i]);
+                unsigned long start = millis();
+                readFZ35();
+                channelNoteSample(channels[i], start, millis());
+            }
+            lastRead = millis();
+        }
+        nowUs += LOOP_PASS_US;
+    }
+
+    uint32_t nominal = (uint32_t)(endUs / 1000 / readInterval);
+    uint32_t nominal0 = (uint32_t)(endUs / 1000 / (readInterval + readDurationMs));
+    printf("%s, %d loads, %u s, read interval %lu ms, load response %u ms\n",
+           blocking ? "blocking reads in turn" : "interleaved (channelsTick)", FZ_CHANNELS,
+           seconds, readInterval, responseMs);
+    printf("ch  samples  nominal  rate_hz  missed  timeouts  mean_ms  max_gap_ms  mean_lat_ms  rx_lost  tests\n");
+    bool pass = true;
+    for (int i = 0; i < FZ_CHANNELS; ++i) {
+        const FzChannel &ch = channels[i];
+        const VirtualLoad &l = loads[ch.port];
+        uint32_t meanGap = ch.samples > 1 ? (ch.lastSampleMs - ch.firstSampleMs) / (ch.samples - 1) : 0;
+        double rate = ch.samples > 1 ? 1000.0 * (ch.samples - 1) / (ch.lastSampleMs - ch.firstSampleMs) : 0;
+        int tests = 0;
+        for (auto &t : testsLogged) if (t.first == "Channel " + std::to_string(i)) tests = t.second;
+        if (i == 0) tests = -1;   // channel 0 tests are logged by loop(), not simulated here
+        uint32_t expected = i == 0 ? nominal0 : nominal;
+        printf("%2d  %7u  %7u  %7.3f  %6u  %8u  %7u  %10u  %11u  %7u  %5s\n", i, ch.samples, expected, rate,
+               ch.missedSlots, ch.timeouts, meanGap, ch.maxGapMs,
+               ch.samples ? ch.latencySumMs / ch.samples : 0, l.overflow,
+               tests < 0 ? "-" : std::to_string(tests).c_str());
+        if (ch.samples * 100 < expected * 95 || l.overflow) pass = false;
+    }
+    printf("%s\n", pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,224 @@
+// fz35_detect: event latency versus false triggers of test start/end detection on
+// simulated noisy read traces, for the raw thresholds loop() used before and for the
+// filter stage in FZ35_Detect.cpp.
+//
+// A trace alternates idle stretches (0 mA plus noise) with tests (a constant current
+// drawn from coin cell to power cell loads, plus noise). Reads come every ~1 s. With
+// probability -g a fresh read is garbled: the current reads 0 during a test or a spike
+// while idle, sometimes two reads in a row. With probability -f a read fails; the raw
+// detector then sees the previous values again (the old stale Strings), the filter gets
+// it flagged as stale. A share -c of the tests is ended by the firmware itself (estop,
+// /cmd disable, program end), which the filter is told about via detectExpect().
+//
+//   fz35_detect [-h hours] [-g glitch] [-f fail] [-c commanded] [-r seed]
+//
+// Without -g it sweeps glitch rates. For each detector it reports missed tests, false
+// starts and false ends per 1000 h of trace, and the latency from the true edge to the
+// event (when it is emitted) and to the time it is dated to. Exits non-zero if the
+// filter misses a test at glitch rates up to 1%, has any false trigger up to 0.1%, or
+// less than 1000x fewer false triggers than the raw thresholds up to 1%.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "FZ35_Detect.h"
+
+struct Read {
+    uint32_t ms;
+    int32_t current_mA;
+    bool fresh;
+};
+
+struct Edge {
+    bool start;
+    uint32_t ms;          // true edge
+    bool commanded;
+};
+
+struct Trace {
+    std::vector<Read> reads;
+    std::vector<Edge> edges;
+    uint32_t tests = 0;
+};
+
+static Trace makeTrace(std::mt19937 &rng, double hours, double glitch, double fail, double commanded) {
+    std::uniform_real_distribution<double> u(0, 1);
+    const int32_t loads[] = { 160, 500, 1000, 3000 };
+    Trace tr;
+    uint64_t endMs = (uint64_t)(hours * 3600000.0);
+    uint32_t ms = 0;
+    bool on = false;
+    uint32_t phaseEnd = 60000;
+    int32_t load = 0;
+    int32_t last = 0;
+    bool endCommanded = false;
+    int burst = 0;
+    while (ms < endMs) {
+        // edges fall between reads; the first read after one shows the new current
+        if (ms >= phaseEnd) {
+            Edge e = { !on, phaseEnd, false };
+            if (on) {
+                e.commanded = endCommanded;
+                phaseEnd += std::uniform_int_distribution<uint32_t>(60000, 600000)(rng);
+            } else {
+                load = loads[std::uniform_int_distribution<int>(0, 3)(rng)];
+                endCommanded = u(rng) < commanded;
+                phaseEnd += std::uniform_int_distribution<uint32_t>(600000, 3600000)(rng);
+                tr.tests++;
+            }
+            on = !on;
+            if (e.ms) tr.edges.push_back(e);
+        }
+        Read r = { ms, 0, true };
+        int32_t truth = on ? load + (int32_t)std::normal_distribution<double>(0, load * 0.01)(rng)
+                           : std::max(0, (int32_t)std::normal_distribution<double>(0, 2)(rng));
+        if (u(rng) < fail) {
+            r.fresh = false;
+            r.current_mA = last;
+        } else if (burst > 0 || u(rng) < glitch) {
+            burst = burst > 0 ? burst - 1 : (u(rng) < 0.1 ? 1 : 0);
+            r.current_mA = on ? 0 : std::uniform_int_distribution<int32_t>(60, 2000)(rng);
+        } else {
+            r.current_mA = truth;
+        }
+        last = r.current_mA;
+        tr.reads.push_back(r);
+        ms += 1000 + std::uniform_int_distribution<uint32_t>(1, 40)(rng);
+    }
+    return tr;
+}
+
+struct Result {
+    uint32_t missed = 0, falseStarts = 0, falseEnds = 0;
+    std::vector<uint32_t> emitMs, datedMs;
+};
+
+// score the events of one detector against the trace's edges
+struct Scorer {
+    const Trace &tr;
+    Result res;
+    size_t edge = 0;          // next true edge
+    bool truthOn = false;
+    bool detected = false;    // current true test has produced a start
+    uint32_t edgeMs = 0;
+
+    explicit Scorer(const Trace &t) : tr(t) {}
+
+    void advance(uint32_t ms) {
+        while (edge < tr.edges.size() && tr.edges[edge].ms <= ms) {
+            const Edge &e = tr.edges[edge++];
+            if (!e.start && !detected) res.missed++;
+            truthOn = e.start;
+            edgeMs = e.ms;
+            if (e.start) detected = false;
+        }
+    }
+
+    void event(bool start, uint32_t emitMs, uint32_t atMs) {
+        if (start) {
+            if (!truthOn || detected) { res.falseStarts++; return; }
+            detected = true;
+        } else if (truthOn) {
+            res.falseEnds++;
+            return;
+        }
+        res.emitMs.push_back(emitMs - edgeMs);
+        res.datedMs.push_back(atMs > edgeMs ? atMs - edgeMs : edgeMs - atMs);
+    }
+};
+
+static Result runRaw(const Trace &tr) {
+    Scorer sc(tr);
+    bool active = false;
+    for (const Read &r : tr.reads) {
+        sc.advance(r.ms);
+        if (!active && r.current_mA > 50) { active = true; sc.event(true, r.ms, r.ms); }
+        if (active && r.current_mA < 10) { active = false; sc.event(false, r.ms, r.ms); }
+    }
+    return sc.res;
+}
+
+static Result runFilter(const Trace &tr) {
+    Scorer sc(tr);
+    LoadDetector d;
+    detectReset(d);
+    bool active = false;
+    size_t edge = 0;
+    for (const Read &r : tr.reads) {
+        // the firmware's own "off" goes out at the true edge
+        while (edge < tr.edges.size() && tr.edges[edge].ms <= r.ms) {
+            if (tr.edges[edge].commanded) detectExpect(d, false, tr.edges[edge].ms);
+            edge++;
+        }
+        sc.advance(r.ms);
+        DetectResult out;
+        DetectRead in = { r.ms, r.current_mA, 0, r.fresh };
+        if (detectAddRead(d, in, active, out) != DetectEvent::None) {
+            active = out.event == DetectEvent::Start;
+            sc.event(active, r.ms, out.atMs);
+        }
+    }
+    return sc.res;
+}
+
+static uint32_t pct(std::vector<uint32_t> &v, int p) {
+    if (v.empty()) return 0;
+    std::sort(v.begin(), v.end());
+    return v[std::min(v.size() - 1, v.size() * p / 100)];
+}
+
+static double mean(const std::vector<uint32_t> &v) {
+    double s = 0;
+    for (uint32_t x : v) s += x;
+    return v.empty() ? 0 : s / v.size();
+}
+
+static void report(const char *name, double glitch, double hours, uint32_t tests, Result &r) {
+    double k = 1000.0 / hours;
+    printf("%-7s %6.2f%% %6u %6u %9.1f %9.1f %8.0f %8u %8u %8.0f\n", name, glitch * 100, tests, r.missed,
+           r.falseStarts * k, r.falseEnds * k, mean(r.emitMs), pct(r.emitMs, 95), pct(r.emitMs, 100),
+           mean(r.datedMs));
+}
+
+static void usage() {
+    fprintf(stderr, "usage: fz35_detect [-h hours] [-g glitch] [-f fail] [-c commanded] [-r seed]\n");
+}
+
+int main(int argc, char **argv) {
+    double hours = 1000, fail = 0.02, commanded = 0.3;
+    double glitch = -1;
+    uint32_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "-h") && i + 1 < argc) hours = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-g") && i + 1 < argc) glitch = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-f") && i + 1 < argc) fail = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-c") && i + 1 < argc) commanded = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-r") && i + 1 < argc) seed = (uint32_t)atoi(argv[++i]);
+        else { usage(); return 2; }
+    }
+    if (hours <= 0 || hours > 1000) { usage(); return 2; }   // ms stay in uint32_t, like millis()
+    std::vector<double> rates = { 0, 0.001, 0.01, 0.05 };
+    if (glitch >= 0) rates = { glitch };
+
+    printf("%.0f h per rate, %.1f%% failed reads, %.0f%% of tests ended by the firmware\n",
+           hours, fail * 100, commanded * 100);
+    printf("%-7s %7s %6s %6s %9s %9s %8s %8s %8s %8s\n", "", "glitch", "tests", "missed",
+           "fstart/kh", "fend/kh", "lat_ms", "p95_ms", "max_ms", "dated_ms");
+    bool ok = true;
+    for (double g : rates) {
+        std::mt19937 rng(seed);
+        Trace tr = makeTrace(rng, hours, g, fail, commanded);
+        Result raw = runRaw(tr), filt = runFilter(tr);
+        report("raw", g, hours, tr.tests, raw);
+        report("filter", g, hours, tr.tests, filt);
+        uint32_t rawFalse = raw.falseStarts + raw.falseEnds, filtFalse = filt.falseStarts + filt.falseEnds;
+        if (g <= 0.01 && filt.missed) ok = false;
+        if (g <= 0.001 && filtFalse) ok = false;
+        if (g <= 0.01 && filtFalse * 1000 > rawFalse) ok = false;
+    }
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
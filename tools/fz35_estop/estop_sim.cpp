@@ -0,0 +1,260 @@
+// fz35_estop: inject emergency stops at random points into the firmware's serial
+// command stream and check the stop path (FZ35_Estop.cpp) on a virtual clock.
+//
+// A virtual FZ35 answers "read" after a response delay and confirms settings; every
+// print() on the link is one frame, shifted out at 9600 baud (blocking, as on the
+// ESP8266). The controller runs a cycle of loop() passes with the real Comm code and
+// the real command batch executor: readFZ35(), a profile-style batch (stop, load, six
+// limits incl. OVP variants, on, start), a timed read and a raw "on", with idle passes
+// in between. Stop requests arrive like HTTP handlers do, at yield points (delay() and
+// between loop() passes), at uniformly random times.
+//
+// For every stop it checks that
+//   - "off" is on the wire within ESTOP_BOUND_MS of the request,
+//   - nothing but "off" is sent for the rest of that loop() pass (no "on"/"start" from
+//     the interrupted sequence),
+//   - the load is off when the pass ends,
+// and reports the latency distribution per interrupted operation.
+//
+//   fz35_estop [-n stops] [-r seed] [-s]
+//
+// Exits non-zero on any violation.
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include "FZ35_Comm.h"
+#include "FZ35_Estop.h"
+#include "FZ35_CmdBatch.h"
+#include "FZ35_Dcir.h"
+#include "FZ35_Program.h"
+
+#define CPU_TICK_US   2     // cost charged per clock read, so busy-wait loops advance
+#define LOOP_PASS_US  200   // loop() return + SDK / WiFi work between passes
+#define BYTE_US       1042  // 10 bits at 9600 baud
+#define READ_RESPONSE_US  180000
+#define CONFIRM_RESPONSE_US 40000
+
+// ---------- stop injection at yield points ----------
+
+static uint64_t nowUs = 0;
+static std::mt19937 rng;
+static uint64_t injectAtUs = 0;
+static uint64_t requestUs = 0;       // outstanding stop (0 = none)
+static uint32_t passNo = 0;
+static const char *opName = "idle";  // operation of the current pass
+static const char *injectedIn = nullptr;
+
+static void scheduleInjection() {
+    injectAtUs = nowUs + std::uniform_int_distribution<uint64_t>(50000, 3000000)(rng);
+}
+
+// what an HTTP handler does when /estop arrives; handlers only run while loop()
+// yields, so a request that arrived during a busy stretch runs at the next yield
+static void yieldUntil(uint64_t endUs) {
+    if (!requestUs && injectAtUs < endUs) {
+        if (injectAtUs > nowUs) nowUs = injectAtUs;
+        requestUs = nowUs;
+        injectedIn = opName;
+        estopRequest(1);
+    }
+    nowUs = endUs;
+}
+
+uint64_t micros64() { return nowUs += CPU_TICK_US; }
+void delay(unsigned long ms) { yieldUntil(nowUs + (uint64_t)ms * 1000); }
+
+// ---------- firmware pieces outside the tested path ----------
+
+HostSerial Serial;
+SoftwareSerial fzSerial(RX_PIN, TX_PIN);
+FzChannel channels[FZ_CHANNELS];
+FzChannel *fzActive = &channels[0];
+int pendingBatteryIdx = -1;
+String LOAD_ENABLE_CMD = "on";
+String LOAD_DISABLE_CMD = "off";
+
+bool captureOn = false;
+uint8_t captureDepth = 0;
+void captureRxByte(uint8_t) {}
+void captureTx(const String &, bool) {}
+void captureCall(uint8_t, uint16_t, const String &) {}
+
+bool traceOn = false;
+uint32_t traceWritten = 0;
+void traceRecord(const char *, char, uint8_t, uint16_t) {}
+void traceDropLast() {}
+
+void parseFZ35(const String &) {}
+bool programActive() { return false; }
+void stopProgram(const char *) {}
+bool dcirBusy() { return false; }
+bool dcirCancel() { return false; }
+
+// ---------- virtual load ----------
+
+struct Frame {
+    uint64_t endUs;
+    uint32_t pass;
+    std::string text;
+};
+
+static std::vector<Frame> frames;
+static std::vector<std::pair<uint64_t, char>> wire;   // answer bytes, arrival time
+static size_t wirePos = 0;
+static bool loadOn = false;
+
+static void respond(const char *text, uint32_t afterUs) {
+    uint64_t at = std::max(nowUs, wirePos < wire.size() ? wire.back().first : 0) + afterUs;
+    for (const char *p = text; *p; ++p) wire.emplace_back(at += BYTE_US, *p);
+}
+
+int SoftwareSerial::available() {
+    int n = 0;
+    for (size_t i = wirePos; i < wire.size() && wire[i].first <= nowUs; ++i) n++;
+    return n;
+}
+
+int SoftwareSerial::read() {
+    if (wirePos >= wire.size() || wire[wirePos].first > nowUs) return -1;
+    return (uint8_t)wire[wirePos++].second;
+}
+
+void SoftwareSerial::print(const String &s) {
+    nowUs += (uint64_t)s.length() * BYTE_US;   // SoftwareSerial TX is blocking
+    std::string cmd(s.c_str());
+    while (!cmd.empty() && (cmd.back() == '\n' || cmd.back() == '\r')) cmd.pop_back();
+    frames.push_back({ nowUs, passNo, cmd });
+    if (cmd == "on") loadOn = true;
+    else if (cmd == "off") loadOn = false;
+    else if (cmd == "read")
+        respond("OVP:25.2, OCP:5.10, OPP:35.00, LVP:2.8, OAH:0.000, OHP:00:00\r\n"
+                "3.95V,1.30A,0.123Ah,00:05\r\n", READ_RESPONSE_US);
+    else if (cmd.find(':') != std::string::npos || (!cmd.empty() && cmd.back() == 'A'))
+        respond("success\r\n", CONFIRM_RESPONSE_US);
+}
+
+void SoftwareSerial::println(const String &s) { print(s + "\r\n"); }
+
+// ---------- controller ----------
+
+static void runOp(int op) {
+    switch (op) {
+    case 0:
+        opName = "readFZ35";
+        readFZ35();
+        break;
+    case 1: {
+        opName = "batch";
+        BatchCommand cmds[CMD_BATCH_MAX];
+        String err;
+        int n = parseCmdBatch("stop;load:1.3;ocp:1.5;opp:6;lvp:3.0;oah:2.5;ohp:10:00;ovp:4.2;on;start",
+                              cmds, CMD_BATCH_MAX, err);
+        if (n < 0 || !requestCmdBatch(cmds, n, false, err)) {
+            fprintf(stderr, "batch rejected: %s\n", err.c_str());
+            exit(2);
+        }
+        processPendingCmdBatch();
+        break;
+    }
+    case 2: {
+        opName = "read timed";
+        TimedRead t;
+        readMeasurementTimed(t);
+        break;
+    }
+    default:
+        opName = "raw on";
+        sendCommandNoNL(LOAD_ENABLE_CMD);
+        break;
+    }
+}
+
+struct OpStats {
+    const char *name;
+    std::vector<uint32_t> us;
+};
+
+static void usage() {
+    fprintf(stderr, "usage: fz35_estop [-n stops] [-r seed] [-s]\n");
+}
+
+int main(int argc, char **argv) {
+    uint32_t wanted = 500;
+    uint32_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) wanted = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-r") && i + 1 < argc) seed = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-s")) Serial.enabled = true;
+        else { usage(); return 2; }
+    }
+    if (!wanted) { usage(); return 2; }
+    rng.seed(seed);
+    channels[0].port = &fzSerial;
+    scheduleInjection();
+
+    std::vector<OpStats> stats = { { "readFZ35", {} }, { "batch", {} }, { "read timed", {} },
+                                   { "raw on", {} }, { "idle", {} } };
+    uint32_t violations = 0, stops = 0;
+    int op = 0;
+    while (stops < wanted) {
+        // one operation, then idle passes until the next one (loop() between reads)
+        uint64_t idleUntil = 0;
+        for (bool first = true; first || nowUs < idleUntil; first = false) {
+            passNo++;
+            size_t passFrames = frames.size();
+            estopRelease();
+            if (first) runOp(op);
+            else opName = "idle";
+
+            if (requestUs) {
+                // the pass the stop happened in has ended: check it
+                auto off = std::find_if(frames.begin() + passFrames, frames.end(),
+                                        [](const Frame &f) { return f.text == "off"; });
+                bool ok = true;
+                // a request after the pass's last poll is served by the next pass
+                if (off == frames.end()) goto next_pass;
+                {
+                    uint32_t us = (uint32_t)(off->endUs - requestUs);
+                    for (OpStats &s : stats) if (!strcmp(s.name, injectedIn)) s.us.push_back(us);
+                    if (us > ESTOP_BOUND_MS * 1000UL) {
+                        ok = false;
+                        printf("stop %u (%s): off after %u us\n", stops, injectedIn, us);
+                    }
+                    for (auto f = off + 1; f != frames.end(); ++f) {
+                        if (f->text == "off") continue;
+                        ok = false;
+                        printf("stop %u (%s): \"%s\" sent after the stop\n", stops, injectedIn, f->text.c_str());
+                    }
+                }
+                if (loadOn) {
+                    ok = false;
+                    printf("stop %u (%s): load on at the end of the pass\n", stops, injectedIn);
+                }
+                if (!ok) violations++;
+                stops++;
+                requestUs = 0;
+                scheduleInjection();
+            }
+        next_pass:
+            if (first) idleUntil = nowUs + 300000;
+            yieldUntil(nowUs + LOOP_PASS_US);
+        }
+        op = (op + 1) % 4;
+    }
+
+    printf("%u stops, bound %u ms\n", stops, ESTOP_BOUND_MS);
+    printf("%-11s %6s %8s %8s %8s %8s\n", "during", "stops", "min_us", "mean_us", "p99_us", "max_us");
+    for (OpStats &s : stats) {
+        if (s.us.empty()) continue;
+        std::sort(s.us.begin(), s.us.end());
+        uint64_t sum = 0;
+        for (uint32_t v : s.us) sum += v;
+        printf("%-11s %6zu %8u %8llu %8u %8u\n", s.name, s.us.size(), s.us.front(),
+               (unsigned long long)(sum / s.us.size()), s.us[s.us.size() * 99 / 100], s.us.back());
+    }
+    printf("firmware: %s\n", estopStatusJson().c_str());
+    printf("%s (%u violations)\n", violations ? "FAIL" : "PASS", violations);
+    return violations ? 1 : 0;
+}
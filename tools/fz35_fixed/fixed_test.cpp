@@ -0,0 +1,199 @@
+// fz35_fixed: equivalence test and benchmark of the integer measurement path
+// (FZ35_Fixed.h, parseFZ35() in FZ35_Parse.cpp) against the float path it replaced.
+//
+// The float path is the old code: values kept as the device's text, String::toFloat()
+// where a number was needed, power as String(v * i, 2), ring units as roundf(v * 100),
+// roundf(i * 100) and roundf(p * 10). Random device numbers with 0-3 decimals (voltage
+// up to 150 V, current up to 5 A, capacity up to 100 Ah) go through both; every
+// difference is classified:
+//   - tie: the exact decimal value lies on a rounding boundary (x.xx5), float rounded
+//     the nearest binary value, the integer path rounds half away from zero;
+//   - near tie: within float's error of a boundary, float landed on the wrong side;
+//   - error: anything else (a bug in the integer path).
+// Then whole CSV lines go through parseFZ35() and must match parseMilli() of their
+// parts. Finally both paths are timed per line. The host has an FPU, the ESP8266 does
+// not (soft float), so the host ratio understates the gain on the device.
+//
+//   fz35_fixed [-n samples] [-r seed]
+//
+// Exits non-zero on any error.
+
+#include <Arduino.h>
+#include <SoftwareSerial.h>
+#include <chrono>
+#include <random>
+#include "FZ35_Comm.h"
+#include "FZ35_Fixed.h"
+
+// ---------- firmware globals the parse code expects ----------
+
+HostSerial Serial;
+SoftwareSerial fzSerial(RX_PIN, TX_PIN);
+FzChannel channels[FZ_CHANNELS];
+FzChannel *fzActive = &channels[0];
+String LOAD_ENABLE_CMD = "on";
+String LOAD_DISABLE_CMD = "off";
+
+bool captureOn = false;
+uint8_t captureDepth = 0;
+void captureRxByte(uint8_t) {}
+void captureTx(const String &, bool) {}
+void captureCall(uint8_t, uint16_t, const String &) {}
+
+bool traceOn = false;
+uint32_t traceWritten = 0;
+void traceRecord(const char *, char, uint8_t, uint16_t) {}
+void traceDropLast() {}
+
+bool estopPoll() { return false; }
+bool estopDelay(unsigned long) { return false; }
+uint64_t micros64() { return 0; }
+void delay(unsigned long) {}
+
+// ---------- inputs ----------
+
+static std::mt19937 rng;
+
+// decimal text of value / 10^decimals, like the device prints it
+static String number(uint32_t maxWhole, int decimals) {
+    uint32_t whole = std::uniform_int_distribution<uint32_t>(0, maxWhole)(rng);
+    char buf[24];
+    if (!decimals) {
+        snprintf(buf, sizeof(buf), "%u", (unsigned)whole);
+    } else {
+        uint32_t frac = std::uniform_int_distribution<uint32_t>(0, FIXED_POW10[decimals] - 1)(rng);
+        snprintf(buf, sizeof(buf), "%u.%0*u", (unsigned)whole, decimals, (unsigned)frac);
+    }
+    return String(buf);
+}
+
+static int decimals() { return std::uniform_int_distribution<int>(0, 3)(rng); }
+
+// ---------- comparison ----------
+
+struct Diff {
+    const char *name;
+    uint32_t checked = 0, ties = 0, nearTies = 0, errors = 0;
+    char example[96] = "";
+};
+
+// exact value = num / den; a difference is a tie if num is on the half, a near tie if
+// it is within tolerance (in units of num) of it
+static void classify(Diff &d, bool equal, int64_t num, int64_t den, int64_t tolerance, const char *what) {
+    d.checked++;
+    if (equal) return;
+    int64_t rem = (num < 0 ? -num : num) % den;
+    int64_t off = rem * 2 - den;   // 0 exactly on the half
+    if (off < 0) off = -off;
+    if (off == 0) d.ties++;
+    else if (off <= 2 * tolerance) d.nearTies++;
+    else {
+        if (!d.errors) snprintf(d.example, sizeof(d.example), "%s", what);
+        d.errors++;
+    }
+}
+
+static void report(const Diff &d) {
+    printf("%-22s %9u %7u %9u %7u  %s\n", d.name, (unsigned)d.checked, (unsigned)d.ties,
+           (unsigned)d.nearTies, (unsigned)d.errors, d.example);
+}
+
+static void usage() {
+    fprintf(stderr, "usage: fz35_fixed [-n samples] [-r seed]\n");
+}
+
+int main(int argc, char **argv) {
+    uint32_t samples = 1000000, seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) samples = (uint32_t)atol(argv[++i]);
+        else if (!strcmp(argv[i], "-r") && i + 1 < argc) seed = (uint32_t)atoi(argv[++i]);
+        else { usage(); return 2; }
+    }
+    rng.seed(seed);
+
+    Diff parse = { "parse (milli)" }, ringV = { "ring V (0.01)" }, ringI = { "ring A (0.01)" };
+    Diff ringP = { "ring W (0.1)" }, power = { "power text (0.01)" }, line = { "parseFZ35 line" };
+    std::vector<String> vs, is, caps;
+    vs.reserve(samples);
+    is.reserve(samples);
+    caps.reserve(samples);
+
+    for (uint32_t n = 0; n < samples; ++n) {
+        String v = number(150, decimals()), i = number(5, decimals()), cap = number(100, decimals());
+        vs.push_back(v);
+        is.push_back(i);
+        caps.push_back(cap);
+        char what[96];
+        snprintf(what, sizeof(what), "v=%s i=%s", v.c_str(), i.c_str());
+
+        // old: toFloat where a number was needed
+        float vf = v.toFloat(), cf = i.toFloat();
+        // new: milli-units
+        int32_t mV = 0, mA = 0, mAh = 0;
+        parseMilli(v.c_str(), mV);
+        parseMilli(i.c_str(), mA);
+        parseMilli(cap.c_str(), mAh);
+
+        // inputs have <= 3 decimals: both must give the same milli value
+        classify(parse, lroundf(vf * 1000.0f) == mV && lroundf(cf * 1000.0f) == mA &&
+                        lroundf(cap.toFloat() * 1000.0f) == mAh, 0, 1, 0, what);
+
+        Measurement m = { mV, mA, mAh, mulMilli(mV, mA) };
+        int64_t uW = (int64_t)mV * mA;   // exact product, 10^-6 W
+        // float carries ~2^-24 relative error per operation
+        int64_t tolV = (int64_t)(mV / 4e6) + 1, tolI = (int64_t)(mA / 4e6) + 1, tolP = (int64_t)(uW / 2e6) + 1;
+
+        classify(ringV, (uint16_t)constrain((int)roundf(vf * 100.0f), 0, 65535) == ringCenti(mV), mV, 10, tolV, what);
+        classify(ringI, (uint16_t)constrain((int)roundf(cf * 100.0f), 0, 65535) == ringCenti(mA), mA, 10, tolI, what);
+        classify(ringP, (uint16_t)constrain((int)roundf(vf * cf * 10.0f), 0, 65535) == ringPowerDeci(m), uW, 100000, tolP, what);
+
+        char pbuf[24];
+        formatFixed(pbuf, sizeof(pbuf), uW, 6, 2);
+        classify(power, String(vf * cf, 2) == pbuf, uW, 10000, tolP, what);
+
+        // the whole line through the firmware parser
+        FzChannel &ch = channels[0];
+        uint32_t before = ch.csvLines;
+        parseFZ35(v + "V," + i + "A," + cap + "Ah,01:02:03");
+        classify(line, ch.csvLines == before + 1 && ch.meas.voltage_mV == mV && ch.meas.current_mA == mA &&
+                       ch.meas.capacity_mAh == mAh && ch.meas.power_mW == m.power_mW && ch.power == pbuf,
+                 0, 1, 0, what);
+    }
+
+    printf("%u samples (voltage 0-150 V, current 0-5 A, capacity 0-100 Ah, 0-3 decimals)\n", (unsigned)samples);
+    printf("%-22s %9s %7s %9s %7s\n", "", "checked", "ties", "near_tie", "errors");
+    report(parse);
+    report(ringV);
+    report(ringI);
+    report(ringP);
+    report(power);
+    report(line);
+
+    // per-line cost of the numeric work each path does for one CSV line
+    using clk = std::chrono::steady_clock;
+    volatile uint32_t sink = 0;
+    auto t0 = clk::now();
+    for (uint32_t n = 0; n < samples; ++n) {
+        float vf = vs[n].toFloat(), cf = is[n].toFloat();
+        String p = String(vf * cf, 2);
+        sink += (uint32_t)roundf(vf * 100.0f) + (uint32_t)roundf(cf * 100.0f) + (uint32_t)roundf(vf * cf * 10.0f) + p.length();
+    }
+    auto t1 = clk::now();
+    for (uint32_t n = 0; n < samples; ++n) {
+        Measurement m = {};
+        parseMilli(vs[n].c_str(), m.voltage_mV);
+        parseMilli(is[n].c_str(), m.current_mA);
+        m.power_mW = mulMilli(m.voltage_mV, m.current_mA);
+        char pbuf[16];
+        size_t len = formatFixed(pbuf, sizeof(pbuf), (int64_t)m.voltage_mV * m.current_mA, 6, 2);
+        sink += ringCenti(m.voltage_mV) + ringCenti(m.current_mA) + ringPowerDeci(m) + len;
+    }
+    auto t2 = clk::now();
+    double floatNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / samples;
+    double fixedNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / samples;
+    printf("host, per line: float path %.0f ns, integer path %.0f ns (%.1fx)\n", floatNs, fixedNs, floatNs / fixedNs);
+
+    uint32_t errors = parse.errors + ringV.errors + ringI.errors + ringP.errors + power.errors + line.errors;
+    printf("%s\n", errors ? "FAIL" : "PASS");
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,329 @@
+// fz35_predict: replay discharge curves through the end-of-test predictor
+// (FZ35_Predict.cpp) and report how far its predicted end is from the real one.
+//
+// Without -f, every built-in profile is discharged at its recommended current on a
+// chemistry-shaped voltage curve (see curve()) from its nominal voltage down to its
+// LVP. The cell delivers 90% of the rated capacity. Readings get +-5 mV of noise and
+// the device's 10 mV resolution, one per second, as loop() feeds them. The test ends
+// at the first of LVP, OAH or OHP, as on the device.
+//
+// With -f, a /history.bin downloaded from the device is replayed instead. Capacity is
+// integrated from the recorded current, the test is taken to end at its last record,
+// and -l gives the LVP in volts (OAH and OHP are not known from the file).
+//
+// At 50/80/90/95/98% of the test it compares the predicted end (elapsed + remaining)
+// with the real one, as a percentage of the test length. The same samples also go
+// through a double precision copy of the estimator. The firmware computes in float
+// because the ESP8266 has no FPU, and the copy shows what that costs. The run fails if
+// any error exceeds the bound of its chemistry and checkpoint (BOUNDS), if float is
+// more than PREDICT_FLOAT_TOLERANCE points worse than double, or on NaN. Before the
+// knee the estimate is the rated capacity, so the early bounds are the 11% a cell with
+// 90% of its rating gives; the late ones check that the fit tightens it.
+//
+//   fz35_predict [-r seed] [-v]
+//   fz35_predict -f history.bin -l lvp_V
+//
+// Exits non-zero on failure.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "FZ35_Predict.h"
+#include "FZ35_Profiles.h"
+
+#define PREDICT_FLOAT_TOLERANCE 0.5   // percentage points
+
+static const double CHECKPOINTS[] = { 0.50, 0.80, 0.90, 0.95, 0.98 };
+#define NCHECK (sizeof(CHECKPOINTS) / sizeof(CHECKPOINTS[0]))
+
+// largest accepted error (% of the test) per chemistry at each checkpoint
+static const struct { BatteryChemistry chem; double bound[NCHECK]; } BOUNDS[] = {
+    { BatteryChemistry::LiIon,    { 13, 13, 13, 11, 5 } },
+    { BatteryChemistry::LeadAcid, { 13, 13, 13, 7, 3 } },
+    { BatteryChemistry::CoinCell, { 13, 13, 13, 9, 5 } },
+    { BatteryChemistry::LiFePO4,  { 13, 13, 13, 13, 10 } },
+};
+
+// ---------- double precision reference ----------
+
+// the estimator as it was first written: the same update in double, hours since start
+struct RefPredictor {
+    PredictLimits limits;
+    uint32_t startMs, lastMs, samples;
+    int32_t startCap_mAh, lastCap_mAh;
+    double theta[3];
+    double P[3][3];
+};
+
+static void refReset(RefPredictor &p, const PredictLimits &limits, const Measurement &m, uint32_t nowMs) {
+    p = RefPredictor();
+    p.limits = limits;
+    p.startMs = p.lastMs = nowMs;
+    p.startCap_mAh = p.lastCap_mAh = m.capacity_mAh;
+    for (int i = 0; i < 3; ++i) p.P[i][i] = 1e4;
+}
+
+static void refAdd(RefPredictor &p, const Measurement &m, uint32_t nowMs) {
+    double memory = p.samples * 0.1;
+    if (memory < PREDICT_MIN_SAMPLES) memory = PREDICT_MIN_SAMPLES;
+    const double lambda = 1.0 - 1.0 / memory;
+    double t = (nowMs - p.startMs) / 3600000.0;
+    double v = m.voltage_mV / 1000.0;
+    const double x[3] = { 1.0, t, t * t };
+    if (p.samples == 0) p.theta[0] = v;
+    double px[3], denom = lambda, err = v;
+    for (int i = 0; i < 3; ++i) {
+        px[i] = 0;
+        for (int j = 0; j < 3; ++j) px[i] += p.P[i][j] * x[j];
+        denom += x[i] * px[i];
+        err -= x[i] * p.theta[i];
+    }
+    for (int i = 0; i < 3; ++i) p.theta[i] += px[i] / denom * err;
+    for (int i = 0; i < 3; ++i)
+        for (int j = i; j < 3; ++j) p.P[j][i] = p.P[i][j] = (p.P[i][j] - px[i] * px[j] / denom) / lambda;
+    p.lastMs = nowMs;
+    p.lastCap_mAh = m.capacity_mAh;
+    p.samples++;
+}
+
+// seconds to the earliest limit, -1 if none is predicted
+static double refRemaining(const RefPredictor &p) {
+    if (p.samples < PREDICT_MIN_SAMPLES) return -1;
+    double elapsed = (p.lastMs - p.startMs) / 1000.0, t = elapsed / 3600.0, best = 1e12;
+    double rate = elapsed > 0 ? (p.lastCap_mAh - p.startCap_mAh) / elapsed : 0;
+    if (p.limits.lvp_mV > 0) {
+        double a = p.theta[0], b = p.theta[1], c = p.theta[2], lvp = p.limits.lvp_mV / 1000.0;
+        double vNow = a + b * t + c * t * t, slope = b + 2 * c * t, h = -1;
+        if (vNow <= lvp) h = 0;
+        else if (c < 0) h = (-slope - sqrt(slope * slope - 4 * c * (vNow - lvp))) / (2 * c);
+        else if (slope < -1e-6) h = (lvp - vNow) / slope;
+        if (p.limits.rated_mAh > 0 && rate > 0) {
+            double r = fmax(0.0, (p.limits.rated_mAh - p.lastCap_mAh) / rate) / 3600;
+            if (h < 0 || r < h) h = r;
+        }
+        if (h >= 0 && h * 3600 < best) best = h * 3600;
+    }
+    if (p.limits.oah_mAh > 0 && rate > 0) best = fmin(best, fmax(0.0, (p.limits.oah_mAh - p.lastCap_mAh) / rate));
+    if (p.limits.ohp_s > 0) best = fmin(best, p.limits.ohp_s > elapsed ? p.limits.ohp_s - elapsed : 0);
+    return best < 1e12 ? best : -1;
+}
+
+// ---------- discharge curves ----------
+
+// voltage as a fraction of the way from LVP (0) to nominal (1) over depth of discharge
+// (delivered / actual capacity); the last point is past the end
+struct CurvePoint { float dod, frac; };
+
+static const CurvePoint LI_ION[] = { { 0, 1 }, { .05f, .83f }, { .2f, .71f }, { .5f, .58f }, { .8f, .46f },
+                                     { .9f, .38f }, { .95f, .25f }, { 1, 0 }, { 1.05f, -.4f } };
+static const CurvePoint LIFEPO4[] = { { 0, 1 }, { .03f, .75f }, { .1f, .69f }, { .5f, .65f }, { .85f, .61f },
+                                      { .92f, .52f }, { .97f, .35f }, { 1, 0 }, { 1.05f, -.4f } };
+static const CurvePoint LEAD_ACID[] = { { 0, 1 }, { .1f, .85f }, { .5f, .65f }, { .8f, .45f }, { .9f, .35f },
+                                        { 1, 0 }, { 1.05f, -.4f } };
+static const CurvePoint COIN[] = { { 0, 1 }, { .1f, .8f }, { .8f, .65f }, { .9f, .5f }, { .95f, .35f },
+                                   { 1, 0 }, { 1.05f, -.4f } };
+
+static float curve(BatteryChemistry chem, float dod) {
+    const CurvePoint *c = LI_ION;
+    size_t n = sizeof(LI_ION) / sizeof(LI_ION[0]);
+    if (chem == BatteryChemistry::LiFePO4) { c = LIFEPO4; n = sizeof(LIFEPO4) / sizeof(LIFEPO4[0]); }
+    if (chem == BatteryChemistry::LeadAcid) { c = LEAD_ACID; n = sizeof(LEAD_ACID) / sizeof(LEAD_ACID[0]); }
+    if (chem == BatteryChemistry::CoinCell) { c = COIN; n = sizeof(COIN) / sizeof(COIN[0]); }
+    for (size_t i = 1; i < n; ++i)
+        if (dod <= c[i].dod || i == n - 1)
+            return c[i - 1].frac + (c[i].frac - c[i - 1].frac) * (dod - c[i - 1].dod) / (c[i].dod - c[i - 1].dod);
+    return 0;
+}
+
+struct Sample {
+    uint32_t ms;
+    Measurement m;
+};
+
+static std::mt19937 rng;
+
+// one test of a built-in profile, up to the first limit the device would stop at
+static std::vector<Sample> discharge(const BatteryModule &b, const PredictLimits &limits) {
+    std::vector<Sample> s;
+    std::uniform_int_distribution<int> noise(-5, 5);
+    int32_t mA = toMilli(b.recommendedLoadA);
+    double actual_mAh = b.capacityAh * 900.0;
+    for (uint32_t sec = 0;; ++sec) {
+        double mAh = (double)mA * sec / 3600.0;
+        double v = b.lowVoltageProtect + (b.nominalVoltage - b.lowVoltageProtect) * curve(b.chem, (float)(mAh / actual_mAh));
+        int32_t mV = (int32_t)lround((v * 1000 + noise(rng)) / 10.0) * 10;
+        Measurement m = { mV, mA, (int32_t)mAh, mulMilli(mV, mA) };
+        s.push_back({ sec * 1000, m });
+        if (mV <= limits.lvp_mV || (limits.oah_mAh && m.capacity_mAh >= limits.oah_mAh) ||
+            (limits.ohp_s && sec >= limits.ohp_s))
+            return s;
+    }
+}
+
+// ---------- replay ----------
+
+// /history.bin layout (FZ35_Export.h, which needs the web server headers)
+#define HISTORY_MAGIC 0x53485A46UL
+struct HistoryHeader { uint32_t magic; uint16_t recordSize, reserved; };
+struct SampleRecord { uint32_t t_s; uint16_t v_cV, i_cA, p_dW, flags; };
+static_assert(sizeof(SampleRecord) == 12, "SampleRecord layout is part of the file format");
+
+struct Errors {
+    double fw[NCHECK], ref[NCHECK];   // |predicted - real end| in % of the test, -1 = none
+    bool nan;
+};
+
+static Errors replay(const std::vector<Sample> &s, const PredictLimits &limits, double &usPerSample) {
+    Errors e;
+    e.nan = false;
+    EndPredictor fw;
+    RefPredictor ref;
+    predictReset(fw, limits, s[0].m, s[0].ms);
+    refReset(ref, limits, s[0].m, s[0].ms);
+    double total = (s.back().ms - s[0].ms) / 1000.0;
+    size_t next = 0;
+    double fwUs = 0;
+    for (size_t i = 0; i < s.size() && next < NCHECK; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        predictAddSample(fw, s[i].m, s[i].ms);
+        fwUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+        refAdd(ref, s[i].m, s[i].ms);
+        double elapsed = (s[i].ms - s[0].ms) / 1000.0;
+        if (elapsed < CHECKPOINTS[next] * total) continue;
+        EndPrediction p = predictEstimate(fw);
+        double r = refRemaining(ref);
+        e.fw[next] = p.valid ? fabs(elapsed + p.remaining_s - total) * 100 / total : -1;
+        e.ref[next] = r >= 0 ? fabs(elapsed + r - total) * 100 / total : -1;
+        for (float th : fw.theta) if (isnan(th)) e.nan = true;
+        next++;
+    }
+    usPerSample = fwUs / s.size();
+    return e;
+}
+
+static void printRow(const char *name, const char *what, const double *err) {
+    printf("%-28s %-6s", name, what);
+    for (size_t c = 0; c < NCHECK; ++c) {
+        if (err[c] < 0) printf(" %6s", "-");
+        else printf(" %6.1f", err[c]);
+    }
+    printf("\n");
+}
+
+static void header() {
+    printf("%-28s %-6s", "error, % of test at", "");
+    for (double c : CHECKPOINTS) printf(" %5.0f%%", c * 100);
+    printf("\n");
+}
+
+static int replayHistory(const char *path, double lvp) {
+    FILE *f = fopen(path, "rb");
+    HistoryHeader hdr;
+    if (!f || fread(&hdr, sizeof(hdr), 1, f) != 1 || hdr.magic != HISTORY_MAGIC || hdr.recordSize != sizeof(SampleRecord)) {
+        fprintf(stderr, "%s: not a history file\n", path);
+        return 2;
+    }
+    std::vector<Sample> s;
+    SampleRecord r;
+    double mAh = 0;
+    while (fread(&r, sizeof(r), 1, f) == 1) {
+        if (!s.empty()) mAh += r.i_cA * 10.0 * (r.t_s - s.back().ms / 1000) / 3600.0;
+        Measurement m = { r.v_cV * 10, r.i_cA * 10, (int32_t)mAh, r.p_dW * 100 };
+        s.push_back({ r.t_s * 1000, m });
+    }
+    fclose(f);
+    if (s.size() < PREDICT_MIN_SAMPLES * 2) {
+        fprintf(stderr, "%s: %zu samples, too short\n", path, s.size());
+        return 2;
+    }
+    PredictLimits limits = { (int32_t)lround(lvp * 1000), 0, 0, 0 };
+    double us;
+    Errors e = replay(s, limits, us);
+    printf("%s: %zu samples, %.2f h, final %.3f V\n", path, s.size(), (s.back().ms - s[0].ms) / 3.6e6,
+           s.back().m.voltage_mV / 1000.0);
+    header();
+    printRow("history", "float", e.fw);
+    printRow("", "double", e.ref);
+    return e.nan ? 1 : 0;
+}
+
+static void usage() {
+    fprintf(stderr, "usage: fz35_predict [-r seed] [-v]\n       fz35_predict -f history.bin -l lvp_V\n");
+}
+
+int main(int argc, char **argv) {
+    uint32_t seed = 1;
+    bool verbose = false;
+    const char *file = nullptr;
+    double lvp = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "-r") && i + 1 < argc) seed = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-f") && i + 1 < argc) file = argv[++i];
+        else if (!strcmp(argv[i], "-l") && i + 1 < argc) lvp = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-v")) verbose = true;
+        else { usage(); return 2; }
+    }
+    if (file) {
+        if (lvp <= 0) { usage(); return 2; }
+        return replayHistory(file, lvp);
+    }
+    rng.seed(seed);
+
+    // worst error per chemistry
+    const size_t NCHEM = sizeof(BOUNDS) / sizeof(BOUNDS[0]);
+    double worstFw[NCHEM][NCHECK] = {}, worstRef[NCHEM][NCHECK] = {};
+    uint32_t failures = 0;
+    double usSum = 0, maxDiff = 0;
+    if (verbose) header();
+
+    for (size_t k = 0; k < batteryModulesCount; ++k) {
+        const BatteryModule &b = batteryModules[k];
+        PredictLimits limits = { toMilli(b.lowVoltageProtect), toMilli(b.overAhLimit),
+                                 predictParseHourLimit(b.overHourLimit), toMilli(b.capacityAh) };
+        std::vector<Sample> s = discharge(b, limits);
+        double us;
+        Errors e = replay(s, limits, us);
+        usSum += us;
+        size_t c = 0;
+        while (BOUNDS[c].chem != b.chem) c++;
+        for (size_t n = 0; n < NCHECK; ++n) {
+            worstFw[c][n] = fmax(worstFw[c][n], e.fw[n]);
+            worstRef[c][n] = fmax(worstRef[c][n], e.ref[n]);
+            maxDiff = fmax(maxDiff, fabs(e.fw[n] - e.ref[n]));
+            if (e.fw[n] > BOUNDS[c].bound[n]) {
+                fprintf(stderr, "%s: %.1f%% off at %.0f%% (bound %.0f%%)\n", b.name, e.fw[n],
+                        CHECKPOINTS[n] * 100, BOUNDS[c].bound[n]);
+                failures++;
+            }
+            if (e.fw[n] < 0 || e.fw[n] > e.ref[n] + PREDICT_FLOAT_TOLERANCE) {
+                fprintf(stderr, "%s: float %.1f%% vs double %.1f%% at %.0f%%\n", b.name, e.fw[n], e.ref[n],
+                        CHECKPOINTS[n] * 100);
+                failures++;
+            }
+        }
+        if (e.nan) {
+            fprintf(stderr, "%s: estimator diverged\n", b.name);
+            failures++;
+        }
+        if (verbose) {
+            printRow(b.name, "float", e.fw);
+            printRow("", "double", e.ref);
+        }
+    }
+
+    printf("%zu profiles, 1 sample/s, +-5 mV noise, 10 mV steps, 90%% of rated capacity\n", batteryModulesCount);
+    header();
+    for (size_t c = 0; c < NCHEM; ++c) {
+        printRow(chemistryToString(BOUNDS[c].chem), "float", worstFw[c]);
+        printRow("", "double", worstRef[c]);
+        printRow("", "bound", BOUNDS[c].bound);
+    }
+    printf("float vs double: largest difference %.2f points\n", maxDiff);
+    printf("host: %.2f us per predictAddSample()\n", usSum / batteryModulesCount);
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
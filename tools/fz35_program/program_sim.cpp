@@ -0,0 +1,442 @@
+// fz35_program: run random discharge programs through the firmware's sequencer
+// (FZ35_Program.cpp) on a virtual clock and check their load changes on the wire.
+//
+// A loop() model calls programTick() at the top of every pass like the firmware, then
+// "other work" (HTTP handlers, telemetry, WiFi; mostly short, sometimes up to
+// OTHER_MAX_US) and, once a second, the blocking read of load 0 gated exactly like
+// FZ35_Lab.ino: skipped while it would end within PROGRAM_READ_MARGIN_MS of the next
+// load change (estimated from the EMA of past reads), forced after
+// PROGRAM_MAX_READ_DEFER_MS. Reads take 220-320 ms, a few of them (retries, timeouts)
+// up to 1.2 s. Constant-power steps get a sagging voltage from every read. Every
+// print() on the link is one frame, shifted out at 9600 baud (blocking).
+//
+// Deadlines are computed here from the parsed steps, independently of the sequencer,
+// and matched against the "<A>A" frames in order. It checks that
+//   - no change goes out before its deadline, and none is missing or out of order
+//     (so deadlines do not drift); a pulse edge whose successor is already due when
+//     the sequencer gets to it is skipped, not replayed,
+//   - a change not held up by a read is late by at most LATE_BOUND_US,
+//   - a change held up by a read goes out within LATE_BOUND_US of the read's end, and
+//     the read either was forced by the deferral cap or overran its estimate
+//     (a read that ran as estimated must not cover a deadline),
+//   - no read starts more than PROGRAM_MAX_READ_DEFER_MS + LATE_BOUND_US after the
+//     previous one ended,
+//   - "off" ends the program at its total duration, /program_status agrees on the
+//     transition, skipped edge and deferred read counts, and every program completes.
+//
+//   fz35_program [-n programs] [-r seed] [-s]
+//
+// Exits non-zero on any violation.
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include "FZ35_Comm.h"
+#include "FZ35_Program.h"
+
+#define CPU_TICK_US     2        // cost charged per clock read
+#define LOOP_PASS_US    200      // loop() return + SDK work between passes
+#define OTHER_MAX_US    25000    // longest non-read work in one pass
+#define BYTE_US         1042     // 10 bits at 9600 baud
+#define READ_INTERVAL_MS 1000
+// one pass of other work plus a tick's worth of frames (pulse edge, step end, "off")
+#define LATE_BOUND_US   (OTHER_MAX_US + 2 * LOOP_PASS_US + 3 * 8 * BYTE_US)
+
+// ---------- virtual clock ----------
+
+static uint64_t nowUs = 0;
+static std::mt19937 rng;
+
+uint64_t micros64() { return nowUs += CPU_TICK_US; }
+void delay(unsigned long ms) { nowUs += (uint64_t)ms * 1000; }
+
+// ---------- firmware pieces outside the tested path ----------
+
+HostSerial Serial;
+SoftwareSerial fzSerial(RX_PIN, TX_PIN);
+FzChannel channels[FZ_CHANNELS];
+FzChannel *fzActive = &channels[0];
+Measurement &meas = channels[0].meas;
+String LOAD_ENABLE_CMD = "on";
+String LOAD_DISABLE_CMD = "off";
+
+bool captureOn = false;
+uint8_t captureDepth = 0;
+void captureRxByte(uint8_t) {}
+void captureTx(const String &, bool) {}
+void captureCall(uint8_t, uint16_t, const String &) {}
+
+bool traceOn = false;
+uint32_t traceWritten = 0;
+void traceRecord(const char *, char, uint8_t, uint16_t) {}
+void traceDropLast() {}
+
+bool estopPoll() { return false; }
+bool estopDelay(unsigned long ms) { delay(ms); return false; }
+
+// ---------- virtual load: frames on the wire ----------
+
+struct Frame {
+    uint64_t startUs, endUs;
+    std::string text;
+};
+
+static std::vector<Frame> frames;
+
+int SoftwareSerial::available() { return 0; }
+int SoftwareSerial::read() { return -1; }
+
+void SoftwareSerial::print(const String &s) {
+    uint64_t start = nowUs;
+    nowUs += (uint64_t)s.length() * BYTE_US;   // SoftwareSerial TX is blocking
+    std::string cmd(s.c_str());
+    while (!cmd.empty() && (cmd.back() == '\n' || cmd.back() == '\r')) cmd.pop_back();
+    frames.push_back({ start, nowUs, cmd });
+}
+
+void SoftwareSerial::println(const String &s) { print(s + "\r\n"); }
+
+// ---------- random programs ----------
+
+static uint32_t uniform(uint32_t lo, uint32_t hi) {
+    return std::uniform_int_distribution<uint32_t>(lo, hi)(rng);
+}
+
+static std::string seconds(uint32_t ms) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%u.%03u", (unsigned)(ms / 1000), (unsigned)(ms % 1000));
+    return buf;
+}
+
+static std::string randomProgram() {
+    std::string text;
+    int steps = (int)uniform(1, 8);
+    for (int i = 0; i < steps; ++i) {
+        if (i) text += ";";
+        uint32_t kind = uniform(0, 9);
+        if (kind < 4) {
+            text += "c," + seconds(uniform(2, 60) * 50) + "," + seconds(uniform(300, 20000));
+        } else if (kind < 8) {
+            uint32_t period = uniform(100, 5000), high = uniform(1, period - 1);
+            text += "p," + seconds(uniform(20, 60) * 50) + "," + seconds(uniform(0, 19) * 50) + "," +
+                    seconds(period) + "," + seconds(high) + "," + seconds(uniform(1000, 30000));
+        } else {
+            text += "w," + seconds(uniform(1000, 10000)) + "," + seconds(uniform(1000, 20000));
+        }
+    }
+    return text;
+}
+
+struct Event {
+    uint64_t deadlineUs;
+    int32_t mA;       // constant-power start: power_mW, the current follows from the voltage
+    bool power;       // constant-power step (corrections may follow)
+    bool edge;        // pulse edge after the step's start (skipped once overtaken)
+};
+
+// the schedule the sequencer must follow, from the steps alone
+static std::vector<Event> schedule(const ProgramStep *steps, int count, uint64_t startUs, uint64_t &endUs) {
+    std::vector<Event> ev;
+    uint64_t t = startUs;
+    for (int i = 0; i < count; ++i) {
+        const ProgramStep &st = steps[i];
+        uint64_t end = t + (uint64_t)st.duration_ms * 1000;
+        switch (st.type) {
+        case ProgramStepType::Constant:
+            ev.push_back({ t, st.currentA_mA, false, false });
+            break;
+        case ProgramStepType::Pulse:
+            for (uint64_t cycle = t; cycle < end; cycle += (uint64_t)st.period_ms * 1000) {
+                ev.push_back({ cycle, st.currentA_mA, false, cycle != t });
+                uint64_t edge = cycle + (uint64_t)st.high_ms * 1000;
+                if (edge < end) ev.push_back({ edge, st.currentB_mA, false, true });
+            }
+            break;
+        case ProgramStepType::ConstantPower:
+            ev.push_back({ t, st.power_mW, true, false });
+            break;
+        }
+        t = end;
+    }
+    endUs = t;
+    return ev;
+}
+
+// ---------- loop() model ----------
+
+struct Read {
+    uint64_t startUs, endUs;
+    uint32_t estimateMs;
+    bool forced;
+};
+
+static std::vector<Read> reads;
+static unsigned long lastRead = 0;
+static unsigned long readDurationMs = 300;
+static uint32_t deferredReads = 0;
+static unsigned long deferredAfter = 0;
+static bool deferredThisProgram = false;
+static std::vector<uint64_t> ticks;   // clock value programTick() decides on, per pass
+static uint64_t programStartUs = 0, programEndUs = 0;
+static std::vector<std::pair<uint64_t, int32_t>> volts;   // meas.voltage_mV from then on
+
+static int32_t simVoltage() {
+    uint64_t span = programEndUs > programStartUs ? programEndUs - programStartUs : 1;
+    uint64_t done = nowUs > programStartUs ? std::min(nowUs - programStartUs, span) : 0;
+    return 4200 - (int32_t)(1000 * done / span) + (int32_t)uniform(0, 40) - 20;
+}
+
+static void loopPass() {
+    if (programActive()) ticks.push_back(nowUs + CPU_TICK_US);   // its first clock read
+    programTick();
+
+    uint32_t other = uniform(0, 9) < 8 ? uniform(0, 2000) : uniform(0, OTHER_MAX_US);
+    nowUs += other;
+
+    if (millis() - lastRead > READ_INTERVAL_MS) {
+        bool tight = programMsUntilNextEvent() < readDurationMs + PROGRAM_READ_MARGIN_MS;
+        if (tight && millis() - lastRead < PROGRAM_MAX_READ_DEFER_MS) {
+            programNoteDeferredRead(lastRead);
+            if (!deferredThisProgram || lastRead != deferredAfter) deferredReads++;
+            deferredThisProgram = true;
+            deferredAfter = lastRead;
+        } else {
+            Read r = { nowUs, 0, (uint32_t)readDurationMs, tight };
+            unsigned long readStart = millis();
+            fzSerial.print("read");
+            uint32_t ms = uniform(0, 99) < 3 ? uniform(400, 1200) : uniform(220, 320);
+            nowUs = r.startUs + (uint64_t)ms * 1000;
+            r.endUs = nowUs;
+            reads.push_back(r);
+            readDurationMs = (readDurationMs * 3 + (millis() - readStart)) / 4;
+
+            meas.voltage_mV = simVoltage();
+            volts.emplace_back(nowUs, meas.voltage_mV);
+            programOnSample(meas);
+            lastRead = millis();
+        }
+    }
+    nowUs += LOOP_PASS_US;
+}
+
+// ---------- checks ----------
+
+struct Late {
+    const char *name;
+    std::vector<uint32_t> us;
+};
+
+static uint32_t violations = 0;
+
+static void violation(int program, const char *what, uint64_t atUs) {
+    if (violations < 20)
+        fprintf(stderr, "program %d: %s at %.3f s\n", program, what, atUs / 1e6);
+    violations++;
+}
+
+static int32_t frameMilliAmps(const std::string &text) {
+    int32_t mA = 0;
+    if (text.size() < 2 || text.back() != 'A') return -1;
+    return parseFixed(text.substr(0, text.size() - 1).c_str(), 3, mA) ? mA : -1;
+}
+
+// the clock value of the first programTick() at or after deadlineUs
+static uint64_t tickAt(uint64_t deadlineUs) {
+    auto it = std::lower_bound(ticks.begin(), ticks.end(), deadlineUs);
+    return it == ticks.end() ? UINT64_MAX : *it;
+}
+
+// the current a constant-power step starts with when begun at tickUs
+static int32_t powerCurrent(int32_t power_mW, uint64_t tickUs) {
+    auto it = std::upper_bound(volts.begin(), volts.end(), std::make_pair(tickUs, INT32_MAX));
+    int32_t mV = it == volts.begin() ? 4200 : std::prev(it)->second;
+    return fixedRoundDiv((int64_t)power_mW * 1000 / mV, 10) * 10;
+}
+
+// the read that held up a change due at deadlineUs and sent at sentUs, if any
+static const Read *blockingRead(uint64_t deadlineUs, uint64_t sentUs) {
+    for (auto it = reads.rbegin(); it != reads.rend(); ++it) {
+        if (it->endUs <= deadlineUs) break;
+        if (it->startUs < sentUs) return &*it;
+    }
+    return nullptr;
+}
+
+static long jsonNumber(const String &json, const char *key) {
+    int at = json.indexOf(String("\"") + key + "\":");
+    return at < 0 ? -1 : atol(json.c_str() + at + strlen(key) + 3);
+}
+
+static uint32_t percentile(std::vector<uint32_t> v, double p) {
+    if (v.empty()) return 0;
+    std::sort(v.begin(), v.end());
+    return v[std::min(v.size() - 1, (size_t)(p * v.size()))];
+}
+
+static void usage() {
+    fprintf(stderr, "usage: fz35_program [-n programs] [-r seed] [-s]\n");
+}
+
+int main(int argc, char **argv) {
+    uint32_t programs = 2000, seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) programs = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-r") && i + 1 < argc) seed = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-s")) Serial.enabled = true;
+        else { usage(); return 2; }
+    }
+    if (!programs) { usage(); return 2; }
+    rng.seed(seed);
+    channels[0].port = &fzSerial;
+    meas.voltage_mV = 4200;
+
+    Late idle = { "not held up" }, overran = { "behind read, overran" }, forced = { "behind forced read" };
+    uint32_t events = 0, collapsed = 0, skippedEdges = 0, corrections = 0, readCount = 0, forcedReads = 0;
+    uint32_t maxGapMs = 0;
+    uint64_t simUs = 0;
+
+    for (uint32_t n = 0; n < programs; ++n) {
+        int p = (int)n + 1;
+        // idle passes between programs (reads continue)
+        for (uint64_t until = nowUs + uniform(500, 3000) * 1000ULL; nowUs < until;) loopPass();
+
+        std::string text = randomProgram();
+        ProgramStep steps[MAX_PROGRAM_STEPS];
+        String err;
+        int count = parseProgram(String(text.c_str()), steps, MAX_PROGRAM_STEPS, err);
+        if (count < 0) {
+            fprintf(stderr, "program %d rejected: %s (%s)\n", p, err.c_str(), text.c_str());
+            return 2;
+        }
+
+        // a /program_start request runs between passes; beginStep() reads the clock first
+        size_t firstFrame = frames.size(), firstRead = reads.size();
+        uint32_t deferredBefore = deferredReads;
+        deferredThisProgram = false;
+        ticks.clear();
+        programStartUs = nowUs + CPU_TICK_US;
+        std::vector<Event> ev = schedule(steps, count, programStartUs, programEndUs);
+        startProgram(steps, count);
+        while (programActive()) loopPass();
+        String status = programStatusJson();
+        simUs += programEndUs - programStartUs;
+
+        // lateness of a frame for a deadline; the bound counts from when the sequencer
+        // could run again: after a read covering the deadline and after the frames
+        // queued before this one in the same tick
+        auto checkLate = [&](uint64_t deadlineUs, const Frame *f, const char *what) {
+            if (f->startUs < deadlineUs) {
+                violation(p, (std::string(what) + " before its deadline").c_str(), f->startUs);
+                return;
+            }
+            uint32_t late = (uint32_t)(f->endUs - deadlineUs);
+            uint64_t readyUs = deadlineUs;
+            if (f > frames.data()) readyUs = std::max(readyUs, f[-1].endUs);
+            const Read *r = blockingRead(deadlineUs, f->startUs);
+            if (r) {
+                readyUs = std::max(readyUs, r->endUs);
+                if (!r->forced && (r->endUs - r->startUs) / 1000 <= r->estimateMs + PROGRAM_READ_MARGIN_MS)
+                    violation(p, "read ran as estimated but covered a deadline", r->startUs);
+            }
+            (r ? (r->forced ? forced : overran) : idle).us.push_back(late);
+            if (f->endUs - readyUs > LATE_BOUND_US) violation(p, (std::string("late ") + what).c_str(), deadlineUs);
+        };
+
+        // match the schedule against the frames of this program
+        size_t fi = firstFrame;
+        int32_t lastSent = -1;
+        uint32_t skipped = 0;
+        auto nextLoadFrame = [&](size_t &at) -> const Frame * {
+            while (at < frames.size()) {
+                const Frame &f = frames[at++];
+                if (f.text != "read" && f.text != "on") return &f;
+            }
+            return nullptr;
+        };
+        // constant-power corrections sent before the sequencer got to tickUs
+        bool inPower = false;
+        auto skipCorrections = [&](uint64_t tickUs) {
+            for (size_t peek = fi; inPower;) {
+                const Frame *f = nextLoadFrame(peek);
+                if (!f || f->startUs >= tickUs || frameMilliAmps(f->text) < 0) return;
+                corrections++;
+                lastSent = frameMilliAmps(f->text);
+                fi = peek;
+            }
+        };
+        for (size_t i = 0; i < ev.size(); ++i) {
+            const Event &e = ev[i];
+            uint64_t tickUs = tickAt(e.deadlineUs);
+            // a pulse edge whose successor is already due when the sequencer gets to it
+            if (e.edge && (i + 1 < ev.size() ? ev[i + 1].deadlineUs : programEndUs) <= tickUs) {
+                skipped++;
+                continue;
+            }
+            skipCorrections(tickUs);
+            int32_t expect = e.power ? powerCurrent(e.mA, tickUs) : e.mA;
+            if (expect == lastSent) {
+                collapsed++;   // same current: the sequencer sends nothing
+                inPower = e.power;
+                continue;
+            }
+            const Frame *f = nextLoadFrame(fi);
+            int32_t mA = f ? frameMilliAmps(f->text) : -1;
+            if (mA != expect) {
+                violation(p, f ? ("unexpected frame \"" + f->text + "\"").c_str() : "load change missing",
+                          f ? f->startUs : e.deadlineUs);
+                break;
+            }
+            lastSent = frameMilliAmps(f->text);
+            inPower = e.power;
+            events++;
+            checkLate(e.deadlineUs, f, "load change");
+        }
+        skippedEdges += skipped;
+
+        // the end: corrections of a last constant-power step may precede "off"
+        skipCorrections(UINT64_MAX);
+        const Frame *f = nextLoadFrame(fi);
+        if (!f || f->text != "off") violation(p, "program does not end with \"off\"", programEndUs);
+        else checkLate(programEndUs, f, "\"off\"");
+        if (nextLoadFrame(fi)) violation(p, "frames after \"off\"", programEndUs);
+        if (std::count_if(frames.begin() + firstFrame, frames.end(), [](const Frame &x) { return x.text == "on"; }) != 1)
+            violation(p, "load not enabled exactly once", programStartUs);
+
+        // the sequencer's own account
+        if (status.indexOf("\"last_stop\":\"completed\"") < 0) violation(p, "did not complete", nowUs);
+        if (jsonNumber(status, "transitions") != (long)(ev.size() - skipped))
+            violation(p, "/program_status transitions differ from the schedule", nowUs);
+        if (jsonNumber(status, "edges_skipped") != (long)skipped)
+            violation(p, "/program_status edges_skipped differs", nowUs);
+        if (jsonNumber(status, "reads_deferred") != (long)(deferredReads - deferredBefore))
+            violation(p, "/program_status reads_deferred differs", nowUs);
+
+        // read gaps while the program ran
+        for (size_t i = firstRead; i < reads.size(); ++i) {
+            if (reads[i].forced) forcedReads++;
+            readCount++;
+            if (i == 0) continue;
+            uint32_t gapMs = (uint32_t)((reads[i].startUs - reads[i - 1].endUs) / 1000);
+            if (gapMs > maxGapMs) maxGapMs = gapMs;
+            if ((uint64_t)gapMs * 1000 > PROGRAM_MAX_READ_DEFER_MS * 1000ULL + LATE_BOUND_US)
+                violation(p, "read deferred past the cap", reads[i].startUs);
+        }
+    }
+
+    printf("%u programs, %.1f h of steps, %u load changes checked (%u unchanged currents not sent, "
+           "%u overtaken pulse edges skipped, %u constant-power corrections)\n",
+           (unsigned)programs, simUs / 3.6e9, (unsigned)events, (unsigned)collapsed, (unsigned)skippedEdges,
+           (unsigned)corrections);
+    printf("reads while running: %u, %u deferred, %u forced after %u ms, longest gap %u ms\n",
+           (unsigned)readCount, (unsigned)deferredReads, (unsigned)forcedReads,
+           (unsigned)PROGRAM_MAX_READ_DEFER_MS, (unsigned)maxGapMs);
+    printf("lateness (us)          %8s %8s %8s %8s\n", "changes", "p50", "p99", "max");
+    for (const Late *l : { &idle, &overran, &forced })
+        printf("%-22s %8u %8u %8u %8u\n", l->name, (unsigned)l->us.size(), (unsigned)percentile(l->us, 0.5),
+               (unsigned)percentile(l->us, 0.99), (unsigned)percentile(l->us, 1.0));
+    printf("bound (not held up / after a read's end): %u us\n", (unsigned)LATE_BOUND_US);
+    if (violations) printf("FAIL (%u violations)\n", (unsigned)violations);
+    else printf("PASS (0 violations)\n");
+    return violations ? 1 : 0;
+}
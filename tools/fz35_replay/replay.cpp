@@ -0,0 +1,340 @@
+// fz35_replay: feed a serial capture (/capture.bin, see FZ35_Capture.h) back through
+// the firmware's FZ35_Comm.h and parseFZ35() on the host.
+//
+// Every CALL record is replayed by calling the same Comm function with the same
+// arguments. The fake device link releases each recorded RX chunk at its original
+// offset from the TX it answered, on a virtual clock, so timeouts, idle gaps and
+// partial frames behave as they did on the device. Whatever the replayed code sends
+// is compared with the recorded TX bytes; any difference is a divergence.
+//
+//   fz35_replay [-v] [-s] [-n N] capture.bin
+//     -v  list every call      -s  show the firmware's Serial log
+//     -n  replay N times (host timing benchmark)
+// Exit status: 0 = replay matched the capture, 1 = divergence, 2 = bad input.
+
+#include <Arduino.h>
+#include <SoftwareSerial.h>
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+#include "FZ35_Comm.h"
+#include "FZ35_Capture.h"
+
+// ---------- firmware globals the Comm / parse code expects ----------
+
+HostSerial Serial;
+SoftwareSerial fzSerial(RX_PIN, TX_PIN);
+// one channel (FZ35_Channel.h) on fzSerial; its values under the firmware's names
+FzChannel channels[FZ_CHANNELS];
+FzChannel *fzActive = &channels[0];
+Measurement &meas = channels[0].meas;
+String &voltage = channels[0].voltage, &current = channels[0].current, &capacityAh = channels[0].capacityAh;
+String &OVP = channels[0].OVP, &OCP = channels[0].OCP, &OPP = channels[0].OPP;
+String &LVP = channels[0].LVP, &OAH = channels[0].OAH, &OHP = channels[0].OHP;
+String LOAD_ENABLE_CMD = "on";
+String LOAD_DISABLE_CMD = "off";
+
+bool captureOn = false;    // never set here: the replay is not recorded again
+uint8_t captureDepth = 0;
+void captureRxByte(uint8_t) {}
+void captureTx(const String &, bool) {}
+void captureCall(uint8_t, uint16_t, const String &) {}
+
+bool traceOn = false;      // scopes in Comm / parse stay disabled
+uint32_t traceWritten = 0;
+void traceRecord(const char *, char, uint8_t, uint16_t) {}
+void traceDropLast() {}
+
+// ---------- virtual clock ----------
+
+#define CPU_TICK_US 2   // cost charged per clock read, so busy-wait loops advance
+
+static uint64_t nowUs = 0;
+uint64_t micros64() { return nowUs += CPU_TICK_US; }
+void delay(unsigned long ms) { nowUs += (uint64_t)ms * 1000; }
+
+// no emergency stops here
+bool estopPoll() { return false; }
+bool estopDelay(unsigned long ms) { delay(ms); return false; }
+
+// ---------- trace ----------
+
+struct Event {
+    uint64_t t;       // us since capture start
+    uint8_t type;     // CAPTURE_RX / CAPTURE_TX / CAPTURE_CALL
+    std::string data;
+};
+
+static bool loadTrace(const char *path, std::vector<Event> &events, uint32_t &startEpoch) {
+    FILE *f = fopen(path, "rb");
+    if (!f) { perror(path); return false; }
+    std::vector<uint8_t> raw;
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) raw.insert(raw.end(), chunk, chunk + n);
+    fclose(f);
+
+    CaptureHeader hdr;
+    if (raw.size() < sizeof(hdr)) { fprintf(stderr, "%s: too short\n", path); return false; }
+    memcpy(&hdr, raw.data(), sizeof(hdr));
+    if (hdr.magic != CAPTURE_MAGIC || hdr.version != CAPTURE_VERSION) {
+        fprintf(stderr, "%s: not a capture file (magic %08x, version %u)\n", path, hdr.magic, hdr.version);
+        return false;
+    }
+    startEpoch = hdr.startEpoch;
+
+    size_t p = sizeof(hdr);
+    uint64_t t = 0;
+    while (p < raw.size()) {
+        uint8_t tag = raw[p++];
+        uint64_t delta = 0;
+        int shift = 0;
+        while (true) {
+            if (p >= raw.size() || shift > 63) { fprintf(stderr, "%s: truncated record\n", path); return true; }
+            uint8_t b = raw[p++];
+            delta |= (uint64_t)(b & 0x7F) << shift;
+            shift += 7;
+            if (!(b & 0x80)) break;
+        }
+        size_t len = tag & CAPTURE_LEN_MAX;
+        if (p + len > raw.size()) { fprintf(stderr, "%s: truncated record\n", path); return true; }
+        t += delta;
+        events.push_back({ t, (uint8_t)(tag & CAPTURE_TYPE), std::string((const char*)&raw[p], len) });
+        p += len;
+    }
+    return true;
+}
+
+// ---------- fake device link ----------
+
+struct Player {
+    const std::vector<Event> *events = nullptr;
+    size_t cur = 0;               // next unconsumed event
+    size_t txOff = 0;             // bytes of events[cur] already matched (TX only)
+    uint64_t anchorReplay = 0;    // replay clock at the last TX / call ...
+    uint64_t anchorTrace = 0;     // ... and the trace time it corresponds to
+    std::deque<std::pair<uint64_t, char>> rx;
+
+    // divergence counters
+    uint32_t txMismatch = 0;      // sent a different byte than recorded
+    uint32_t txExtra = 0;         // sent bytes the recorded call did not send
+    uint32_t txMissing = 0;       // recorded TX records the replay never sent
+
+    void reset(const std::vector<Event> &ev) {
+        *this = Player();
+        events = &ev;
+        if (!ev.empty()) anchorTrace = ev.front().t;
+    }
+
+    uint64_t replayTime(uint64_t traceT) const {
+        return traceT >= anchorTrace ? anchorReplay + (traceT - anchorTrace) : anchorReplay;
+    }
+
+    // queue the RX records at cur (the device's answer to what was just sent)
+    void scheduleRx() {
+        while (cur < events->size() && (*events)[cur].type == CAPTURE_RX) {
+            const Event &e = (*events)[cur++];
+            for (char c : e.data) rx.emplace_back(replayTime(e.t), c);
+        }
+    }
+
+    // position on the CALL record at index i, keeping the original idle time before it
+    void beginCall(size_t i) {
+        for (; cur < i; ++cur) {
+            const Event &e = (*events)[cur];
+            if (e.type == CAPTURE_TX) txMissing++;
+            else if (e.type == CAPTURE_RX) for (char c : e.data) rx.emplace_back(replayTime(e.t), c);
+        }
+        uint64_t at = replayTime((*events)[i].t);
+        if (at > nowUs) nowUs = at;
+        anchorReplay = nowUs;
+        anchorTrace = (*events)[i].t;
+        cur = i + 1;
+        txOff = 0;
+    }
+
+    void write(const char *p, size_t n) {
+        for (size_t k = 0; k < n; ++k) {
+            if (txOff == 0) {
+                scheduleRx();
+                if (cur >= events->size() || (*events)[cur].type != CAPTURE_TX) { txExtra++; continue; }
+                anchorReplay = nowUs;
+                anchorTrace = (*events)[cur].t;
+            }
+            const Event &e = (*events)[cur];
+            if (e.data[txOff] != p[k]) txMismatch++;
+            if (++txOff == e.data.size()) {
+                cur++;
+                txOff = 0;
+                scheduleRx();
+            }
+        }
+    }
+
+    int available() const {
+        int n = 0;
+        for (auto &b : rx) {
+            if (b.first > nowUs) break;
+            n++;
+        }
+        return n;
+    }
+
+    int read() {
+        if (rx.empty() || rx.front().first > nowUs) return -1;
+        char c = rx.front().second;
+        rx.pop_front();
+        return (uint8_t)c;
+    }
+
+    uint32_t divergences() const { return txMismatch + txExtra + txMissing; }
+};
+
+static Player player;
+
+int SoftwareSerial::available() { return player.available(); }
+int SoftwareSerial::read() { return player.read(); }
+void SoftwareSerial::print(const String &s) { player.write(s.c_str(), s.length()); }
+void SoftwareSerial::println(const String &s) { print(s + "\r\n"); }
+
+// ---------- replay ----------
+
+static const char *opName(uint8_t op) {
+    switch (op) {
+        case CAPTURE_OP_RAW: return "raw";
+        case CAPTURE_OP_CONFIRM: return "confirm";
+        case CAPTURE_OP_SEND: return "send";
+        case CAPTURE_OP_READ: return "read";
+        case CAPTURE_OP_READ_TIMED: return "read_timed";
+        default: return "?";
+    }
+}
+
+#define OP_COUNT (CAPTURE_OP_READ_TIMED + 1)
+
+struct OpStats {
+    uint32_t calls = 0, ok = 0, diverged = 0;
+    uint64_t virtualUs = 0, maxVirtualUs = 0;
+    uint64_t hostNs = 0;
+};
+
+struct ReplayResult {
+    OpStats ops[OP_COUNT];
+    uint32_t calls = 0, divergences = 0;
+    uint64_t virtualUs = 0;
+};
+
+static ReplayResult replayOnce(const std::vector<Event> &events, bool verbose) {
+    ReplayResult res;
+    player.reset(events);
+    nowUs = 0;
+    meas = { 0, 0, 0, 0 };
+
+    for (size_t i = 0; i < events.size(); ++i) {
+        const Event &e = events[i];
+        if (e.type != CAPTURE_CALL || i < player.cur || e.data.size() < 3) continue;
+        uint8_t op = (uint8_t)e.data[0];
+        if (op == 0 || op >= OP_COUNT) continue;
+        unsigned long timeout = (uint8_t)e.data[1] | ((uint8_t)e.data[2] << 8);
+        String arg(e.data.substr(3));
+
+        player.beginCall(i);
+        uint32_t divBefore = player.divergences();
+        uint64_t v0 = nowUs;
+        auto h0 = std::chrono::steady_clock::now();
+
+        bool ok = true;
+        switch (op) {
+            case CAPTURE_OP_RAW: sendCommandNoNL(arg); break;
+            case CAPTURE_OP_CONFIRM: ok = sendCommandWithConfirm(arg, timeout); break;
+            case CAPTURE_OP_SEND: ok = sendCommand(arg, timeout).length() > 0; break;
+            case CAPTURE_OP_READ: {
+                Measurement before = meas;
+                readFZ35();
+                ok = memcmp(&before, &meas, sizeof(meas)) != 0 || meas.voltage_mV != 0;
+                break;
+            }
+            case CAPTURE_OP_READ_TIMED: { TimedRead t; ok = readMeasurementTimed(t, timeout); break; }
+        }
+
+        auto h1 = std::chrono::steady_clock::now();
+        uint64_t dv = nowUs - v0;
+        bool diverged = player.divergences() != divBefore;
+        OpStats &s = res.ops[op];
+        s.calls++;
+        s.ok += ok;
+        s.diverged += diverged;
+        s.virtualUs += dv;
+        if (dv > s.maxVirtualUs) s.maxVirtualUs = dv;
+        s.hostNs += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(h1 - h0).count();
+        res.calls++;
+
+        if (verbose) {
+            printf("%10.3f s  %-10s %-20s %6.1f ms  %s%s", e.t / 1e6, opName(op), arg.c_str(), dv / 1e3,
+                   ok ? "ok" : "FAIL", diverged ? " DIVERGED" : "");
+            if (op == CAPTURE_OP_READ || op == CAPTURE_OP_READ_TIMED) {
+                printf("  V=%s I=%s Ah=%s", voltage.c_str(), current.c_str(), capacityAh.c_str());
+            }
+            printf("\n");
+        }
+    }
+    player.beginCall(events.size() - 1); // count TX after the last call as missing
+    res.divergences = player.divergences();
+    res.virtualUs = nowUs;
+    return res;
+}
+
+static void usage() {
+    fprintf(stderr, "usage: fz35_replay [-v] [-s] [-n N] capture.bin\n");
+}
+
+int main(int argc, char **argv) {
+    bool verbose = false;
+    int repeat = 1;
+    const char *path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "-v")) verbose = true;
+        else if (!strcmp(argv[i], "-s")) Serial.enabled = true;
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc) repeat = atoi(argv[++i]);
+        else if (argv[i][0] != '-' && !path) path = argv[i];
+        else { usage(); return 2; }
+    }
+    if (!path || repeat < 1) { usage(); return 2; }
+    channels[0].port = &fzSerial;
+
+    std::vector<Event> events;
+    uint32_t startEpoch = 0;
+    if (!loadTrace(path, events, startEpoch)) return 2;
+    if (events.empty()) { fprintf(stderr, "%s: no records\n", path); return 2; }
+
+    size_t rxBytes = 0, txBytes = 0;
+    for (auto &e : events) {
+        if (e.type == CAPTURE_RX) rxBytes += e.data.size();
+        if (e.type == CAPTURE_TX) txBytes += e.data.size();
+    }
+    printf("%s: %zu records, %zu TX / %zu RX bytes, %.1f s captured (start epoch %u)\n",
+           path, events.size(), txBytes, rxBytes, events.back().t / 1e6, startEpoch);
+
+    ReplayResult res = replayOnce(events, verbose);
+    for (int r = 1; r < repeat; ++r) {
+        ReplayResult again = replayOnce(events, false);
+        for (int op = 0; op < OP_COUNT; ++op) res.ops[op].hostNs += again.ops[op].hostNs;
+        if (again.divergences != res.divergences || again.virtualUs != res.virtualUs) {
+            fprintf(stderr, "replay %d is not deterministic\n", r + 1);
+        }
+    }
+
+    printf("\n%-10s %7s %7s %9s %11s %11s %12s\n", "op", "calls", "ok", "diverged", "mean ms", "max ms", "host us/call");
+    for (int op = 1; op < OP_COUNT; ++op) {
+        const OpStats &s = res.ops[op];
+        if (!s.calls) continue;
+        printf("%-10s %7u %7u %9u %11.1f %11.1f %12.2f\n", opName(op), s.calls, s.ok, s.diverged,
+               s.virtualUs / 1e3 / s.calls, s.maxVirtualUs / 1e3, s.hostNs / 1e3 / s.calls / repeat);
+    }
+    printf("\n%u calls, replayed in %.1f s virtual; divergences: %u mismatched, %u extra, %u missing TX bytes/records\n",
+           res.calls, res.virtualUs / 1e6, player.txMismatch, player.txExtra, player.txMissing);
+    printf("last: OVP=%s OCP=%s OPP=%s LVP=%s OAH=%s OHP=%s V=%s I=%s Ah=%s\n", OVP.c_str(), OCP.c_str(),
+           OPP.c_str(), LVP.c_str(), OAH.c_str(), OHP.c_str(), voltage.c_str(), current.c_str(), capacityAh.c_str());
+    return res.divergences ? 1 : 0;
+}
@@ -0,0 +1,270 @@
+// fz35_wifi: run the WiFi connection manager (FZ35_WiFi.cpp) against a simulated router
+// that goes away and comes back, on a virtual clock, next to a 1 Hz read loop like the
+// one in loop(), and check that WiFi never costs a read.
+//
+// The router is up for 10-120 min at a time; outages are mostly short (2-60 s), some
+// last minutes, a few up to two hours. The station takes 2-6 s to associate if the
+// router is there when the attempt's scan ends, else it reports WL_NO_SSID_AVAIL; a
+// connected station notices a vanished router after the beacon timeout. With
+// probability -a a phone joins the fallback AP 20 s after it comes up and stays 3 min.
+// Every WiFi call is charged an assumed cost (softAP() the most), so wifiTick()'s time
+// shows up in the read gaps.
+//
+//   fz35_wifi [-h hours] [-a apclients] [-r seed] [-v]
+//
+// It checks that
+//   - no read slot is missed, offline or online (missed_offline / missed_online),
+//   - every outage longer than the beacon timeout is one disconnect and one reconnect,
+//   - the station is back within the backoff bound after the router returns,
+//   - the fallback AP is up whenever the station has been offline WIFI_AP_AFTER_MS, and
+//     off once it is back with no client on the AP,
+// and reports the reconnect latency distribution. Exits non-zero on any violation.
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "FZ35_WiFi.h"
+
+#define CPU_TICK_US      2        // per clock read, so busy loops advance
+#define LOOP_PASS_US     300      // the rest of loop() and the SDK between passes
+#define READ_US          180000   // one blocking read of load 0
+#define READ_INTERVAL_MS 1000
+#define BEACON_US        6000000  // a vanished router is noticed after this
+#define CLIENT_JOIN_US   20000000
+#define CLIENT_STAY_US   180000000
+
+// assumed costs of the SDK calls (radio reconfiguration is the expensive part)
+#define COST_STATUS_US     3
+#define COST_BEGIN_US      2000
+#define COST_DISCONNECT_US 500
+#define COST_MODE_US       5000
+#define COST_SOFTAP_US     30000
+#define COST_SOFTAPOFF_US  10000
+#define COST_DNS_US        20
+
+static uint64_t nowUs = 0;
+uint64_t micros64() { return nowUs += CPU_TICK_US; }
+void delay(unsigned long ms) { nowUs += (uint64_t)ms * 1000; }
+
+HostSerial Serial;
+static uint32_t networkUps = 0;
+void telemetryNetworkUp() { networkUps++; }
+
+// ---------- router ----------
+
+struct Outage {
+    uint64_t downUs, upUs;
+};
+
+static std::vector<Outage> outages;
+
+static void makeOutages(std::mt19937 &rng, uint64_t endUs) {
+    std::uniform_real_distribution<double> u(0, 1);
+    uint64_t t = 0;
+    for (;;) {
+        t += (uint64_t)std::uniform_int_distribution<uint32_t>(600, 7200)(rng) * 1000000;
+        double k = u(rng);
+        uint32_t s = k < 0.7 ? std::uniform_int_distribution<uint32_t>(2, 60)(rng)
+                   : k < 0.95 ? std::uniform_int_distribution<uint32_t>(60, 900)(rng)
+                   : std::uniform_int_distribution<uint32_t>(900, 7200)(rng);
+        if (t + s * 1000000ULL >= endUs) break;
+        outages.push_back({ t, t + s * 1000000ULL });
+        t += s * 1000000ULL;
+    }
+}
+
+static bool routerUp(uint64_t t) {
+    auto it = std::upper_bound(outages.begin(), outages.end(), t,
+                               [](uint64_t v, const Outage &o) { return v < o.upUs; });
+    return it == outages.end() || t < it->downUs;
+}
+
+// ---------- station / AP ----------
+
+static std::mt19937 rng;
+static double apClientProb = 0.2;
+
+enum class Sta { Idle, Scanning, Connected, NotFound };
+static Sta sta = Sta::Idle;
+static uint64_t staAtUs = 0;     // Scanning: outcome time; Connected: since
+static uint64_t lostAtUs = 0;    // Connected: link loss noticed then (0 = not scheduled)
+static bool ap = false;
+static uint64_t apSinceUs = 0;
+static bool apClient = false;
+
+static void scheduleLoss() {
+    lostAtUs = 0;
+    for (const Outage &o : outages) {
+        if (o.downUs < staAtUs) continue;
+        if (o.upUs - o.downUs > BEACON_US) {
+            lostAtUs = o.downUs + BEACON_US;
+            return;
+        }
+    }
+}
+
+ESP8266WiFiClass WiFi;
+
+wl_status_t ESP8266WiFiClass::status() {
+    nowUs += COST_STATUS_US;
+    if (sta == Sta::Scanning && nowUs >= staAtUs) {
+        if (routerUp(staAtUs)) {
+            sta = Sta::Connected;
+            scheduleLoss();
+        } else {
+            sta = Sta::NotFound;
+        }
+    }
+    if (sta == Sta::Connected && lostAtUs && nowUs >= lostAtUs) sta = Sta::Idle;
+    return sta == Sta::Connected ? WL_CONNECTED : sta == Sta::NotFound ? WL_NO_SSID_AVAIL : WL_DISCONNECTED;
+}
+
+bool ESP8266WiFiClass::mode(WiFiMode_t) { nowUs += COST_MODE_US; return true; }
+
+wl_status_t ESP8266WiFiClass::begin(const char *, const char *) {
+    nowUs += COST_BEGIN_US;
+    sta = Sta::Scanning;
+    staAtUs = nowUs + std::uniform_int_distribution<uint32_t>(2000, 6000)(rng) * 1000ULL;
+    return WL_DISCONNECTED;
+}
+
+bool ESP8266WiFiClass::disconnect(bool) { nowUs += COST_DISCONNECT_US; sta = Sta::Idle; return true; }
+
+bool ESP8266WiFiClass::softAP(const char *, const char *) {
+    nowUs += COST_SOFTAP_US;
+    ap = true;
+    apSinceUs = nowUs;
+    apClient = std::uniform_real_distribution<double>(0, 1)(rng) < apClientProb;
+    return true;
+}
+
+bool ESP8266WiFiClass::softAPdisconnect(bool) { nowUs += COST_SOFTAPOFF_US; ap = false; return true; }
+
+uint8_t ESP8266WiFiClass::softAPgetStationNum() {
+    return ap && apClient && nowUs >= apSinceUs + CLIENT_JOIN_US && nowUs < apSinceUs + CLIENT_JOIN_US + CLIENT_STAY_US;
+}
+
+IPAddress ESP8266WiFiClass::localIP() { return IPAddress(192, 168, 1, 50); }
+IPAddress ESP8266WiFiClass::softAPIP() { return IPAddress(192, 168, 4, 1); }
+String ESP8266WiFiClass::SSID() const { return "lab"; }
+String ESP8266WiFiClass::psk() const { return "secretpass"; }
+int32_t ESP8266WiFiClass::RSSI() { return -60; }
+bool ESP8266WiFiClass::setAutoReconnect(bool) { return true; }
+bool ESP8266WiFiClass::persistent(bool) { return true; }
+
+bool DNSServer::start(uint16_t, const String &, const IPAddress &) { return true; }
+void DNSServer::stop() {}
+void DNSServer::processNextRequest() { nowUs += COST_DNS_US; }
+
+// ---------- checks ----------
+
+static unsigned long field(const String &json, const char *key) {
+    String k = String("\"") + key + "\":";
+    int i = json.indexOf(k);
+    return i < 0 ? 0 : strtoul(json.c_str() + i + k.length(), nullptr, 10);
+}
+
+static uint64_t pct(std::vector<uint64_t> &v, int p) {
+    if (v.empty()) return 0;
+    std::sort(v.begin(), v.end());
+    return v[std::min(v.size() - 1, v.size() * p / 100)];
+}
+
+static void usage() {
+    fprintf(stderr, "usage: fz35_wifi [-h hours] [-a apclients] [-r seed] [-v]\n");
+}
+
+int main(int argc, char **argv) {
+    double hours = 200;
+    uint32_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "-h") && i + 1 < argc) hours = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-a") && i + 1 < argc) apClientProb = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-r") && i + 1 < argc) seed = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-v")) Serial.enabled = true;
+        else { usage(); return 2; }
+    }
+    if (hours <= 0 || hours > 1000) { usage(); return 2; }   // millis() stays in uint32_t
+    rng.seed(seed);
+    uint64_t endUs = (uint64_t)(hours * 3600e6);
+    makeOutages(rng, endUs);
+
+    DNSServer dns;
+    setupWiFi(dns);
+    uint32_t lastRead = millis();
+    uint32_t reads = 0, violations = 0;
+    uint32_t apLate = 0, apLingered = 0;
+    bool wasUp = false;
+    uint64_t offlineSinceUs = nowUs;
+    std::vector<uint64_t> recoverUs;   // router back -> station connected
+    uint32_t backoffViolations = 0;
+
+    while (nowUs < endUs) {
+        wifiTick();
+        bool up = wifiStationUp();
+        if (up && !wasUp && offlineSinceUs) {
+            // latest router return before now: the wait since then is the backoff's doing
+            uint64_t backUs = 0;
+            for (const Outage &o : outages) {
+                if (o.upUs <= nowUs && o.upUs > offlineSinceUs) backUs = o.upUs;
+            }
+            if (backUs) {
+                uint64_t waitUs = nowUs - backUs;
+                recoverUs.push_back(waitUs);
+                // the pending backoff is at most the outage so far (it doubles), plus an
+                // attempt that was already scanning, plus a phone on the AP holding it off
+                uint64_t outageUs = backUs - offlineSinceUs;
+                uint64_t boundUs = std::min<uint64_t>(std::max<uint64_t>(outageUs, WIFI_BACKOFF_MIN * 1000ULL),
+                                                      WIFI_BACKOFF_MAX * 1000ULL) +
+                                   2 * (WIFI_CONNECT_TIMEOUT_MS * 1000ULL) + CLIENT_JOIN_US + CLIENT_STAY_US;
+                if (waitUs > boundUs) backoffViolations++;
+            }
+        }
+        if (!up && wasUp) offlineSinceUs = nowUs;
+        wasUp = up;
+        if (!up && !wifiApActive() && nowUs - offlineSinceUs > (WIFI_AP_AFTER_MS + 1000) * 1000ULL) apLate++;
+        if (up && wifiApActive() && !WiFi.softAPgetStationNum()) apLingered++;
+
+        if (millis() - lastRead > READ_INTERVAL_MS) {
+            uint32_t start = millis();
+            nowUs += READ_US;
+            wifiNoteRead(start, READ_INTERVAL_MS);
+            reads++;
+            lastRead = millis();
+        }
+        nowUs += LOOP_PASS_US;
+    }
+
+    String st = wifiStatusJson();
+    uint32_t drops = 0;
+    for (const Outage &o : outages) drops += o.upUs - o.downUs > BEACON_US;
+    unsigned long missedOff = field(st, "missed_offline"), missedOn = field(st, "missed_online");
+    unsigned long disconnects = field(st, "disconnects"), reconnects = field(st, "reconnects");
+    bool endUp = wifiStationUp();
+
+    printf("%.0f h, %u outages (%u longer than the beacon timeout), %u reads\n", hours,
+           (unsigned)outages.size(), (unsigned)drops, (unsigned)reads);
+    printf("disconnects %lu, reconnects %lu, attempts %lu, AP starts %lu, telemetry told %u times\n",
+           disconnects, reconnects, field(st, "attempts"), field(st, "ap_starts"), (unsigned)networkUps);
+    printf("offline total %lu s, reconnect max %lu ms, wifiTick max %lu us\n",
+           field(st, "offline_ms_total") / 1000, field(st, "reconnect_ms_max"), field(st, "tick_us_max"));
+    printf("reads offline %lu, missed offline %lu, missed online %lu, max gap offline %lu ms, online %lu ms\n",
+           field(st, "reads_offline"), missedOff, missedOn, field(st, "gap_ms_max_offline"),
+           field(st, "gap_ms_max_online"));
+    std::vector<uint64_t> r = recoverUs;
+    printf("router back -> connected: p50 %.1f s, p95 %.1f s, max %.1f s\n", pct(r, 50) / 1e6, pct(r, 95) / 1e6,
+           pct(r, 100) / 1e6);
+
+    if (missedOff || missedOn) { printf("FAIL: reads missed\n"); violations++; }
+    // an outage still running at the end has disconnected but not reconnected
+    if (disconnects != drops || reconnects != drops - !endUp) {
+        printf("FAIL: %lu disconnects / %lu reconnects for %u outages\n", disconnects, reconnects, (unsigned)drops);
+        violations++;
+    }
+    if (networkUps != reconnects + 1) { printf("FAIL: telemetry told %u times\n", (unsigned)networkUps); violations++; }
+    if (backoffViolations) { printf("FAIL: %u reconnects beyond the backoff bound\n", (unsigned)backoffViolations); violations++; }
+    if (apLate) { printf("FAIL: AP down %u passes after %d ms offline\n", (unsigned)apLate, WIFI_AP_AFTER_MS); violations++; }
+    if (apLingered) { printf("FAIL: AP up %u passes after reconnecting\n", (unsigned)apLingered); violations++; }
+    printf("%s\n", violations ? "FAIL" : "PASS");
+    return violations ? 1 : 0;
+}
@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+"""Regenerate FZ35_WebUI_gz.h from the index_html literal in FZ35_WebUI.h.
+
+Run from anywhere after editing the dashboard:
+    python3 tools/gen_webui_gz.py
+
+The output is deterministic (gzip mtime 0), so an unchanged dashboard yields an
+unchanged header and ETag. The ETag is derived from the uncompressed page.
+"""
+import gzip
+import hashlib
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SRC = os.path.join(ROOT, "FZ35_WebUI.h")
+DST = os.path.join(ROOT, "FZ35_WebUI_gz.h")
+
+
+def main():
+    with open(SRC, "r", encoding="utf-8") as f:
+        text = f.read()
+    m = re.search(r'index_html\[\] PROGMEM = R"rawliteral\((.*?)\)rawliteral"', text, re.S)
+    if not m:
+        sys.exit("index_html raw literal not found in FZ35_WebUI.h")
+    raw = m.group(1).encode("utf-8")
+    gz = gzip.compress(raw, compresslevel=9, mtime=0)
+    etag = hashlib.sha1(raw).hexdigest()[:16]
+
+    lines = []
+    for i in range(0, len(gz), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in gz[i:i + 16]) + ",")
+
+    out = []
+    out.append("#pragma once")
+    out.append("#include <Arduino.h>")
+    out.append("#include <pgmspace.h>")
+    out.append("")
+    out.append("/**")
+    out.append(" * @file FZ35_WebUI_gz.h")
+    out.append(" * @brief GENERATED by tools/gen_webui_gz.py from index_html in FZ35_WebUI.h - do not edit.")
+    out.append(" *        %d bytes raw -> %d bytes gzip." % (len(raw), len(gz)))
+    out.append(" */")
+    out.append("")
+    out.append("#define INDEX_HTML_RAW_LEN %d" % len(raw))
+    out.append('#define INDEX_HTML_ETAG "\\"%s\\""' % etag)
+    out.append("")
+    out.append("const uint8_t index_html_gz[] PROGMEM = {")
+    out.extend(lines)
+    out.append("};")
+    out.append("const size_t index_html_gz_len = sizeof(index_html_gz);")
+    out.append("")
+
+    with open(DST, "w", encoding="utf-8", newline="\r\n") as f:
+        f.write("\n".join(out))
+    print("index_html: %d bytes raw, %d bytes gzip (%.1f%%), etag %s"
+          % (len(raw), len(gz), 100.0 * len(gz) / len(raw), etag))
+
+
+if __name__ == "__main__":
+    main()
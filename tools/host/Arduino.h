@@ -0,0 +1,110 @@
+#pragma once
+// Minimal Arduino core for host builds of the firmware's serial/parse code
+// (tools/fz35_replay). Time is virtual: the tool owns the clock.
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <string>
+
+// ---------- virtual clock (defined by the tool) ----------
+
+uint64_t micros64();
+void delay(unsigned long ms);
+inline unsigned long millis() { return (unsigned long)(micros64() / 1000); }
+inline unsigned long micros() { return (unsigned long)micros64(); }
+inline void yield() {}
+
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+#define constrain(x, lo, hi) ((x) < (lo) ? (lo) : ((x) > (hi) ? (hi) : (x)))
+
+// ---------- String ----------
+
+class String {
+public:
+    String(const char *s = "") : s_(s ? s : "") {}
+    String(const std::string &s) : s_(s) {}
+    String(char c) : s_(1, c) {}
+    String(int v) : s_(std::to_string(v)) {}
+    String(unsigned v) : s_(std::to_string(v)) {}
+    String(long v) : s_(std::to_string(v)) {}
+    String(unsigned long v) : s_(std::to_string(v)) {}
+    String(float v, unsigned decimals = 2) : String((double)v, decimals) {}
+    String(double v, unsigned decimals = 2) {
+        char buf[48];
+        snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+        s_ = buf;
+    }
+
+    unsigned length() const { return (unsigned)s_.size(); }
+    const char *c_str() const { return s_.c_str(); }
+    char charAt(unsigned i) const { return i < s_.size() ? s_[i] : 0; }
+    void setCharAt(unsigned i, char c) { if (i < s_.size()) s_[i] = c; }
+    char operator[](unsigned i) const { return charAt(i); }
+    void reserve(unsigned n) { s_.reserve(n); }
+
+    int indexOf(char c, unsigned from = 0) const { return pos(s_.find(c, from)); }
+    int indexOf(const String &t, unsigned from = 0) const { return pos(s_.find(t.s_, from)); }
+    int indexOf(const char *t, unsigned from = 0) const { return pos(s_.find(t, from)); }
+    String substring(unsigned from) const { return from < s_.size() ? String(s_.substr(from)) : String(); }
+    String substring(unsigned from, unsigned to) const {
+        if (to > s_.size()) to = (unsigned)s_.size();
+        return from < to ? String(s_.substr(from, to - from)) : String();
+    }
+    bool startsWith(const String &t) const { return s_.compare(0, t.s_.size(), t.s_) == 0; }
+    bool endsWith(const String &t) const {
+        return s_.size() >= t.s_.size() && s_.compare(s_.size() - t.s_.size(), t.s_.size(), t.s_) == 0;
+    }
+    bool equalsIgnoreCase(const String &t) const {
+        if (s_.size() != t.s_.size()) return false;
+        for (size_t i = 0; i < s_.size(); ++i) {
+            if (tolower((unsigned char)s_[i]) != tolower((unsigned char)t.s_[i])) return false;
+        }
+        return true;
+    }
+    void trim() {
+        size_t a = 0, b = s_.size();
+        while (a < b && isspace((unsigned char)s_[a])) a++;
+        while (b > a && isspace((unsigned char)s_[b - 1])) b--;
+        s_ = s_.substr(a, b - a);
+    }
+    void toLowerCase() { for (auto &c : s_) c = (char)tolower((unsigned char)c); }
+    void toUpperCase() { for (auto &c : s_) c = (char)toupper((unsigned char)c); }
+    float toFloat() const { return (float)atof(s_.c_str()); }
+    long toInt() const { return atol(s_.c_str()); }
+
+    String &operator+=(const String &t) { s_ += t.s_; return *this; }
+    String &operator+=(const char *t) { s_ += t; return *this; }
+    String &operator+=(char c) { s_ += c; return *this; }
+    friend String operator+(const String &a, const String &b) { return String(a.s_ + b.s_); }
+    friend String operator+(const String &a, const char *b) { return String(a.s_ + b); }
+    friend String operator+(const char *a, const String &b) { return String(a + b.s_); }
+    bool operator==(const String &t) const { return s_ == t.s_; }
+    bool operator==(const char *t) const { return s_ == t; }
+    bool operator!=(const String &t) const { return s_ != t.s_; }
+
+private:
+    static int pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+    std::string s_;
+};
+
+// ---------- Serial (debug console) ----------
+
+class HostSerial {
+public:
+    bool enabled = false;
+    void printf(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+        if (!enabled) return;
+        va_list ap;
+        va_start(ap, fmt);
+        vprintf(fmt, ap);
+        va_end(ap);
+    }
+    void print(const String &s) { if (enabled) fputs(s.c_str(), stdout); }
+    void println(const String &s = String()) { if (enabled) puts(s.c_str()); }
+};
+extern HostSerial Serial;
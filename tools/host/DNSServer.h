@@ -0,0 +1,10 @@
+#pragma once
+// Host stand-in for the captive portal DNS; the tool defines the methods.
+#include "ESP8266WiFi.h"
+
+class DNSServer {
+public:
+    bool start(uint16_t port, const String &domain, const IPAddress &ip);
+    void stop();
+    void processNextRequest();
+};
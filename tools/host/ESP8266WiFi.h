@@ -0,0 +1,42 @@
+#pragma once
+// Host stand-in for the ESP8266 WiFi core; the tool defines the methods (e.g. a
+// simulated router, tools/fz35_wifi).
+#include "Arduino.h"
+
+class IPAddress {
+public:
+    IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : b_{ a, b, c, d } {}
+    String toString() const {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%u.%u.%u.%u", b_[0], b_[1], b_[2], b_[3]);
+        return String(buf);
+    }
+
+private:
+    uint8_t b_[4];
+};
+
+enum WiFiMode_t { WIFI_OFF, WIFI_STA, WIFI_AP, WIFI_AP_STA };
+enum wl_status_t {
+    WL_IDLE_STATUS = 0, WL_NO_SSID_AVAIL = 1, WL_CONNECTED = 3, WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5, WL_WRONG_PASSWORD = 6, WL_DISCONNECTED = 7
+};
+
+class ESP8266WiFiClass {
+public:
+    wl_status_t status();
+    bool mode(WiFiMode_t m);
+    wl_status_t begin(const char *ssid, const char *pass = nullptr);
+    bool disconnect(bool wifiOff = false);
+    bool softAP(const char *ssid, const char *pass = nullptr);
+    bool softAPdisconnect(bool wifiOff = false);
+    uint8_t softAPgetStationNum();
+    IPAddress localIP();
+    IPAddress softAPIP();
+    String SSID() const;
+    String psk() const;
+    int32_t RSSI();
+    bool setAutoReconnect(bool on);
+    bool persistent(bool on);
+};
+extern ESP8266WiFiClass WiFi;
@@ -0,0 +1,3 @@
+#pragma once
+// Host stand-in: the tools link no file system code, headers only need this to exist.
+#include "Arduino.h"
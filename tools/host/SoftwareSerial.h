@@ -0,0 +1,24 @@
+#pragma once
+// Host stand-in for the device link; the tool defines the methods (e.g. a trace player).
+#include "Arduino.h"
+
+enum SoftwareSerialConfig { SWSERIAL_8N1 };
+
+class SoftwareSerial {
+public:
+    SoftwareSerial(int rx, int tx) : rxPin(rx), txPin(tx) {}
+    void begin(long baud) { (void)baud; }
+    void begin(long baud, SoftwareSerialConfig config, int rx, int tx, bool invert, int bufCapacity = 64) {
+        (void)baud; (void)config; (void)invert;
+        rxPin = rx;
+        txPin = tx;
+        rxCapacity = bufCapacity;
+    }
+    int available();
+    int read();
+    void print(const String &s);
+    void println(const String &s = String());
+
+    int rxPin, txPin;
+    int rxCapacity = 64;    // RX buffer size, for tools that model overflow
+};
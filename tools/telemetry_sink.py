@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+"""Stub broker / InfluxDB for testing the telemetry publisher (FZ35_Telemetry).
+
+  telemetry_sink.py mqtt   [--port 1883] [--down 30,60]
+  telemetry_sink.py influx [--port 8086] [--down 30,60] [--status 204]
+
+mqtt:   accepts CONNECT (answers CONNACK), PUBLISH (QoS 0) and PINGREQ.
+influx: accepts POST /write and answers --status.
+Prints every line received and, every 10 s, lines/s and bytes/s.
+--down A,B drops open connections at A and refuses new ones until B seconds after
+start, to exercise spooling and the backlog drain. Point the device at this machine:
+
+  curl -d enabled=1 -d proto=mqtt -d host=192.168.1.10 -d port=1883 http://<device>/telemetry_config
+"""
+import argparse
+import socket
+import threading
+import time
+
+start = time.time()
+lock = threading.Lock()
+totals = {"lines": 0, "bytes": 0, "messages": 0}
+conns = set()
+
+
+def received(payload, quiet):
+    text = payload.decode(errors="replace")
+    lines = [l for l in text.split("\n") if l]
+    with lock:
+        totals["lines"] += len(lines)
+        totals["bytes"] += len(payload)
+        totals["messages"] += 1
+    if not quiet:
+        for l in lines:
+            print(l)
+
+
+def read_exact(conn, n):
+    data = b""
+    while len(data) < n:
+        chunk = conn.recv(n - len(data))
+        if not chunk:
+            raise ConnectionError("closed")
+        data += chunk
+    return data
+
+
+def serve_mqtt(conn, args):
+    while True:
+        head = read_exact(conn, 1)[0]
+        length, shift = 0, 0
+        while True:
+            b = read_exact(conn, 1)[0]
+            length |= (b & 0x7F) << shift
+            shift += 7
+            if not b & 0x80:
+                break
+        body = read_exact(conn, length)
+        kind = head >> 4
+        if kind == 1:  # CONNECT
+            client_id = body[12:12 + (body[10] << 8 | body[11])].decode(errors="replace")
+            print("CONNECT %s keepalive %ds" % (client_id, body[8] << 8 | body[9]))
+            conn.sendall(bytes([0x20, 0x02, 0x00, 0x00]))
+        elif kind == 3:  # PUBLISH
+            topic_len = body[0] << 8 | body[1]
+            offset = 2 + topic_len + (2 if head & 0x06 else 0)
+            received(body[offset:], args.quiet)
+        elif kind == 12:  # PINGREQ
+            conn.sendall(bytes([0xD0, 0x00]))
+        elif kind == 14:  # DISCONNECT
+            return
+
+
+def serve_influx(conn, args):
+    data = b""
+    while b"\r\n\r\n" not in data:
+        chunk = conn.recv(4096)
+        if not chunk:
+            return
+        data += chunk
+    head, body = data.split(b"\r\n\r\n", 1)
+    length = 0
+    for line in head.split(b"\r\n")[1:]:
+        name, _, value = line.partition(b":")
+        if name.strip().lower() == b"content-length":
+            length = int(value)
+    body += read_exact(conn, length - len(body))
+    if not args.quiet:
+        print(head.split(b"\r\n")[0].decode())
+    received(body, args.quiet)
+    reason = {204: "No Content", 400: "Bad Request", 500: "Internal Server Error"}.get(args.status, "")
+    conn.sendall(b"HTTP/1.1 %d %s\r\nContent-Length: 0\r\nConnection: close\r\n\r\n"
+                 % (args.status, reason.encode()))
+
+
+def handle(conn, args):
+    with lock:
+        conns.add(conn)
+    try:
+        (serve_mqtt if args.proto == "mqtt" else serve_influx)(conn, args)
+    except (ConnectionError, OSError):
+        pass
+    finally:
+        with lock:
+            conns.discard(conn)
+        conn.close()
+
+
+def outage(at):
+    time.sleep(at)
+    print("-- outage")
+    with lock:
+        for conn in conns:
+            conn.shutdown(socket.SHUT_RDWR)
+
+
+def report():
+    last = dict(totals)
+    while True:
+        time.sleep(10)
+        with lock:
+            now = dict(totals)
+        print("-- %4ds  %.1f lines/s  %.0f B/s  (%d lines, %d messages)" % (
+            time.time() - start, (now["lines"] - last["lines"]) / 10.0,
+            (now["bytes"] - last["bytes"]) / 10.0, now["lines"], now["messages"]))
+        last = now
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("proto", choices=["mqtt", "influx"])
+    ap.add_argument("--port", type=int)
+    ap.add_argument("--down", help="drop connections at A, refuse them until B (seconds after start)")
+    ap.add_argument("--status", type=int, default=204, help="influx: HTTP status to answer")
+    ap.add_argument("-q", "--quiet", action="store_true", help="counters only")
+    args = ap.parse_args()
+    port = args.port or (1883 if args.proto == "mqtt" else 8086)
+    down = [float(x) for x in args.down.split(",")] if args.down else None
+
+    srv = socket.socket()
+    srv.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    srv.bind(("", port))
+    srv.listen(4)
+    print("%s sink on port %d" % (args.proto, port))
+    threading.Thread(target=report, daemon=True).start()
+    if down:
+        threading.Thread(target=outage, args=(down[0],), daemon=True).start()
+    while True:
+        conn, addr = srv.accept()
+        t = time.time() - start
+        if down and down[0] <= t < down[1]:
+            conn.close()
+            continue
+        threading.Thread(target=handle, args=(conn, args), daemon=True).start()
+
+
+if __name__ == "__main__":
+    main()